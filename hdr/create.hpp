@@ -200,6 +200,12 @@ namespace create{
 	double get_material_height_min(const int material);
 	double get_material_height_max(const int material);
 
+   // Functions to cache data computed after system creation (such as dipole
+   // tensors) alongside the system cache, keyed on a hash of its input
+   uint64_t hash_cache_input(uint64_t hash, const void* data, const uint64_t bytes);
+   bool load_cache_section(const std::string& name, const uint64_t input_hash, const std::vector< std::vector< std::vector<double> >* >& arrays);
+   void save_cache_section(const std::string& name, const uint64_t input_hash, const std::vector< const std::vector< std::vector<double> >* >& arrays);
+
 
 } // end of namespace create
 
@@ -24,6 +24,10 @@ namespace cs{
 
 //------------------------------------------------------------------
 // Simple class to store atom properties in object oriented way
+//
+// One object exists for every generated site until the system is cut
+// to shape, so members are ordered largest first and kept to 32 bit
+// types to avoid padding (80 bytes per atom).
 //------------------------------------------------------------------
 class catom_t {
 
@@ -35,15 +39,10 @@ public:
    double z; // z-position of atom
 
    // Global atomic coordinates
-   uint64_t uc_id;        // atom number of host unit cell
-   int64_t scx;                   // supercell x coordinate of atom |
-   int64_t scy;                   // supercell y coordinate of atom |
-   int64_t scz;                   // supercell z coordinate of atom /
-
-   // Flags
-   bool include; // boolean to incude atom in structure (or not)
-   bool boundary; // boolean to determine if atom interacts with MPI halo
-   bool non_interacting_halo; // boolean to determine if atom is non-interacting halo
+   int scx;                   // supercell x coordinate of atom |
+   int scy;                   // supercell y coordinate of atom |
+   int scz;                   // supercell z coordinate of atom /
+   unsigned int uc_id;        // atom number of host unit cell
 
    // Integers
    int material;              // atom material belongs to
@@ -55,8 +54,11 @@ public:
    int mpi_cpuid;             // CPU id atom is located on
    int mpi_atom_number;       //
    int mpi_old_atom_number;   //
-   unsigned int nn;           // number of neighbours
-   unsigned int nbqn;         // number of biquadratic neighbours
+
+   // Flags
+   bool include; // boolean to incude atom in structure (or not)
+   bool boundary; // boolean to determine if atom interacts with MPI halo
+   bool non_interacting_halo; // boolean to determine if atom is non-interacting halo
 
    //----------------------------------
    // Class constructor
@@ -65,13 +67,10 @@ public:
       x(0.0),
       y(0.0),
       z(0.0),
-      uc_id(0),
       scx(0),
       scy(0),
       scz(0),
-      include(false),
-      boundary(false),
-      non_interacting_halo(true),
+      uc_id(0),
       material(0),
       uc_category(0),
       lh_category(0),
@@ -81,9 +80,9 @@ public:
       mpi_cpuid(0),
       mpi_atom_number(0),
       mpi_old_atom_number(0),
-
-      nn(0),
-      nbqn(0)
+      include(false),
+      boundary(false),
+      non_interacting_halo(true)
    {
       // Do nothing
       return;
@@ -114,6 +114,11 @@ namespace dipole{
                    int num_atoms
    );
 
+   //-----------------------------------------------------------------------------
+   // Function to release memory of dipole module at end of simulation
+   //-----------------------------------------------------------------------------
+   void finalize();
+
    //---------------------------------------------------------------------------
    // Function to process input file parameters for dipole module
    //---------------------------------------------------------------------------
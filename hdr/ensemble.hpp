@@ -0,0 +1,79 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+#ifndef ENSEMBLE_H_
+#define ENSEMBLE_H_
+
+// C++ standard library headers
+#include <string>
+#include <vector>
+
+//--------------------------------------------------------------------------------
+// Namespace for variables and functions for batched multi-replica ensembles
+//--------------------------------------------------------------------------------
+namespace ensemble{
+
+   //-----------------------------------------------------------------------------
+   // Externally visible variables
+   //-----------------------------------------------------------------------------
+   extern bool enabled; // flag to enable multi-replica ensemble mode
+
+   //-----------------------------------------------------------------------------
+   // Function to initialise ensemble module
+   //-----------------------------------------------------------------------------
+   void initialize(const int num_atoms,
+                   const std::vector<double>& x_spin_array,
+                   const std::vector<double>& y_spin_array,
+                   const std::vector<double>& z_spin_array);
+
+   //-----------------------------------------------------------------------------
+   // Function to integrate all replicas by one Monte Carlo step
+   //-----------------------------------------------------------------------------
+   void mc_step();
+
+   //-----------------------------------------------------------------------------
+   // Functions to update and reset statistics of additional replicas
+   //-----------------------------------------------------------------------------
+   void update_statistics();
+   void reset_statistics();
+
+   //-----------------------------------------------------------------------------
+   // Function to swap statistics, temperature and applied field of a replica
+   // with the global values for output, a second call restores them
+   //-----------------------------------------------------------------------------
+   void swap_replica_statistics(const int replica);
+
+   //-----------------------------------------------------------------------------
+   // Function to set explicit replica temperatures, replacing the temperature
+   // increment relative to sim::temperature
+   //-----------------------------------------------------------------------------
+   void set_temperature_ladder(const std::vector<double>& temperatures);
+
+   //-----------------------------------------------------------------------------
+   // Functions to attempt configuration exchange between neighbouring replicas
+   // and to get and reset the acceptance rate for each pair of replicas
+   //-----------------------------------------------------------------------------
+   void attempt_replica_exchange();
+   void get_exchange_acceptance(std::vector<double>& acceptance);
+   void reset_exchange_statistics();
+
+   //-----------------------------------------------------------------------------
+   // Function to get number of replicas in the ensemble
+   //-----------------------------------------------------------------------------
+   int get_num_replicas();
+
+   //---------------------------------------------------------------------------
+   // Function to process input file parameters for ensemble module
+   //---------------------------------------------------------------------------
+   bool match_input_parameter(std::string const key, std::string const word, std::string const value, std::string const unit, int const line);
+
+} // end of ensemble namespace
+
+#endif //ENSEMBLE_H_
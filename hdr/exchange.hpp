@@ -91,6 +91,11 @@ namespace exchange{
    //-----------------------------------------------------------------------------
    unsigned int get_exchange_type();
 
+   //-----------------------------------------------------------------------------
+   // Function to check if four spin exchange interactions are enabled
+   //-----------------------------------------------------------------------------
+   bool is_four_spin_enabled();
+
    //---------------------------------------------------------------------------
    // Calculate  exchange energy for single spin selecting the correct type
    //---------------------------------------------------------------------------
@@ -98,6 +103,19 @@ namespace exchange{
    double single_spin_biquadratic_energy(const int atom, const double sx, const double sy, const double sz);
    double single_spin_four_spin_energy(const int atom, const double sx, const double sy, const double sz);
 
+   //---------------------------------------------------------------------------
+   // Calculate total four spin exchange energy of the system
+   //---------------------------------------------------------------------------
+   double four_spin_energy();
+
+   //---------------------------------------------------------------------------
+   // Calculate exchange field of a single atom for a batch of replicas (or a
+   // block of them) with spins stored replica interleaved [atom][component][replica]
+   //---------------------------------------------------------------------------
+   void replica_fields(const int atom, const int num_replicas, const std::vector<double>& spin_array, std::vector<double>& field_array);
+   void replica_fields(const int atom, const int num_replicas, const int first_replica, const int last_replica,
+                       const std::vector<double>& spin_array, std::vector<double>& field_array);
+
    //-----------------------------------------------------------------------------
    // Function to calculate exchange fields for spins between start and end index
    //-----------------------------------------------------------------------------
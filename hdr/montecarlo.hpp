@@ -14,6 +14,7 @@
 #define MONTECARLO_H_
 
 // C++ standard library headers
+#include <random>
 #include <string>
 #include <vector>
 
@@ -52,6 +53,37 @@ namespace montecarlo{
    void lsf_mc_step();
    void lsf_mc_step_parallel(std::vector<double> &x_spin_array, std::vector<double> &y_spin_array, std::vector<double> &z_spin_array, std::vector<int> &type_array);
 
+   //---------------------------------------------------------------------------
+   // Random number generator of a single replica of a batch. The generator of
+   // mtrandom shares its state between all instances, so each replica holds
+   // its own stream to allow replicas to be integrated on separate threads.
+   //---------------------------------------------------------------------------
+   struct replica_rng_t{
+
+      std::mt19937 generator;
+      std::uniform_real_distribution<double> uniform;
+      std::normal_distribution<double> gaussian;
+
+      replica_rng_t(): uniform(0.0, 1.0), gaussian(0.0, 1.0) {}
+
+   };
+
+   //---------------------------------------------------------------------------
+   // Function to perform one monte carlo step for a batch of replicas with
+   // spins stored replica interleaved [atom][component][replica]
+   //---------------------------------------------------------------------------
+   void mc_step_ensemble(std::vector<double>& spin_array, const int num_replicas, const int num_atoms, const std::vector<int>& type_array,
+                         const std::vector<double>& temperature, const std::vector<double>& applied_field, std::vector<double>& adaptive_sigma,
+                         std::vector<replica_rng_t>& rng);
+
+   //---------------------------------------------------------------------------
+   // Function to attempt exchange of configurations between neighbouring
+   // replicas (offset, offset+1), (offset+2, offset+3) ... of a batch
+   //---------------------------------------------------------------------------
+   void replica_exchange(std::vector<double>& spin_array, const int num_replicas, const int num_atoms, const std::vector<int>& type_array,
+                         const std::vector<double>& temperature, const std::vector<double>& applied_field, const int offset,
+                         std::vector<double>& attempts, std::vector<double>& accepts);
+
    //---------------------------------------------------------------------------
    // Provide access to CMCinit and CMCMCinit for cmc_anisotropy and
    // hybrid_cmc programs respectively
@@ -73,6 +73,7 @@ namespace program
 	extern void electrical_pulse();
 	extern void spin_waves(); // JRH
 	extern void field_pulse();
+	extern void parallel_tempering();
 
 	// Sundry programs and diagnostics not under general release
 	extern int LLB_Boltzmann();
@@ -77,7 +77,11 @@ namespace sim{
 	// enumerated list for integrators
 	enum integrator_t{ llg_heun = 0, monte_carlo = 1, llg_midpoint = 2,
 							 cmc = 3, hybrid_cmc = 4, llg_quantum = 5, lsf = 6,
-							 lsf_mc = 7, lsf_rk4 = 8, suzuki_trotter = 9};
+							 lsf_mc = 7, lsf_rk4 = 8, suzuki_trotter = 9,
+							 llg_adaptive = 10};
+
+	// enumerated list for energy minimisers of quasi-static programs
+	enum minimiser_t{ no_minimiser = 0, fire_minimiser = 1 };
 
 	extern std::ofstream mag_file;
 	extern uint64_t time;
@@ -163,6 +167,7 @@ namespace sim{
 	extern int noise_type;
 
 	extern integrator_t integrator; // variable to specify integrator
+	extern minimiser_t minimiser; // energy minimiser used by quasi-static programs
 	extern int program;
 
    // Local system variables
@@ -189,6 +194,7 @@ namespace sim{
 	extern int run();
 	extern int initialise();
 	extern int integrate(uint64_t);
+	extern uint64_t minimise(const uint64_t max_iterations);
 
 	// Legacy integrators
 	extern int LLB(int);
@@ -215,6 +221,8 @@ namespace sim{
    extern double calculate_spin_energy(const int atom);
    extern double spin_applied_field_energy(const double, const double, const double);
    extern double spin_magnetostatic_energy(const int, const double, const double, const double);
+   extern double spin_onsite_energy(const int atom, const int imaterial, const double sx, const double sy, const double sz,
+                                    const double temperature, const double applied_field);
 
 	void calculate_spin_fields(const int start_index,const int end_index);
 	void calculate_external_fields(const int start_index,const int end_index);
@@ -106,10 +106,15 @@ namespace stats
 	extern bool calculate_system_binder_cumulant;
 	extern bool calculate_material_binder_cumulant;
 
+   extern bool calculate_system_histogram;
+   extern int histogram_energy_bins;        // number of energy bins for histograms
+   extern int histogram_magnetization_bins; // number of magnetization bins for histograms
+
 	// forward declaration of friend classes
 	class susceptibility_statistic_t;
 	class specific_heat_statistic_t;
         class binder_cumulant_statistic_t;
+   class histogram_statistic_t;
 
 	class standard_deviation_statistic_t;
    //----------------------------------
@@ -118,6 +123,7 @@ namespace stats
    class energy_statistic_t{
 
       friend class specific_heat_statistic_t;
+      friend class histogram_statistic_t;
 
    public:
       energy_statistic_t (std::string n):initialized(false){
@@ -247,6 +253,7 @@ namespace stats
       friend class susceptibility_statistic_t;
       friend class standard_deviation_statistic_t;
       friend class binder_cumulant_statistic_t;
+      friend class histogram_statistic_t;
       public:
          magnetization_statistic_t (std::string n):initialized(false){
            name = n;
@@ -534,6 +541,32 @@ namespace stats
 
    };
 
+   //----------------------------------
+   // Energy-magnetization histogram Class definition
+   //----------------------------------
+   class histogram_statistic_t{
+
+      public:
+         histogram_statistic_t (std::string n):initialized(false){
+           name = n;
+         };
+         void initialize(energy_statistic_t& energy_stat, magnetization_statistic_t& mag_stat);
+         void calculate(const std::vector<double>& energy, const std::vector<double>& magnetization, const double temperature, const double field);
+         void write_histogram();
+         void reset_histogram();
+
+      private:
+         bool initialized;
+         double normalisation;                    // number of spins
+         double saturation;                       // saturation moment (mu_B)
+         double temperature;                      // temperature of current block of samples
+         double field;                            // applied field of current block of samples
+         std::vector<double> energy_samples;      // total energy samples (J)
+         std::vector<double> magnetization_samples; // reduced magnetization length samples
+         std::string name;
+
+   };
+
    //----------------------------------
 	// Statistics class instantiations
    //----------------------------------
@@ -586,6 +619,8 @@ namespace stats
    extern binder_cumulant_statistic_t system_binder_cumulant;
    extern binder_cumulant_statistic_t material_binder_cumulant;
 
+   extern histogram_statistic_t system_histogram;
+
 }
 
 #endif /*STATS_H_*/
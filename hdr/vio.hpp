@@ -107,7 +107,8 @@ namespace vin{
    extern std::vector<int> integers_from_string(std::string value);
 
    // function to read file on master process and return a std::string of its contents
-   extern std::string get_string(std::string const filename, std::string source_file_name, int line);
+   // on all processes (or only on the master process if broadcast is false)
+   extern std::string get_string(std::string const filename, std::string source_file_name, int line, bool broadcast = true);
 
    // simple functions to extract variables from strings
    extern uint64_t str_to_uint64(std::string input_str);
@@ -115,6 +116,8 @@ namespace vin{
 
    extern std::vector<mp::materials_t> read_material;
 
+   extern uint64_t structural_input_hash; // hash of input and material file lines which can affect the system structure
+
 }
 
 namespace vout{
@@ -136,6 +136,92 @@ namespace vmpi{
    // function to seed random numbers in parallel
    uint32_t parallel_rng_seed(int seed);
 
+   //---------------------------------------------------------------------------
+   // Node level shared memory
+   //---------------------------------------------------------------------------
+   extern int my_node_rank;        // rank of processor within shared memory node
+   extern int num_node_processors; // number of processors sharing memory on node
+#ifdef MPICF
+   extern MPI_Comm node_comm;        // communicator for processors on the same node
+   extern MPI_Comm node_master_comm; // communicator for node master processors (MPI_COMM_NULL elsewhere)
+#endif
+
+   extern void initialise_shared_memory();
+
+   //---------------------------------------------------------------------------
+   // Block of memory stored once per node and visible to all processors on
+   // the node (MPI-3 shared memory window). Allocation and release are
+   // collective over all processors. Without MPI-3 each processor holds its
+   // own copy.
+   //---------------------------------------------------------------------------
+   class shared_memory_t{
+
+   public:
+
+      shared_memory_t();
+      ~shared_memory_t();
+
+      void allocate(uint64_t bytes); // allocate zeroed memory (collective)
+      void release();                // free memory (collective)
+      void sync();                   // synchronise writes between processors on node
+      bool writer() const;           // true on one processor per copy of the data
+      void* data() const { return ptr; }
+
+   private:
+
+      // shared windows cannot be copied
+      shared_memory_t(const shared_memory_t&);
+      shared_memory_t& operator=(const shared_memory_t&);
+
+      void* ptr;             // pointer to start of shared data
+      uint64_t num_bytes;    // size of shared data
+      std::vector<char> local_data; // storage without shared memory support
+   #ifdef MPICF
+      MPI_Win window;        // shared memory window
+      bool window_allocated; // flag if window has been allocated
+   #endif
+
+   };
+
+   //---------------------------------------------------------------------------
+   // Read-mostly array of trivially copyable values shared within a node.
+   // Data should only be written where writer() is true (or to disjoint
+   // ranges by each processor), followed by a call to sync() before reading.
+   //---------------------------------------------------------------------------
+   template <typename T>
+   class shared_array_t{
+
+   public:
+
+      shared_array_t() : num_elements(0) {}
+
+      void resize(uint64_t n){
+         memory.allocate(n*sizeof(T));
+         num_elements = n;
+      }
+      void clear(){
+         memory.release();
+         num_elements = 0;
+      }
+      void sync(){ memory.sync(); }
+      bool writer() const { return memory.writer(); }
+
+      uint64_t size() const { return num_elements; }
+      T* data(){ return static_cast<T*>(memory.data()); }
+      const T* data() const { return static_cast<const T*>(memory.data()); }
+      T& operator[](uint64_t i){ return data()[i]; }
+      const T& operator[](uint64_t i) const { return data()[i]; }
+
+   private:
+
+      shared_memory_t memory;
+      uint64_t num_elements;
+
+   };
+
+   // gather local data from all processors into a shared array (collective)
+   extern void all_gather_shared(const double* local, uint64_t num_local, uint64_t offset, shared_array_t<double>& global);
+
 }
 
 #endif /*VMPI_H_*/
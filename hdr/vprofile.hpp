@@ -0,0 +1,139 @@
+#ifndef VPROFILE_H_
+#define VPROFILE_H_
+//-----------------------------------------------------------------------------
+//
+// This header file is part of the VAMPIRE open source package under the
+// GNU GPL (version 2) licence (see licence file for details).
+//
+// (c) agent 2026. All rights reserved.
+//
+//-----------------------------------------------------------------------------
+
+// System headers
+#include <cstdint>
+#include <vector>
+
+#ifdef VPROFILE
+   #if defined(__x86_64__) || defined(__i386__)
+      #include <x86intrin.h>
+   #else
+      #include <chrono>
+   #endif
+   #ifdef _OPENMP
+      #include <omp.h>
+   #endif
+#endif
+
+//---------------------------------------------------------------------
+// Namespace for the built-in hot path profiler. Timers are only
+// compiled in when the code is built with -DVPROFILE, otherwise all
+// profiling calls compile to nothing.
+//
+// Usage:
+//
+//    void function(){
+//       VPROFILE_SCOPE(vprofile::exchange);
+//       ...
+//    }
+//
+// Each section records the total (inclusive) time spent inside it and
+// the self time excluding nested sections.
+//---------------------------------------------------------------------
+namespace vprofile{
+
+   // list of profiled sections
+   enum section_t { integrator = 0,
+                    spin_fields,
+                    exchange,
+                    anisotropy,
+                    external_fields,
+                    thermal_fields,
+                    dipole_fields,
+                    mpi_wait,
+                    statistics,
+                    output,
+                    num_sections };
+
+   // functions to start profiling and print the profile to the log file
+   void initialise();
+   void report();
+
+   // function to add the number of integration steps for time per step
+   void add_steps(uint64_t num_steps);
+
+#ifdef VPROFILE
+
+   //------------------------------------------------------------------
+   // Per-thread accumulator, padded to avoid false sharing
+   //------------------------------------------------------------------
+   struct accumulator_t{
+      uint64_t ticks[num_sections];       // inclusive ticks in each section
+      uint64_t child_ticks[num_sections]; // ticks in nested sections
+      uint64_t calls[num_sections];       // number of calls of each section
+      int current;                        // currently active section (-1 if none)
+      char padding[64];
+   };
+
+   extern std::vector<accumulator_t> accumulators;
+
+   // read processor time stamp counter (or steady clock in ns)
+   inline uint64_t ticks(){
+      #if defined(__x86_64__) || defined(__i386__)
+         return __rdtsc();
+      #else
+         return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+      #endif
+   }
+
+   // get accumulator for the calling thread
+   inline accumulator_t* thread_accumulator(){
+      #ifdef _OPENMP
+         const unsigned int thread = omp_get_thread_num();
+      #else
+         const unsigned int thread = 0;
+      #endif
+      if(thread < accumulators.size()) return &accumulators[thread];
+      return NULL;
+   }
+
+   //------------------------------------------------------------------
+   // Timer adding the time until it goes out of scope to a section
+   //------------------------------------------------------------------
+   class scoped_timer_t{
+
+   private:
+      accumulator_t* acc;
+      int section;
+      int parent;
+      uint64_t start;
+
+   public:
+      scoped_timer_t(const section_t s): acc(thread_accumulator()), section(s), parent(-1), start(0){
+         if(acc == NULL) return;
+         parent = acc->current;
+         acc->current = section;
+         start = ticks();
+      }
+
+      ~scoped_timer_t(){
+         if(acc == NULL) return;
+         const uint64_t elapsed = ticks() - start;
+         acc->ticks[section] += elapsed;
+         acc->calls[section]++;
+         if(parent >= 0) acc->child_ticks[parent] += elapsed;
+         acc->current = parent;
+      }
+
+   };
+
+   #define VPROFILE_SCOPE(section) vprofile::scoped_timer_t vprofile_scoped_timer(section)
+
+#else
+
+   #define VPROFILE_SCOPE(section)
+
+#endif
+
+} // end of namespace vprofile
+
+#endif //VPROFILE_H_
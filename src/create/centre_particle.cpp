@@ -32,7 +32,7 @@ void centre_particle_on_atom(std::vector<double>& particle_origin, std::vector<c
 
    // set initial max range
    double max_range_sq = 1e123;
-   unsigned int nearest; // nearest atom to initial particle origin
+   unsigned int nearest = 0; // nearest atom to initial particle origin
 
    // copy to temporary for speed
    const double prx = particle_origin[0];
@@ -51,10 +51,12 @@ void centre_particle_on_atom(std::vector<double>& particle_origin, std::vector<c
       }
    }
 
-   // set particle origin to nearest atom
-   particle_origin[0] = catom_array[nearest].x;
-   particle_origin[1] = catom_array[nearest].y;
-   particle_origin[2] = catom_array[nearest].z;
+   // set particle origin to nearest atom (if any atoms exist on this processor)
+   if(catom_array.size() > 0){
+      particle_origin[0] = catom_array[nearest].x;
+      particle_origin[1] = catom_array[nearest].y;
+      particle_origin[2] = catom_array[nearest].z;
+   }
 
    //-----------------------------------------------------
    // For parallel reduce on all CPUs
@@ -127,40 +127,55 @@ int create(){
 		if(vmpi::mpi_mode==0) vmpi::geometric_decomposition(vmpi::num_processors,cs::system_dimensions);
 	#endif
 
-	// Create block of crystal of desired size
-	cs::create_crystal_structure(catom_array);
-
-	// Cut system to the correct type, species etc
-	create::create_system_type(catom_array);
-
-	// Copy atoms for interprocessor communications
-	#ifdef MPICF
-	if(vmpi::mpi_mode==0){
-		create::internal::copy_halo_atoms(catom_array);
-   }
-	#endif
-
    //---------------------------------------------
-	// Create Neighbour lists for system
+	// Neighbour lists for system
    //---------------------------------------------
    neighbours::list_t bilinear; // bilinear exchange list
    neighbours::list_t biquadratic; // biquadratic exchange list
 
-   // generate bilinear exchange list
-   bilinear.generate(catom_array, cs::unit_cell.bilinear, na, ucx, ucy, ucz);
+	// Load previously generated system if available
+	bool loaded_from_cache = false;
+	if(create::internal::use_system_cache){
+		loaded_from_cache = create::internal::load_system_cache(catom_array, bilinear, biquadratic);
+	}
 
-   // optionally create a biquadratic neighbour list
-   if(exchange::biquadratic){
-      biquadratic.generate(catom_array, cs::unit_cell.biquadratic, na, ucx, ucy, ucz);
-   }
+	if(!loaded_from_cache){
 
-	#ifdef MPICF
-		create::internal::identify_mpi_boundary_atoms(catom_array,bilinear);
-      if(exchange::biquadratic) create::internal::identify_mpi_boundary_atoms(catom_array,biquadratic);
-      create::internal::mark_non_interacting_halo(catom_array);
-      // Sort Arrays by MPI Type
-      create::internal::sort_atoms_by_mpi_type(catom_array, bilinear, biquadratic);
-	#endif
+		// Create block of crystal of desired size
+		cs::create_crystal_structure(catom_array);
+
+		// Cut system to the correct type, species etc
+		create::create_system_type(catom_array);
+
+		// Copy atoms for interprocessor communications
+		#ifdef MPICF
+		if(vmpi::mpi_mode==0){
+			create::internal::copy_halo_atoms(catom_array);
+		}
+		#endif
+
+		// generate bilinear exchange list
+		bilinear.generate(catom_array, cs::unit_cell.bilinear, na, ucx, ucy, ucz);
+
+		// optionally create a biquadratic neighbour list
+		if(exchange::biquadratic){
+			biquadratic.generate(catom_array, cs::unit_cell.biquadratic, na, ucx, ucy, ucz);
+		}
+
+		#ifdef MPICF
+			create::internal::identify_mpi_boundary_atoms(catom_array,bilinear);
+			if(exchange::biquadratic) create::internal::identify_mpi_boundary_atoms(catom_array,biquadratic);
+			create::internal::mark_non_interacting_halo(catom_array);
+			// Sort Arrays by MPI Type
+			create::internal::sort_atoms_by_mpi_type(catom_array, bilinear, biquadratic);
+		#endif
+
+		// Save generated system for subsequent runs
+		if(create::internal::use_system_cache){
+			create::internal::save_system_cache(catom_array, bilinear, biquadratic);
+		}
+
+	}
 
 	#ifdef MPICF
       // ** Must be done in parallel **
@@ -56,6 +56,9 @@ namespace create{
          bool select_material_by_z_height = false;	// Toggle overwriting of material id by z-height
          bool output_gv_file = true; // toggle output of grain positions to file
 
+         bool use_system_cache = false; // toggle loading and saving of generated system to cache file
+         std::string system_cache_directory = ""; // directory for system cache files (default current directory)
+
       } // end of internal namespace
 
 } // end of create namespace
@@ -32,6 +32,91 @@
 
 namespace cs{
 
+//------------------------------------------------------------------------------
+// Function to determine if unit cell site is generated on this processor
+//------------------------------------------------------------------------------
+inline bool site_in_system(const double cx, const double cy, const double cz, const bool include_uc_atom){
+	#ifdef MPICF
+		if(vmpi::mpi_mode==0){
+			// only generate atoms within allowed dimensions
+			return (cx>=vmpi::min_dimensions[0] && cx<vmpi::max_dimensions[0]) &&
+			       (cy>=vmpi::min_dimensions[1] && cy<vmpi::max_dimensions[1]) &&
+			       (cz>=vmpi::min_dimensions[2] && cz<vmpi::max_dimensions[2]) &&
+			       include_uc_atom &&
+			       cx >= 0.0 && cx < cs::system_dimensions[0] &&
+			       cy >= 0.0 && cy < cs::system_dimensions[1] &&
+			       cz >= 0.0 && cz < cs::system_dimensions[2];
+		}
+		else{
+			return (cx<cs::system_dimensions[0]) && (cy<cs::system_dimensions[1]) && (cz<cs::system_dimensions[2]);
+		}
+	#else
+		return include_uc_atom &&
+		       cx >= 0.0 && cx < cs::system_dimensions[0] &&
+		       cy >= 0.0 && cy < cs::system_dimensions[1] &&
+		       cz >= 0.0 && cz < cs::system_dimensions[2];
+	#endif
+}
+
+//------------------------------------------------------------------------------
+// Function to determine if unit cell site is within a bounding box
+//------------------------------------------------------------------------------
+inline bool site_in_bounds(const double cx, const double cy, const double cz, const double min_bound[3], const double max_bound[3]){
+	return cx >= min_bound[0] && cx <= max_bound[0] &&
+	       cy >= min_bound[1] && cy <= max_bound[1] &&
+	       cz >= min_bound[2] && cz <= max_bound[2];
+}
+
+//------------------------------------------------------------------------------
+// Function to determine a box bounding an isolated particle, so that unit cell
+// sites which cannot be part of the particle are never stored. The box is
+// a conservative bound; the exact shape and core-shell cut is still applied by
+// the shape functions. Returns false if the cut cannot be applied per site
+// without changing the generated structure, i.e. when later stages re-include
+// removed atoms (fill, geometry selection, voronoi substructure) or draw random
+// numbers for every atom (intermixing, alloys, dilution).
+//------------------------------------------------------------------------------
+bool particle_site_bounds(double min_bound[3], double max_bound[3]){
+
+	// only isolated cube, cylinder and sphere particles are bounded
+	if(cs::system_creation_flags[2] != 0) return false;
+	const int shape = cs::system_creation_flags[1];
+	if(shape != 1 && shape != 2 && shape != 4) return false;
+
+	if(create::internal::select_material_by_geometry) return false;
+	if(create::internal::generate_voronoi_substructure) return false;
+	if(create::internal::select_material_by_z_height && cs::interfacial_roughness) return false;
+
+	// core-shell sizes are limited to 0-1 so shells lie within the particle size
+	for(int mat=0; mat<mp::num_materials; mat++){
+		if(mp::material[mat].fill) return false;
+		if(mp::material[mat].density < 1.0) return false;
+		if(create::internal::mp[mat].alloy_master) return false;
+		for(int imat=0; imat<mp::num_materials; imat++) if(mp::material[mat].intermixing[imat] > 0.0) return false;
+	}
+
+	// The particle is centred on the site nearest the centre of the system, which
+	// is within one unit cell diagonal of it, plus an optional half cell shift
+	const double diagonal = sqrt(unit_cell.dimensions[0]*unit_cell.dimensions[0] +
+	                             unit_cell.dimensions[1]*unit_cell.dimensions[1] +
+	                             unit_cell.dimensions[2]*unit_cell.dimensions[2]);
+	const double extent = cs::particle_scale*0.5 + 1.5*diagonal;
+
+	for(int i=0; i<3; i++){
+		min_bound[i] = cs::system_dimensions[i]*0.5 - extent;
+		max_bound[i] = cs::system_dimensions[i]*0.5 + extent;
+	}
+
+	// cubes and cylinders are not cut along z
+	if(shape != 4){
+		min_bound[2] = -1.0e300;
+		max_bound[2] =  1.0e300;
+	}
+
+	return true;
+
+}
+
 int create_crystal_structure(std::vector<cs::catom_t> & catom_array){
 	//----------------------------------------------------------
 	// check calling of routine if error checking is activated
@@ -71,14 +156,6 @@ int create_crystal_structure(std::vector<cs::catom_t> & catom_array){
 	cs::local_num_unit_cells[1]=max_bounds[1]-min_bounds[1];
 	cs::local_num_unit_cells[2]=max_bounds[2]-min_bounds[2];
 
-	int num_atoms=cs::local_num_unit_cells[0]*cs::local_num_unit_cells[1]*cs::local_num_unit_cells[2]*unit_cell.atom.size();
-
-	// set catom_array size
-	catom_array.reserve(num_atoms);
-
-	// Initialise atoms number
-	int atom=0;
-
    // find maximum height lh_category
    unsigned int maxlh=0;
    for(unsigned int uca=0;uca<unit_cell.atom.size();uca++) if(unit_cell.atom[uca].hc > maxlh) maxlh = unit_cell.atom[uca].hc;
@@ -88,6 +165,34 @@ int create_crystal_structure(std::vector<cs::catom_t> & catom_array){
 	std::vector<bool> inc_uc_atom(mp::max_materials, false);
 	for( auto m : create::internal::mp) inc_uc_atom[m.unit_cell_category] = true;
 
+	// bounds of an isolated particle, applied to each site before it is stored
+	double min_site[3] = {-1.0e300, -1.0e300, -1.0e300};
+	double max_site[3] = { 1.0e300,  1.0e300,  1.0e300};
+	const bool bounded = particle_site_bounds(min_site, max_site);
+	if(bounded){
+		zlog << zTs() << "Generating only unit cell sites within particle bounds" << std::endl;
+	}
+
+	// Count atoms to be generated first so that catom_array is allocated once
+	// with its final size, rather than for every unit cell site in range
+	uint64_t num_atoms=0;
+	for(int z=min_bounds[2];z<max_bounds[2];z++){
+		for(int y=min_bounds[1];y<max_bounds[1];y++){
+			for(int x=min_bounds[0];x<max_bounds[0];x++){
+				for(unsigned int uca=0;uca<unit_cell.atom.size();uca++){
+					const double cx = (double(x)+unit_cell.atom[uca].x)*unit_cell.dimensions[0];
+					const double cy = (double(y)+unit_cell.atom[uca].y)*unit_cell.dimensions[1];
+					const double cz = (double(z)+unit_cell.atom[uca].z)*unit_cell.dimensions[2];
+					if(site_in_system(cx, cy, cz, inc_uc_atom[unit_cell.atom[uca].mat]) &&
+					   site_in_bounds(cx, cy, cz, min_site, max_site)) num_atoms++;
+				}
+			}
+		}
+	}
+
+	// set catom_array size
+	catom_array.reserve(num_atoms);
+
 	// This has been modified by Mara Strungaru to go from x to z, rather than z to x
 	// unmodified by RE as this is less optimal for large lateral samples in x,y which is a more common usage pattern in ASD
 	// Duplicate unit cell
@@ -98,74 +203,33 @@ int create_crystal_structure(std::vector<cs::catom_t> & catom_array){
 				// need to change this to accept non-orthogonal lattices
 				// Loop over atoms in unit cell
 				for(unsigned int uca=0;uca<unit_cell.atom.size();uca++){
-					double cx = (double(x)+unit_cell.atom[uca].x)*unit_cell.dimensions[0];
-					double cy = (double(y)+unit_cell.atom[uca].y)*unit_cell.dimensions[1];
-					double cz = (double(z)+unit_cell.atom[uca].z)*unit_cell.dimensions[2];
-					#ifdef MPICF
-						if(vmpi::mpi_mode==0){
-							// only generate atoms within allowed dimensions
-                     if(   (cx>=vmpi::min_dimensions[0] && cx<vmpi::max_dimensions[0]) &&
-                           (cy>=vmpi::min_dimensions[1] && cy<vmpi::max_dimensions[1]) &&
-                           (cz>=vmpi::min_dimensions[2] && cz<vmpi::max_dimensions[2])){
-						#endif
-							if(inc_uc_atom[unit_cell.atom[uca].mat] &&
-								cx >= 0.0 && cx < cs::system_dimensions[0] &&
-								cy >= 0.0 && cy < cs::system_dimensions[1] &&
-								cz >= 0.0 && cz < cs::system_dimensions[2]
-							){
-							catom_array.push_back(cs::catom_t());
-							catom_array[atom].x=cx;
-							catom_array[atom].y=cy;
-							catom_array[atom].z=cz;
-							//std::cout << atom << "\t" << cx << "\t" << cy <<"\t" << cz << std::endl;
-							catom_array[atom].material=unit_cell.atom[uca].mat;
-							catom_array[atom].uc_id=uca;
-							catom_array[atom].lh_category=unit_cell.atom[uca].hc+z*maxlh;
-							catom_array[atom].uc_category=unit_cell.atom[uca].mat; // determine initial material (uc_category) for unit cell
-							catom_array[atom].scx=x;
-							catom_array[atom].scy=y;
-							catom_array[atom].scz=z;
-							atom++;
-							}
-						#ifdef MPICF
-							}
-						}
-						else{
-							if((cx<cs::system_dimensions[0]) && (cy<cs::system_dimensions[1]) && (cz<cs::system_dimensions[2])){
-							catom_array.push_back(cs::catom_t());
-							catom_array[atom].x=cx;
-							catom_array[atom].y=cy;
-							catom_array[atom].z=cz;
-							catom_array[atom].material=unit_cell.atom[uca].mat;
-							catom_array[atom].uc_id=uca;
-							catom_array[atom].lh_category=unit_cell.atom[uca].hc+z*maxlh;
-							catom_array[atom].uc_category=unit_cell.atom[uca].mat; // determine initial material (uc_category) for unit cell
-							catom_array[atom].scx=x;
-							catom_array[atom].scy=y;
-							catom_array[atom].scz=z;
-							catom_array[atom].include=false; // assume no atoms until classification complete
-							atom++;
-							}
-						}
-						#endif
+					const double cx = (double(x)+unit_cell.atom[uca].x)*unit_cell.dimensions[0];
+					const double cy = (double(y)+unit_cell.atom[uca].y)*unit_cell.dimensions[1];
+					const double cz = (double(z)+unit_cell.atom[uca].z)*unit_cell.dimensions[2];
+					if(site_in_system(cx, cy, cz, inc_uc_atom[unit_cell.atom[uca].mat]) &&
+					   site_in_bounds(cx, cy, cz, min_site, max_site)){
+						cs::catom_t atom;
+						atom.x=cx;
+						atom.y=cy;
+						atom.z=cz;
+						atom.material=unit_cell.atom[uca].mat;
+						atom.uc_id=uca;
+						atom.lh_category=unit_cell.atom[uca].hc+z*maxlh;
+						atom.uc_category=unit_cell.atom[uca].mat; // determine initial material (uc_category) for unit cell
+						atom.scx=x;
+						atom.scy=y;
+						atom.scz=z;
+						atom.include=false; // assume no atoms until classification complete
+						catom_array.push_back(atom);
 					}
 				}
 			}
 		}
-
-	// Check to see if actual and expected number of atoms agree, if not trim the excess
-	if(atom!=num_atoms){
-		std::vector<cs::catom_t> tmp_catom_array(num_atoms);
-		tmp_catom_array=catom_array;
-		catom_array.resize(atom);
-		for(int a=0;a<atom;a++){
-			catom_array[a]=tmp_catom_array[a];
-		}
-		tmp_catom_array.resize(0);
 	}
 
-	// Check to see if any atoms have been generated
-	if(atom==0){
+	// Check to see if any atoms have been generated (a processor may have no
+	// sites within the particle bounds, which is reported after the shape cut)
+	if(catom_array.size()==0 && !bounded){
 		terminaltextcolor(RED);
 		std::cout << "Error - no atoms have been generated, increase system dimensions!" << std::endl;
 		terminaltextcolor(WHITE);
@@ -173,11 +237,6 @@ int create_crystal_structure(std::vector<cs::catom_t> & catom_array){
 		err::vexit();
 	}
 
-	// Now unselect all atoms by default for particle shape cutting
-	for(unsigned int atom=0;atom<catom_array.size();atom++){
-		catom_array[atom].include=false;
-	}
-
 	return EXIT_SUCCESS;
 }
 
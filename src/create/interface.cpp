@@ -8,6 +8,7 @@
 //-----------------------------------------------------------------------------
 
 // C++ standard library headers
+#include <algorithm>
 
 // Vampire headers
 #include "errors.hpp"
@@ -536,6 +537,16 @@ namespace create{
          create::internal::spin_init_seed = sirs;
          return true;
       }
+      //--------------------------------------------------------------------
+      test="system-cache";
+      if(word==test){
+         // optional value sets directory for cache files
+         std::string directory = value;
+         directory.erase(remove(directory.begin(), directory.end(), '\"'), directory.end());
+         create::internal::use_system_cache = true;
+         create::internal::system_cache_directory = directory;
+         return true;
+      }
       /*std::string test="slonczewski-spin-polarization-unit-vector";
       if(word==test){
          std::vector<double> u(3);
@@ -145,6 +145,9 @@ namespace create{
       extern bool select_material_by_z_height;
       extern bool output_gv_file; // toggle output of grain positions to file
 
+      extern bool use_system_cache; // toggle loading and saving of generated system to cache file
+      extern std::string system_cache_directory; // directory for system cache files
+
       //-----------------------------------------------------------------------------
       // Internal functions for create module
       //-----------------------------------------------------------------------------
@@ -196,6 +199,10 @@ namespace create{
       extern void sort_atoms_by_mpi_type(std::vector<cs::catom_t> & catom_array, neighbours::list_t& bilinear, neighbours::list_t& biquadratic);
       extern void init_mpi_comms(std::vector<cs::catom_t> & catom_array);
 
+      // System cache functions
+      bool load_system_cache(std::vector<cs::catom_t>& catom_array, neighbours::list_t& bilinear, neighbours::list_t& biquadratic);
+      void save_system_cache(const std::vector<cs::catom_t>& catom_array, const neighbours::list_t& bilinear, const neighbours::list_t& biquadratic);
+
    } // end of internal namespace
 } // end of create namespace
 
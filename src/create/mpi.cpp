@@ -447,7 +447,10 @@ namespace create{
 
    /// @brief Set Replicated Data
    ///
-   /// @details Sets atom CPU ID for replicated data decomposition
+   /// @details Sets atom CPU ID for replicated data decomposition. The
+   ///          catom_array is not held in node shared memory since each
+   ///          processor marks its own atoms as core and all others as halo,
+   ///          and the array is later sorted and trimmed per processor.
    ///
    /// @section License
    /// Use of this code, either in source or compiled form, is subject to license from the authors.
@@ -0,0 +1,694 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// System headers for memory mapped files
+#ifndef WIN_COMPILE
+   #include <fcntl.h>
+   #include <sys/mman.h>
+   #include <sys/stat.h>
+#endif
+
+// Vampire headers
+#include "create.hpp"
+#include "errors.hpp"
+#include "grains.hpp"
+#include "neighbours.hpp"
+#include "unitcell.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+// Internal create header
+#include "internal.hpp"
+
+namespace create{
+namespace internal{
+
+//------------------------------------------------------------------------------
+// The system cache stores the generated atoms and neighbour lists of each
+// processor after the structure, halo and MPI ordering are complete, along with
+// the voronoi grain shapes output on the root process. Data computed after
+// creation, such as dipole tensors, is stored in secondary section files keyed
+// on both the system and a hash of the input used to compute it.
+//
+// All files share a memory mappable layout: a fixed header, a table of block
+// offsets and sizes, and then each block as a contiguous array aligned to 64
+// bytes, so that the blocks match the in-memory layout of catom_t, nm_atom_t,
+// neighbour_t and double.
+//------------------------------------------------------------------------------
+namespace{
+
+   const char cache_magic[8]   = {'V','A','M','P','S','Y','S','\0'};
+   const char section_magic[8] = {'V','A','M','P','S','E','C','\0'};
+   const uint32_t cache_version = 3;
+   const uint64_t block_alignment = 64;
+   const char grain_shapes_file[] = "grain_shapes.txt";
+
+   // header at start of every cache file, followed by block table
+   struct cache_header_t{
+      char magic[8];
+      uint32_t version;
+      uint32_t catom_size;
+      uint32_t neighbour_size;
+      uint32_t padding;
+      uint64_t key;
+      uint64_t num_blocks;
+   };
+
+   // entry in block table giving location of each block in the file
+   struct block_entry_t{
+      uint64_t offset;
+      uint64_t bytes;
+   };
+
+   // contiguous piece of memory to be written as part of a block
+   struct piece_t{
+      const char* data;
+      uint64_t bytes;
+   };
+
+   // block of data written from one or more pieces of memory
+   typedef std::vector<piece_t> block_t;
+
+   // block of data read from a file
+   struct read_block_t{
+      const char* data;
+      uint64_t bytes;
+   };
+
+   //---------------------------------------------------------------------------
+   // Add raw bytes of a value to a 64 bit FNV-1a hash
+   //---------------------------------------------------------------------------
+   template <typename T>
+   void hash_value(uint64_t& hash, const T& value){
+      hash = create::hash_cache_input(hash, &value, sizeof(T));
+   }
+
+   void hash_template(uint64_t& hash, const unitcell::exchange_template_t& exchange){
+      hash_value(hash, uint64_t(exchange.interaction.size()));
+      for(const unitcell::interaction_t& interaction : exchange.interaction){
+         hash_value(hash, interaction.i);
+         hash_value(hash, interaction.j);
+         hash_value(hash, interaction.dx);
+         hash_value(hash, interaction.dy);
+         hash_value(hash, interaction.dz);
+      }
+   }
+
+   //---------------------------------------------------------------------------
+   // Key identifying the structure, combining the structural input parameters,
+   // the unit cell and the parallel decomposition
+   //---------------------------------------------------------------------------
+   uint64_t system_cache_key(){
+
+      uint64_t key = vin::structural_input_hash;
+
+      hash_value(key, cache_version);
+      hash_value(key, vmpi::num_processors);
+      hash_value(key, vmpi::mpi_mode);
+
+      for(int i = 0; i < 3; i++) hash_value(key, cs::unit_cell.dimensions[i]);
+      hash_value(key, uint64_t(cs::unit_cell.atom.size()));
+      for(const unitcell::atom_t& atom : cs::unit_cell.atom){
+         hash_value(key, atom.x);
+         hash_value(key, atom.y);
+         hash_value(key, atom.z);
+         hash_value(key, atom.mat);
+         hash_value(key, atom.lc);
+         hash_value(key, atom.hc);
+      }
+      hash_template(key, cs::unit_cell.bilinear);
+      hash_template(key, cs::unit_cell.biquadratic);
+
+      return key;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // File name of cache for this processor
+   //---------------------------------------------------------------------------
+   std::string cache_file_name(const std::string& prefix, const uint64_t key){
+      std::stringstream filename;
+      if(system_cache_directory != "") filename << system_cache_directory << "/";
+      filename << prefix << "-" << std::hex << std::setfill('0') << std::setw(16) << key << std::dec << "-" << vmpi::my_rank << ".cache";
+      return filename.str();
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to create a uniquely named temporary file in the same directory
+   // as the cache file, so that it can be renamed into place once complete
+   //---------------------------------------------------------------------------
+   std::string open_temporary_file(const std::string& filename, std::ofstream& file){
+      #ifdef WIN_COMPILE
+         std::stringstream tmp_name;
+         tmp_name << filename << "." << _getpid() << ".tmp";
+         const std::string tmp_filename = tmp_name.str();
+      #else
+         std::string tmp_template = filename + ".XXXXXX";
+         const int fd = mkstemp(&tmp_template[0]);
+         if(fd == -1) return "";
+         close(fd);
+         const std::string tmp_filename = tmp_template;
+      #endif
+      file.open(tmp_filename.c_str(), std::ios::binary | std::ios::trunc);
+      return tmp_filename;
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to write a cache file from a list of blocks. The file is written
+   // to a temporary file and renamed into place so that other runs never read
+   // a partial cache.
+   //---------------------------------------------------------------------------
+   bool write_cache_file(const std::string& filename, const char* magic, const uint64_t key, const std::vector<block_t>& blocks){
+
+      std::ofstream file;
+      const std::string tmp_filename = open_temporary_file(filename, file);
+      if(!file.is_open()){
+         if(tmp_filename != "") std::remove(tmp_filename.c_str());
+         terminaltextcolor(RED);
+         std::cerr << "Warning: Unable to open system cache file " << filename << " for writing, system will not be cached." << std::endl;
+         terminaltextcolor(WHITE);
+         zlog << zTs() << "Warning: Unable to open system cache file " << filename << " for writing, system will not be cached." << std::endl;
+         return false;
+      }
+
+      // header
+      cache_header_t header;
+      std::memset(&header, 0, sizeof(header));
+      std::memcpy(header.magic, magic, sizeof(header.magic));
+      header.version = cache_version;
+      header.catom_size = sizeof(cs::catom_t);
+      header.neighbour_size = sizeof(neighbours::neighbour_t);
+      header.key = key;
+      header.num_blocks = blocks.size();
+
+      // determine aligned offset of each block
+      std::vector<block_entry_t> table(blocks.size());
+      uint64_t offset = sizeof(cache_header_t) + sizeof(block_entry_t) * blocks.size();
+      for(size_t b = 0; b < blocks.size(); b++){
+         offset = (offset + block_alignment - 1) / block_alignment * block_alignment;
+         table[b].offset = offset;
+         table[b].bytes = 0;
+         for(const piece_t& piece : blocks[b]) table[b].bytes += piece.bytes;
+         offset += table[b].bytes;
+      }
+
+      file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      file.write(reinterpret_cast<const char*>(table.data()), sizeof(block_entry_t) * table.size());
+
+      // write blocks, padding each to its aligned offset
+      const char padding[block_alignment] = {0};
+      uint64_t position = sizeof(cache_header_t) + sizeof(block_entry_t) * blocks.size();
+      for(size_t b = 0; b < blocks.size(); b++){
+         file.write(padding, table[b].offset - position);
+         for(const piece_t& piece : blocks[b]) file.write(piece.data, piece.bytes);
+         position = table[b].offset + table[b].bytes;
+      }
+
+      file.close();
+
+      // move complete file into place, replacing any existing cache
+      #ifdef WIN_COMPILE
+         std::remove(filename.c_str());
+      #endif
+      if(file.fail() || std::rename(tmp_filename.c_str(), filename.c_str()) != 0){
+         std::remove(tmp_filename.c_str());
+         terminaltextcolor(RED);
+         std::cerr << "Warning: Unable to write system cache file " << filename << ", system will not be cached." << std::endl;
+         terminaltextcolor(WHITE);
+         zlog << zTs() << "Warning: Unable to write system cache file " << filename << ", system will not be cached." << std::endl;
+         return false;
+      }
+
+      return true;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Class for read only access to a cache file, memory mapped where supported
+   // and otherwise read into memory
+   //---------------------------------------------------------------------------
+   class mapped_file_t{
+
+   public:
+
+      mapped_file_t() : ptr(NULL), num_bytes(0) {}
+      ~mapped_file_t(){ close_file(); }
+
+      bool open_file(const std::string& filename){
+         #ifdef WIN_COMPILE
+            std::ifstream file(filename.c_str(), std::ios::binary);
+            if(!file.is_open()) return false;
+            file.seekg(0, std::ios::end);
+            const std::streamoff length = file.tellg();
+            file.seekg(0, std::ios::beg);
+            if(length <= 0) return false;
+            buffer.resize(length);
+            file.read(&buffer[0], length);
+            if(!file.good()) return false;
+            ptr = &buffer[0];
+            num_bytes = length;
+         #else
+            const int fd = open(filename.c_str(), O_RDONLY);
+            if(fd == -1) return false;
+            struct stat file_stat;
+            if(fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0){
+               close(fd);
+               return false;
+            }
+            void* map = mmap(NULL, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            close(fd);
+            if(map == MAP_FAILED) return false;
+            ptr = static_cast<const char*>(map);
+            num_bytes = file_stat.st_size;
+         #endif
+         return true;
+      }
+
+      void close_file(){
+         #ifndef WIN_COMPILE
+            if(ptr != NULL) munmap(const_cast<char*>(ptr), num_bytes);
+         #endif
+         ptr = NULL;
+         num_bytes = 0;
+      }
+
+      const char* data() const { return ptr; }
+      uint64_t size() const { return num_bytes; }
+
+   private:
+
+      const char* ptr;
+      uint64_t num_bytes;
+      #ifdef WIN_COMPILE
+         std::vector<char> buffer;
+      #endif
+
+      // mapped files cannot be copied
+      mapped_file_t(const mapped_file_t&);
+      mapped_file_t& operator=(const mapped_file_t&);
+
+   };
+
+   //---------------------------------------------------------------------------
+   // Function to check the header of a mapped cache file and locate its blocks,
+   // so that sizes read from a truncated or corrupt file are never used
+   //---------------------------------------------------------------------------
+   bool read_cache_blocks(const std::string& filename, const mapped_file_t& file, const char* magic,
+                          const uint64_t key, const uint64_t num_blocks, std::vector<read_block_t>& blocks){
+
+      if(file.size() < sizeof(cache_header_t)) return false;
+
+      cache_header_t header;
+      std::memcpy(&header, file.data(), sizeof(header));
+
+      if(std::memcmp(header.magic, magic, sizeof(header.magic)) != 0 ||
+         header.version != cache_version || header.catom_size != sizeof(cs::catom_t) ||
+         header.neighbour_size != sizeof(neighbours::neighbour_t) || header.key != key ||
+         header.num_blocks != num_blocks){
+         zlog << zTs() << "System cache file " << filename << " is incompatible with this version or input and will be regenerated" << std::endl;
+         return false;
+      }
+
+      const uint64_t table_end = sizeof(cache_header_t) + sizeof(block_entry_t) * num_blocks;
+      if(file.size() < table_end){
+         zlog << zTs() << "System cache file " << filename << " is truncated or corrupt and will be regenerated" << std::endl;
+         return false;
+      }
+
+      blocks.resize(num_blocks);
+      for(uint64_t b = 0; b < num_blocks; b++){
+         block_entry_t entry;
+         std::memcpy(&entry, file.data() + sizeof(cache_header_t) + sizeof(block_entry_t) * b, sizeof(entry));
+         if(entry.offset < table_end || entry.offset % block_alignment != 0 ||
+            entry.offset > file.size() || entry.bytes > file.size() - entry.offset){
+            zlog << zTs() << "System cache file " << filename << " is truncated or corrupt and will be regenerated" << std::endl;
+            return false;
+         }
+         blocks[b].data = file.data() + entry.offset;
+         blocks[b].bytes = entry.bytes;
+      }
+
+      return true;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to copy a block into a vector, checking the size is a whole
+   // number of elements
+   //---------------------------------------------------------------------------
+   template <typename T>
+   bool copy_block(const read_block_t& block, std::vector<T>& array){
+      if(block.bytes % sizeof(T) != 0) return false;
+      array.resize(block.bytes / sizeof(T));
+      if(block.bytes > 0) std::memcpy(reinterpret_cast<char*>(array.data()), block.data, block.bytes);
+      return true;
+   }
+
+   //---------------------------------------------------------------------------
+   // Functions to write and read neighbour list as counts and flat array
+   //---------------------------------------------------------------------------
+   void add_list_blocks(const neighbours::list_t& nlist, std::vector<uint32_t>& counts, std::vector<block_t>& blocks){
+
+      const uint64_t num_atoms = nlist.list.size();
+      counts.resize(num_atoms);
+      for(uint64_t atom = 0; atom < num_atoms; atom++) counts[atom] = nlist.list[atom].size();
+
+      blocks.push_back(block_t(1, piece_t{ reinterpret_cast<const char*>(counts.data()), sizeof(uint32_t)*num_atoms }));
+
+      block_t neighbours;
+      for(uint64_t atom = 0; atom < num_atoms; atom++){
+         if(counts[atom] > 0) neighbours.push_back(piece_t{ reinterpret_cast<const char*>(nlist.list[atom].data()), sizeof(neighbours::neighbour_t)*counts[atom] });
+      }
+      blocks.push_back(neighbours);
+
+   }
+
+   bool read_list(const read_block_t& count_block, const read_block_t& neighbour_block, const uint64_t expected_atoms, neighbours::list_t& nlist){
+
+      std::vector<uint32_t> counts;
+      if(!copy_block(count_block, counts)) return false;
+
+      // lists which were not generated (such as biquadratic) are empty
+      const uint64_t num_atoms = counts.size();
+      if(num_atoms != expected_atoms && num_atoms != 0) return false;
+
+      uint64_t total_count = 0;
+      for(uint64_t atom = 0; atom < num_atoms; atom++) total_count += counts[atom];
+      if(neighbour_block.bytes != total_count * sizeof(neighbours::neighbour_t)) return false;
+
+      const char* data = neighbour_block.data;
+      nlist.list.resize(num_atoms);
+      for(uint64_t atom = 0; atom < num_atoms; atom++){
+         const uint64_t bytes = sizeof(neighbours::neighbour_t)*counts[atom];
+         nlist.list[atom].resize(counts[atom]);
+         if(bytes > 0) std::memcpy(reinterpret_cast<char*>(nlist.list[atom].data()), data, bytes);
+         data += bytes;
+         // neighbours must refer to atoms in this list
+         for(const neighbours::neighbour_t& neighbour : nlist.list[atom]){
+            if(neighbour.nn < 0 || uint64_t(neighbour.nn) >= expected_atoms) return false;
+         }
+      }
+
+      return true;
+
+   }
+
+   // number and order of blocks in system cache file
+   enum system_block_t { variables_block = 0, atoms_block, nm_atoms_block,
+                         bilinear_counts_block, bilinear_block,
+                         biquadratic_counts_block, biquadratic_block,
+                         grain_shapes_block, num_system_blocks };
+
+   //---------------------------------------------------------------------------
+   // Function to read cache file for this processor, returning false if the
+   // file does not exist or does not match the current structure
+   //---------------------------------------------------------------------------
+   bool read_system_cache(const std::string& filename, const uint64_t key,
+                          std::vector<cs::catom_t>& catom_array,
+                          neighbours::list_t& bilinear,
+                          neighbours::list_t& biquadratic,
+                          std::string& grain_shapes){
+
+      mapped_file_t file;
+      if(!file.open_file(filename)) return false;
+
+      std::vector<read_block_t> blocks;
+      if(!read_cache_blocks(filename, file, cache_magic, key, num_system_blocks, blocks)) return false;
+
+      // message for files which pass the header check but are truncated or corrupt
+      const std::string corrupt = "System cache file " + filename + " is truncated or corrupt and will be regenerated";
+
+      // read system variables set during creation
+      std::vector<int32_t> variables;
+      if(!copy_block(blocks[variables_block], variables) || variables.size() != 5){
+         zlog << zTs() << corrupt << std::endl;
+         return false;
+      }
+
+      // read atoms and non-magnetic atoms
+      if(!copy_block(blocks[atoms_block], catom_array) || !copy_block(blocks[nm_atoms_block], cs::non_magnetic_atoms_array)){
+         zlog << zTs() << corrupt << std::endl;
+         return false;
+      }
+      const uint64_t num_atoms = catom_array.size();
+
+      // check atom counts set during creation are consistent with the atoms
+      const int64_t num_mpi_atoms = int64_t(variables[2]) + int64_t(variables[3]) + int64_t(variables[4]);
+      if(variables[2] < 0 || variables[3] < 0 || variables[4] < 0 || uint64_t(num_mpi_atoms) > num_atoms){
+         zlog << zTs() << corrupt << std::endl;
+         return false;
+      }
+
+      // read neighbour lists, which have one entry per atom
+      if(!read_list(blocks[bilinear_counts_block], blocks[bilinear_block], num_atoms, bilinear) ||
+         !read_list(blocks[biquadratic_counts_block], blocks[biquadratic_block], num_atoms, biquadratic)){
+         zlog << zTs() << corrupt << std::endl;
+         return false;
+      }
+
+      // read voronoi grain shapes output (empty if not generated)
+      grain_shapes.assign(blocks[grain_shapes_block].data, blocks[grain_shapes_block].bytes);
+
+      // set system variables
+      grains::num_grains = variables[0];
+      create::num_total_atoms_non_filler = variables[1];
+      vmpi::num_core_atoms = variables[2];
+      vmpi::num_bdry_atoms = variables[3];
+      vmpi::num_halo_atoms = variables[4];
+
+      return true;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Key and file name of a secondary cache section for this processor
+   //---------------------------------------------------------------------------
+   uint64_t section_key(const std::string& name, const uint64_t input_hash){
+      uint64_t key = system_cache_key();
+      key = create::hash_cache_input(key, name.data(), name.size());
+      hash_value(key, input_hash);
+      return key;
+   }
+
+} // end of anonymous namespace
+
+//------------------------------------------------------------------------------
+// Function to load generated system from cache. Returns true only if the cache
+// was loaded successfully on all processors.
+//------------------------------------------------------------------------------
+bool load_system_cache(std::vector<cs::catom_t>& catom_array,
+                       neighbours::list_t& bilinear,
+                       neighbours::list_t& biquadratic){
+
+   const uint64_t key = system_cache_key();
+   const std::string filename = cache_file_name("system", key);
+
+   std::string grain_shapes;
+   bool loaded = read_system_cache(filename, key, catom_array, bilinear, biquadratic, grain_shapes);
+
+   // all processors must agree to use the cache
+   const uint64_t num_loaded = vmpi::all_reduce_sum(uint64_t(loaded ? 1 : 0));
+   if(num_loaded != uint64_t(vmpi::num_processors)) loaded = false;
+
+   if(!loaded){
+      // discard partially loaded data
+      std::vector<cs::catom_t>().swap(catom_array);
+      std::vector<cs::nm_atom_t>().swap(cs::non_magnetic_atoms_array);
+      bilinear.clear();
+      biquadratic.clear();
+      zlog << zTs() << "No valid system cache found, generating system" << std::endl;
+      return false;
+   }
+
+   // restore voronoi grain shapes output which is otherwise written during creation
+   if(vmpi::my_rank == 0 && grain_shapes.size() > 0){
+      std::ofstream gvfile(grain_shapes_file);
+      gvfile << grain_shapes;
+   }
+
+   if(vmpi::my_rank == 0) std::cout << "Loaded system from cache file " << filename << std::endl;
+   zlog << zTs() << "Loaded system with " << catom_array.size() << " atoms from cache file " << filename << std::endl;
+
+   return true;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to save generated system to cache file for this processor
+//------------------------------------------------------------------------------
+void save_system_cache(const std::vector<cs::catom_t>& catom_array,
+                       const neighbours::list_t& bilinear,
+                       const neighbours::list_t& biquadratic){
+
+   const uint64_t key = system_cache_key();
+   const std::string filename = cache_file_name("system", key);
+
+   std::vector<block_t> blocks;
+
+   // system variables set during creation
+   const int32_t variables[5] = { grains::num_grains,
+                                  create::num_total_atoms_non_filler,
+                                  vmpi::num_core_atoms,
+                                  vmpi::num_bdry_atoms,
+                                  vmpi::num_halo_atoms };
+   blocks.push_back(block_t(1, piece_t{ reinterpret_cast<const char*>(variables), sizeof(variables) }));
+
+   // atoms and non-magnetic atoms
+   const uint64_t num_atoms = catom_array.size();
+   blocks.push_back(block_t(1, piece_t{ reinterpret_cast<const char*>(catom_array.data()), sizeof(cs::catom_t)*num_atoms }));
+   blocks.push_back(block_t(1, piece_t{ reinterpret_cast<const char*>(cs::non_magnetic_atoms_array.data()), sizeof(cs::nm_atom_t)*cs::non_magnetic_atoms_array.size() }));
+
+   // neighbour lists
+   std::vector<uint32_t> bilinear_counts;
+   std::vector<uint32_t> biquadratic_counts;
+   add_list_blocks(bilinear, bilinear_counts, blocks);
+   add_list_blocks(biquadratic, biquadratic_counts, blocks);
+
+   // voronoi grain shapes output from root process so that it can be restored
+   std::string grain_shapes;
+   if(vmpi::my_rank == 0 && cs::system_creation_flags[2] == 3 && create::internal::output_gv_file){
+      std::ifstream gvfile(grain_shapes_file);
+      std::stringstream contents;
+      contents << gvfile.rdbuf();
+      grain_shapes = contents.str();
+   }
+   blocks.push_back(block_t(1, piece_t{ grain_shapes.data(), grain_shapes.size() }));
+
+   if(write_cache_file(filename, cache_magic, key, blocks)){
+      zlog << zTs() << "Saved system with " << num_atoms << " atoms to cache file " << filename << std::endl;
+   }
+
+   return;
+
+}
+
+} // end of internal namespace
+
+//------------------------------------------------------------------------------
+// Function to add raw bytes to a 64 bit FNV-1a hash of cached input
+//------------------------------------------------------------------------------
+uint64_t hash_cache_input(uint64_t hash, const void* data, const uint64_t bytes){
+   const unsigned char* input = static_cast<const unsigned char*>(data);
+   for(uint64_t b = 0; b < bytes; b++){
+      hash ^= uint64_t(input[b]);
+      hash *= 1099511628211ULL;
+   }
+   return hash;
+}
+
+//------------------------------------------------------------------------------
+// Function to load a secondary cache section of rectangular 2D arrays. Returns
+// true only if the section was loaded successfully on all processors.
+//------------------------------------------------------------------------------
+bool load_cache_section(const std::string& name, const uint64_t input_hash, const std::vector< std::vector< std::vector<double> >* >& arrays){
+
+   if(!internal::use_system_cache) return false;
+
+   const uint64_t key = internal::section_key(name, input_hash);
+   const std::string filename = internal::cache_file_name(name, key);
+
+   // each array is stored as a block of dimensions and a block of data
+   bool loaded = false;
+   internal::mapped_file_t file;
+   std::vector<internal::read_block_t> blocks;
+   if(file.open_file(filename) && internal::read_cache_blocks(filename, file, internal::section_magic, key, 2*arrays.size(), blocks)){
+      loaded = true;
+      for(size_t a = 0; a < arrays.size() && loaded; a++){
+         std::vector<uint64_t> dimensions;
+         if(!internal::copy_block(blocks[2*a], dimensions) || dimensions.size() != 2 ||
+            (dimensions[1] > 0 && dimensions[0] > blocks[2*a+1].bytes / sizeof(double) / dimensions[1]) ||
+            blocks[2*a+1].bytes != sizeof(double) * dimensions[0] * dimensions[1]){
+            zlog << zTs() << "System cache file " << filename << " is truncated or corrupt and will be regenerated" << std::endl;
+            loaded = false;
+            break;
+         }
+         std::vector< std::vector<double> >& array = *arrays[a];
+         array.resize(dimensions[0]);
+         const char* data = blocks[2*a+1].data;
+         for(uint64_t row = 0; row < dimensions[0]; row++){
+            array[row].resize(dimensions[1]);
+            if(dimensions[1] > 0) std::memcpy(reinterpret_cast<char*>(array[row].data()), data, sizeof(double)*dimensions[1]);
+            data += sizeof(double)*dimensions[1];
+         }
+      }
+   }
+
+   // all processors must agree to use the cache
+   const uint64_t num_loaded = vmpi::all_reduce_sum(uint64_t(loaded ? 1 : 0));
+   if(num_loaded != uint64_t(vmpi::num_processors)) loaded = false;
+
+   if(!loaded){
+      zlog << zTs() << "No valid " << name << " cache found, recalculating" << std::endl;
+      return false;
+   }
+
+   if(vmpi::my_rank == 0) std::cout << "Loaded " << name << " data from cache file " << filename << std::endl;
+   zlog << zTs() << "Loaded " << name << " data from cache file " << filename << std::endl;
+
+   return true;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to save a secondary cache section of rectangular 2D arrays
+//------------------------------------------------------------------------------
+void save_cache_section(const std::string& name, const uint64_t input_hash, const std::vector< const std::vector< std::vector<double> >* >& arrays){
+
+   if(!internal::use_system_cache) return;
+
+   const uint64_t key = internal::section_key(name, input_hash);
+   const std::string filename = internal::cache_file_name(name, key);
+
+   std::vector<uint64_t> dimensions(2*arrays.size(), 0);
+   std::vector<internal::block_t> blocks;
+
+   for(size_t a = 0; a < arrays.size(); a++){
+
+      const std::vector< std::vector<double> >& array = *arrays[a];
+      dimensions[2*a+0] = array.size();
+      dimensions[2*a+1] = array.size() > 0 ? array[0].size() : 0;
+
+      internal::block_t data;
+      for(const std::vector<double>& row : array){
+         if(row.size() != dimensions[2*a+1]){
+            terminaltextcolor(RED);
+            std::cerr << "Programmer Error - cache section " << name << " contains a non-rectangular array" << std::endl;
+            terminaltextcolor(WHITE);
+            zlog << zTs() << "Programmer Error - cache section " << name << " contains a non-rectangular array" << std::endl;
+            err::vexit();
+         }
+         if(row.size() > 0) data.push_back(internal::piece_t{ reinterpret_cast<const char*>(row.data()), sizeof(double)*row.size() });
+      }
+
+      blocks.push_back(internal::block_t(1, internal::piece_t{ reinterpret_cast<const char*>(&dimensions[2*a]), 2*sizeof(uint64_t) }));
+      blocks.push_back(data);
+
+   }
+
+   if(internal::write_cache_file(filename, internal::section_magic, key, blocks)){
+      zlog << zTs() << "Saved " << name << " data to cache file " << filename << std::endl;
+   }
+
+   return;
+
+}
+
+} // end of create namespace
@@ -38,8 +38,8 @@ namespace dipole{
                                        std::vector<double>& moments_array, // atomistic magnetic moments (bohr magnetons)
                                        std::vector<int>& mat_id_array){    // atom material ID
 
-         // Calculate memory requirements and inform user
-         const double mem = double(num_atoms) * double(vmpi::num_processors) * sizeof(double) * 7.0 / 1.0e6;
+         // Calculate memory requirements and inform user (coordinates and moments are stored once per node)
+         const double mem = double(num_atoms) * double(vmpi::num_processors) * sizeof(double) * (3.0 + 4.0 / double(vmpi::num_node_processors)) / 1.0e6;
          zlog << zTs() << "Atomistic dipole field calculation has been enabled and requires " << mem << " MB of RAM" << std::endl;
          std::cout     << "Atomistic dipole field calculation has been enabled and requires " << mem << " MB of RAM" << std::endl;
 
@@ -79,17 +79,18 @@ namespace dipole{
 
          //std::cerr << vmpi::my_rank << "\t" << total_num_atoms << "\t" << num_local_atoms << std::endl;
 
-         // resize coordinate arrays to include all atoms
-         dp::cx.resize(total_num_atoms, 0.0);
-         dp::cy.resize(total_num_atoms, 0.0);
-         dp::cz.resize(total_num_atoms, 0.0);
-         dp::sm.resize(total_num_atoms, 0.0);
+         // resize coordinate arrays to include all atoms (shared by all processors on node)
+         dp::cx.resize(total_num_atoms);
+         dp::cy.resize(total_num_atoms);
+         dp::cz.resize(total_num_atoms);
+         dp::sm.resize(total_num_atoms);
 
-         // Gather atomic positions on all processors
-         MPI_Allgatherv(&x_coord_array[0],      num_local_atoms, MPI_DOUBLE, &dp::cx[0], &dp::receive_counts[0], &dp::receive_displacements[0], MPI_DOUBLE, MPI_COMM_WORLD);
-         MPI_Allgatherv(&y_coord_array[0],      num_local_atoms, MPI_DOUBLE, &dp::cy[0], &dp::receive_counts[0], &dp::receive_displacements[0], MPI_DOUBLE, MPI_COMM_WORLD);
-         MPI_Allgatherv(&z_coord_array[0],      num_local_atoms, MPI_DOUBLE, &dp::cz[0], &dp::receive_counts[0], &dp::receive_displacements[0], MPI_DOUBLE, MPI_COMM_WORLD);
-         MPI_Allgatherv(&moments_array_copy[0], num_local_atoms, MPI_DOUBLE, &dp::sm[0], &dp::receive_counts[0], &dp::receive_displacements[0], MPI_DOUBLE, MPI_COMM_WORLD);
+         // Gather atomic positions on all nodes
+         const int offset = dp::receive_displacements[vmpi::my_rank];
+         vmpi::all_gather_shared(&x_coord_array[0],      num_local_atoms, offset, dp::cx);
+         vmpi::all_gather_shared(&y_coord_array[0],      num_local_atoms, offset, dp::cy);
+         vmpi::all_gather_shared(&z_coord_array[0],      num_local_atoms, offset, dp::cz);
+         vmpi::all_gather_shared(&moments_array_copy[0], num_local_atoms, offset, dp::sm);
 
          // Resize arrays to hold all spin and moment positions
          dp::sx.resize(total_num_atoms, 0.0);
@@ -110,10 +111,10 @@ namespace dipole{
          }
 
          // resize coordinate arrays to include all atoms
-         dp::cx.resize(total_num_atoms, 0.0);
-         dp::cy.resize(total_num_atoms, 0.0);
-         dp::cz.resize(total_num_atoms, 0.0);
-         dp::sm.resize(total_num_atoms, 0.0);
+         dp::cx.resize(total_num_atoms);
+         dp::cy.resize(total_num_atoms);
+         dp::cz.resize(total_num_atoms);
+         dp::sm.resize(total_num_atoms);
 
          // copy atomic coordinates to local array
          for (int atom = 0; atom < dp::total_num_atoms; atom++){
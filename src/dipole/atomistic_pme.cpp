@@ -0,0 +1,1210 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// Vampire headers
+#include "atoms.hpp"
+#include "create.hpp"
+#include "dipole.hpp"
+#include "errors.hpp"
+#include "material.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+#ifdef FFT
+#include <fftw3.h>
+#endif
+
+// dipole module headers
+#include "internal.hpp"
+
+namespace dipole{
+
+   namespace internal{
+
+      namespace atomistic_pme{
+
+         //------------------------------------------------------------------------------
+         // Distributed atomistic dipole solver using particle-mesh Ewald splitting
+         //------------------------------------------------------------------------------
+         // The dipole tensor T(r) = (3 r r - r^2 I) / r^5 is split with the Ewald
+         // screening function into a short ranged part
+         //
+         //    T_s(r) = C(r) r r - B(r) I
+         //
+         //    B(r) = [   erfc(ar) + (2ar/sqrt(pi))                    exp(-a^2 r^2) ] / r^3
+         //    C(r) = [ 3 erfc(ar) + (2ar/sqrt(pi)) (3 + 2 a^2 r^2) exp(-a^2 r^2) ] / r^5
+         //
+         // which is negligible beyond the cutoff radius r_c = 3/a, and a smooth long
+         // ranged remainder T_l = T - T_s. The short ranged part is summed directly
+         // over neighbours within the cutoff, including halo atoms received from other
+         // processors and periodic images. The smooth part is evaluated on a regular
+         // mesh: moments are spread with cubic B-splines, convolved with T_l using
+         // FFTs on a grid distributed in slabs along x, and interpolated back to the
+         // atoms. The interaction of each atom with its own smoothed moment,
+         // T_l(0) = -4a^3/(3 sqrt(pi)) I, is removed analytically.
+         //
+         // For fully periodic systems the smooth kernel is summed over all images in
+         // k-space, giving the Ewald sum with vacuum boundary conditions. Otherwise
+         // the kernel is sampled in real space and periodic dimensions use the
+         // minimum image convention for the smooth part, neglecting interactions
+         // with more distant images.
+         //
+         // Only spins of atoms within the cutoff of another processor and planes of
+         // the mesh are communicated, so memory and communication scale with the
+         // local problem size rather than the total number of atoms. Without FFTW the
+         // mesh part is unavailable and the solver reduces to a bare dipole sum
+         // truncated at the cutoff radius.
+         //------------------------------------------------------------------------------
+
+         bool pme_initialised = false;
+
+         double alpha = 0.0;          // Ewald splitting parameter (1/A)
+         double rcut = 0.0;           // real space cutoff radius (A)
+         double mesh_spacing = 0.0;   // target mesh spacing, 0 for automatic (A)
+
+         int num_local_atoms = 0;     // number of local atoms (excluding MPI halo)
+         int num_halo_atoms = 0;      // number of atoms received from other processors and periodic images
+
+         // coordinates and moment vectors of local atoms followed by halo atoms
+         std::vector<double> cx;
+         std::vector<double> cy;
+         std::vector<double> cz;
+         std::vector<double> mu; // moment length (bohr magnetons), zero for non-magnetic atoms
+         std::vector<double> mx;
+         std::vector<double> my;
+         std::vector<double> mz;
+
+         // list of local atoms sent to each processor (grouped by destination)
+         std::vector<int> send_atoms;
+         std::vector<int> halo_send_counts;
+         std::vector<int> halo_send_displacements;
+         std::vector<int> halo_recv_counts;
+         std::vector<int> halo_recv_displacements;
+         std::vector<double> halo_send_buffer;
+         std::vector<double> halo_recv_buffer;
+
+         // short range neighbour list in compressed row format
+         std::vector<int> neighbour_start;
+         std::vector<int> neighbour_list;
+
+         // tabulated screening factors r^3 B(r) and r^5 C(r) as a function of r^2
+         const int table_size = 16384;
+         double table_dr2 = 1.0;
+         std::vector<double> table_b;
+         std::vector<double> table_c;
+
+         //---------------------------------------------------------------------------
+         // Helper function to exchange double data between all processors
+         // (counts and displacements in units of doubles)
+         //---------------------------------------------------------------------------
+         void all_to_all(std::vector<double>& send, std::vector<int>& send_counts, std::vector<int>& send_displacements,
+                         std::vector<double>& recv, std::vector<int>& recv_counts, std::vector<int>& recv_displacements){
+
+            #ifdef MPICF
+               // resize buffers to ensure valid pointers for empty exchanges
+               if(send.size() == 0) send.resize(1);
+               if(recv.size() == 0) recv.resize(1);
+               MPI_Alltoallv(&send[0], &send_counts[0], &send_displacements[0], MPI_DOUBLE,
+                             &recv[0], &recv_counts[0], &recv_displacements[0], MPI_DOUBLE, MPI_COMM_WORLD);
+            #else
+               for(int i = 0; i < send_counts[0]; i++) recv[recv_displacements[0] + i] = send[send_displacements[0] + i];
+            #endif
+
+            return;
+
+         }
+
+         //---------------------------------------------------------------------------
+         // Helper function to exchange integer counts between all processors
+         //---------------------------------------------------------------------------
+         void exchange_counts(std::vector<int>& send_counts, std::vector<int>& recv_counts){
+            #ifdef MPICF
+               MPI_Alltoall(&send_counts[0], 1, MPI_INT, &recv_counts[0], 1, MPI_INT, MPI_COMM_WORLD);
+            #else
+               recv_counts[0] = send_counts[0];
+            #endif
+            return;
+         }
+
+         //---------------------------------------------------------------------------
+         // Function to compute short range radial functions B(r) and C(r)
+         //---------------------------------------------------------------------------
+         void short_range_functions(const double r, double& b, double& c){
+
+            const double ar = alpha * r;
+            const double erfc_ar = erfc(ar);
+            const double g = 2.0 * ar * exp(-ar * ar) / sqrt(M_PI);
+            const double ir2 = 1.0 / (r * r);
+            const double ir3 = ir2 / r;
+
+            b = (erfc_ar + g) * ir3;
+            c = (3.0 * erfc_ar + g * (3.0 + 2.0 * ar * ar)) * ir3 * ir2;
+
+            return;
+
+         }
+
+         #ifdef FFT
+
+         //---------------------------------------------------------------------------
+         // Mesh data for smooth long range field
+         //---------------------------------------------------------------------------
+         int num_procs = 1;
+         int my_rank = 0;
+
+         int n[3];      // number of mesh points in x,y,z (including padding)
+         double h[3];   // mesh spacing (A)
+         double o[3];   // mesh origin (A)
+
+         std::vector<int> slab_x_start;   // first x plane owned by each processor [num_procs+1]
+         std::vector<int> slab_y_start;   // first y plane owned by each processor after transpose [num_procs+1]
+         std::vector<int> x_owner;        // processor owning each x plane
+         int nlx = 0;                     // number of local x planes
+         int nly = 0;                     // number of local y planes after transpose
+
+         int brick_min[3];                // first mesh point (unwrapped) touched by local atoms
+         int brick_size[3];               // number of mesh points touched by local atoms
+         std::vector<int> all_bricks;     // brick_min and brick_size of all processors [6*num_procs]
+         std::vector<double> brick;       // local moments and fields on brick [ix][iy][iz][3]
+
+         fftw_complex* mesh;              // x-slab of mesh [3][nlx][Ny][Nz]
+         fftw_complex* trans;             // y-slab of transposed mesh [3][nly][Nz][Nx]
+         std::vector<double> kernel;      // k-space interaction tensor [6][nly][Nz][Nx]
+
+         fftw_plan plan_yz_forward;
+         fftw_plan plan_yz_backward;
+         fftw_plan plan_x_forward;
+         fftw_plan plan_x_backward;
+
+         // communication arrays for brick to slab and transpose exchanges (units of doubles)
+         std::vector<int> brick_send_counts;
+         std::vector<int> brick_send_displacements;
+         std::vector<int> brick_recv_counts;
+         std::vector<int> brick_recv_displacements;
+         std::vector<int> transpose_send_counts;
+         std::vector<int> transpose_send_displacements;
+         std::vector<int> transpose_recv_counts;
+         std::vector<int> transpose_recv_displacements;
+         std::vector<double> mesh_send_buffer;
+         std::vector<double> mesh_recv_buffer;
+
+         inline int wrap(const int i, const int N){ return ((i % N) + N) % N; }
+
+         //---------------------------------------------------------------------------
+         // Function to return smallest integer >= i with only factors 2, 3 and 5
+         //---------------------------------------------------------------------------
+         int fft_size(int i){
+            while(true){
+               int r = i;
+               while(r % 2 == 0) r /= 2;
+               while(r % 3 == 0) r /= 3;
+               while(r % 5 == 0) r /= 5;
+               if(r == 1) return i;
+               i++;
+            }
+         }
+
+         //---------------------------------------------------------------------------
+         // Cubic B-spline weights for mesh coordinate u. k is first point of stencil
+         //---------------------------------------------------------------------------
+         inline void bspline(const double u, int& k, double w[4]){
+            const double f = floor(u);
+            const double t = u - f;
+            const double t2 = t * t;
+            const double t3 = t2 * t;
+            const double one_sixth = 1.0 / 6.0;
+            k = int(f) - 1;
+            w[0] = (1.0 - t) * (1.0 - t) * (1.0 - t) * one_sixth;
+            w[1] = (3.0 * t3 - 6.0 * t2 + 4.0) * one_sixth;
+            w[2] = (-3.0 * t3 + 3.0 * t2 + 3.0 * t + 1.0) * one_sixth;
+            w[3] = t3 * one_sixth;
+            return;
+         }
+
+         //---------------------------------------------------------------------------
+         // Function to transpose mesh between x-slabs and y-slabs
+         //---------------------------------------------------------------------------
+         void transpose(const bool forward){
+
+            const int Nx = n[0];
+            const int Ny = n[1];
+            const int Nz = n[2];
+
+            if(forward){
+               // pack x-slab data by destination y range
+               int index = 0;
+               for(int p = 0; p < num_procs; p++){
+                  for(int c = 0; c < 3; c++){
+                     for(int lx = 0; lx < nlx; lx++){
+                        for(int y = slab_y_start[p]; y < slab_y_start[p+1]; y++){
+                           const int base = ((c * nlx + lx) * Ny + y) * Nz;
+                           for(int z = 0; z < Nz; z++){
+                              mesh_send_buffer[index++] = mesh[base + z][0];
+                              mesh_send_buffer[index++] = mesh[base + z][1];
+                           }
+                        }
+                     }
+                  }
+               }
+               all_to_all(mesh_send_buffer, transpose_send_counts, transpose_send_displacements,
+                          mesh_recv_buffer, transpose_recv_counts, transpose_recv_displacements);
+               // unpack into y-slab with x contiguous
+               index = 0;
+               for(int p = 0; p < num_procs; p++){
+                  for(int c = 0; c < 3; c++){
+                     for(int x = slab_x_start[p]; x < slab_x_start[p+1]; x++){
+                        for(int ly = 0; ly < nly; ly++){
+                           for(int z = 0; z < Nz; z++){
+                              const int id = ((c * nly + ly) * Nz + z) * Nx + x;
+                              trans[id][0] = mesh_recv_buffer[index++];
+                              trans[id][1] = mesh_recv_buffer[index++];
+                           }
+                        }
+                     }
+                  }
+               }
+            }
+            else{
+               // pack y-slab data by destination x range
+               int index = 0;
+               for(int p = 0; p < num_procs; p++){
+                  for(int c = 0; c < 3; c++){
+                     for(int x = slab_x_start[p]; x < slab_x_start[p+1]; x++){
+                        for(int ly = 0; ly < nly; ly++){
+                           for(int z = 0; z < Nz; z++){
+                              const int id = ((c * nly + ly) * Nz + z) * Nx + x;
+                              mesh_send_buffer[index++] = trans[id][0];
+                              mesh_send_buffer[index++] = trans[id][1];
+                           }
+                        }
+                     }
+                  }
+               }
+               // reverse exchange swaps roles of send and receive counts
+               all_to_all(mesh_send_buffer, transpose_recv_counts, transpose_recv_displacements,
+                          mesh_recv_buffer, transpose_send_counts, transpose_send_displacements);
+               index = 0;
+               for(int p = 0; p < num_procs; p++){
+                  for(int c = 0; c < 3; c++){
+                     for(int lx = 0; lx < nlx; lx++){
+                        for(int y = slab_y_start[p]; y < slab_y_start[p+1]; y++){
+                           const int base = ((c * nlx + lx) * Ny + y) * Nz;
+                           for(int z = 0; z < Nz; z++){
+                              mesh[base + z][0] = mesh_recv_buffer[index++];
+                              mesh[base + z][1] = mesh_recv_buffer[index++];
+                           }
+                        }
+                     }
+                  }
+               }
+            }
+
+            return;
+
+         }
+
+         //---------------------------------------------------------------------------
+         // Forward 3D FFT from x-slab mesh to y-slab trans arrays
+         //---------------------------------------------------------------------------
+         void forward_transform(){
+            if(nlx > 0) fftw_execute(plan_yz_forward);
+            transpose(true);
+            if(nly > 0) fftw_execute(plan_x_forward);
+            return;
+         }
+
+         //---------------------------------------------------------------------------
+         // Backward 3D FFT from y-slab trans to x-slab mesh arrays
+         //---------------------------------------------------------------------------
+         void backward_transform(){
+            if(nly > 0) fftw_execute(plan_x_backward);
+            transpose(false);
+            if(nlx > 0) fftw_execute(plan_yz_backward);
+            return;
+         }
+
+         //---------------------------------------------------------------------------
+         // Function to exchange brick data with owners of the mesh slabs. For
+         // spreading brick moments are added to the mesh; for gathering the mesh
+         // field is copied back to the brick.
+         //---------------------------------------------------------------------------
+         void exchange_brick(const bool spread){
+
+            const int Ny = n[1];
+            const int Nz = n[2];
+
+            if(spread){
+               // pack brick planes by owner of the (wrapped) x plane
+               int index = 0;
+               for(int p = 0; p < num_procs; p++){
+                  for(int bx = 0; bx < brick_size[0]; bx++){
+                     if(x_owner[wrap(brick_min[0] + bx, n[0])] != p) continue;
+                     const int plane = 3 * brick_size[1] * brick_size[2];
+                     for(int i = 0; i < plane; i++) mesh_send_buffer[index++] = brick[bx * plane + i];
+                  }
+               }
+               all_to_all(mesh_send_buffer, brick_send_counts, brick_send_displacements,
+                          mesh_recv_buffer, brick_recv_counts, brick_recv_displacements);
+
+               // zero mesh and accumulate received moments
+               for(int i = 0; i < 3 * nlx * Ny * Nz; i++){
+                  mesh[i][0] = 0.0;
+                  mesh[i][1] = 0.0;
+               }
+               index = 0;
+               for(int p = 0; p < num_procs; p++){
+                  const int* b = &all_bricks[6 * p];
+                  for(int bx = 0; bx < b[3]; bx++){
+                     const int x = wrap(b[0] + bx, n[0]);
+                     if(x_owner[x] != my_rank) continue;
+                     const int lx = x - slab_x_start[my_rank];
+                     for(int by = 0; by < b[4]; by++){
+                        const int y = wrap(b[1] + by, Ny);
+                        for(int bz = 0; bz < b[5]; bz++){
+                           const int z = wrap(b[2] + bz, Nz);
+                           for(int c = 0; c < 3; c++){
+                              mesh[((c * nlx + lx) * Ny + y) * Nz + z][0] += mesh_recv_buffer[index++];
+                           }
+                        }
+                     }
+                  }
+               }
+            }
+            else{
+               // pack mesh field in the order requested by each brick
+               int index = 0;
+               for(int p = 0; p < num_procs; p++){
+                  const int* b = &all_bricks[6 * p];
+                  for(int bx = 0; bx < b[3]; bx++){
+                     const int x = wrap(b[0] + bx, n[0]);
+                     if(x_owner[x] != my_rank) continue;
+                     const int lx = x - slab_x_start[my_rank];
+                     for(int by = 0; by < b[4]; by++){
+                        const int y = wrap(b[1] + by, Ny);
+                        for(int bz = 0; bz < b[5]; bz++){
+                           const int z = wrap(b[2] + bz, Nz);
+                           for(int c = 0; c < 3; c++){
+                              mesh_send_buffer[index++] = mesh[((c * nlx + lx) * Ny + y) * Nz + z][0];
+                           }
+                        }
+                     }
+                  }
+               }
+               all_to_all(mesh_send_buffer, brick_recv_counts, brick_recv_displacements,
+                          mesh_recv_buffer, brick_send_counts, brick_send_displacements);
+               index = 0;
+               for(int p = 0; p < num_procs; p++){
+                  for(int bx = 0; bx < brick_size[0]; bx++){
+                     if(x_owner[wrap(brick_min[0] + bx, n[0])] != p) continue;
+                     const int plane = 3 * brick_size[1] * brick_size[2];
+                     for(int i = 0; i < plane; i++) brick[bx * plane + i] = mesh_recv_buffer[index++];
+                  }
+               }
+            }
+
+            return;
+
+         }
+
+         //---------------------------------------------------------------------------
+         // Function to initialise distributed mesh for smooth long range field
+         //---------------------------------------------------------------------------
+         void initialize_mesh(){
+
+            const double prefactor = 0.9274009994; // mu_0 * muB / (4*pi*Angstrom^3) = 1.0e-7 * 9.274009994e-24 / 1.0e-30 = 0.9274009994
+
+            #ifdef MPICF
+               num_procs = vmpi::num_processors;
+               my_rank = vmpi::my_rank;
+            #endif
+
+            // default mesh spacing resolves the field to around 0.1% for disordered spins
+            const double spacing = mesh_spacing > 0.0 ? mesh_spacing : 0.5 / alpha;
+
+            //------------------------------------------------------------------------
+            // Determine mesh dimensions from system size and boundary conditions
+            //------------------------------------------------------------------------
+            double min_coord[3] = { 1.0e123,  1.0e123,  1.0e123};
+            double max_coord[3] = {-1.0e123, -1.0e123, -1.0e123};
+            for(int atom = 0; atom < num_local_atoms; atom++){
+               min_coord[0] = std::min(min_coord[0], cx[atom]); max_coord[0] = std::max(max_coord[0], cx[atom]);
+               min_coord[1] = std::min(min_coord[1], cy[atom]); max_coord[1] = std::max(max_coord[1], cy[atom]);
+               min_coord[2] = std::min(min_coord[2], cz[atom]); max_coord[2] = std::max(max_coord[2], cz[atom]);
+            }
+            #ifdef MPICF
+               MPI_Allreduce(MPI_IN_PLACE, min_coord, 3, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
+               MPI_Allreduce(MPI_IN_PLACE, max_coord, 3, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+            #endif
+
+            for(int d = 0; d < 3; d++){
+               if(cs::pbc[d]){
+                  // periodic dimension: mesh fits exactly into system
+                  n[d] = fft_size(std::max(4, int(ceil(cs::system_dimensions[d] / spacing))));
+                  h[d] = cs::system_dimensions[d] / double(n[d]);
+                  o[d] = 0.0;
+               }
+               else{
+                  // open dimension: mesh covers atoms and stencil, padded by two for aperiodic convolution
+                  h[d] = spacing;
+                  o[d] = min_coord[d] - 2.0 * spacing;
+                  const int nreal = int(floor((max_coord[d] - min_coord[d]) / spacing)) + 5;
+                  n[d] = fft_size(2 * nreal);
+               }
+            }
+
+            const int Nx = n[0];
+            const int Ny = n[1];
+            const int Nz = n[2];
+
+            //------------------------------------------------------------------------
+            // Decompose mesh into slabs along x (real space) and y (k-space)
+            //------------------------------------------------------------------------
+            slab_x_start.resize(num_procs + 1);
+            slab_y_start.resize(num_procs + 1);
+            for(int p = 0; p <= num_procs; p++){
+               slab_x_start[p] = int((long(p) * long(Nx)) / num_procs);
+               slab_y_start[p] = int((long(p) * long(Ny)) / num_procs);
+            }
+            nlx = slab_x_start[my_rank + 1] - slab_x_start[my_rank];
+            nly = slab_y_start[my_rank + 1] - slab_y_start[my_rank];
+            x_owner.resize(Nx);
+            for(int p = 0; p < num_procs; p++){
+               for(int x = slab_x_start[p]; x < slab_x_start[p+1]; x++) x_owner[x] = p;
+            }
+
+            //------------------------------------------------------------------------
+            // Determine brick of mesh points touched by local atoms
+            //------------------------------------------------------------------------
+            int bmin[3] = { 2147483647,  2147483647,  2147483647};
+            int bmax[3] = {-2147483647, -2147483647, -2147483647};
+            for(int atom = 0; atom < num_local_atoms; atom++){
+               const double u[3] = { (cx[atom] - o[0]) / h[0], (cy[atom] - o[1]) / h[1], (cz[atom] - o[2]) / h[2] };
+               for(int d = 0; d < 3; d++){
+                  const int k = int(floor(u[d])) - 1;
+                  bmin[d] = std::min(bmin[d], k);
+                  bmax[d] = std::max(bmax[d], k + 3);
+               }
+            }
+            for(int d = 0; d < 3; d++){
+               brick_min[d]  = num_local_atoms > 0 ? bmin[d] : 0;
+               brick_size[d] = num_local_atoms > 0 ? bmax[d] - bmin[d] + 1 : 0;
+            }
+            brick.resize(3 * brick_size[0] * brick_size[1] * brick_size[2], 0.0);
+
+            all_bricks.resize(6 * num_procs);
+            const int my_brick[6] = { brick_min[0], brick_min[1], brick_min[2], brick_size[0], brick_size[1], brick_size[2] };
+            #ifdef MPICF
+               MPI_Allgather(my_brick, 6, MPI_INT, &all_bricks[0], 6, MPI_INT, MPI_COMM_WORLD);
+            #else
+               for(int i = 0; i < 6; i++) all_bricks[i] = my_brick[i];
+            #endif
+
+            //------------------------------------------------------------------------
+            // Calculate communication pattern for brick and transpose exchanges
+            //------------------------------------------------------------------------
+            brick_send_counts.assign(num_procs, 0);
+            brick_recv_counts.assign(num_procs, 0);
+            transpose_send_counts.assign(num_procs, 0);
+            transpose_recv_counts.assign(num_procs, 0);
+
+            for(int bx = 0; bx < brick_size[0]; bx++){
+               brick_send_counts[x_owner[wrap(brick_min[0] + bx, Nx)]] += 3 * brick_size[1] * brick_size[2];
+            }
+            for(int p = 0; p < num_procs; p++){
+               const int* b = &all_bricks[6 * p];
+               for(int bx = 0; bx < b[3]; bx++){
+                  if(x_owner[wrap(b[0] + bx, Nx)] == my_rank) brick_recv_counts[p] += 3 * b[4] * b[5];
+               }
+               transpose_send_counts[p] = 2 * 3 * nlx * (slab_y_start[p+1] - slab_y_start[p]) * Nz;
+               transpose_recv_counts[p] = 2 * 3 * (slab_x_start[p+1] - slab_x_start[p]) * nly * Nz;
+            }
+
+            brick_send_displacements.assign(num_procs, 0);
+            brick_recv_displacements.assign(num_procs, 0);
+            transpose_send_displacements.assign(num_procs, 0);
+            transpose_recv_displacements.assign(num_procs, 0);
+            for(int p = 1; p < num_procs; p++){
+               brick_send_displacements[p] = brick_send_displacements[p-1] + brick_send_counts[p-1];
+               brick_recv_displacements[p] = brick_recv_displacements[p-1] + brick_recv_counts[p-1];
+               transpose_send_displacements[p] = transpose_send_displacements[p-1] + transpose_send_counts[p-1];
+               transpose_recv_displacements[p] = transpose_recv_displacements[p-1] + transpose_recv_counts[p-1];
+            }
+
+            int buffer_size = 1;
+            buffer_size = std::max(buffer_size, brick_send_displacements[num_procs-1] + brick_send_counts[num_procs-1]);
+            buffer_size = std::max(buffer_size, brick_recv_displacements[num_procs-1] + brick_recv_counts[num_procs-1]);
+            buffer_size = std::max(buffer_size, transpose_send_displacements[num_procs-1] + transpose_send_counts[num_procs-1]);
+            buffer_size = std::max(buffer_size, transpose_recv_displacements[num_procs-1] + transpose_recv_counts[num_procs-1]);
+            mesh_send_buffer.resize(buffer_size);
+            mesh_recv_buffer.resize(buffer_size);
+
+            //------------------------------------------------------------------------
+            // Allocate mesh arrays and plan transforms
+            //------------------------------------------------------------------------
+            const int slab_points  = std::max(1, nlx * Ny * Nz);
+            const int trans_points = std::max(1, nly * Nz * Nx);
+            mesh  = (fftw_complex*) fftw_malloc( sizeof(fftw_complex) * 3 * slab_points);
+            trans = (fftw_complex*) fftw_malloc( sizeof(fftw_complex) * 3 * trans_points);
+            kernel.resize(6 * trans_points, 0.0);
+
+            // Calculate memory requirements and inform user
+            const double mem = (double(slab_points + trans_points) * 3.0 * sizeof(fftw_complex) + double(trans_points) * 6.0 * sizeof(double) +
+                                double(brick.size() + 2 * buffer_size) * sizeof(double)) / 1.0e6;
+            zlog << zTs() << "Atomistic PME mesh of " << Nx << " x " << Ny << " x " << Nz << " points with spacing " << h[0] << " x " << h[1] << " x " << h[2]
+                 << " A requires " << mem << " MB of RAM" << std::endl;
+            if(vmpi::my_rank == 0) std::cout << "Atomistic PME mesh of " << Nx << " x " << Ny << " x " << Nz << " points requires " << mem << " MB of RAM" << std::endl;
+
+            if(nlx > 0){
+               int nyz[2] = {Ny, Nz};
+               plan_yz_forward  = fftw_plan_many_dft(2, nyz, 3 * nlx, mesh, NULL, 1, Ny * Nz, mesh, NULL, 1, Ny * Nz, FFTW_FORWARD,  FFTW_MEASURE);
+               plan_yz_backward = fftw_plan_many_dft(2, nyz, 3 * nlx, mesh, NULL, 1, Ny * Nz, mesh, NULL, 1, Ny * Nz, FFTW_BACKWARD, FFTW_MEASURE);
+            }
+            if(nly > 0){
+               int nx[1] = {Nx};
+               plan_x_forward  = fftw_plan_many_dft(1, nx, 3 * nly * Nz, trans, NULL, 1, Nx, trans, NULL, 1, Nx, FFTW_FORWARD,  FFTW_MEASURE);
+               plan_x_backward = fftw_plan_many_dft(1, nx, 3 * nly * Nz, trans, NULL, 1, Nx, trans, NULL, 1, Nx, FFTW_BACKWARD, FFTW_MEASURE);
+            }
+
+            //------------------------------------------------------------------------
+            // Calculate k-space interaction tensor from real space smooth kernel
+            //------------------------------------------------------------------------
+            const double self = -4.0 * alpha * alpha * alpha / (3.0 * sqrt(M_PI));
+            // FFTW does not normalise the transform so we do here
+            const double norm = prefactor / (double(Nx) * double(Ny) * double(Nz));
+
+            // components xx,xy,xz then yy,yz,zz are transformed in two sets of three
+            const int components[2][3][2] = { { {0,0}, {0,1}, {0,2} }, { {1,1}, {1,2}, {2,2} } };
+
+            //------------------------------------------------------------------------
+            // For fully periodic systems the smooth kernel is summed over all images
+            // analytically in k-space, T_l(k) = -4 pi k k / k^2 exp(-k^2/4a^2) / V,
+            // with the k = 0 term of a spherical sample, -4 pi / 3V I (Ewald sum with
+            // vacuum boundary conditions)
+            //------------------------------------------------------------------------
+            if(cs::pbc[0] && cs::pbc[1] && cs::pbc[2]){
+
+               const double volume = cs::system_dimensions[0] * cs::system_dimensions[1] * cs::system_dimensions[2];
+               const double kernel_norm = prefactor / volume;
+
+               for(int ly = 0; ly < nly; ly++){
+                  const int y = slab_y_start[my_rank] + ly;
+                  const double by = (4.0 + 2.0 * cos(2.0 * M_PI * double(y) / double(Ny))) / 6.0;
+                  for(int z = 0; z < Nz; z++){
+                     const double bz = (4.0 + 2.0 * cos(2.0 * M_PI * double(z) / double(Nz))) / 6.0;
+                     for(int x = 0; x < Nx; x++){
+                        const double bx = (4.0 + 2.0 * cos(2.0 * M_PI * double(x) / double(Nx))) / 6.0;
+                        const double bspline_factor = 1.0 / (bx * bx * by * by * bz * bz);
+
+                        const int id = (ly * Nz + z) * Nx + x;
+                        const int index[3] = {x, y, z};
+                        double k[3];
+                        bool nyquist[3];
+                        for(int d = 0; d < 3; d++){
+                           k[d] = 2.0 * M_PI * double(index[d] <= n[d] / 2 ? index[d] : index[d] - n[d]) / cs::system_dimensions[d];
+                           nyquist[d] = (2 * index[d] == n[d]);
+                        }
+                        const double k2 = k[0] * k[0] + k[1] * k[1] + k[2] * k[2];
+
+                        for(int set = 0; set < 2; set++){
+                           for(int c = 0; c < 3; c++){
+                              const int a = components[set][c][0];
+                              const int b = components[set][c][1];
+                              double tab = 0.0;
+                              if(x == 0 && y == 0 && z == 0){
+                                 tab = (a == b) ? -4.0 * M_PI / 3.0 : 0.0;
+                              }
+                              // off-diagonal terms at the Nyquist frequency have no real transform
+                              else if(a == b || !(nyquist[a] || nyquist[b])){
+                                 tab = -4.0 * M_PI * k[a] * k[b] * exp(-k2 / (4.0 * alpha * alpha)) / k2;
+                              }
+                              kernel[(3 * set + c) * trans_points + id] = bspline_factor * kernel_norm * tab;
+                           }
+                        }
+                     }
+                  }
+               }
+
+               return;
+
+            }
+
+            //------------------------------------------------------------------------
+            // Otherwise the smooth kernel is sampled in real space for the nearest
+            // (minimum) image of each atom only
+            //------------------------------------------------------------------------
+            for(int set = 0; set < 2; set++){
+
+               for(int lx = 0; lx < nlx; lx++){
+                  const int x = slab_x_start[my_rank] + lx;
+                  const double rx = h[0] * double(x <= Nx / 2 ? x : x - Nx);
+                  for(int y = 0; y < Ny; y++){
+                     const double ry = h[1] * double(y <= Ny / 2 ? y : y - Ny);
+                     for(int z = 0; z < Nz; z++){
+                        const double rz = h[2] * double(z <= Nz / 2 ? z : z - Nz);
+                        const double r[3] = {rx, ry, rz};
+                        const double r2 = rx * rx + ry * ry + rz * rz;
+                        const double rr = sqrt(r2);
+
+                        // smooth tensor T_l = C_l r r - B_l I
+                        double bl, cl;
+                        if(alpha * rr < 1.0e-2){
+                           // series expansion of grad grad erf(ar)/r near the origin
+                           const double a2 = alpha * alpha;
+                           bl = -self - (2.0 * alpha / sqrt(M_PI)) * a2 * a2 * 0.4 * r2;
+                           cl = (2.0 * alpha / sqrt(M_PI)) * a2 * a2 * 0.8;
+                        }
+                        else{
+                           double bshort, cshort;
+                           short_range_functions(rr, bshort, cshort);
+                           bl = 1.0 / (r2 * rr) - bshort;
+                           cl = 3.0 / (r2 * r2 * rr) - cshort;
+                        }
+
+                        for(int c = 0; c < 3; c++){
+                           const int a = components[set][c][0];
+                           const int b = components[set][c][1];
+                           const double tab = cl * r[a] * r[b] - (a == b ? bl : 0.0);
+                           mesh[((c * nlx + lx) * Ny + y) * Nz + z][0] = norm * tab;
+                           mesh[((c * nlx + lx) * Ny + y) * Nz + z][1] = 0.0;
+                        }
+                     }
+                  }
+               }
+
+               forward_transform();
+
+               // store real kernel, deconvolving the B-spline smoothing of spreading and interpolation
+               for(int ly = 0; ly < nly; ly++){
+                  const int y = slab_y_start[my_rank] + ly;
+                  const double by = (4.0 + 2.0 * cos(2.0 * M_PI * double(y) / double(Ny))) / 6.0;
+                  for(int z = 0; z < Nz; z++){
+                     const double bz = (4.0 + 2.0 * cos(2.0 * M_PI * double(z) / double(Nz))) / 6.0;
+                     for(int x = 0; x < Nx; x++){
+                        const double bx = (4.0 + 2.0 * cos(2.0 * M_PI * double(x) / double(Nx))) / 6.0;
+                        const double bspline_factor = 1.0 / (bx * bx * by * by * bz * bz);
+                        for(int c = 0; c < 3; c++){
+                           const int id = (ly * Nz + z) * Nx + x;
+                           kernel[(3 * set + c) * trans_points + id] = bspline_factor * trans[c * trans_points + id][0];
+                        }
+                     }
+                  }
+               }
+
+            }
+
+            return;
+
+         }
+
+         //---------------------------------------------------------------------------
+         // Function to calculate smooth long range field on mesh and add to field
+         //---------------------------------------------------------------------------
+         void add_mesh_field(std::vector<double>& hx, std::vector<double>& hy, std::vector<double>& hz){
+
+            const int bsy = brick_size[1];
+            const int bsz = brick_size[2];
+
+            // spread local moments onto brick
+            std::fill(brick.begin(), brick.end(), 0.0);
+            for(int atom = 0; atom < num_local_atoms; atom++){
+               int kx, ky, kz;
+               double wx[4], wy[4], wz[4];
+               bspline((cx[atom] - o[0]) / h[0], kx, wx);
+               bspline((cy[atom] - o[1]) / h[1], ky, wy);
+               bspline((cz[atom] - o[2]) / h[2], kz, wz);
+               kx -= brick_min[0];
+               ky -= brick_min[1];
+               kz -= brick_min[2];
+               for(int i = 0; i < 4; i++){
+                  for(int j = 0; j < 4; j++){
+                     const double wij = wx[i] * wy[j];
+                     double* b = &brick[3 * (((kx + i) * bsy + ky + j) * bsz + kz)];
+                     for(int k = 0; k < 4; k++){
+                        const double w = wij * wz[k];
+                        b[3*k + 0] += w * mx[atom];
+                        b[3*k + 1] += w * my[atom];
+                        b[3*k + 2] += w * mz[atom];
+                     }
+                  }
+               }
+            }
+
+            // convolve with interaction tensor
+            exchange_brick(true);
+            forward_transform();
+
+            const int points = nly * n[2] * n[0];
+            for(int id = 0; id < points; id++){
+               const double Kxx = kernel[0 * points + id];
+               const double Kxy = kernel[1 * points + id];
+               const double Kxz = kernel[2 * points + id];
+               const double Kyy = kernel[3 * points + id];
+               const double Kyz = kernel[4 * points + id];
+               const double Kzz = kernel[5 * points + id];
+               for(int part = 0; part < 2; part++){
+                  const double Mx = trans[0 * points + id][part];
+                  const double My = trans[1 * points + id][part];
+                  const double Mz = trans[2 * points + id][part];
+                  trans[0 * points + id][part] = Kxx * Mx + Kxy * My + Kxz * Mz;
+                  trans[1 * points + id][part] = Kxy * Mx + Kyy * My + Kyz * Mz;
+                  trans[2 * points + id][part] = Kxz * Mx + Kyz * My + Kzz * Mz;
+               }
+            }
+
+            backward_transform();
+            exchange_brick(false);
+
+            // interpolate field back to local atoms
+            for(int atom = 0; atom < num_local_atoms; atom++){
+               int kx, ky, kz;
+               double wx[4], wy[4], wz[4];
+               bspline((cx[atom] - o[0]) / h[0], kx, wx);
+               bspline((cy[atom] - o[1]) / h[1], ky, wy);
+               bspline((cz[atom] - o[2]) / h[2], kz, wz);
+               kx -= brick_min[0];
+               ky -= brick_min[1];
+               kz -= brick_min[2];
+               double bx = 0.0;
+               double by = 0.0;
+               double bz = 0.0;
+               for(int i = 0; i < 4; i++){
+                  for(int j = 0; j < 4; j++){
+                     const double wij = wx[i] * wy[j];
+                     const double* b = &brick[3 * (((kx + i) * bsy + ky + j) * bsz + kz)];
+                     for(int k = 0; k < 4; k++){
+                        const double w = wij * wz[k];
+                        bx += w * b[3*k + 0];
+                        by += w * b[3*k + 1];
+                        bz += w * b[3*k + 2];
+                     }
+                  }
+               }
+               hx[atom] += bx;
+               hy[atom] += by;
+               hz[atom] += bz;
+            }
+
+            return;
+
+         }
+
+         #endif
+
+         //---------------------------------------------------------------------------
+         // Function to build list of local atoms (and periodic images) within the
+         // cutoff of each processor's domain and exchange their coordinates
+         //---------------------------------------------------------------------------
+         void initialize_halo(){
+
+            int nprocs = 1;
+            int rank = 0;
+            #ifdef MPICF
+               nprocs = vmpi::num_processors;
+               rank = vmpi::my_rank;
+            #endif
+
+            // determine bounding box of local atoms on all processors
+            std::vector<double> box(6 * nprocs, 0.0);
+            double my_box[6] = {1.0e123, 1.0e123, 1.0e123, -1.0e123, -1.0e123, -1.0e123};
+            for(int atom = 0; atom < num_local_atoms; atom++){
+               my_box[0] = std::min(my_box[0], cx[atom]); my_box[3] = std::max(my_box[3], cx[atom]);
+               my_box[1] = std::min(my_box[1], cy[atom]); my_box[4] = std::max(my_box[4], cy[atom]);
+               my_box[2] = std::min(my_box[2], cz[atom]); my_box[5] = std::max(my_box[5], cz[atom]);
+            }
+            #ifdef MPICF
+               MPI_Allgather(my_box, 6, MPI_DOUBLE, &box[0], 6, MPI_DOUBLE, MPI_COMM_WORLD);
+            #else
+               for(int i = 0; i < 6; i++) box[i] = my_box[i];
+            #endif
+
+            // determine periodic image shifts
+            std::vector<double> shifts;
+            for(int i = -1; i <= 1; i++){
+               if(i != 0 && !cs::pbc[0]) continue;
+               for(int j = -1; j <= 1; j++){
+                  if(j != 0 && !cs::pbc[1]) continue;
+                  for(int k = -1; k <= 1; k++){
+                     if(k != 0 && !cs::pbc[2]) continue;
+                     shifts.push_back(double(i) * cs::system_dimensions[0]);
+                     shifts.push_back(double(j) * cs::system_dimensions[1]);
+                     shifts.push_back(double(k) * cs::system_dimensions[2]);
+                  }
+               }
+            }
+            const int num_shifts = shifts.size() / 3;
+
+            // find atoms within cutoff of each processor domain (grouped by destination)
+            const double rc2 = rcut * rcut;
+            std::vector<double> send_coords;
+            halo_send_counts.assign(nprocs, 0);
+            send_atoms.resize(0);
+            for(int p = 0; p < nprocs; p++){
+               const double* b = &box[6 * p];
+               if(b[0] > b[3]) continue; // no atoms on processor
+               for(int atom = 0; atom < num_local_atoms; atom++){
+                  for(int s = 0; s < num_shifts; s++){
+                     const double px = cx[atom] + shifts[3*s + 0];
+                     const double py = cy[atom] + shifts[3*s + 1];
+                     const double pz = cz[atom] + shifts[3*s + 2];
+                     // atoms are always present locally without a shift
+                     if(p == rank && shifts[3*s] == 0.0 && shifts[3*s+1] == 0.0 && shifts[3*s+2] == 0.0) continue;
+                     const double dx = std::max(0.0, std::max(b[0] - px, px - b[3]));
+                     const double dy = std::max(0.0, std::max(b[1] - py, py - b[4]));
+                     const double dz = std::max(0.0, std::max(b[2] - pz, pz - b[5]));
+                     if(dx * dx + dy * dy + dz * dz <= rc2){
+                        send_atoms.push_back(atom);
+                        send_coords.push_back(px);
+                        send_coords.push_back(py);
+                        send_coords.push_back(pz);
+                        send_coords.push_back(mu[atom]);
+                        halo_send_counts[p]++;
+                     }
+                  }
+               }
+            }
+
+            // exchange number of halo atoms
+            halo_recv_counts.assign(nprocs, 0);
+            exchange_counts(halo_send_counts, halo_recv_counts);
+
+            halo_send_displacements.assign(nprocs, 0);
+            halo_recv_displacements.assign(nprocs, 0);
+            for(int p = 1; p < nprocs; p++){
+               halo_send_displacements[p] = halo_send_displacements[p-1] + halo_send_counts[p-1];
+               halo_recv_displacements[p] = halo_recv_displacements[p-1] + halo_recv_counts[p-1];
+            }
+            num_halo_atoms = halo_recv_displacements[nprocs-1] + halo_recv_counts[nprocs-1];
+
+            // exchange coordinates and moments of halo atoms
+            std::vector<int> counts(nprocs), displacements(nprocs), rcounts(nprocs), rdisplacements(nprocs);
+            for(int p = 0; p < nprocs; p++){
+               counts[p]         = 4 * halo_send_counts[p];
+               displacements[p]  = 4 * halo_send_displacements[p];
+               rcounts[p]        = 4 * halo_recv_counts[p];
+               rdisplacements[p] = 4 * halo_recv_displacements[p];
+            }
+            std::vector<double> recv_coords(4 * num_halo_atoms);
+            all_to_all(send_coords, counts, displacements, recv_coords, rcounts, rdisplacements);
+
+            const int total = num_local_atoms + num_halo_atoms;
+            cx.resize(total);
+            cy.resize(total);
+            cz.resize(total);
+            mu.resize(total);
+            for(int i = 0; i < num_halo_atoms; i++){
+               cx[num_local_atoms + i] = recv_coords[4*i + 0];
+               cy[num_local_atoms + i] = recv_coords[4*i + 1];
+               cz[num_local_atoms + i] = recv_coords[4*i + 2];
+               mu[num_local_atoms + i] = recv_coords[4*i + 3];
+            }
+            mx.assign(total, 0.0);
+            my.assign(total, 0.0);
+            mz.assign(total, 0.0);
+
+            // communication arrays for spin updates (3 components)
+            for(int p = 0; p < nprocs; p++){
+               halo_send_counts[p]        *= 3;
+               halo_send_displacements[p] *= 3;
+               halo_recv_counts[p]        *= 3;
+               halo_recv_displacements[p] *= 3;
+            }
+            halo_send_buffer.resize(3 * send_atoms.size());
+            halo_recv_buffer.resize(3 * num_halo_atoms);
+
+            return;
+
+         }
+
+         //---------------------------------------------------------------------------
+         // Function to construct short range neighbour list using a cell list
+         //---------------------------------------------------------------------------
+         void initialize_neighbour_list(){
+
+            const int total = num_local_atoms + num_halo_atoms;
+
+            double min_coord[3] = { 1.0e123,  1.0e123,  1.0e123};
+            double max_coord[3] = {-1.0e123, -1.0e123, -1.0e123};
+            for(int atom = 0; atom < total; atom++){
+               min_coord[0] = std::min(min_coord[0], cx[atom]); max_coord[0] = std::max(max_coord[0], cx[atom]);
+               min_coord[1] = std::min(min_coord[1], cy[atom]); max_coord[1] = std::max(max_coord[1], cy[atom]);
+               min_coord[2] = std::min(min_coord[2], cz[atom]); max_coord[2] = std::max(max_coord[2], cz[atom]);
+            }
+
+            // bin atoms into cells of size rcut
+            int nc[3];
+            for(int d = 0; d < 3; d++) nc[d] = total > 0 ? int((max_coord[d] - min_coord[d]) / rcut) + 1 : 1;
+            std::vector<int> head(nc[0] * nc[1] * nc[2], -1);
+            std::vector<int> next(total, -1);
+            std::vector<int> cell_of(total);
+            for(int atom = total - 1; atom >= 0; atom--){
+               const int i = int((cx[atom] - min_coord[0]) / rcut);
+               const int j = int((cy[atom] - min_coord[1]) / rcut);
+               const int k = int((cz[atom] - min_coord[2]) / rcut);
+               const int cell = (i * nc[1] + j) * nc[2] + k;
+               cell_of[atom] = cell;
+               next[atom] = head[cell];
+               head[cell] = atom;
+            }
+
+            const double rc2 = rcut * rcut;
+            neighbour_start.resize(num_local_atoms + 1);
+            neighbour_list.resize(0);
+            neighbour_start[0] = 0;
+
+            for(int atom = 0; atom < num_local_atoms; atom++){
+               const int cell = cell_of[atom];
+               const int ci = cell / (nc[1] * nc[2]);
+               const int cj = (cell / nc[2]) % nc[1];
+               const int ck = cell % nc[2];
+               for(int i = std::max(0, ci - 1); i <= std::min(nc[0] - 1, ci + 1); i++){
+                  for(int j = std::max(0, cj - 1); j <= std::min(nc[1] - 1, cj + 1); j++){
+                     for(int k = std::max(0, ck - 1); k <= std::min(nc[2] - 1, ck + 1); k++){
+                        for(int natom = head[(i * nc[1] + j) * nc[2] + k]; natom >= 0; natom = next[natom]){
+                           if(natom == atom) continue;
+                           const double dx = cx[natom] - cx[atom];
+                           const double dy = cy[natom] - cy[atom];
+                           const double dz = cz[natom] - cz[atom];
+                           if(dx * dx + dy * dy + dz * dz < rc2 && mu[natom] != 0.0) neighbour_list.push_back(natom);
+                        }
+                     }
+                  }
+               }
+               neighbour_start[atom + 1] = neighbour_list.size();
+            }
+
+            return;
+
+         }
+
+         //---------------------------------------------------------------------------
+         // Function to initialise distributed atomistic PME dipole solver
+         //---------------------------------------------------------------------------
+         void initialize_atomistic_pme_solver(){
+
+            rcut = dipole::atomistic_cutoff;
+
+            // check that periodic images can be represented by a single shift
+            for(int d = 0; d < 3; d++){
+               if(cs::pbc[d] && cs::system_dimensions[d] < rcut){
+                  terminaltextcolor(RED);
+                  std::cerr << "Error: dipole:atomistic-cutoff-range of " << rcut << " A is larger than the periodic system size of " << cs::system_dimensions[d] << " A. Exiting." << std::endl;
+                  terminaltextcolor(WHITE);
+                  zlog << zTs() << "Error: dipole:atomistic-cutoff-range of " << rcut << " A is larger than the periodic system size of " << cs::system_dimensions[d] << " A. Exiting." << std::endl;
+                  err::vexit();
+               }
+            }
+
+            #ifdef FFT
+               // screening chosen so that erfc(a r_c) ~ 2e-5
+               alpha = 3.0 / rcut;
+            #else
+               alpha = 0.0;
+               terminaltextcolor(YELLOW);
+               if(vmpi::my_rank == 0) std::cout << "Warning: atomistic PME dipole solver compiled without FFTW. The dipole field will be truncated at " << rcut << " A" << std::endl;
+               terminaltextcolor(WHITE);
+               zlog << zTs() << "Warning: atomistic PME dipole solver compiled without FFTW. The dipole field will be truncated at " << rcut << " A" << std::endl;
+            #endif
+
+            // calculate number of local atoms excluding halo
+            #ifdef MPICF
+               num_local_atoms = vmpi::num_core_atoms + vmpi::num_bdry_atoms;
+            #else
+               num_local_atoms = atoms::num_atoms;
+            #endif
+
+            // copy local coordinates and moments, zeroing moments of non-magnetic materials
+            cx.resize(num_local_atoms);
+            cy.resize(num_local_atoms);
+            cz.resize(num_local_atoms);
+            mu.resize(num_local_atoms);
+            for(int atom = 0; atom < num_local_atoms; atom++){
+               cx[atom] = atoms::x_coord_array[atom];
+               cy[atom] = atoms::y_coord_array[atom];
+               cz[atom] = atoms::z_coord_array[atom];
+               const int mat = atoms::type_array[atom];
+               mu[atom] = mp::material[mat].non_magnetic != 0 ? 0.0 : atoms::m_spin_array[atom];
+            }
+
+            initialize_halo();
+            initialize_neighbour_list();
+
+            // tabulate smooth screening factors r^3 B(r) and r^5 C(r)
+            table_dr2 = rcut * rcut / double(table_size - 2);
+            table_b.resize(table_size);
+            table_c.resize(table_size);
+            for(int i = 0; i < table_size; i++){
+               const double r = sqrt(double(std::max(i, 1)) * table_dr2);
+               short_range_functions(r, table_b[i], table_c[i]);
+               table_b[i] *= r * r * r;
+               table_c[i] *= r * r * r * r * r;
+            }
+
+            // Calculate memory requirements and inform user
+            const double mem = (double(num_local_atoms + num_halo_atoms) * 7.0 * sizeof(double) + double(neighbour_list.size() + send_atoms.size()) * sizeof(int)) / 1.0e6;
+            zlog << zTs() << "Atomistic PME dipole near field with cutoff " << rcut << " A, " << num_halo_atoms << " halo atoms and "
+                 << neighbour_list.size() << " neighbours requires " << mem << " MB of RAM" << std::endl;
+            if(vmpi::my_rank == 0) std::cout << "Atomistic PME dipole near field requires " << mem << " MB of RAM" << std::endl;
+
+            #ifdef FFT
+               initialize_mesh();
+            #endif
+
+            // set global atom counts used for output of atomistic fields
+            dipole::internal::num_local_atoms = num_local_atoms;
+            dipole::internal::total_num_atoms = num_local_atoms;
+            #ifdef MPICF
+               MPI_Allreduce(MPI_IN_PLACE, &dipole::internal::total_num_atoms, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+            #endif
+
+            // If enabled, output calculated atomistic dipole field coordinates and moments (passing local values)
+            if(dipole::internal::output_atomistic_dipole_field){
+               std::vector<double> moments(mu.begin(), mu.begin() + num_local_atoms);
+               output_atomistic_coordinates(num_local_atoms, atoms::x_coord_array, atoms::y_coord_array, atoms::z_coord_array, moments);
+            }
+
+            pme_initialised = true;
+
+            return;
+
+         }
+
+         //---------------------------------------------------------------------------
+         // Function to update atomistic dipole field
+         //---------------------------------------------------------------------------
+         void update_field_atomistic_pme(){
+
+            if(!pme_initialised){
+               std::cerr << "Programmer error : dipole::internal::atomistic_pme::update_field_atomistic_pme() called before initialisation" << std::endl;
+               err::vexit();
+            }
+
+            const double prefactor = 0.9274009994; // mu_o_4pi * muB / Angstrom^3 = 1.0e-7 * 9.274009994e-24 / 1.0e-30 = 0.9274009994
+
+            // update local moment vectors
+            for(int atom = 0; atom < num_local_atoms; atom++){
+               mx[atom] = atoms::x_spin_array[atom] * mu[atom];
+               my[atom] = atoms::y_spin_array[atom] * mu[atom];
+               mz[atom] = atoms::z_spin_array[atom] * mu[atom];
+            }
+
+            // exchange halo moment vectors
+            for(unsigned int i = 0; i < send_atoms.size(); i++){
+               const int atom = send_atoms[i];
+               halo_send_buffer[3*i + 0] = mx[atom];
+               halo_send_buffer[3*i + 1] = my[atom];
+               halo_send_buffer[3*i + 2] = mz[atom];
+            }
+            all_to_all(halo_send_buffer, halo_send_counts, halo_send_displacements, halo_recv_buffer, halo_recv_counts, halo_recv_displacements);
+            for(int i = 0; i < num_halo_atoms; i++){
+               mx[num_local_atoms + i] = halo_recv_buffer[3*i + 0];
+               my[num_local_atoms + i] = halo_recv_buffer[3*i + 1];
+               mz[num_local_atoms + i] = halo_recv_buffer[3*i + 2];
+            }
+
+            std::vector<double>& hx = dipole::atom_dipolar_field_array_x;
+            std::vector<double>& hy = dipole::atom_dipolar_field_array_y;
+            std::vector<double>& hz = dipole::atom_dipolar_field_array_z;
+
+            //------------------------------------------------------------------------
+            // Short range field from neighbours within cutoff
+            //------------------------------------------------------------------------
+            const double inv_dr2 = 1.0 / table_dr2;
+            for(int atom = 0; atom < num_local_atoms; atom++){
+
+               const double xi = cx[atom];
+               const double yi = cy[atom];
+               const double zi = cz[atom];
+
+               double bx = 0.0;
+               double by = 0.0;
+               double bz = 0.0;
+
+               for(int nn = neighbour_start[atom]; nn < neighbour_start[atom + 1]; nn++){
+                  const int natom = neighbour_list[nn];
+                  const double rx = cx[natom] - xi;
+                  const double ry = cy[natom] - yi;
+                  const double rz = cz[natom] - zi;
+                  const double r2 = rx * rx + ry * ry + rz * rz;
+
+                  // interpolate tabulated screening factors
+                  const double u = r2 * inv_dr2;
+                  const int i = int(u);
+                  const double f = u - double(i);
+                  const double ir2 = 1.0 / r2;
+                  const double ir3 = ir2 / sqrt(r2);
+                  const double b = (table_b[i] + f * (table_b[i+1] - table_b[i])) * ir3;
+                  const double c = (table_c[i] + f * (table_c[i+1] - table_c[i])) * ir3 * ir2;
+
+                  const double rdotm = rx * mx[natom] + ry * my[natom] + rz * mz[natom];
+
+                  bx += c * rdotm * rx - b * mx[natom];
+                  by += c * rdotm * ry - b * my[natom];
+                  bz += c * rdotm * rz - b * mz[natom];
+               }
+
+               // self correction for smooth mesh field
+               const double self = 4.0 * alpha * alpha * alpha / (3.0 * sqrt(M_PI));
+
+               hx[atom] = prefactor * (bx + self * mx[atom]);
+               hy[atom] = prefactor * (by + self * my[atom]);
+               hz[atom] = prefactor * (bz + self * mz[atom]);
+
+            }
+
+            //------------------------------------------------------------------------
+            // Smooth long range field from mesh
+            //------------------------------------------------------------------------
+            #ifdef FFT
+               add_mesh_field(hx, hy, hz);
+            #endif
+
+            if(dipole::internal::output_atomistic_dipole_field) output_atomistic_dipole_fields();
+
+            return;
+
+         }
+
+         //---------------------------------------------------------------------------
+         // Function to deallocate mesh memory
+         //---------------------------------------------------------------------------
+         void finalize_atomistic_pme_solver(){
+
+            #ifdef FFT
+               if(pme_initialised){
+                  if(nlx > 0){
+                     fftw_destroy_plan(plan_yz_forward);
+                     fftw_destroy_plan(plan_yz_backward);
+                  }
+                  if(nly > 0){
+                     fftw_destroy_plan(plan_x_forward);
+                     fftw_destroy_plan(plan_x_backward);
+                  }
+                  fftw_free(mesh);
+                  fftw_free(trans);
+               }
+            #endif
+
+            pme_initialised = false;
+
+            return;
+
+         }
+
+      } // end of atomistic_pme namespace
+
+   } // end of internal namespace
+
+} // end of dipole namespace
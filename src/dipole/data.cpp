@@ -108,16 +108,16 @@ namespace dipole{
       int num_local_atoms = 0; // number of local atoms (my processor)
       int total_num_atoms = 0; // number of total atoms (all processors)
 
-      // arrays to store atomic coordinates
-      std::vector <double> cx(0);
-      std::vector <double> cy(0);
-      std::vector <double> cz(0);
+      // arrays to store atomic coordinates (one copy per node)
+      vmpi::shared_array_t <double> cx;
+      vmpi::shared_array_t <double> cy;
+      vmpi::shared_array_t <double> cz;
 
       // arrays to store atomic spins
       std::vector <double> sx(0);
       std::vector <double> sy(0);
       std::vector <double> sz(0);
-      std::vector <double> sm(0);
+      vmpi::shared_array_t <double> sm; // moments (one copy per node)
 
       // arrays for calculating displacements for parallelisation
       std::vector <int> receive_counts(0);
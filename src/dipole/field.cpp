@@ -93,6 +93,10 @@ namespace dipole{
                   dipole::internal::atomistic_fft::update_field_atomistic_fft();
                   break;
 
+               case dipole::internal::atomisticpme:
+                  dipole::internal::atomistic_pme::update_field_atomistic_pme();
+                  break;
+
 
             }
 
@@ -0,0 +1,35 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+
+// Vampire headers
+#include "dipole.hpp"
+
+// dipole module headers
+#include "internal.hpp"
+
+namespace dipole{
+
+   //----------------------------------------------------------------------------
+   // Function to release memory held by the dipole solvers at the end of the
+   // simulation
+   //----------------------------------------------------------------------------
+   void finalize(){
+
+      if(!dipole::activated) return;
+
+      if(dipole::internal::solver == dipole::internal::atomisticpme) dipole::internal::atomistic_pme::finalize_atomistic_pme_solver();
+
+      return;
+
+   }
+
+} // end of dipole namespace
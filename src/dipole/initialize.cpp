@@ -135,6 +135,12 @@ namespace dipole{
             dipole::internal::atomistic_fft::initialize_atomistic_fft_solver();
             break;
 
+        case dipole::internal::atomisticpme:
+            std::cout     << "Initialising dipole field calculation using atomistic PME solver" << std::endl;
+            zlog << zTs() << "Initialising dipole field calculation using atomistic PME solver" << std::endl;
+            dipole::internal::atomistic_pme::initialize_atomistic_pme_solver();
+            break;
+
 
       }
       // Set initialised flag
@@ -76,11 +76,23 @@ namespace dipole{
             dipole::activated=true;
             return true;
          }
+         test="atomistic-pme";
+         if(value == test){
+            dipole::internal::solver = dipole::internal::atomisticpme;
+            // enable dipole calculation
+            dipole::activated=true;
+            return true;
+         }
          else{
             terminaltextcolor(RED);
             std::cerr << "Error: Value for \'" << prefix << ":" << word << "\' must be one of:" << std::endl;
             std::cerr << "\t\"macrocell\"" << std::endl;
             std::cerr << "\t\"tensor\"" << std::endl;
+            std::cerr << "\t\"atomistic\"" << std::endl;
+            std::cerr << "\t\"hierarchical\"" << std::endl;
+            std::cerr << "\t\"fft\"" << std::endl;
+            std::cerr << "\t\"atomistic-fft\"" << std::endl;
+            std::cerr << "\t\"atomistic-pme\"" << std::endl;
             terminaltextcolor(WHITE);
             err::vexit();
          }
@@ -101,6 +113,24 @@ namespace dipole{
          dipole::cutoff=dpur;
          return true;
       }
+      //-------------------------------------------------------------------
+      test="atomistic-cutoff-range";
+      if(word==test){
+         double cr=atof(value.c_str());
+         // Test for valid range
+         vin::check_for_valid_value(cr, word, line, prefix, unit, "length", 1.0, 1.0e4,"input","1.0 - 10,000.0 A");
+         dipole::atomistic_cutoff=cr;
+         return true;
+      }
+      //-------------------------------------------------------------------
+      test="atomistic-mesh-spacing";
+      if(word==test){
+         double ms=atof(value.c_str());
+         // Test for valid range
+         vin::check_for_valid_value(ms, word, line, prefix, unit, "length", 0.1, 1.0e3,"input","0.1 - 1,000.0 A");
+         dipole::internal::atomistic_pme::mesh_spacing=ms;
+         return true;
+      }
       test="atomistic-tensor-enabled";
       if(word==test){
          dipole::atomsitic_tensor_enabled=true;
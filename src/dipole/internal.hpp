@@ -22,6 +22,7 @@
 
 // Vampire headers
 #include "dipole.hpp"
+#include "vmpi.hpp"
 #ifdef FFT
 #include <fftw3.h>
 #endif
@@ -50,7 +51,8 @@ namespace dipole{
          hierarchical   = 3, // new macrocell with tensor including local corrections and nearfield multipole
          atomistic      = 4, // atomistic dipole dipole (too slow for anything over 1000 atoms)
          fft            = 5, // fft method wit tranlational invariance
-         atomisticfft   = 6   // atomistic dipole dipole with fft
+         atomisticfft   = 6,  // atomistic dipole dipole with fft
+         atomisticpme   = 7   // distributed atomistic dipole dipole with particle-mesh Ewald
       };
       extern std::vector < int > cell_dx;
       extern std::vector < int > cell_dy;
@@ -93,16 +95,16 @@ namespace dipole{
       extern int num_local_atoms; // number of local atoms (my processor)
       extern int total_num_atoms; // number of total atoms (all processors)
 
-      // arrays to store atomic coordinates
-      extern std::vector <double> cx;
-      extern std::vector <double> cy;
-      extern std::vector <double> cz;
+      // arrays to store atomic coordinates (one copy per node)
+      extern vmpi::shared_array_t <double> cx;
+      extern vmpi::shared_array_t <double> cy;
+      extern vmpi::shared_array_t <double> cz;
 
       // arrays to store atomic spins
       extern std::vector <double> sx;
       extern std::vector <double> sy;
       extern std::vector <double> sz;
-      extern std::vector <double> sm;
+      extern vmpi::shared_array_t <double> sm; // moments (one copy per node)
 
       // arrays for calculating displacements for parallelisation
       extern std::vector <int> receive_counts;
@@ -168,6 +170,13 @@ namespace dipole{
           void finalize_atomistic_fft_solver();
       }
 
+      namespace atomistic_pme{
+          extern double mesh_spacing; // target mesh spacing, 0 for automatic (A)
+          void initialize_atomistic_pme_solver();
+          void update_field_atomistic_pme();
+          void finalize_atomistic_pme_solver();
+      }
+
 
       //-------------------------------------------------------------------------
       // Internal function declarations
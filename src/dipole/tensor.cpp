@@ -26,6 +26,44 @@ namespace dipole{
 
    namespace internal{
 
+      //------------------------------------------------------------------------
+      // Function to hash the cells, atoms and cutoff used to calculate the
+      // dipole tensors, identifying them in the system cache
+      //------------------------------------------------------------------------
+      template <typename T>
+      void hash_array(uint64_t& hash, const std::vector<T>& array){
+         const uint64_t size = array.size();
+         hash = create::hash_cache_input(hash, &size, sizeof(uint64_t));
+         hash = create::hash_cache_input(hash, array.data(), sizeof(T)*size);
+      }
+
+      uint64_t tensor_input_hash(const double cutoff,
+                                 const int num_cells,
+                                 const std::vector<int>& local_cell_array,
+                                 const std::vector<int>& num_atoms_in_cell,
+                                 const std::vector<int>& num_atoms_in_cell_global,
+                                 const std::vector<double>& pos_and_mom_array,
+                                 const std::vector<double>& atom_coords_x,
+                                 const std::vector<double>& atom_coords_y,
+                                 const std::vector<double>& atom_coords_z,
+                                 const std::vector<double>& atom_moments){
+
+         uint64_t hash = 14695981039346656037ULL; // FNV-1a offset basis
+         hash = create::hash_cache_input(hash, &cutoff, sizeof(double));
+         hash = create::hash_cache_input(hash, &num_cells, sizeof(int));
+         hash_array(hash, local_cell_array);
+         hash_array(hash, num_atoms_in_cell);
+         hash_array(hash, num_atoms_in_cell_global);
+         hash_array(hash, pos_and_mom_array);
+         hash_array(hash, atom_coords_x);
+         hash_array(hash, atom_coords_y);
+         hash_array(hash, atom_coords_z);
+         hash_array(hash, atom_moments);
+
+         return hash;
+
+      }
+
       //------------------------------------------------------------------------
       // Function to initialise dipole tensors with default scheme.
       //
@@ -66,8 +104,16 @@ namespace dipole{
             std::vector< std::vector<double> > atoms_in_cells_array; // 2D list of [cell][atom] for local cells needed for computing dipole tensor
             std::vector<int> list_of_atoms_with_cells; // list of cell IDs to enable parsing of atomistic data
 
+            // load dipole tensors from system cache if calculated before for the same cells and atoms
+            std::vector< std::vector< std::vector<double> >* > tensors = { &rij_tensor_xx, &rij_tensor_xy, &rij_tensor_xz,
+                                                                          &rij_tensor_yy, &rij_tensor_yz, &rij_tensor_zz };
+            const uint64_t input_hash = tensor_input_hash(real_cutoff, cells_num_cells, cells_local_cell_array, cells_num_atoms_in_cell,
+                                                          cells_num_atoms_in_cell_global, cells_pos_and_mom_array,
+                                                          atom_coords_x, atom_coords_y, atom_coords_z, atoms::m_spin_array);
+            const bool loaded_from_cache = create::load_cache_section("dipole-tensor", input_hash, tensors);
+
             // distribute atomistic data to enable tensor dipole calculation
-            initialise_atomistic_cell_data(cells_num_cells,
+            if(!loaded_from_cache) initialise_atomistic_cell_data(cells_num_cells,
                                            cells_num_local_cells,
                                            real_cutoff,                     // cutoff range for dipole tensor construction (Angstroms)
                                            cells_num_atoms_in_cell,         // number of atoms in each cell (local CPU)
@@ -93,6 +139,8 @@ namespace dipole{
             //}
          }
 
+         if(loaded_from_cache) return;
+
          // print informative message to user
          zlog << zTs() << "Precalculating rij matrix for dipole calculation using tensor solver... " << std::endl;
          std::cout     << "Precalculating rij matrix for dipole calculation using tensor solver"     << std::flush;
@@ -180,6 +228,9 @@ namespace dipole{
          std::cout << "done! [ " << timer.elapsed_time() << " s ]" << std::endl;
          zlog << zTs() << "Precalculation of rij matrix for dipole calculation complete. Time taken: " << timer.elapsed_time() << " s"<< std::endl;
 
+         // save dipole tensors for subsequent runs
+         create::save_cache_section("dipole-tensor", input_hash, std::vector< const std::vector< std::vector<double> >* >(tensors.begin(), tensors.end()));
+
          return;
 
       }
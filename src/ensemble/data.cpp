@@ -0,0 +1,57 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+
+// Vampire headers
+#include "ensemble.hpp"
+
+// ensemble module headers
+#include "internal.hpp"
+
+namespace ensemble{
+
+   //------------------------------------------------------------------------------
+   // Externally visible variables
+   //------------------------------------------------------------------------------
+   bool enabled = false; // flag to enable multi-replica ensemble mode
+
+   namespace internal{
+
+      //------------------------------------------------------------------------
+      // Shared variables inside ensemble module
+      //------------------------------------------------------------------------
+      bool initialised = false;
+
+      int num_replicas = 1;                // number of replicas in ensemble
+      int num_atoms = 0;                   // number of atoms in each replica
+      double temperature_increment = 0.0;  // temperature difference between successive replicas (K)
+      double field_increment = 0.0;        // applied field difference between successive replicas (T)
+
+      std::vector<double> spin_array;      // replica interleaved spins [atom][component][replica]
+      std::vector<double> temperature;     // current temperature of each replica
+      std::vector<double> applied_field;   // current applied field strength of each replica
+      std::vector<double> adaptive_sigma;  // adaptive Monte Carlo trial width of each replica
+      std::vector<montecarlo::replica_rng_t> rng; // random number generator of each replica
+
+      std::vector<double> temperature_ladder; // explicit replica temperatures, replaces increment if set
+      int exchange_offset = 0;                // first replica of pairs for next exchange attempt (0 or 1)
+      std::vector<double> exchange_attempts;  // number of exchange attempts between replicas r and r+1
+      std::vector<double> exchange_accepts;   // number of accepted exchanges between replicas r and r+1
+
+      std::vector<replica_statistics_t> statistics; // statistics of replicas 1 to num_replicas-1
+
+      int swapped_replica = 0;             // replica with statistics currently swapped into global statistics
+      double primary_temperature = 0.0;    // global temperature saved during swap
+      double primary_field = 0.0;          // global applied field saved during swap
+
+   } // end of internal namespace
+
+} // end of ensemble namespace
@@ -0,0 +1,92 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <algorithm>
+#include <iostream>
+
+// Vampire headers
+#include "atoms.hpp"
+#include "ensemble.hpp"
+#include "errors.hpp"
+#include "montecarlo.hpp"
+#include "vio.hpp"
+
+// ensemble module headers
+#include "internal.hpp"
+
+namespace ensemble{
+
+   //---------------------------------------------------------------------------
+   // Function to set explicit temperatures for all replicas, for example the
+   // temperature ladder of a parallel tempering simulation
+   //---------------------------------------------------------------------------
+   void set_temperature_ladder(const std::vector<double>& temperatures){
+
+      if(temperatures.size() != size_t(internal::num_replicas)){
+         terminaltextcolor(RED);
+         std::cerr << "Programmer Error - temperature ladder of size " << temperatures.size() << " does not match number of replicas " << internal::num_replicas << ". Exiting." << std::endl;
+         terminaltextcolor(WHITE);
+         zlog << zTs() << "Programmer Error - temperature ladder of size " << temperatures.size() << " does not match number of replicas " << internal::num_replicas << ". Exiting." << std::endl;
+         err::vexit();
+      }
+
+      internal::temperature_ladder = temperatures;
+
+      return;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to attempt exchange of configurations between neighbouring
+   // replicas, alternating between even and odd pairs on successive calls
+   //---------------------------------------------------------------------------
+   void attempt_replica_exchange(){
+
+      if(!internal::initialised) return;
+
+      internal::update_replica_conditions();
+
+      montecarlo::replica_exchange(internal::spin_array, internal::num_replicas, internal::num_atoms, atoms::type_array,
+                                   internal::temperature, internal::applied_field, internal::exchange_offset,
+                                   internal::exchange_attempts, internal::exchange_accepts);
+
+      internal::exchange_offset = 1 - internal::exchange_offset;
+
+      internal::unpack_replica(0, atoms::x_spin_array, atoms::y_spin_array, atoms::z_spin_array);
+
+      return;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to get fraction of accepted exchanges between replicas r and r+1
+   //---------------------------------------------------------------------------
+   void get_exchange_acceptance(std::vector<double>& acceptance){
+
+      acceptance.assign(internal::exchange_attempts.size(), 0.0);
+      for(size_t r = 0; r < acceptance.size(); r++){
+         if(internal::exchange_attempts[r] > 0.0) acceptance[r] = internal::exchange_accepts[r] / internal::exchange_attempts[r];
+      }
+
+      return;
+
+   }
+
+   void reset_exchange_statistics(){
+
+      std::fill(internal::exchange_attempts.begin(), internal::exchange_attempts.end(), 0.0);
+      std::fill(internal::exchange_accepts.begin(), internal::exchange_accepts.end(), 0.0);
+
+      return;
+
+   }
+
+} // end of ensemble namespace
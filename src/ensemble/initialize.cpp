@@ -0,0 +1,138 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <iostream>
+
+// Vampire headers
+#include "dipole.hpp"
+#include "ensemble.hpp"
+#include "errors.hpp"
+#include "exchange.hpp"
+#include "gpu.hpp"
+#include "random.hpp"
+#include "sim.hpp"
+#include "vio.hpp"
+
+// ensemble module headers
+#include "internal.hpp"
+
+namespace ensemble{
+
+   //---------------------------------------------------------------------------
+   // Function to check the simulation supports a multi-replica ensemble and to
+   // allocate replica interleaved spins, initialised to the current spin
+   // configuration, and per replica statistics copied from the global
+   // statistics. Called after statistics initialisation and preconditioning.
+   //---------------------------------------------------------------------------
+   void initialize(const int num_atoms,
+                   const std::vector<double>& x_spin_array,
+                   const std::vector<double>& y_spin_array,
+                   const std::vector<double>& z_spin_array){
+
+      // check that ensemble mode is needed
+      if(!ensemble::enabled) return;
+
+      zlog << zTs() << "Initialising multi-replica ensemble with " << internal::num_replicas << " replicas" << std::endl;
+
+      // check for unsupported simulation options
+      std::string error = "";
+      #ifdef MPICF
+         error = "parallel simulations";
+      #endif
+      if(sim::integrator != sim::monte_carlo) error = "integrators other than monte-carlo";
+      if(gpu::acceleration)                   error = "gpu acceleration";
+      if(dipole::activated)                   error = "dipole fields";
+      if(exchange::biquadratic)               error = "biquadratic exchange";
+      if(exchange::is_four_spin_enabled())    error = "four spin exchange";
+      if(error != ""){
+         terminaltextcolor(RED);
+         std::cerr << "Error - ensemble:num-replicas > 1 is not supported for " << error << ". Exiting." << std::endl;
+         terminaltextcolor(WHITE);
+         zlog << zTs() << "Error - ensemble:num-replicas > 1 is not supported for " << error << ". Exiting." << std::endl;
+         err::vexit();
+      }
+
+      if(sim::save_checkpoint_flag || sim::load_checkpoint_flag){
+         zlog << zTs() << "Warning - checkpoints only store the spin configuration of replica 0 of the ensemble" << std::endl;
+      }
+
+      const int R = internal::num_replicas;
+      internal::num_atoms = num_atoms;
+
+      // copy current spin configuration to all replicas
+      internal::spin_array.resize(3*R*num_atoms);
+      for(int atom = 0; atom < num_atoms; atom++){
+         const double S[3] = {x_spin_array[atom], y_spin_array[atom], z_spin_array[atom]};
+         for(int c = 0; c < 3; c++){
+            for(int r = 0; r < R; r++) internal::spin_array[(3*atom + c)*R + r] = S[c];
+         }
+      }
+
+      internal::temperature.resize(R, 0.0);
+      internal::applied_field.resize(R, 0.0);
+      internal::adaptive_sigma.assign(R, 60.0);
+
+      // seed independent random number generator of each replica from the global sequence
+      internal::rng = std::vector<montecarlo::replica_rng_t>(R);
+      for(int r = 0; r < R; r++) internal::rng[r].generator.seed(mtrandom::grnd.i32());
+
+      internal::exchange_attempts.assign(R-1, 0.0);
+      internal::exchange_accepts.assign(R-1, 0.0);
+      internal::update_replica_conditions();
+
+      // additional replicas start from the reset global statistics
+      internal::statistics.assign(R-1, internal::replica_statistics_t());
+
+      internal::initialised = true;
+
+      return;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to get number of replicas in the ensemble
+   //---------------------------------------------------------------------------
+   int get_num_replicas(){
+      return internal::num_replicas;
+   }
+
+   namespace internal{
+
+      //------------------------------------------------------------------------
+      // Function to set temperature and applied field of each replica from the
+      // global values, so that program loops sweep the whole ensemble
+      //------------------------------------------------------------------------
+      void update_replica_conditions(){
+         for(int r = 0; r < num_replicas; r++){
+            const double T = temperature_ladder.size() == size_t(num_replicas) ? temperature_ladder[r] :
+                                                                                 sim::temperature + double(r) * temperature_increment;
+            temperature[r] = T > 0.0 ? T : 0.0;
+            applied_field[r] = sim::H_applied + double(r) * field_increment;
+         }
+         return;
+      }
+
+      //------------------------------------------------------------------------
+      // Function to copy the spins of one replica to separate spin arrays
+      //------------------------------------------------------------------------
+      void unpack_replica(const int replica, std::vector<double>& x_spin_array, std::vector<double>& y_spin_array, std::vector<double>& z_spin_array){
+         const int R = num_replicas;
+         for(int atom = 0; atom < num_atoms; atom++){
+            x_spin_array[atom] = spin_array[(3*atom + 0)*R + replica];
+            y_spin_array[atom] = spin_array[(3*atom + 1)*R + replica];
+            z_spin_array[atom] = spin_array[(3*atom + 2)*R + replica];
+         }
+         return;
+      }
+
+   } // end of internal namespace
+
+} // end of ensemble namespace
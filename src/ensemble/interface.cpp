@@ -0,0 +1,69 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <string>
+
+// Vampire headers
+#include "ensemble.hpp"
+#include "errors.hpp"
+#include "vio.hpp"
+
+// ensemble module headers
+#include "internal.hpp"
+
+namespace ensemble{
+
+   //---------------------------------------------------------------------------
+   // Function to process input file parameters for ensemble module
+   //---------------------------------------------------------------------------
+   bool match_input_parameter(std::string const key, std::string const word, std::string const value, std::string const unit, int const line){
+
+      // Check for valid key, if no match return false
+      std::string prefix="ensemble";
+      if(key!=prefix) return false;
+
+      //--------------------------------------------------------------------
+      std::string test="num-replicas";
+      if( word == test ){
+         int n = atoi(value.c_str());
+         // Test for valid range
+         vin::check_for_valid_int(n, word, line, prefix, 1, 1000,"input","1 - 1000");
+         internal::num_replicas = n;
+         ensemble::enabled = n > 1;
+         return true;
+      }
+      //--------------------------------------------------------------------
+      test="temperature-increment";
+      if( word == test ){
+         double T = atof(value.c_str());
+         // Test for valid range
+         vin::check_for_valid_value(T, word, line, prefix, unit, "none", -1.0e4, 1.0e4,"input","-10,000 - 10,000 K");
+         internal::temperature_increment = T;
+         return true;
+      }
+      //--------------------------------------------------------------------
+      test="applied-field-increment";
+      if( word == test ){
+         double H = atof(value.c_str());
+         // Test for valid range
+         vin::check_for_valid_value(H, word, line, prefix, unit, "field", -1.0e3, 1.0e3,"input","-1,000 - 1,000 T");
+         internal::field_increment = H;
+         return true;
+      }
+
+      //--------------------------------------------------------------------
+      // Keyword not found
+      //--------------------------------------------------------------------
+      return false;
+
+   }
+
+} // end of ensemble namespace
@@ -0,0 +1,103 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+#ifndef ENSEMBLE_INTERNAL_H_
+#define ENSEMBLE_INTERNAL_H_
+//
+//---------------------------------------------------------------------
+// This header file defines shared internal data structures and
+// functions for the ensemble module. These functions and
+// variables should not be accessed outside of this module.
+//---------------------------------------------------------------------
+
+// C++ standard library headers
+#include <vector>
+
+// Vampire headers
+#include "ensemble.hpp"
+#include "montecarlo.hpp"
+#include "stats.hpp"
+
+namespace ensemble{
+
+   namespace internal{
+
+      //-------------------------------------------------------------------------
+      // Internal data type definitions
+      //-------------------------------------------------------------------------
+
+      // statistics of an additional replica, initialised as copies of the
+      // global statistics so that masks and normalisations are shared
+      struct replica_statistics_t{
+
+         stats::energy_statistic_t system_energy;
+         stats::energy_statistic_t material_energy;
+         stats::magnetization_statistic_t system_magnetization;
+         stats::magnetization_statistic_t material_magnetization;
+         stats::specific_heat_statistic_t system_specific_heat;
+         stats::specific_heat_statistic_t material_specific_heat;
+         stats::susceptibility_statistic_t system_susceptibility;
+         stats::susceptibility_statistic_t material_susceptibility;
+         stats::binder_cumulant_statistic_t system_binder_cumulant;
+         stats::binder_cumulant_statistic_t material_binder_cumulant;
+
+         replica_statistics_t():
+            system_energy(stats::system_energy),
+            material_energy(stats::material_energy),
+            system_magnetization(stats::system_magnetization),
+            material_magnetization(stats::material_magnetization),
+            system_specific_heat(stats::system_specific_heat),
+            material_specific_heat(stats::material_specific_heat),
+            system_susceptibility(stats::system_susceptibility),
+            material_susceptibility(stats::material_susceptibility),
+            system_binder_cumulant(stats::system_binder_cumulant),
+            material_binder_cumulant(stats::material_binder_cumulant)
+         {}
+
+      };
+
+      //-------------------------------------------------------------------------
+      // Internal shared variables
+      //-------------------------------------------------------------------------
+      extern bool initialised;
+
+      extern int num_replicas;              // number of replicas in ensemble
+      extern int num_atoms;                 // number of atoms in each replica
+      extern double temperature_increment;  // temperature difference between successive replicas (K)
+      extern double field_increment;        // applied field difference between successive replicas (T)
+
+      extern std::vector<double> spin_array;     // replica interleaved spins [atom][component][replica]
+      extern std::vector<double> temperature;    // current temperature of each replica
+      extern std::vector<double> applied_field;  // current applied field strength of each replica
+      extern std::vector<double> adaptive_sigma; // adaptive Monte Carlo trial width of each replica
+      extern std::vector<montecarlo::replica_rng_t> rng; // random number generator of each replica
+
+      extern std::vector<double> temperature_ladder; // explicit replica temperatures, replaces increment if set
+      extern int exchange_offset;                    // first replica of pairs for next exchange attempt (0 or 1)
+      extern std::vector<double> exchange_attempts;  // number of exchange attempts between replicas r and r+1
+      extern std::vector<double> exchange_accepts;   // number of accepted exchanges between replicas r and r+1
+
+      extern std::vector<replica_statistics_t> statistics; // statistics of replicas 1 to num_replicas-1
+
+      extern int swapped_replica;       // replica with statistics currently swapped into global statistics
+      extern double primary_temperature; // global temperature saved during swap
+      extern double primary_field;       // global applied field saved during swap
+
+      //-------------------------------------------------------------------------
+      // Internal function declarations
+      //-------------------------------------------------------------------------
+      void update_replica_conditions();
+      void unpack_replica(const int replica, std::vector<double>& x_spin_array, std::vector<double>& y_spin_array, std::vector<double>& z_spin_array);
+
+   } // end of internal namespace
+
+} // end of ensemble namespace
+
+#endif //ENSEMBLE_INTERNAL_H_
@@ -0,0 +1,42 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+
+// Vampire headers
+#include "atoms.hpp"
+#include "ensemble.hpp"
+#include "montecarlo.hpp"
+
+// ensemble module headers
+#include "internal.hpp"
+
+namespace ensemble{
+
+   //---------------------------------------------------------------------------
+   // Function to integrate all replicas by one Monte Carlo step at their
+   // current temperatures and applied fields. Replica 0 is copied back to the
+   // atomic spin arrays so that all other outputs follow the first replica.
+   //---------------------------------------------------------------------------
+   void mc_step(){
+
+      internal::update_replica_conditions();
+
+      montecarlo::mc_step_ensemble(internal::spin_array, internal::num_replicas, internal::num_atoms, atoms::type_array,
+                                   internal::temperature, internal::applied_field, internal::adaptive_sigma,
+                                   internal::rng);
+
+      internal::unpack_replica(0, atoms::x_spin_array, atoms::y_spin_array, atoms::z_spin_array);
+
+      return;
+
+   }
+
+} // end of ensemble namespace
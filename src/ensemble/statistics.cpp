@@ -0,0 +1,153 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <algorithm>
+
+// Vampire headers
+#include "atoms.hpp"
+#include "ensemble.hpp"
+#include "sim.hpp"
+#include "stats.hpp"
+
+// ensemble module headers
+#include "internal.hpp"
+
+namespace ensemble{
+
+   //---------------------------------------------------------------------------
+   // Function to update statistics of replicas 1 to num_replicas-1, with the
+   // statistics of replica 0 calculated by stats::update(). Each replica is
+   // temporarily copied to the atomic spin arrays, which are used by the
+   // exchange energy, and the applied field energy uses the replica field.
+   //---------------------------------------------------------------------------
+   void update_statistics(){
+
+      if(!internal::initialised) return;
+
+      internal::update_replica_conditions();
+
+      const double global_field = sim::H_applied;
+
+      for(int r = 1; r < internal::num_replicas; r++){
+
+         internal::unpack_replica(r, atoms::x_spin_array, atoms::y_spin_array, atoms::z_spin_array);
+         sim::H_applied = internal::applied_field[r];
+
+         const std::vector<double>& sx = atoms::x_spin_array;
+         const std::vector<double>& sy = atoms::y_spin_array;
+         const std::vector<double>& sz = atoms::z_spin_array;
+         const std::vector<double>& mm = atoms::m_spin_array;
+         const std::vector<int>& mat = atoms::type_array;
+         const double temperature = internal::temperature[r];
+
+         internal::replica_statistics_t& rs = internal::statistics[r-1];
+
+         // update energy statistics
+         if(stats::calculate_system_energy)           rs.system_energy.calculate(sx, sy, sz, mm, mat, temperature);
+         if(stats::calculate_material_energy)         rs.material_energy.calculate(sx, sy, sz, mm, mat, temperature);
+
+         // update magnetization statistics
+         if(stats::calculate_system_magnetization)    rs.system_magnetization.calculate_magnetization(sx, sy, sz, mm);
+         if(stats::calculate_material_magnetization)  rs.material_magnetization.calculate_magnetization(sx, sy, sz, mm);
+
+         // update specific heat statistics
+         if(stats::calculate_system_specific_heat)    rs.system_specific_heat.calculate(rs.system_energy.get_total_energy());
+         if(stats::calculate_material_specific_heat)  rs.material_specific_heat.calculate(rs.material_energy.get_total_energy());
+
+         // update susceptibility statistics
+         if(stats::calculate_system_susceptibility)   rs.system_susceptibility.calculate(rs.system_magnetization.get_magnetization());
+         if(stats::calculate_material_susceptibility) rs.material_susceptibility.calculate(rs.material_magnetization.get_magnetization());
+
+         // update binder cumulant statistics
+         if(stats::calculate_system_binder_cumulant)   rs.system_binder_cumulant.calculate(rs.system_magnetization.get_magnetization());
+         if(stats::calculate_material_binder_cumulant) rs.material_binder_cumulant.calculate(rs.material_magnetization.get_magnetization());
+
+      }
+
+      // restore global field and replica 0 spins
+      sim::H_applied = global_field;
+      internal::unpack_replica(0, atoms::x_spin_array, atoms::y_spin_array, atoms::z_spin_array);
+
+      return;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to reset statistics averages of replicas 1 to num_replicas-1
+   //---------------------------------------------------------------------------
+   void reset_statistics(){
+
+      if(!internal::initialised) return;
+
+      for(size_t i = 0; i < internal::statistics.size(); i++){
+
+         internal::replica_statistics_t& rs = internal::statistics[i];
+
+         if(stats::calculate_system_energy)            rs.system_energy.reset_averages();
+         if(stats::calculate_material_energy)          rs.material_energy.reset_averages();
+         if(stats::calculate_system_magnetization)     rs.system_magnetization.reset_magnetization_averages();
+         if(stats::calculate_material_magnetization)   rs.material_magnetization.reset_magnetization_averages();
+         if(stats::calculate_system_specific_heat)     rs.system_specific_heat.reset_averages();
+         if(stats::calculate_material_specific_heat)   rs.material_specific_heat.reset_averages();
+         if(stats::calculate_system_susceptibility)    rs.system_susceptibility.reset_averages();
+         if(stats::calculate_material_susceptibility)  rs.material_susceptibility.reset_averages();
+         if(stats::calculate_system_binder_cumulant)   rs.system_binder_cumulant.reset_averages();
+         if(stats::calculate_material_binder_cumulant) rs.material_binder_cumulant.reset_averages();
+
+      }
+
+      return;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to swap the statistics, temperature and applied field of a
+   // replica with the global values so that existing output functions write
+   // replica data. A second call with the same replica restores the globals.
+   //---------------------------------------------------------------------------
+   void swap_replica_statistics(const int replica){
+
+      if(!internal::initialised || replica < 1 || replica >= internal::num_replicas) return;
+
+      internal::replica_statistics_t& rs = internal::statistics[replica-1];
+
+      std::swap(stats::system_energy,            rs.system_energy);
+      std::swap(stats::material_energy,          rs.material_energy);
+      std::swap(stats::system_magnetization,     rs.system_magnetization);
+      std::swap(stats::material_magnetization,   rs.material_magnetization);
+      std::swap(stats::system_specific_heat,     rs.system_specific_heat);
+      std::swap(stats::material_specific_heat,   rs.material_specific_heat);
+      std::swap(stats::system_susceptibility,    rs.system_susceptibility);
+      std::swap(stats::material_susceptibility,  rs.material_susceptibility);
+      std::swap(stats::system_binder_cumulant,   rs.system_binder_cumulant);
+      std::swap(stats::material_binder_cumulant, rs.material_binder_cumulant);
+
+      // set replica conditions, saving global values
+      if(internal::swapped_replica == 0){
+         internal::update_replica_conditions();
+         internal::swapped_replica = replica;
+         internal::primary_temperature = sim::temperature;
+         internal::primary_field = sim::H_applied;
+         sim::temperature = internal::temperature[replica];
+         sim::H_applied = internal::applied_field[replica];
+      }
+      // restore global values
+      else{
+         internal::swapped_replica = 0;
+         sim::temperature = internal::primary_temperature;
+         sim::H_applied = internal::primary_field;
+      }
+
+      return;
+
+   }
+
+} // end of ensemble namespace
@@ -32,6 +32,30 @@ namespace exchange{
    	// energy
    	double energy=0.0;
 
+      // once merged into the unified list the per-type list is released, so use
+      // the stored 2 Jbq coefficients of the unified list instead
+      if(internal::unified_biquadratic){
+
+         const int num_J = internal::unified_form == exchange::isotropic ? 1 : internal::unified_form == exchange::vectorial ? 3 : 9;
+         const int stride = num_J + (internal::unified_dmi ? 3 : 0) + 1;
+
+         for(int nn = internal::unified_list_start[atom]; nn < internal::unified_list_start[atom+1]; ++nn){
+
+            const int natom = internal::unified_list_neighbour[nn];
+
+            // get exchange constant between atoms
+            const double Jbq = 0.5 * internal::unified_list_coefficient[size_t(stride) * nn + stride - 1];
+
+            const double si_dot_sj = sx*atoms::x_spin_array[natom] + sy*atoms::y_spin_array[natom] + sz*atoms::z_spin_array[natom];
+
+            energy -= Jbq * si_dot_sj * si_dot_sj;
+
+         }
+
+         return energy;
+
+      }
+
    	// Loop over neighbouring spins to calculate exchange
    	for(int nn = internal::biquadratic_neighbour_list_start_index[atom]; nn <= internal::biquadratic_neighbour_list_end_index[atom]; ++nn){
 
@@ -63,11 +63,23 @@ namespace exchange{
       std::vector <int> four_spin_neighbour_list_end_index;   // list of last four spin neighbours for atom i
       std::vector <double> four_spin_exchange_list;   // value of four_spin
 
+      std::vector <int> four_spin_list_start;      // first quadruplet for each central atom [num_atoms+1]
+      std::vector <int> four_spin_list_jkl;        // j,k,l atoms of each quadruplet sorted by central atom
+      std::vector <double> four_spin_list_value;   // Dq/3 for each quadruplet sorted by central atom
+
       std::vector <int> biquadratic_neighbour_list_array; // 1D list of biquadratic neighbours
       std::vector <int> biquadratic_neighbour_interaction_type_array; // 1D list of biquadratic exchange interaction types
       std::vector <int> biquadratic_neighbour_list_start_index; // list of first biquadratic neighbour for atom i
       std::vector <int> biquadratic_neighbour_list_end_index;   // list of last biquadratic neighbour for atom i
 
+      bool unified_exchange = false;                 // flag to indicate unified exchange list is initialised
+      exchange_t unified_form = isotropic;           // form of bilinear exchange in unified list
+      bool unified_dmi = false;                      // flag to indicate DMI vectors are stored in unified list
+      bool unified_biquadratic = false;              // flag to indicate biquadratic constants are stored in unified list
+      std::vector <int> unified_list_start;          // first merged interaction for each atom [num_atoms+1]
+      std::vector <int> unified_list_neighbour;      // neighbouring atom for each merged interaction
+      std::vector <double> unified_list_coefficient; // packed coefficients for each merged interaction
+
       std::vector <exchange::internal::value_t  > bq_i_exchange_list(0); // list of isotropic biquadratic exchange constants
       std::vector <exchange::internal::vector_t > bq_v_exchange_list(0); // list of vectorial biquadratic exchange constants
       std::vector <exchange::internal::tensor_t > bq_t_exchange_list(0); // list of tensorial biquadratic exchange constants
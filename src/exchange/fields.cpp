@@ -42,16 +42,27 @@ namespace exchange{
                std::vector<double>& field_array_z){
 
 
-   	// Calculate standard (bilinear) exchange fields
-      exchange::internal::exchange_fields(start_index, end_index,
-                                neighbour_list_start_index, neighbour_list_end_index,
-                                type_array, neighbour_list_array, neighbour_interaction_type_array,
-                                i_exchange_list, v_exchange_list, t_exchange_list,
-                                spin_array_x, spin_array_y, spin_array_z,
-                                field_array_x, field_array_y, field_array_z);
+      // Merge interactions into unified list on first use, so that programs
+      // which only evaluate energies (Monte Carlo) do not hold a second copy
+      if(!internal::unified_exchange) exchange::internal::initialize_unified_exchange();
 
-      // calculate biquadratic exchange field
-      if(exchange::biquadratic){
+      // Calculate bilinear, DMI and biquadratic exchange fields in a single neighbour pass
+      if(internal::unified_exchange){
+         exchange::internal::unified_exchange_fields(start_index, end_index,
+                                                     spin_array_x, spin_array_y, spin_array_z,
+                                                     field_array_x, field_array_y, field_array_z);
+      }
+      else{
+         exchange::internal::exchange_fields(start_index, end_index,
+                                   neighbour_list_start_index, neighbour_list_end_index,
+                                   type_array, neighbour_list_array, neighbour_interaction_type_array,
+                                   i_exchange_list, v_exchange_list, t_exchange_list,
+                                   spin_array_x, spin_array_y, spin_array_z,
+                                   field_array_x, field_array_y, field_array_z);
+      }
+
+      // calculate biquadratic exchange field if not included in unified list
+      if(exchange::biquadratic && !internal::unified_biquadratic){
          exchange::internal::biquadratic_exchange_fields(start_index, end_index,
                                                          exchange::internal::biquadratic_neighbour_list_start_index, exchange::internal::biquadratic_neighbour_list_end_index,
                                                          type_array, exchange::internal::biquadratic_neighbour_list_array, exchange::internal::biquadratic_neighbour_interaction_type_array,
@@ -61,7 +72,7 @@ namespace exchange{
       }
 
       if (exchange::four_spin){
-         exchange::internal::four_spin_exchange_fields(start_index, end_index, field_array_x, field_array_y, field_array_z);
+         exchange::internal::four_spin_exchange_fields(start_index, end_index, spin_array_x, spin_array_y, spin_array_z, field_array_x, field_array_y, field_array_z);
       }
 
    	return;
@@ -46,16 +46,17 @@ double single_spin_four_spin_energy(const int atom, const double sx, const doubl
 
    double energy=0.0;
 
-   const double six = atoms::x_spin_array[atom];
-   const double siy = atoms::y_spin_array[atom];
-   const double siz = atoms::z_spin_array[atom];
+   // use trial spin direction of atom i
+   const double six = sx;
+   const double siy = sy;
+   const double siz = sz;
 
-   // Loop over neighbouring spins to calculate exchange
-   for(int nn = internal::four_spin_neighbour_list_start_index[atom]; nn <= internal::four_spin_neighbour_list_end_index[atom]; ++nn){
+   // Loop over quadruplets with atom i at the centre (Dq/3 stored in list)
+   for(int nn = internal::four_spin_list_start[atom]; nn < internal::four_spin_list_start[atom+1]; ++nn){
 
-      const int natomj = internal::four_spin_neighbour_list_array_j[nn];
-		const int natomk = internal::four_spin_neighbour_list_array_k[nn];
-		const int natoml = internal::four_spin_neighbour_list_array_l[nn];
+      const int natomj = internal::four_spin_list_jkl[3*nn + 0];
+      const int natomk = internal::four_spin_list_jkl[3*nn + 1];
+      const int natoml = internal::four_spin_list_jkl[3*nn + 2];
 
       const double sjx = atoms::x_spin_array[natomj];
       const double sjy = atoms::y_spin_array[natomj];
@@ -75,13 +76,67 @@ double single_spin_four_spin_energy(const int atom, const double sx, const doubl
       const double sk_dot_sl = dot_product2(skx,sky,skz,slx,sly,slz);
       const double sj_dot_sk = dot_product2(skx,sky,skz,sjx,sjy,sjz);
       const double sj_dot_sl = dot_product2(sjx,sjy,sjz,slx,sly,slz);
-      const double Jij = internal::four_spin_exchange_list[nn];
+      const double Dq = internal::four_spin_list_value[nn];
 
-      energy = energy - 4.0*Jij/12.0*(si_dot_sj*sk_dot_sl + si_dot_sk*sj_dot_sl + si_dot_sl*sj_dot_sk);
+      energy = energy - Dq*(si_dot_sj*sk_dot_sl + si_dot_sk*sj_dot_sl + si_dot_sl*sj_dot_sk);
 
-    }
+   }
+
+   return energy;
+
+}
+
+//-----------------------------------------------------------------------------------------
+// Function to calculate the total four spin exchange energy of the system
+//
+// Each quartet is stored four times, once for each atom at the centre, so the
+// energy is summed over the first of each group of four entries only.
+//-----------------------------------------------------------------------------------------
+double four_spin_energy(){
+
+   if (!internal::enable_fourspin) return 0.0;
+
+   double energy=0.0;
+
+   const int num_quadruplets = internal::four_spin_neighbour_list_array_i.size();
+
+   for(int q = 0; q < num_quadruplets; q += 4){
+
+      const int natomi = internal::four_spin_neighbour_list_array_i[q];
+      const int natomj = internal::four_spin_neighbour_list_array_j[q];
+      const int natomk = internal::four_spin_neighbour_list_array_k[q];
+      const int natoml = internal::four_spin_neighbour_list_array_l[q];
+
+      const double six = atoms::x_spin_array[natomi];
+      const double siy = atoms::y_spin_array[natomi];
+      const double siz = atoms::z_spin_array[natomi];
+
+      const double sjx = atoms::x_spin_array[natomj];
+      const double sjy = atoms::y_spin_array[natomj];
+      const double sjz = atoms::z_spin_array[natomj];
+
+      const double skx = atoms::x_spin_array[natomk];
+      const double sky = atoms::y_spin_array[natomk];
+      const double skz = atoms::z_spin_array[natomk];
+
+      const double slx = atoms::x_spin_array[natoml];
+      const double sly = atoms::y_spin_array[natoml];
+      const double slz = atoms::z_spin_array[natoml];
+
+      const double si_dot_sj = dot_product2(six,siy,siz,sjx,sjy,sjz);
+      const double si_dot_sk = dot_product2(six,siy,siz,skx,sky,skz);
+      const double si_dot_sl = dot_product2(six,siy,siz,slx,sly,slz);
+      const double sk_dot_sl = dot_product2(skx,sky,skz,slx,sly,slz);
+      const double sj_dot_sk = dot_product2(skx,sky,skz,sjx,sjy,sjz);
+      const double sj_dot_sl = dot_product2(sjx,sjy,sjz,slx,sly,slz);
+      const double Jij = internal::four_spin_exchange_list[q];
+
+      energy = energy - Jij/3.0*(si_dot_sj*sk_dot_sl + si_dot_sk*sj_dot_sl + si_dot_sl*sj_dot_sk);
+
+   }
+
+   return energy;
 
-    return 0;
 }
 
 } // end of namespace
@@ -20,57 +20,80 @@
 // exchange module headers
 #include "internal.hpp"
 
-double dot_product(double six, double siy, double siz, double sjx, double sjy, double sjz){
-   double dp = six*sjx + siy*sjy + siz*sjz;
-   return dp;
-}
-
 namespace exchange{
 
 namespace internal{
 
+//-----------------------------------------------------------------------------------------
+// Function to calculate four spin exchange fields for atoms between start and end index
+//
+//    H_4s^x = 1/3 Dq (Sxj (Sk . Sl) + Sxk (Sl . Sj) + Sxl (Sk . Sj))
+//
+// Quadruplets are sorted by central atom so that the field for each atom is
+// accumulated locally and written once, allowing threading over atoms.
+//-----------------------------------------------------------------------------------------
 void four_spin_exchange_fields(const int start_index, // first atom for exchange interactions to be calculated
-                               const int end_index,                                 // field vectors for atoms
-                               std::vector<double>& field_array_x,
+                               const int end_index,   // last +1 atom to be calculated
+                               const std::vector<double>& spin_array_x, // spin vectors for atoms
+                               const std::vector<double>& spin_array_y,
+                               const std::vector<double>& spin_array_z,
+                               std::vector<double>& field_array_x, // field vectors for atoms
                                std::vector<double>& field_array_y,
-                               std::vector<double>& field_array_z){ // last +1 atom to be calculated){
+                               std::vector<double>& field_array_z){
+
+   // check for interactions
+   if(four_spin_list_start.empty()) return;
+
+   const int* const jkl = four_spin_list_jkl.data();
+   const double* const dq = four_spin_list_value.data();
+
+   const double* const sx = spin_array_x.data();
+   const double* const sy = spin_array_y.data();
+   const double* const sz = spin_array_z.data();
+
+   // loop over atoms
+   #ifdef _OPENMP
+   #pragma omp parallel for schedule(static)
+   #endif
+   for(int atom = start_index; atom < end_index; ++atom){
 
-   //std::vector < int > numbers(atoms::num_atoms,0);
+      double hx = 0.0;
+      double hy = 0.0;
+      double hz = 0.0;
 
-   const int num_four_spin_neighbours = four_spin_neighbour_list_array_l.size();
+      // loop over quadruplets with atom at the centre
+      for(int nn = four_spin_list_start[atom]; nn < four_spin_list_start[atom+1]; ++nn){
 
-   // loop over all neighbours
-	for(int nn = 0; nn < num_four_spin_neighbours; ++nn){
+         const int natomj = jkl[3*nn + 0];
+         const int natomk = jkl[3*nn + 1];
+         const int natoml = jkl[3*nn + 2];
 
-      // get neighbouring atom number
-   	const int atom = four_spin_neighbour_list_array_i[nn];
-   	const int natomj = four_spin_neighbour_list_array_j[nn];
-   	const int natomk = four_spin_neighbour_list_array_k[nn];
-      const int natoml = four_spin_neighbour_list_array_l[nn];
-      //const int jmaterial = atoms::type_array[natomj];
-      const double Jij = four_spin_exchange_list[nn];
+         const double sjx = sx[natomj];
+         const double sjy = sy[natomj];
+         const double sjz = sz[natomj];
 
-      const double sjx = atoms::x_spin_array[natomj];
-      const double sjy = atoms::y_spin_array[natomj];
-      const double sjz = atoms::z_spin_array[natomj];
+         const double skx = sx[natomk];
+         const double sky = sy[natomk];
+         const double skz = sz[natomk];
 
-      const double skx = atoms::x_spin_array[natomk];
-      const double sky = atoms::y_spin_array[natomk];
-      const double skz = atoms::z_spin_array[natomk];
+         const double slx = sx[natoml];
+         const double sly = sy[natoml];
+         const double slz = sz[natoml];
 
-      const double slx = atoms::x_spin_array[natoml];
-      const double sly = atoms::y_spin_array[natoml];
-      const double slz = atoms::z_spin_array[natoml];
+         const double Dq = dq[nn];
+         const double sk_dot_sl = Dq*(skx*slx + sky*sly + skz*slz);
+         const double sj_dot_sk = Dq*(sjx*skx + sjy*sky + sjz*skz);
+         const double sj_dot_sl = Dq*(sjx*slx + sjy*sly + sjz*slz);
 
-      const double sk_dot_sl = dot_product(skx,sky,skz,slx,sly,slz);
-      const double sj_dot_sk = dot_product(skx,sky,skz,sjx,sjy,sjz);
-      const double sj_dot_sl = dot_product(sjx,sjy,sjz,slx,sly,slz);
+         hx += sjx*sk_dot_sl + skx*sj_dot_sl + slx*sj_dot_sk;
+         hy += sjy*sk_dot_sl + sky*sj_dot_sl + sly*sj_dot_sk;
+         hz += sjz*sk_dot_sl + skz*sj_dot_sl + slz*sj_dot_sk;
 
-      double athird=1.0/3.0;
+      }
 
-      field_array_x[atom] = field_array_x[atom] + (Jij*athird)*(sjx*sk_dot_sl + skx*sj_dot_sl + slx*sj_dot_sk);
-      field_array_y[atom] = field_array_y[atom] + (Jij*athird)*(sjy*sk_dot_sl + sky*sj_dot_sl + sly*sj_dot_sk);
-      field_array_z[atom] = field_array_z[atom] + (Jij*athird)*(sjz*sk_dot_sl + skz*sj_dot_sl + slz*sj_dot_sk);
+      field_array_x[atom] += hx;
+      field_array_y[atom] += hy;
+      field_array_z[atom] += hz;
 
    }
 
@@ -27,4 +27,11 @@ namespace exchange{
       return internal::exchange_type;
    }
 
+   //------------------------------------------------------------------------------
+   // Function to return if four spin exchange interactions are enabled
+   //------------------------------------------------------------------------------
+   bool is_four_spin_enabled(){
+      return internal::enable_fourspin;
+   }
+
 } // end of exchange namespace
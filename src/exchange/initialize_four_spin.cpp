@@ -59,7 +59,7 @@ namespace internal{
       std::vector <int> end_first_neigh(0);
 
       first_neigh.resize(20*atoms::num_atoms);
-      start_first_neigh.resize(atoms::num_atoms);
+      start_first_neigh.resize(atoms::num_atoms+1);
       end_first_neigh.resize(atoms::num_atoms);
 
       //to print out the four-spin interaction
@@ -197,6 +197,41 @@ namespace internal{
       ofile.close();
       std::cout<<"Four-spin quartets have been initialised"<<std::endl;
 
+      // sort quadruplets by central atom for field calculation
+      sort_four_spin_interactions();
+
+      return;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to sort four spin quadruplets by central atom i in CSR form with
+   // the j,k,l atoms packed together and the factor of 1/3 included in Dq
+   //---------------------------------------------------------------------------
+   void sort_four_spin_interactions(){
+
+      const int num_quadruplets = four_spin_neighbour_list_array_i.size();
+
+      // count quadruplets for each central atom
+      four_spin_list_start.assign(atoms::num_atoms + 1, 0);
+      for(int q = 0; q < num_quadruplets; q++) four_spin_list_start[four_spin_neighbour_list_array_i[q] + 1]++;
+      for(int atom = 0; atom < atoms::num_atoms; atom++) four_spin_list_start[atom + 1] += four_spin_list_start[atom];
+
+      // place quadruplets in order of central atom (stable)
+      std::vector<int> next(four_spin_list_start.begin(), four_spin_list_start.end() - 1);
+      four_spin_list_jkl.resize(3 * num_quadruplets);
+      four_spin_list_value.resize(num_quadruplets);
+      const double athird = 1.0/3.0;
+      for(int q = 0; q < num_quadruplets; q++){
+         const int index = next[four_spin_neighbour_list_array_i[q]]++;
+         four_spin_list_jkl[3*index + 0] = four_spin_neighbour_list_array_j[q];
+         four_spin_list_jkl[3*index + 1] = four_spin_neighbour_list_array_k[q];
+         four_spin_list_jkl[3*index + 2] = four_spin_neighbour_list_array_l[q];
+         four_spin_list_value[index] = four_spin_exchange_list[q] * athird;
+      }
+
+      zlog << zTs() << "Sorted " << num_quadruplets << " four-spin quadruplets by central atom" << std::endl;
+
       return;
 
    }
@@ -0,0 +1,232 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <cmath>
+#include <vector>
+
+// Vampire headers
+#include "atoms.hpp"
+#include "exchange.hpp"
+#include "vio.hpp"
+
+// exchange module headers
+#include "internal.hpp"
+
+namespace exchange{
+
+namespace internal{
+
+   //----------------------------------------------------------------------------
+   // Function to merge bilinear and biquadratic interactions into a single list
+   //----------------------------------------------------------------------------
+   // For each atom the union of bilinear and biquadratic neighbours is stored
+   // once, with the coefficients for all pairwise terms packed contiguously
+   // after each other:
+   //
+   //    [ J (1, 3 or 9 values) | D (3 values, optional) | 2Jbq (optional) ]
+   //
+   // Repeated neighbours (from periodic images in small systems) are summed
+   // into a single entry. Tensorial exchange whose symmetric part is diagonal
+   // (the usual result of adding DMI to isotropic or vectorial exchange) is
+   // stored as a diagonal plus the DMI vector d, with field J.S + d x S.
+   //
+   // The form is chosen from the per-type exchange constants, so that the
+   // merged list can be counted and then packed in place without an
+   // intermediate copy of the coefficients.
+   //
+   // The bilinear per-type lists are kept as they are used by the energy, GPU,
+   // micromagnetic and spin-lattice routines, and so the unified list is only
+   // built on the first field evaluation (see exchange::fields). Isotropic
+   // biquadratic interactions are only used within this module, so once merged
+   // the biquadratic energy is also evaluated from the unified list and the
+   // per-type biquadratic list is released.
+   //----------------------------------------------------------------------------
+   void initialize_unified_exchange(){
+
+      const int num_atoms = atoms::num_atoms;
+
+      // biquadratic terms can only be merged for isotropic biquadratic constants
+      const bool merge_bq = exchange::biquadratic && internal::bq_i_exchange_list.size() > 0;
+
+      //-------------------------------------------------------------------------
+      // Determine minimal form needed to represent all interactions
+      //-------------------------------------------------------------------------
+      bool anisotropic_diagonal = false; // Jxx, Jyy, Jzz differ
+      bool symmetric_off_diagonal = false; // tensor has symmetric off-diagonal part
+      bool antisymmetric = false; // tensor has antisymmetric (DMI) part
+
+      switch(internal::exchange_type){
+         case exchange::vectorial:
+            for(size_t i = 0; i < atoms::v_exchange_list.size(); i++){
+               const double* J = atoms::v_exchange_list[i].Jij;
+               if(J[0] != J[1] || J[1] != J[2]) anisotropic_diagonal = true;
+            }
+            break;
+         case exchange::tensorial:
+            for(size_t i = 0; i < atoms::t_exchange_list.size(); i++){
+               const double (&J)[3][3] = atoms::t_exchange_list[i].Jij;
+               if(J[0][0] != J[1][1] || J[1][1] != J[2][2]) anisotropic_diagonal = true;
+               if(J[0][1] + J[1][0] != 0.0 || J[0][2] + J[2][0] != 0.0 || J[1][2] + J[2][1] != 0.0) symmetric_off_diagonal = true;
+               if(J[0][1] != 0.0 || J[0][2] != 0.0 || J[1][2] != 0.0) antisymmetric = true;
+            }
+            break;
+         default:
+            break;
+      }
+
+      if(symmetric_off_diagonal){
+         unified_form = exchange::tensorial;
+         unified_dmi = false;
+      }
+      else{
+         unified_form = anisotropic_diagonal ? exchange::vectorial : exchange::isotropic;
+         unified_dmi = antisymmetric;
+      }
+      unified_biquadratic = merge_bq;
+
+      const int num_J = unified_form == exchange::isotropic ? 1 : unified_form == exchange::vectorial ? 3 : 9;
+      const int stride = num_J + (unified_dmi ? 3 : 0) + (unified_biquadratic ? 1 : 0);
+
+      //-------------------------------------------------------------------------
+      // Count merged neighbours of each atom
+      //-------------------------------------------------------------------------
+      // position of neighbour in merged list for current atom (-1 if not present)
+      std::vector<int> slot(num_atoms, -1);
+
+      unified_list_start.assign(num_atoms + 1, 0);
+
+      int num_interactions = 0;
+
+      for(int atom = 0; atom < num_atoms; atom++){
+
+         unified_list_start[atom] = num_interactions;
+
+         for(int nn = atoms::neighbour_list_start_index[atom]; nn <= atoms::neighbour_list_end_index[atom]; nn++){
+            const int natom = atoms::neighbour_list_array[nn];
+            if(slot[natom] < 0) slot[natom] = num_interactions++;
+         }
+
+         if(merge_bq){
+            for(int nn = biquadratic_neighbour_list_start_index[atom]; nn <= biquadratic_neighbour_list_end_index[atom]; nn++){
+               const int natom = biquadratic_neighbour_list_array[nn];
+               if(slot[natom] < 0) slot[natom] = num_interactions++;
+            }
+         }
+
+         // reset slots for next atom
+         for(int nn = atoms::neighbour_list_start_index[atom]; nn <= atoms::neighbour_list_end_index[atom]; nn++) slot[atoms::neighbour_list_array[nn]] = -1;
+         if(merge_bq){
+            for(int nn = biquadratic_neighbour_list_start_index[atom]; nn <= biquadratic_neighbour_list_end_index[atom]; nn++) slot[biquadratic_neighbour_list_array[nn]] = -1;
+         }
+
+      }
+
+      unified_list_start[num_atoms] = num_interactions;
+
+      //-------------------------------------------------------------------------
+      // Pack coefficients directly from per-type lists
+      //-------------------------------------------------------------------------
+      unified_list_neighbour.assign(num_interactions, 0);
+      unified_list_coefficient.assign(size_t(stride) * num_interactions, 0.0);
+
+      for(int atom = 0; atom < num_atoms; atom++){
+
+         int next = unified_list_start[atom];
+
+         // bilinear interactions
+         for(int nn = atoms::neighbour_list_start_index[atom]; nn <= atoms::neighbour_list_end_index[atom]; nn++){
+
+            const int natom = atoms::neighbour_list_array[nn];
+            const int iid = atoms::neighbour_interaction_type_array[nn];
+
+            if(slot[natom] < 0){
+               slot[natom] = next++;
+               unified_list_neighbour[slot[natom]] = natom;
+            }
+            double* c = &unified_list_coefficient[size_t(stride) * slot[natom]];
+
+            switch(internal::exchange_type){
+               case exchange::isotropic:
+                  c[0] += atoms::i_exchange_list[iid].Jij;
+                  break;
+               case exchange::vectorial:
+                  for(int v = 0; v < num_J; v++) c[v] += atoms::v_exchange_list[iid].Jij[v];
+                  break;
+               case exchange::tensorial:{
+                  const double (&J)[3][3] = atoms::t_exchange_list[iid].Jij;
+                  if(num_J == 9){
+                     for(int a = 0; a < 3; a++){
+                        for(int b = 0; b < 3; b++) c[3 * a + b] += J[a][b];
+                     }
+                  }
+                  else{
+                     for(int v = 0; v < num_J; v++) c[v] += J[v][v];
+                  }
+                  // DMI vector d from antisymmetric part, h = d x S
+                  if(unified_dmi){
+                     c[num_J + 0] -= 0.5 * (J[1][2] - J[2][1]);
+                     c[num_J + 1] += 0.5 * (J[0][2] - J[2][0]);
+                     c[num_J + 2] -= 0.5 * (J[0][1] - J[1][0]);
+                  }
+                  break;
+               }
+               default:
+                  break;
+            }
+
+         }
+
+         // biquadratic interactions
+         if(merge_bq){
+            for(int nn = biquadratic_neighbour_list_start_index[atom]; nn <= biquadratic_neighbour_list_end_index[atom]; nn++){
+
+               const int natom = biquadratic_neighbour_list_array[nn];
+
+               if(slot[natom] < 0){
+                  slot[natom] = next++;
+                  unified_list_neighbour[slot[natom]] = natom;
+               }
+               unified_list_coefficient[size_t(stride) * slot[natom] + stride - 1] += 2.0 * bq_i_exchange_list[ biquadratic_neighbour_interaction_type_array[nn] ].Jij;
+
+            }
+         }
+
+         // reset slots for next atom
+         for(int i = unified_list_start[atom]; i < next; i++) slot[unified_list_neighbour[i]] = -1;
+
+      }
+
+      unified_exchange = true;
+
+      const char* form_names[3] = {"isotropic", "vectorial", "tensorial"};
+      zlog << zTs() << "Unified exchange kernel using " << form_names[unified_form] << " form";
+      if(unified_dmi) zlog << " with DMI";
+      if(unified_biquadratic) zlog << " with biquadratic exchange";
+      zlog << " for " << num_interactions << " interactions (" << double(unified_list_coefficient.size() * sizeof(double) + unified_list_neighbour.size() * sizeof(int)) / 1.0e6 << " MB)" << std::endl;
+
+      //-------------------------------------------------------------------------
+      // Release per-type biquadratic list which is no longer read
+      //-------------------------------------------------------------------------
+      if(merge_bq){
+         std::vector<int>().swap(biquadratic_neighbour_list_array);
+         std::vector<int>().swap(biquadratic_neighbour_interaction_type_array);
+         std::vector<int>().swap(biquadratic_neighbour_list_start_index);
+         std::vector<int>().swap(biquadratic_neighbour_list_end_index);
+         std::vector<value_t>().swap(bq_i_exchange_list);
+      }
+
+      return;
+
+   }
+
+} // end of internal namespace
+
+} // end of exchange namespace
@@ -250,6 +250,18 @@ namespace exchange{
       extern std::vector <int> four_spin_neighbour_list_end_index;   // list of last four spin neighbours for atom i
       extern std::vector <double> four_spin_exchange_list;   // value of fourspin
 
+      extern std::vector <int> four_spin_list_start;      // first quadruplet for each central atom [num_atoms+1]
+      extern std::vector <int> four_spin_list_jkl;        // j,k,l atoms of each quadruplet sorted by central atom
+      extern std::vector <double> four_spin_list_value;   // Dq/3 for each quadruplet sorted by central atom
+
+      extern bool unified_exchange;                  // flag to indicate unified exchange list is initialised
+      extern exchange_t unified_form;                // form of bilinear exchange in unified list
+      extern bool unified_dmi;                       // flag to indicate DMI vectors are stored in unified list
+      extern bool unified_biquadratic;               // flag to indicate biquadratic constants are stored in unified list
+      extern std::vector <int> unified_list_start;        // first merged interaction for each atom [num_atoms+1]
+      extern std::vector <int> unified_list_neighbour;    // neighbouring atom for each merged interaction
+      extern std::vector <double> unified_list_coefficient; // packed coefficients for each merged interaction
+
       extern std::vector <exchange::internal::value_t > bq_i_exchange_list; // list of isotropic biquadratic exchange constants
       extern std::vector <exchange::internal::vector_t> bq_v_exchange_list; // list of vectorial biquadratic exchange constants
       extern std::vector <exchange::internal::tensor_t> bq_t_exchange_list; // list of tensorial biquadratic exchange constants
@@ -298,12 +310,25 @@ namespace exchange{
 
       void four_spin_exchange_fields(const int start_index, // first atom for exchange interactions to be calculated
                                      const int end_index, // last +1 atom to be calculated
+                                     const std::vector<double>& spin_array_x, // spin vectors for atoms
+                                     const std::vector<double>& spin_array_y,
+                                     const std::vector<double>& spin_array_z,
                                      std::vector<double>& field_array_x, // field vectors for atoms
                                      std::vector<double>& field_array_y,
                                      std::vector<double>& field_array_z);
 
       void initialize_biquadratic_exchange();
       void initialize_four_spin_exchange(std::vector<std::vector <neighbours::neighbour_t> >& cneighbourlist);
+      void sort_four_spin_interactions();
+      void initialize_unified_exchange();
+      void unified_exchange_fields(const int start_index, // first atom for exchange interactions to be calculated
+                                   const int end_index, // last +1 atom to be calculated
+                                   const std::vector<double>& spin_array_x, // spin vectors for atoms
+                                   const std::vector<double>& spin_array_y,
+                                   const std::vector<double>& spin_array_z,
+                                   std::vector<double>& field_array_x, // field vectors for atoms
+                                   std::vector<double>& field_array_y,
+                                   std::vector<double>& field_array_z);
 
    } // end of internal namespace
 
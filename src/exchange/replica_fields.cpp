@@ -0,0 +1,122 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <algorithm>
+
+// Vampire headers
+#include "atoms.hpp" // for exchange list type defs
+#include "exchange.hpp"
+
+// exchange module headers
+#include "internal.hpp"
+
+namespace exchange{
+
+   //---------------------------------------------------------------------------
+   // Function to calculate the exchange field on a single atom for a batch of
+   // replicas sharing the same neighbour list. Spins are stored replica
+   // interleaved as spin_array[(3*atom + component)*num_replicas + replica],
+   // so that each neighbour index and exchange constant is loaded once and the
+   // inner loop over replicas is contiguous and vectorisable. Fields are
+   // returned as field_array[component*num_replicas + replica] and satisfy
+   // E_exchange = -h.S as for single_spin_energy().
+   //---------------------------------------------------------------------------
+   void replica_fields(const int atom,                         // atom to calculate fields for
+                       const int num_replicas,                 // number of interleaved replicas
+                       const std::vector<double>& spin_array,  // replica interleaved spins
+                       std::vector<double>& field_array){      // exchange field for each replica
+
+      replica_fields(atom, num_replicas, 0, num_replicas, spin_array, field_array);
+
+      return;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to calculate the exchange field on a single atom for replicas
+   // first_replica to last_replica-1 of a batch, so that threads can each
+   // gather the fields of their own block of replicas. Fields of other
+   // replicas in field_array are left unchanged.
+   //---------------------------------------------------------------------------
+   void replica_fields(const int atom,                         // atom to calculate fields for
+                       const int num_replicas,                 // number of interleaved replicas
+                       const int first_replica,                // first replica of block
+                       const int last_replica,                 // last replica of block (exclusive)
+                       const std::vector<double>& spin_array,  // replica interleaved spins
+                       std::vector<double>& field_array){      // exchange field for each replica
+
+      const int R = num_replicas;
+      const int r0 = first_replica;
+      const int r1 = last_replica;
+
+      for(int c = 0; c < 3; ++c) std::fill(field_array.begin() + c*R + r0, field_array.begin() + c*R + r1, 0.0);
+
+      double* __restrict hx = field_array.data();
+      double* __restrict hy = hx + R;
+      double* __restrict hz = hy + R;
+
+      const int start = atoms::neighbour_list_start_index[atom];
+      const int end   = atoms::neighbour_list_end_index[atom];
+
+      // select calculation based on exchange type
+      switch(internal::exchange_type){
+
+         case exchange::isotropic:
+            for(int nn = start; nn <= end; ++nn){
+               const int natom = atoms::neighbour_list_array[nn];
+               const double Jij = atoms::i_exchange_list[atoms::neighbour_interaction_type_array[nn]].Jij;
+               const double* __restrict s = &spin_array[3*R*natom];
+               for(int r = r0; r < r1; ++r){
+                  hx[r] += Jij * s[r];
+                  hy[r] += Jij * s[R+r];
+                  hz[r] += Jij * s[2*R+r];
+               }
+            }
+            break;
+
+         case exchange::vectorial:
+            for(int nn = start; nn <= end; ++nn){
+               const int natom = atoms::neighbour_list_array[nn];
+               const zvec_t& J = atoms::v_exchange_list[atoms::neighbour_interaction_type_array[nn]];
+               const double Jij[3] = {J.Jij[0], J.Jij[1], J.Jij[2]};
+               const double* __restrict s = &spin_array[3*R*natom];
+               for(int r = r0; r < r1; ++r){
+                  hx[r] += Jij[0] * s[r];
+                  hy[r] += Jij[1] * s[R+r];
+                  hz[r] += Jij[2] * s[2*R+r];
+               }
+            }
+            break;
+
+         case exchange::tensorial:
+            for(int nn = start; nn <= end; ++nn){
+               const int natom = atoms::neighbour_list_array[nn];
+               const zten_t& J = atoms::t_exchange_list[atoms::neighbour_interaction_type_array[nn]];
+               const double Jij[3][3] = {{J.Jij[0][0], J.Jij[0][1], J.Jij[0][2]},
+                                         {J.Jij[1][0], J.Jij[1][1], J.Jij[1][2]},
+                                         {J.Jij[2][0], J.Jij[2][1], J.Jij[2][2]}};
+               const double* __restrict s = &spin_array[3*R*natom];
+               for(int r = r0; r < r1; ++r){
+                  const double S[3] = {s[r], s[R+r], s[2*R+r]};
+                  hx[r] += Jij[0][0] * S[0] + Jij[0][1] * S[1] + Jij[0][2] * S[2];
+                  hy[r] += Jij[1][0] * S[0] + Jij[1][1] * S[1] + Jij[1][2] * S[2];
+                  hz[r] += Jij[2][0] * S[0] + Jij[2][1] * S[1] + Jij[2][2] * S[2];
+               }
+            }
+            break;
+
+      }
+
+      return;
+
+   }
+
+} // end of exchange namespace
@@ -0,0 +1,170 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <iostream>
+#include <vector>
+
+// Vampire headers
+#include "errors.hpp"
+#include "exchange.hpp"
+#include "vio.hpp"
+
+// exchange module headers
+#include "internal.hpp"
+
+namespace exchange{
+
+namespace internal{
+
+   //-----------------------------------------------------------------------------
+   // Unified exchange field kernel for all pairwise interactions
+   //-----------------------------------------------------------------------------
+   // Each neighbour spin is loaded once and all pairwise terms evaluated
+   //
+   //    H = J Sj + d x Sj + 2 Jbq Sj (Si . Sj)
+   //
+   // with the form of J (isotropic, vectorial, tensorial) and presence of DMI
+   // and biquadratic terms fixed at compile time.
+   //-----------------------------------------------------------------------------
+   template <int form, bool dmi, bool biquadratic>
+   void unified_kernel(const int start_index, // first atom for exchange interactions to be calculated
+                       const int end_index, // last +1 atom to be calculated
+                       const double* spin_array_x, // spin vectors for atoms
+                       const double* spin_array_y,
+                       const double* spin_array_z,
+                       double* field_array_x, // field vectors for atoms
+                       double* field_array_y,
+                       double* field_array_z){
+
+      const int num_J = form == exchange::isotropic ? 1 : form == exchange::vectorial ? 3 : 9;
+      const int stride = num_J + (dmi ? 3 : 0) + (biquadratic ? 1 : 0);
+
+      const int* list_start = unified_list_start.data();
+      const int* list_neighbour = unified_list_neighbour.data();
+      const double* coefficient = unified_list_coefficient.data();
+
+      #ifdef _OPENMP
+      #pragma omp parallel for schedule(static)
+      #endif
+      for(int atom = start_index; atom < end_index; ++atom){
+
+         // temporary variables (registers) to calculate intermediate sum
+         double hx = 0.0;
+         double hy = 0.0;
+         double hz = 0.0;
+
+         const double six = spin_array_x[atom];
+         const double siy = spin_array_y[atom];
+         const double siz = spin_array_z[atom];
+
+         const int end = list_start[atom+1];
+
+         // loop over all neighbours
+         for(int nn = list_start[atom]; nn < end; ++nn){
+
+            const int natom = list_neighbour[nn]; // get neighbouring atom number
+            const double* c = coefficient + size_t(stride) * nn; // coefficients for this pair
+
+            const double sjx = spin_array_x[natom];
+            const double sjy = spin_array_y[natom];
+            const double sjz = spin_array_z[natom];
+
+            if(form == exchange::isotropic){
+               hx += c[0] * sjx;
+               hy += c[0] * sjy;
+               hz += c[0] * sjz;
+            }
+            else if(form == exchange::vectorial){
+               hx += c[0] * sjx;
+               hy += c[1] * sjy;
+               hz += c[2] * sjz;
+            }
+            else{
+               hx += c[0] * sjx + c[1] * sjy + c[2] * sjz;
+               hy += c[3] * sjx + c[4] * sjy + c[5] * sjz;
+               hz += c[6] * sjx + c[7] * sjy + c[8] * sjz;
+            }
+
+            if(dmi){
+               const double* d = c + num_J;
+               hx += d[1] * sjz - d[2] * sjy;
+               hy += d[2] * sjx - d[0] * sjz;
+               hz += d[0] * sjy - d[1] * sjx;
+            }
+
+            if(biquadratic){
+               const double bq = c[stride - 1] * (six * sjx + siy * sjy + siz * sjz);
+               hx += bq * sjx;
+               hy += bq * sjy;
+               hz += bq * sjz;
+            }
+
+         }
+
+         field_array_x[atom] += hx; // save total field to field array
+         field_array_y[atom] += hy;
+         field_array_z[atom] += hz;
+
+      }
+
+      return;
+
+   }
+
+   //-----------------------------------------------------------------------------
+   // Function to select kernel specialisation for the unified exchange list
+   //-----------------------------------------------------------------------------
+   void unified_exchange_fields(const int start_index, // first atom for exchange interactions to be calculated
+                                const int end_index, // last +1 atom to be calculated
+                                const std::vector<double>& spin_array_x, // spin vectors for atoms
+                                const std::vector<double>& spin_array_y,
+                                const std::vector<double>& spin_array_z,
+                                std::vector<double>& field_array_x, // field vectors for atoms
+                                std::vector<double>& field_array_y,
+                                std::vector<double>& field_array_z){
+
+      const double* sx = spin_array_x.data();
+      const double* sy = spin_array_y.data();
+      const double* sz = spin_array_z.data();
+      double* hx = field_array_x.data();
+      double* hy = field_array_y.data();
+      double* hz = field_array_z.data();
+
+      // index kernels as form*4 + dmi*2 + biquadratic
+      const int kernel = 4 * unified_form + 2 * unified_dmi + unified_biquadratic;
+
+      switch(kernel){
+         case 0:  unified_kernel<exchange::isotropic, false, false>(start_index, end_index, sx, sy, sz, hx, hy, hz); break;
+         case 1:  unified_kernel<exchange::isotropic, false, true >(start_index, end_index, sx, sy, sz, hx, hy, hz); break;
+         case 2:  unified_kernel<exchange::isotropic, true,  false>(start_index, end_index, sx, sy, sz, hx, hy, hz); break;
+         case 3:  unified_kernel<exchange::isotropic, true,  true >(start_index, end_index, sx, sy, sz, hx, hy, hz); break;
+         case 4:  unified_kernel<exchange::vectorial, false, false>(start_index, end_index, sx, sy, sz, hx, hy, hz); break;
+         case 5:  unified_kernel<exchange::vectorial, false, true >(start_index, end_index, sx, sy, sz, hx, hy, hz); break;
+         case 6:  unified_kernel<exchange::vectorial, true,  false>(start_index, end_index, sx, sy, sz, hx, hy, hz); break;
+         case 7:  unified_kernel<exchange::vectorial, true,  true >(start_index, end_index, sx, sy, sz, hx, hy, hz); break;
+         // full tensors already contain any antisymmetric (DMI) part
+         case 8:  unified_kernel<exchange::tensorial, false, false>(start_index, end_index, sx, sy, sz, hx, hy, hz); break;
+         case 9:  unified_kernel<exchange::tensorial, false, true >(start_index, end_index, sx, sy, sz, hx, hy, hz); break;
+         default:
+            terminaltextcolor(RED);
+            std::cerr << "Programmer Error - unknown unified exchange kernel " << kernel << " in exchange field calculation. Exiting." << std::endl;
+            terminaltextcolor(WHITE);
+            zlog << zTs() << "Programmer Error - unknown unified exchange kernel " << kernel << " in exchange field calculation. Exiting." << std::endl;
+            err::vexit();
+      }
+
+      return;
+
+   }
+
+} // end of internal namespace
+
+} // end of exchange namespace
@@ -69,5 +69,20 @@ namespace hamr{
       std::vector<double> atom_coords_y;
       std::vector<double> atom_coords_z;
 
+      const double profile_cutoff = 1.0e-12; // smallest Gaussian factor evaluated for heating
+      std::vector<double> profile_grid_x; // sorted distinct atomic x coordinates
+      std::vector<double> profile_grid_y; // sorted distinct atomic y coordinates
+      std::vector<int> atom_profile_index_x; // index of atom x coordinate in grid
+      std::vector<int> atom_profile_index_y; // index of atom y coordinate in grid
+      std::vector<double> profile_x; // Gaussian factor for each grid coordinate
+      std::vector<double> profile_y;
+      int profile_window_x[2] = {0, 0}; // range of grid points with non-zero factor
+      int profile_window_y[2] = {0, 0};
+      double profile_position_y = -1.0e300; // head position for current y factors
+      std::vector<double> cold_sigma_prefactor; // thermal field prefactor at Tmin for each material
+      double cold_sigma_temperature = -1.0; // temperature of cached cold prefactors
+      std::vector<double> sigma_prefactor; // thermal field prefactor at global temperature
+      double sigma_temperature = -1.0; // temperature of cached global prefactors
+
    } // end of internal namespace
 } // end of hamr namespace
@@ -62,21 +62,9 @@ namespace hamr{
 		}
 		// Otherwise just use global temperature
 		else{
-			// unroll sigma for speed
-			std::vector<double> sigma_prefactor(0);
-			sigma_prefactor.reserve(mp::material.size());
-
-			// Calculate material temperature (with optional rescaling)
-			for(unsigned int mat=0;mat<mp::material.size();mat++){
-
-			   // Calculate temperature rescaling
-			   double alpha = mp::material[mat].temperature_rescaling_alpha;
-			   double Tc = mp::material[mat].temperature_rescaling_Tc;
-			   // if T<Tc T/Tc = (T/Tc)^alpha else T = T
-			   double rescaled_temperature = temperature < Tc ? Tc*pow(temperature/Tc,alpha) : temperature;
-			   double sqrt_T=sqrt(rescaled_temperature);
-			   sigma_prefactor.push_back(sqrt_T*mp::material[mat].H_th_sigma);
-			}
+			// Calculate material temperature (with optional rescaling) if changed
+			hamr::internal::update_sigma_prefactor(temperature, hamr::internal::sigma_prefactor, hamr::internal::sigma_temperature);
+			const std::vector<double>& sigma_prefactor = hamr::internal::sigma_prefactor;
 
 			for(int atom=start_index;atom<end_index;atom++){
 
@@ -85,6 +85,9 @@ namespace hamr{
       hamr::internal::laser_sigma_x = hamr::internal::fwhm_x * one_over_sqrt;
       hamr::internal::laser_sigma_y = hamr::internal::fwhm_y * one_over_sqrt;
 
+      // Index atoms on coordinate grid for separable temperature profile
+      hamr::internal::initialize_temperature_profile();
+
       // Calculate max number of allowed tracks and bits-per-track in the system
       hamr::internal::num_tracks = int(floor((hamr::internal::system_dimensions_y - 1.0 - 2.0*hamr::internal::track_padding)/(hamr::internal::track_size)));
       hamr::internal::bits_per_track = int(floor((hamr::internal::system_dimensions_x - 1.0)/hamr::internal::bit_size));
@@ -35,6 +35,12 @@ namespace hamr{
 
       void apply_temperature_profile(const int start_index, const int end_index, const double Tmin, const double DeltaT);
 
+      //-----------------------------------------------------------------------------
+      // Functions for cached temperature profile and thermal field prefactors
+      //-----------------------------------------------------------------------------
+      void initialize_temperature_profile();
+      void update_sigma_prefactor(const double temperature, std::vector<double>& prefactor, double& cached_temperature);
+
       //-----------------------------------------------------------------------------
       // Function to calculate the external field with trapezoidal temporal profile
       //-----------------------------------------------------------------------------
@@ -108,6 +114,21 @@ namespace hamr{
       extern std::vector<double> y_field_array;
       extern std::vector<double> z_field_array;
 
+      extern const double profile_cutoff; /// smallest Gaussian factor evaluated for heating
+      extern std::vector<double> profile_grid_x; /// sorted distinct atomic x coordinates
+      extern std::vector<double> profile_grid_y; /// sorted distinct atomic y coordinates
+      extern std::vector<int> atom_profile_index_x; /// index of atom x coordinate in grid
+      extern std::vector<int> atom_profile_index_y; /// index of atom y coordinate in grid
+      extern std::vector<double> profile_x; /// Gaussian factor for each grid coordinate
+      extern std::vector<double> profile_y;
+      extern int profile_window_x[2]; /// range of grid points with non-zero factor
+      extern int profile_window_y[2];
+      extern double profile_position_y; /// head position for current y factors
+      extern std::vector<double> cold_sigma_prefactor; /// thermal field prefactor at Tmin for each material
+      extern double cold_sigma_temperature; /// temperature of cached cold prefactors
+      extern std::vector<double> sigma_prefactor; /// thermal field prefactor at global temperature
+      extern double sigma_temperature; /// temperature of cached global prefactors
+
    } // end of internal namespace
 } // end of hamr namespace
 
@@ -10,12 +10,15 @@
 //-----------------------------------------------------------------------------
 
 // C++ standard library headers
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 // #include "math.h"
 
 // Vampire headers
 #include "hamr.hpp"
 #include "material.hpp"
+#include "vio.hpp"
 #include "vmpi.hpp"
 
 // hamr headers
@@ -55,6 +58,97 @@ namespace hamr{
       }
 
 
+      //-----------------------------------------------------------------------------
+      // Function to index atoms on the grid of distinct x and y coordinates
+      //-----------------------------------------------------------------------------
+      // The Gaussian profile is separable, and for crystalline systems atoms
+      // lie on a small number of distinct x and y coordinates, so the x and y
+      // factors need only be evaluated once per grid point rather than per atom.
+      //-----------------------------------------------------------------------------
+      void initialize_temperature_profile(){
+
+         const int num_atoms = hamr::internal::atom_coords_x.size();
+
+         // determine sorted list of unique coordinates and index of each atom in list
+         std::vector<double>* coords[2] = { &hamr::internal::atom_coords_x, &hamr::internal::atom_coords_y };
+         std::vector<double>* grids[2]  = { &hamr::internal::profile_grid_x, &hamr::internal::profile_grid_y };
+         std::vector<int>* indices[2]   = { &hamr::internal::atom_profile_index_x, &hamr::internal::atom_profile_index_y };
+
+         for(int d = 0; d < 2; d++){
+            std::vector<double>& grid = *grids[d];
+            grid = *coords[d];
+            std::sort(grid.begin(), grid.end());
+            grid.erase(std::unique(grid.begin(), grid.end()), grid.end());
+
+            std::vector<int>& index = *indices[d];
+            index.resize(num_atoms);
+            for(int atom = 0; atom < num_atoms; atom++){
+               index[atom] = std::lower_bound(grid.begin(), grid.end(), (*coords[d])[atom]) - grid.begin();
+            }
+         }
+
+         hamr::internal::profile_x.assign(hamr::internal::profile_grid_x.size(), 0.0);
+         hamr::internal::profile_y.assign(hamr::internal::profile_grid_y.size(), 0.0);
+
+         zlog << zTs() << "HAMR temperature profile evaluated on " << hamr::internal::profile_grid_x.size() << " x " << hamr::internal::profile_grid_y.size() << " coordinate grid" << std::endl;
+
+         return;
+
+      }
+
+      //-----------------------------------------------------------------------------
+      // Function to evaluate 1D Gaussian factors within window around head
+      //-----------------------------------------------------------------------------
+      // Factors smaller than the cutoff (beyond ~7.4 sigma from the head) are set
+      // to zero, so that only grid points within a moving window are evaluated
+      // and the heating outside the window is treated as exactly Tmin.
+      //-----------------------------------------------------------------------------
+      void update_gaussian_window(const std::vector<double>& grid,
+                                  std::vector<double>& profile,
+                                  int& window_start,
+                                  int& window_end,
+                                  const double position,
+                                  const double sigma){
+
+         const double one_over_den = 1.0/(2.0 * sigma * sigma);
+         const double range = sigma * sqrt(-2.0 * log(hamr::internal::profile_cutoff));
+
+         // clear previous window
+         for(int i = window_start; i < window_end; i++) profile[i] = 0.0;
+
+         window_start = std::lower_bound(grid.begin(), grid.end(), position - range) - grid.begin();
+         window_end   = std::upper_bound(grid.begin(), grid.end(), position + range) - grid.begin();
+
+         for(int i = window_start; i < window_end; i++){
+            const double dx = grid[i] - position;
+            profile[i] = exp(-dx * dx * one_over_den);
+         }
+
+         return;
+
+      }
+
+      //-----------------------------------------------------------------------------
+      // Function to calculate per-material thermal field prefactor for temperature
+      //-----------------------------------------------------------------------------
+      void update_sigma_prefactor(const double temperature, std::vector<double>& prefactor, double& cached_temperature){
+
+         if(temperature == cached_temperature && prefactor.size() == mp::material.size()) return;
+         cached_temperature = temperature;
+
+         prefactor.resize(mp::material.size());
+         for(unsigned int mat = 0; mat < mp::material.size(); mat++){
+            const double alpha = mp::material[mat].temperature_rescaling_alpha;
+            const double Tc = mp::material[mat].temperature_rescaling_Tc;
+            // if T<Tc T/Tc = (T/Tc)^alpha else T = T
+            const double rescaled_temperature = temperature < Tc ? Tc*pow(temperature/Tc,alpha) : temperature;
+            prefactor[mat] = sqrt(rescaled_temperature)*mp::material[mat].H_th_sigma;
+         }
+
+         return;
+
+      }
+
 		/* ------------------------------------------------------------------  /
 		/  Continuous HAMR process                                             /
 		/  T(x,y,t) = (Tmax-Tmin)* exp( -(x-v*t)*(x-v*t)/(2*sigmax*sigmax) )   /
@@ -65,37 +159,49 @@ namespace hamr{
 		/ ------------------------------------------------------------------- */
       void apply_temperature_profile(const int start_index, const int end_index, const double Tmin, const double DeltaT)
 		{
-			// Define constants
-			const double laser_sigma_x2 = hamr::internal::laser_sigma_x * hamr::internal::laser_sigma_x;
-			const double laser_sigma_y2 = hamr::internal::laser_sigma_y * hamr::internal::laser_sigma_y;
-			const double px = hamr::internal::head_position_x;
-			const double py = hamr::internal::head_position_y;
-			const double denx = 2.0 * laser_sigma_x2;
-			const double one_over_denx = 1.0/denx;
-			const double deny = 2.0 * laser_sigma_y2;
-			const double one_over_deny = 1.0/deny;
+
+			// Update separable Gaussian factors for current head position
+			update_gaussian_window(hamr::internal::profile_grid_x, hamr::internal::profile_x,
+			                       hamr::internal::profile_window_x[0], hamr::internal::profile_window_x[1],
+			                       hamr::internal::head_position_x, hamr::internal::laser_sigma_x);
+			if(hamr::internal::head_position_y != hamr::internal::profile_position_y){
+				update_gaussian_window(hamr::internal::profile_grid_y, hamr::internal::profile_y,
+				                       hamr::internal::profile_window_y[0], hamr::internal::profile_window_y[1],
+				                       hamr::internal::head_position_y, hamr::internal::laser_sigma_y);
+				hamr::internal::profile_position_y = hamr::internal::head_position_y;
+			}
+
+			// Thermal field prefactors for atoms outside heated region
+			update_sigma_prefactor(Tmin, hamr::internal::cold_sigma_prefactor, hamr::internal::cold_sigma_temperature);
+
+			const double* profile_x = hamr::internal::profile_x.data();
+			const double* profile_y = hamr::internal::profile_y.data();
+			const int* index_x = hamr::internal::atom_profile_index_x.data();
+			const int* index_y = hamr::internal::atom_profile_index_y.data();
+			const double* cold_prefactor = hamr::internal::cold_sigma_prefactor.data();
 
 			for(int atom=start_index;atom<end_index;atom++){
 
 				const int imaterial=hamr::internal::atom_type_array[atom];
-				double alpha = mp::material[imaterial].temperature_rescaling_alpha;
-				double Tc = mp::material[imaterial].temperature_rescaling_Tc;
 
-				const double cx = hamr::internal::atom_coords_x[atom];
-				const double cy = hamr::internal::atom_coords_y[atom];
-				const double cx2 = (cx-px)*(cx-px);
-				const double cy2 = (cy-py)*(cy-py);
+				const double exp_x = profile_x[index_x[atom]];
+				const double exp_y = profile_y[index_y[atom]];
+
+				double H_th_sigma = cold_prefactor[imaterial];
+
+				// Get local temperature field from application of heat profile within window
+				if(exp_x != 0.0 && exp_y != 0.0){
+
+					const double alpha = mp::material[imaterial].temperature_rescaling_alpha;
+					const double Tc = mp::material[imaterial].temperature_rescaling_Tc;
 
-				// Get local temperature filed from application of heat profile
-				const double exp_x =  exp(-cx2 * one_over_denx);
-				const double exp_y =  exp(-cy2 * one_over_deny);
-				const double temp = Tmin + DeltaT * exp_x * exp_y;
+					const double temp = Tmin + DeltaT * exp_x * exp_y;
 
-				// if T<Tc T/Tc = (T/Tc)^alpha else T = T
-				double rescaled_temperature = temp < Tc ? Tc*pow(temp/Tc,alpha) : temp;
-				const double sqrt_T=sqrt(rescaled_temperature);
+					// if T<Tc T/Tc = (T/Tc)^alpha else T = T
+					const double rescaled_temperature = temp < Tc ? Tc*pow(temp/Tc,alpha) : temp;
+					H_th_sigma = sqrt(rescaled_temperature)*mp::material[imaterial].H_th_sigma;
 
-				const double H_th_sigma = sqrt_T*mp::material[imaterial].H_th_sigma;
+				}
 
 				hamr::internal::x_field_array[atom] *= H_th_sigma;
 				hamr::internal::y_field_array[atom] *= H_th_sigma;
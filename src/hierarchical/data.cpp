@@ -31,6 +31,8 @@ namespace hierarchical{
       // Shared variables inside hierarchical module
       //------------------------------------------------------------------------
 
+      method_t method = tree; // method for far-field interactions
+
       int num_levels; // number of levels for hierarchical expansion
 
       //create arrays for data storage
@@ -52,6 +54,23 @@ namespace hierarchical{
 
       double av_cell_size;                               // weighted average of cell_size_x, cell_size_y, cell_size_z
 
+      std::vector < int > level_num_cells_x;             // number of cells in each level in x,y,z
+      std::vector < int > level_num_cells_y;
+      std::vector < int > level_num_cells_z;
+
+      //------------------------------------------------------------------------
+      // fast multipole method data
+      //------------------------------------------------------------------------
+      std::vector < int > cell_level;                    // level of each hierarchical cell
+      std::vector < int > cell_parent;                   // parent cell of each hierarchical cell (-1 at top level)
+      std::vector < double > multipole_q;                // first moments Q_ij = sum d_i m_j of each cell (9N)
+      std::vector < int > fmm_target_cells;              // cells needing a local expansion on this processor
+      std::vector < int > fmm_target_parent;             // index of parent in target list
+      std::vector < int > fmm_m2l_start_index;           // index of first source cell in m2l list for each target
+      std::vector < int > fmm_m2l_list;                  // list of well separated source cells
+      std::vector < int > fmm_leaf_target;               // index of target for each local cell
+      std::vector < double > fmm_local_expansion;        // field and field gradient for each target (12N)
+
       std::vector<double> mag_array_x;       // arrays to store cell magnetisation
       std::vector<double> mag_array_y;
       std::vector<double> mag_array_z;
@@ -0,0 +1,437 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+// Vampire headers
+#include "atoms.hpp"
+#include "cells.hpp"
+#include "hierarchical.hpp"
+#include "micromagnetic.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+// hierarchical module headers
+#include "internal.hpp"
+
+// alias internal hierarchical namespace for brevity
+namespace ha = hierarchical::internal;
+
+//------------------------------------------------------------------------------
+// Fast multipole method for the hierarchical dipole solver
+//------------------------------------------------------------------------------
+//
+// The hierarchical cells form an octree where level 0 cells are the dipole
+// macrocells and each level doubles the cell size. Each cell carries a
+// multipole expansion about its geometric centre truncated at first order:
+//
+//    M_j    = sum m_j           (total moment)
+//    Q_ij   = sum d_i m_j       (first moment, d = r - centre)
+//
+// and each target cell a local expansion of the field about its centre:
+//
+//    H_j    (field)
+//    G_ij = dH_j/dr_i (field gradient)
+//
+// The upward pass (P2M, M2M) is distributed over processors by their local
+// atoms and reduced once at the zero level. The downward pass (M2L, L2L) is
+// evaluated only for the ancestors of local cells, so the far field cost on
+// each processor is O(N_local) with no further communication. Adjacent zero
+// level cells are computed with the explicit (atomistic) near field tensors.
+//
+// Truncation error: for a source cell of radius a_s and a target cell of
+// radius a_t separated by R, the first order expansions neglect terms of
+// relative size rho^2 with rho = (a_s + a_t)/R. Cells in the m2l lists are at
+// least two cell widths apart (rho <= sqrt(3)/2), so the error is dominated by
+// the closest well separated cells and is around 1% rms of the macrocell field
+// compared to the tensor solver (test/integration dipole/fast-multipole).
+//
+//------------------------------------------------------------------------------
+
+namespace hierarchical{
+namespace internal{
+
+//------------------------------------------------------------------------------
+// Function to compute 1D cell ID in level from 3D coordinates
+//------------------------------------------------------------------------------
+inline int level_cell_id(const int level, const int i, const int j, const int k){
+   return ha::cells_level_start_index[level] + (i*ha::level_num_cells_y[level] + j)*ha::level_num_cells_z[level] + k;
+}
+
+//------------------------------------------------------------------------------
+// Function to unpack 3D coordinates of a cell within its level
+//------------------------------------------------------------------------------
+inline void level_cell_coords(const int cell, int& i, int& j, int& k){
+   const int level = ha::cell_level[cell];
+   const int ncy = ha::level_num_cells_y[level];
+   const int ncz = ha::level_num_cells_z[level];
+   const int id = cell - ha::cells_level_start_index[level];
+   i = id / (ncy*ncz);
+   j = (id / ncz) % ncy;
+   k = id % ncz;
+   return;
+}
+
+//------------------------------------------------------------------------------
+// Function to determine if two cells in the same level are adjacent
+//------------------------------------------------------------------------------
+inline bool adjacent(const int cell_a, const int cell_b){
+   int ia, ja, ka, ib, jb, kb;
+   level_cell_coords(cell_a, ia, ja, ka);
+   level_cell_coords(cell_b, ib, jb, kb);
+   return std::abs(ia-ib) <= 1 && std::abs(ja-jb) <= 1 && std::abs(ka-kb) <= 1;
+}
+
+//------------------------------------------------------------------------------
+// Function to initialise tree connectivity and m2l interaction lists
+//------------------------------------------------------------------------------
+void initialize_fmm(const std::vector<int>& global_atoms_in_cell_count){
+
+   //---------------------------------------------------------------------------
+   // determine level and parent of each cell from the cells in cells list
+   //---------------------------------------------------------------------------
+   ha::cell_level.assign(ha::total_num_cells, 0);
+   ha::cell_parent.assign(ha::total_num_cells, -1);
+
+   for (int level = 0; level < ha::num_levels; level++){
+      for (int cell = ha::cells_level_start_index[level]; cell < ha::cells_level_end_index[level]; cell++){
+         ha::cell_level[cell] = level;
+         if(level == 0) continue;
+         for (int idx = ha::cells_in_cells_start_index[cell]; idx < ha::cells_in_cells_end_index[cell]; idx++){
+            ha::cell_parent[ha::cells_in_cells[idx]] = cell;
+         }
+      }
+   }
+
+   //---------------------------------------------------------------------------
+   // determine which cells contain atoms at any level (sources)
+   //---------------------------------------------------------------------------
+   std::vector<bool> occupied(ha::total_num_cells, false);
+   for (int cell = 0; cell < ha::num_zero_level_cells; cell++){
+      if(global_atoms_in_cell_count[cell] > 0){
+         int c = cell;
+         while(c >= 0 && !occupied[c]){
+            occupied[c] = true;
+            c = ha::cell_parent[c];
+         }
+      }
+   }
+
+   //---------------------------------------------------------------------------
+   // determine target cells as all ancestors of local cells (locally
+   // essential tree), ordered from the top level downwards so parents are
+   // always evaluated before their children
+   //---------------------------------------------------------------------------
+   std::vector<int> target_index(ha::total_num_cells, -1);
+   std::vector<bool> needed(ha::total_num_cells, false);
+   for (int lc = 0; lc < cells::num_local_cells; lc++){
+      int c = cells::cell_id_array[lc];
+      while(c >= 0 && !needed[c]){
+         needed[c] = true;
+         c = ha::cell_parent[c];
+      }
+   }
+
+   ha::fmm_target_cells.clear();
+   ha::fmm_target_parent.clear();
+   for (int level = ha::num_levels - 1; level >= 0; level--){
+      for (int cell = ha::cells_level_start_index[level]; cell < ha::cells_level_end_index[level]; cell++){
+         if(!needed[cell]) continue;
+         target_index[cell] = ha::fmm_target_cells.size();
+         ha::fmm_target_cells.push_back(cell);
+         const int parent = ha::cell_parent[cell];
+         ha::fmm_target_parent.push_back( parent >= 0 ? target_index[parent] : -1 );
+      }
+   }
+
+   //---------------------------------------------------------------------------
+   // construct m2l lists: children of the neighbours of the parent which are
+   // not adjacent to the target. At the top level all non-adjacent cells
+   // interact directly.
+   //---------------------------------------------------------------------------
+   const int num_targets = ha::fmm_target_cells.size();
+   ha::fmm_m2l_start_index.assign(num_targets + 1, 0);
+   ha::fmm_m2l_list.clear();
+
+   for (int t = 0; t < num_targets; t++){
+
+      ha::fmm_m2l_start_index[t] = ha::fmm_m2l_list.size();
+
+      const int cell = ha::fmm_target_cells[t];
+      const int level = ha::cell_level[cell];
+      const int parent = ha::cell_parent[cell];
+
+      // top level cell - interact with all well separated cells in level
+      if(parent < 0){
+         for (int source = ha::cells_level_start_index[level]; source < ha::cells_level_end_index[level]; source++){
+            if(occupied[source] && !adjacent(cell, source)) ha::fmm_m2l_list.push_back(source);
+         }
+         continue;
+      }
+
+      // loop over neighbours of parent cell (including parent)
+      int pi, pj, pk;
+      level_cell_coords(parent, pi, pj, pk);
+      for (int ni = pi-1; ni <= pi+1; ni++){
+         if(ni < 0 || ni >= ha::level_num_cells_x[level+1]) continue;
+         for (int nj = pj-1; nj <= pj+1; nj++){
+            if(nj < 0 || nj >= ha::level_num_cells_y[level+1]) continue;
+            for (int nk = pk-1; nk <= pk+1; nk++){
+               if(nk < 0 || nk >= ha::level_num_cells_z[level+1]) continue;
+               const int neighbour = level_cell_id(level+1, ni, nj, nk);
+               if(!occupied[neighbour]) continue;
+               // add non-adjacent children of neighbour
+               for (int idx = ha::cells_in_cells_start_index[neighbour]; idx < ha::cells_in_cells_end_index[neighbour]; idx++){
+                  const int source = ha::cells_in_cells[idx];
+                  if(occupied[source] && !adjacent(cell, source)) ha::fmm_m2l_list.push_back(source);
+               }
+            }
+         }
+      }
+
+   }
+   ha::fmm_m2l_start_index[num_targets] = ha::fmm_m2l_list.size();
+
+   // map local cells to their zero level targets
+   ha::fmm_leaf_target.resize(cells::num_local_cells);
+   for (int lc = 0; lc < cells::num_local_cells; lc++) ha::fmm_leaf_target[lc] = target_index[cells::cell_id_array[lc]];
+
+   // allocate expansion storage
+   ha::multipole_q.assign(9*ha::total_num_cells, 0.0);
+   ha::fmm_local_expansion.assign(12*num_targets, 0.0);
+
+   zlog << zTs() << "\tFast multipole method: " << num_targets << " local expansions with " << ha::fmm_m2l_list.size() << " m2l translations" << std::endl;
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Upward pass: compute multipoles of zero level cells from local atoms (P2M),
+// reduce over all processors and accumulate up the tree (M2M)
+//------------------------------------------------------------------------------
+void fmm_upward_pass(const std::vector <double>& x_spin_array, // atomic spin directions
+                     const std::vector <double>& y_spin_array,
+                     const std::vector <double>& z_spin_array,
+                     const std::vector <double>& m_spin_array, // atomic spin moment
+                     const std::vector < bool >& magnetic){    // is magnetic
+
+   const int nz = ha::num_zero_level_cells;
+
+   // pack zero level moments and first moments into a single buffer for reduction
+   std::vector<double> buffer(12*nz, 0.0);
+
+   if( micromagnetic::discretisation_type != 1 ){
+
+      for(int atom = 0; atom < vmpi::num_local_atoms; ++atom){
+
+         if( !magnetic[atom] ) continue;
+
+         const int cell = cells::atom_cell_id_array[atom];
+         const double mus = m_spin_array[atom];
+
+         const double m[3] = { x_spin_array[atom] * mus, y_spin_array[atom] * mus, z_spin_array[atom] * mus };
+         const double d[3] = { atoms::x_coord_array[atom] - ha::cell_positions[3*cell+0],
+                               atoms::y_coord_array[atom] - ha::cell_positions[3*cell+1],
+                               atoms::z_coord_array[atom] - ha::cell_positions[3*cell+2] };
+
+         double* b = &buffer[12*cell];
+         b[0] += m[0];
+         b[1] += m[1];
+         b[2] += m[2];
+         for(int i = 0; i < 3; i++){
+            b[3+3*i+0] += d[i]*m[0];
+            b[3+3*i+1] += d[i]*m[1];
+            b[3+3*i+2] += d[i]*m[2];
+         }
+
+      }
+
+   }
+   // for micromagnetic cells treat the cell moment as a point at the cell centre
+   else {
+
+      const double imuB = 1.0/9.27400915e-24;
+
+      for (int lc = 0; lc < micromagnetic::number_of_micromagnetic_cells; lc++){
+         const int cell = micromagnetic::list_of_micromagnetic_cells[lc];
+         buffer[12*cell+0] = cells::mag_array_x[cell]*imuB;
+         buffer[12*cell+1] = cells::mag_array_y[cell]*imuB;
+         buffer[12*cell+2] = cells::mag_array_z[cell]*imuB;
+      }
+
+   }
+
+   // single reduction of all zero level multipoles
+   vmpi::all_reduce_sum(buffer);
+
+   // unpack zero level cells
+   for(int cell = 0; cell < nz; cell++){
+      ha::mag_array_x[cell] = buffer[12*cell+0];
+      ha::mag_array_y[cell] = buffer[12*cell+1];
+      ha::mag_array_z[cell] = buffer[12*cell+2];
+      for(int q = 0; q < 9; q++) ha::multipole_q[9*cell+q] = buffer[12*cell+3+q];
+   }
+
+   // M2M translation for higher levels (replicated and cheap)
+   for (int level = 1; level < ha::num_levels; level++ ){
+      for (int cell = ha::cells_level_start_index[level]; cell < ha::cells_level_end_index[level]; cell++){
+
+         double m[3] = {0.0, 0.0, 0.0};
+         double q[9] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+         for (int idx = ha::cells_in_cells_start_index[cell]; idx < ha::cells_in_cells_end_index[cell]; idx++){
+
+            const int sub = ha::cells_in_cells[idx];
+            const double mx = ha::mag_array_x[sub];
+            const double my = ha::mag_array_y[sub];
+            const double mz = ha::mag_array_z[sub];
+
+            // shift of child centre relative to parent centre
+            const double d[3] = { ha::cell_positions[3*sub+0] - ha::cell_positions[3*cell+0],
+                                  ha::cell_positions[3*sub+1] - ha::cell_positions[3*cell+1],
+                                  ha::cell_positions[3*sub+2] - ha::cell_positions[3*cell+2] };
+
+            m[0] += mx;
+            m[1] += my;
+            m[2] += mz;
+            for(int i = 0; i < 3; i++){
+               q[3*i+0] += ha::multipole_q[9*sub+3*i+0] + d[i]*mx;
+               q[3*i+1] += ha::multipole_q[9*sub+3*i+1] + d[i]*my;
+               q[3*i+2] += ha::multipole_q[9*sub+3*i+2] + d[i]*mz;
+            }
+
+         }
+
+         ha::mag_array_x[cell] = m[0];
+         ha::mag_array_y[cell] = m[1];
+         ha::mag_array_z[cell] = m[2];
+         for(int i = 0; i < 9; i++) ha::multipole_q[9*cell+i] = q[i];
+
+      }
+   }
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Downward pass: shift parent local expansions (L2L) and add well separated
+// contributions (M2L) for all target cells on this processor
+//------------------------------------------------------------------------------
+void fmm_downward_pass(){
+
+   const int num_targets = ha::fmm_target_cells.size();
+
+   for (int t = 0; t < num_targets; t++){
+
+      const int cell = ha::fmm_target_cells[t];
+      const double cx = ha::cell_positions[3*cell+0];
+      const double cy = ha::cell_positions[3*cell+1];
+      const double cz = ha::cell_positions[3*cell+2];
+
+      // local expansion H_j, G_ij = dH_j/dr_i
+      double h[3] = {0.0, 0.0, 0.0};
+      double g[9] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+      // L2L translation from parent
+      const int pt = ha::fmm_target_parent[t];
+      if(pt >= 0){
+         const int parent = ha::fmm_target_cells[pt];
+         const double e[3] = { cx - ha::cell_positions[3*parent+0],
+                               cy - ha::cell_positions[3*parent+1],
+                               cz - ha::cell_positions[3*parent+2] };
+         const double* lp = &ha::fmm_local_expansion[12*pt];
+         for(int j = 0; j < 3; j++) h[j] = lp[j] + e[0]*lp[3+j] + e[1]*lp[6+j] + e[2]*lp[9+j];
+         for(int i = 0; i < 9; i++) g[i] = lp[3+i];
+      }
+
+      // M2L translations from well separated cells
+      for(int idx = ha::fmm_m2l_start_index[t]; idx < ha::fmm_m2l_start_index[t+1]; idx++){
+
+         const int source = ha::fmm_m2l_list[idx];
+
+         const double M[3] = { ha::mag_array_x[source], ha::mag_array_y[source], ha::mag_array_z[source] };
+         const double* Q = &ha::multipole_q[9*source];
+
+         // separation vector from source to target
+         const double R[3] = { cx - ha::cell_positions[3*source+0],
+                               cy - ha::cell_positions[3*source+1],
+                               cz - ha::cell_positions[3*source+2] };
+
+         const double ir  = 1.0/sqrt(R[0]*R[0] + R[1]*R[1] + R[2]*R[2]);
+         const double ir3 = ir*ir*ir;
+         const double ir5 = ir3*ir*ir;
+         const double ir7 = ir5*ir*ir;
+
+         // contractions of separation vector with multipoles
+         const double RM  = R[0]*M[0] + R[1]*M[1] + R[2]*M[2];
+         const double trQ = Q[0] + Q[4] + Q[8];
+         double QR[3], RQ[3]; // QR_j = Q_jk R_k, RQ_j = R_i Q_ij
+         for(int j = 0; j < 3; j++){
+            QR[j] = Q[3*j+0]*R[0] + Q[3*j+1]*R[1] + Q[3*j+2]*R[2];
+            RQ[j] = R[0]*Q[j] + R[1]*Q[3+j] + R[2]*Q[6+j];
+         }
+         const double RQR = R[0]*QR[0] + R[1]*QR[1] + R[2]*QR[2];
+
+         // H_j = T_jk M_k - D_ijk Q_ik with D_ijk = dT_jk/dR_i
+         for(int j = 0; j < 3; j++){
+            h[j] += 3.0*R[j]*RM*ir5 - M[j]*ir3
+                  + 15.0*R[j]*RQR*ir7 - 3.0*(QR[j] + RQ[j] + R[j]*trQ)*ir5;
+         }
+
+         // G_ij = D_ijk M_k
+         for(int i = 0; i < 3; i++){
+            for(int j = 0; j < 3; j++){
+               const double dij = (i == j) ? RM : 0.0;
+               g[3*i+j] += -15.0*R[i]*R[j]*RM*ir7 + 3.0*(dij + R[j]*M[i] + R[i]*M[j])*ir5;
+            }
+         }
+
+      }
+
+      // save local expansion
+      double* l = &ha::fmm_local_expansion[12*t];
+      for(int j = 0; j < 3; j++) l[j] = h[j];
+      for(int i = 0; i < 9; i++) l[3+i] = g[i];
+
+   }
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to evaluate far field local expansion at the moment weighted
+// position of a local cell (L2P) in units of muB/A^3
+//------------------------------------------------------------------------------
+void fmm_far_field(const int lc, double& hx, double& hy, double& hz){
+
+   const int t = ha::fmm_leaf_target[lc];
+   const int cell = ha::fmm_target_cells[t];
+
+   const double e[3] = { cells::pos_and_mom_array[4*cell+0] - ha::cell_positions[3*cell+0],
+                         cells::pos_and_mom_array[4*cell+1] - ha::cell_positions[3*cell+1],
+                         cells::pos_and_mom_array[4*cell+2] - ha::cell_positions[3*cell+2] };
+
+   const double* l = &ha::fmm_local_expansion[12*t];
+   hx = l[0] + e[0]*l[3] + e[1]*l[6] + e[2]*l[ 9];
+   hy = l[1] + e[0]*l[4] + e[1]*l[7] + e[2]*l[10];
+   hz = l[2] + e[0]*l[5] + e[1]*l[8] + e[2]*l[11];
+
+   return;
+
+}
+
+} // end of internal namespace
+} // end of hierarchical namespace
@@ -87,7 +87,7 @@ void initialize(const double system_dimensions_x,
                 int num_atoms){
 
    // store segment timings for optional printing
-   std::vector <double> segment_time(9,0.0);
+   std::vector <double> segment_time(10,0.0);
 
    // instantiate timer
    vutil::vtimer_t timer;
@@ -123,6 +123,9 @@ void initialize(const double system_dimensions_x,
    ha::cells_level_start_index.resize(ha::num_levels,0.0);
    ha::cells_level_end_index.resize(ha::num_levels,0.0);
    ha::interaction_range.resize(ha::num_levels,0.0);
+   ha::level_num_cells_x.resize(ha::num_levels,0);
+   ha::level_num_cells_y.resize(ha::num_levels,0);
+   ha::level_num_cells_z.resize(ha::num_levels,0);
 
    std::vector < std::vector < int > > cells_index_atoms_array;
 
@@ -274,6 +277,11 @@ void initialize(const double system_dimensions_x,
 
       const int temp_num_cells = ncx*ncy*ncz;
 
+      // save level dimensions for fast multipole neighbour searches
+      ha::level_num_cells_x[level] = ncx;
+      ha::level_num_cells_y[level] = ncy;
+      ha::level_num_cells_z[level] = ncz;
+
       //set the start and end index for the level
       ha::cells_level_start_index[level] = index;
       index = index + temp_num_cells;
@@ -535,7 +543,44 @@ void initialize(const double system_dimensions_x,
 
    // determine the interaction list for local cells
    int interaction_num = 0;
-   for (int lc = 0; lc < cells_num_local_cells; lc ++){
+
+   // for the fast multipole method only adjacent zero level cells are
+   // computed explicitly, with the far field handled by local expansions
+   if(ha::method == ha::fmm){
+
+      const int ncx = ha::level_num_cells_x[0];
+      const int ncy = ha::level_num_cells_y[0];
+      const int ncz = ha::level_num_cells_z[0];
+
+      for (int lc = 0; lc < cells_num_local_cells; lc ++){
+
+         ha::interaction_list_start_index[lc] = interaction_num;
+         ha::interaction_list_end_index[lc] = interaction_num;
+
+         // unpack 3D cell coordinates from 1D cell ID
+         const int cell_i = cells::cell_id_array[lc];
+         const int i = cell_i / (ncy*ncz);
+         const int j = (cell_i / ncz) % ncy;
+         const int k = cell_i % ncz;
+
+         for (int ni = i-1; ni <= i+1; ni++){
+            if(ni < 0 || ni >= ncx) continue;
+            for (int nj = j-1; nj <= j+1; nj++){
+               if(nj < 0 || nj >= ncy) continue;
+               for (int nk = k-1; nk <= k+1; nk++){
+                  if(nk < 0 || nk >= ncz) continue;
+                  ha::interaction_list.push_back((ni*ncy + nj)*ncz + nk);
+                  interaction_num ++;
+                  ha::interaction_list_end_index[lc] = interaction_num;
+               }
+            }
+         }
+
+      }
+
+   }
+
+   for (int lc = 0; lc < cells_num_local_cells && ha::method == ha::tree; lc ++){
 
       std::vector < bool > interacted(ha::total_num_cells,false);
       ha::interaction_list_start_index[lc] = interaction_num;
@@ -769,9 +814,21 @@ void initialize(const double system_dimensions_x,
    // Output detailed timings for the hierarchical initialisation
    //---------------------------------------------------------------------------
 
+   //---------------------------------------------------------------------------
+   // Segment 10
+   //---------------------------------------------------------------------------
+   // Construct tree connectivity and m2l lists for fast multipole method
+   //---------------------------------------------------------------------------
+   if(ha::method == ha::fmm){
+      timer.start();
+      ha::initialize_fmm(cells_num_atoms_in_cell_global);
+      timer.stop();
+      segment_time[9] = timer.elapsed_time();
+   }
+
    // print out detailed hierarchical timings
    zlog << zTs() << "\tSegment times for hierarchical initialisation:" << std::endl;
-   for(int i=0; i<9; i++) zlog << zTs() << "\t\t Segment time " << i+1 << ": " << segment_time[i] << " s" << std::endl;
+   for(int i=0; i<10; i++) zlog << zTs() << "\t\t Segment time " << i+1 << ": " << segment_time[i] << " s" << std::endl;
 
    // Woohoo we made it!
    return;
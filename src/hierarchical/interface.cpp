@@ -11,6 +11,7 @@
 //
 
 // C++ standard library headers
+#include <iostream>
 #include <string>
 
 // Vampire headers
@@ -32,6 +33,28 @@ namespace hierarchical{
       std::string prefix="hierarchical";
       if(key!=prefix) return false;
 
+      //--------------------------------------------------------------------
+      std::string test="method";
+      if(word==test){
+         test="tree";
+         if(value == test){
+            hierarchical::internal::method = hierarchical::internal::tree;
+            return true;
+         }
+         test="fast-multipole";
+         if(value == test){
+            hierarchical::internal::method = hierarchical::internal::fmm;
+            return true;
+         }
+         else{
+            terminaltextcolor(RED);
+            std::cerr << "Error: Value for \'" << prefix << ":" << word << "\' must be one of:" << std::endl;
+            std::cerr << "\t\"tree\"" << std::endl;
+            std::cerr << "\t\"fast-multipole\"" << std::endl;
+            terminaltextcolor(WHITE);
+            err::vexit();
+         }
+      }
       //--------------------------------------------------------------------
       // Keyword not found
       //--------------------------------------------------------------------
@@ -36,6 +36,14 @@ namespace hierarchical{
       // Internal data type definitions
       //-------------------------------------------------------------------------
 
+      // enumerated list of methods for evaluating far-field interactions
+      enum method_t{
+         tree = 0, // explicit per-cell interaction list over all levels
+         fmm  = 1  // fast multipole method with multipole-to-local translations
+      };
+
+      extern method_t method;
+
       extern int num_levels;
       //create arrays for data storage
       extern std::vector < double > cell_positions;
@@ -73,6 +81,23 @@ namespace hierarchical{
 
       extern double av_cell_size;
 
+      extern std::vector < int > level_num_cells_x; // number of cells in each level in x,y,z
+      extern std::vector < int > level_num_cells_y;
+      extern std::vector < int > level_num_cells_z;
+
+      //------------------------------------------------------------------------
+      // data structures for fast multipole method
+      //------------------------------------------------------------------------
+      extern std::vector < int > cell_level;                  // level of each hierarchical cell
+      extern std::vector < int > cell_parent;                 // parent cell of each hierarchical cell (-1 at top level)
+      extern std::vector < double > multipole_q;              // first moments Q_ij = sum d_i m_j of each cell (9N)
+      extern std::vector < int > fmm_target_cells;            // cells needing a local expansion on this processor (top level first)
+      extern std::vector < int > fmm_target_parent;           // index of parent in target list (-1 at top level)
+      extern std::vector < int > fmm_m2l_start_index;         // index of first source cell in m2l list for each target
+      extern std::vector < int > fmm_m2l_list;                // list of well separated source cells
+      extern std::vector < int > fmm_leaf_target;             // index of target for each local cell
+      extern std::vector < double > fmm_local_expansion;      // field and field gradient for each target (12N)
+
       //-------------------------------------------------------------------------
       // Internal function declarations
       //-------------------------------------------------------------------------
@@ -105,6 +130,16 @@ namespace hierarchical{
                       const std::vector< std::vector<double> >& atoms_in_cells_array  // output array of positions and moments of atoms in cells
                      );
 
+      // functions for fast multipole method
+      void initialize_fmm(const std::vector<int>& global_atoms_in_cell_count);
+      void fmm_upward_pass(const std::vector <double>& x_spin_array, // atomic spin directions
+                           const std::vector <double>& y_spin_array,
+                           const std::vector <double>& z_spin_array,
+                           const std::vector <double>& m_spin_array, // atomic spin moment
+                           const std::vector < bool >& magnetic);    // is magnetic
+      void fmm_downward_pass();
+      void fmm_far_field(const int lc, double& hx, double& hy, double& hz);
+
       void calc_tensor(int cells_num_local_cells,
                        std::vector < std::vector < double > >& cells_atom_in_cell_coords_array_x,
                        std::vector < std::vector < double > >& cells_atom_in_cell_coords_array_y,
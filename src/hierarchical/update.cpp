@@ -20,6 +20,7 @@
 // Vampire headers
 #include "cells.hpp" // needed for cells::cell_id_array but to be removed
 #include "dipole.hpp"
+#include "micromagnetic.hpp"
 #include "vio.hpp"
 #include "vutil.hpp"
 #include "sim.hpp"
@@ -46,7 +47,11 @@ void update(std::vector <double>& x_spin_array, // atomic spin directions
    const double imuB = 1.0/9.27400915e-24;
 
    // update hierarchical magnetization in cells
-   hierarchical::internal::calculate_hierarchical_magnetisation(x_spin_array, y_spin_array, z_spin_array, m_spin_array, magnetic);
+   if(ha::method == ha::fmm){
+      ha::fmm_upward_pass(x_spin_array, y_spin_array, z_spin_array, m_spin_array, magnetic);
+      ha::fmm_downward_pass();
+   }
+   else hierarchical::internal::calculate_hierarchical_magnetisation(x_spin_array, y_spin_array, z_spin_array, m_spin_array, magnetic);
 
    // instantiate timer
    vutil::vtimer_t timer;
@@ -118,6 +123,18 @@ void update(std::vector <double>& x_spin_array, // atomic spin directions
          // std::cout << rij_tensor_xx[j] << '\t' << rij_tensor_xy[j] << '\t' << rij_tensor_xz[j] << '\t' << rij_tensor_yy[j] << '\t' << rij_tensor_yz[j] << '\t' << rij_tensor_zz[j] << '\t' <<std::endl;
 
       }
+
+      // Add far field from local expansion
+      if(ha::method == ha::fmm){
+         double hx, hy, hz;
+         ha::fmm_far_field(lc, hx, hy, hz);
+         dipole::cells_field_array_x[cell_i]      += hx;
+         dipole::cells_field_array_y[cell_i]      += hy;
+         dipole::cells_field_array_z[cell_i]      += hz;
+         dipole::cells_mu0Hd_field_array_x[cell_i] += hx;
+         dipole::cells_mu0Hd_field_array_y[cell_i] += hy;
+         dipole::cells_mu0Hd_field_array_z[cell_i] += hz;
+      }
       //   std::cout <<"D\t" << cell_i << '\t' << dipole::cells_field_array_x[cell_i] <<'\t' << dipole::cells_field_array_y[cell_i] <<'\t' << dipole::cells_field_array_z[cell_i] <<std::endl;
 
       // Multiply Hdemg by mu_0/4pi * 1e30 * mu_B to account for normalisation of magnetisation and volume in angstrom
@@ -136,10 +153,13 @@ void update(std::vector <double>& x_spin_array, // atomic spin directions
    }
 
    #ifdef MPICF
-      // Reduce fields on all processors so all have correct field values
-      MPI_Allreduce(MPI_IN_PLACE, &dipole::cells_field_array_x[0], dipole::internal::cells_num_cells, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE, &dipole::cells_field_array_y[0], dipole::internal::cells_num_cells, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE, &dipole::cells_field_array_z[0], dipole::internal::cells_num_cells, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+      // Reduce fields on all processors so all have correct field values. With the fast multipole
+      // method atomistic discretisations only need local cell fields, so the reduction is skipped
+      if(ha::method == ha::tree || micromagnetic::discretisation_type != 0){
+         MPI_Allreduce(MPI_IN_PLACE, &dipole::cells_field_array_x[0], dipole::internal::cells_num_cells, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+         MPI_Allreduce(MPI_IN_PLACE, &dipole::cells_field_array_y[0], dipole::internal::cells_num_cells, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+         MPI_Allreduce(MPI_IN_PLACE, &dipole::cells_field_array_z[0], dipole::internal::cells_num_cells, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+      }
    #endif
 
    // Check for cells with unrealistic fields from initialisation and zero
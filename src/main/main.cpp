@@ -21,6 +21,7 @@
 #include "sim.hpp"
 #include "vmpi.hpp"
 #include "vio.hpp"
+#include "vprofile.hpp"
 
 #include "internal.hpp"
 
@@ -112,9 +113,15 @@ int main(int argc, char* argv[]){
    //test initialise SLD
    sld::initialize();
 
+   // Start profiling of simulation (only active if compiled with -DVPROFILE)
+   vprofile::initialise();
+
    // Simulate system
    sim::run();
 
+   // Print time spent in each part of the simulation to log file
+   vprofile::report();
+
    // Finalise MPI
    #ifdef MPICF
       vmpi::finalise();
@@ -0,0 +1,194 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <cmath>
+#include <vector>
+
+// Vampire headers
+#include "micromagnetic.hpp"
+
+// micromagnetic module headers
+#include "internal.hpp"
+
+// shorthand for brevity
+namespace mm = micromagnetic::internal;
+
+namespace micromagnetic{
+
+   namespace internal{
+
+      //------------------------------------------------------------------------
+      // Temperature dependent coefficient cache
+      //------------------------------------------------------------------------
+      // The equilibrium magnetisation, damping, susceptibilities and (for the
+      // LLG) the reduced exchange constants depend only on temperature, and so
+      // are recomputed only when the temperature differs from that of the
+      // cached values. The macrocell neighbour list is stored in compressed
+      // sparse row form with integer indices for the field calculations.
+      //------------------------------------------------------------------------
+
+      //------------------------------------------------------------------------
+      // Function to convert macrocell neighbour list to CSR form
+      //------------------------------------------------------------------------
+      void initialise_exchange_list(const int num_cells){
+
+         exchange_list_start.assign(num_cells + 1, 0);
+         exchange_list_neighbour.clear();
+         exchange_list_A.clear();
+
+         const int num_interactions = macro_neighbour_list_array.size();
+
+         // interactions for each cell are stored contiguously in cell order
+         if(num_cells > 1){
+            for(int cell = 0; cell < num_cells; cell++) exchange_list_start[cell] = int(macro_neighbour_list_start_index[cell]);
+            exchange_list_start[num_cells] = num_interactions;
+            exchange_list_neighbour.resize(num_interactions);
+            exchange_list_A.resize(num_interactions);
+            for(int j = 0; j < num_interactions; j++){
+               exchange_list_neighbour[j] = int(macro_neighbour_list_array[j]);
+               exchange_list_A[j] = A[j];
+            }
+         }
+
+         exchange_list_coefficient.assign(num_interactions, 0.0);
+         exchange_self_coefficient.assign(num_cells, 0.0);
+         llb_exchange_scaling.assign(num_cells, 0.0);
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to update temperature dependent coefficients for LLG
+      //------------------------------------------------------------------------
+      void update_llg_coefficients(const double temperature, const int num_cells){
+
+         if(temperature == llg_coefficient_temperature) return;
+         llg_coefficient_temperature = temperature;
+         llb_coefficient_temperature = -1.0;
+
+         if(int(exchange_list_start.size()) != num_cells + 1) initialise_exchange_list(num_cells);
+
+         // set cell temperatures
+         for (int lc = 0; lc < number_of_micromagnetic_cells; lc++){
+            int cell = list_of_micromagnetic_cells[lc];
+            mm::T[cell] = temperature;
+         }
+
+         // calculate chi(T).
+         mm::calculate_chi_perp(number_of_micromagnetic_cells, list_of_micromagnetic_cells, mm::one_o_chi_perp, mm::T, mm::Tc);
+
+         for (int cell = 0; cell < num_cells; cell++){
+            // Optionally determine temperature dependent constants
+            if(mm::temperature_dependent_parameters){
+
+               const double rT = temperature/Tc[cell]; // ratio T/Tc
+
+               // determine equilibrium magnetization and damping
+               if( temperature <= Tc[cell] ){
+                  m_e[cell] = std::pow( (1.0 - rT) ,0.34);
+                  alpha_perp[cell] = alpha[cell]*(1.0 - 0.333333333333 * rT);
+               }
+               else{
+                  m_e[cell] = 0.01;
+                  alpha_perp[cell] = alpha[cell] * 0.666666666667 * rT;
+               }
+
+            }
+            // constant micromagnetic parameters
+            else{
+               m_e[cell] = 1.0;
+               alpha_perp[cell] = alpha[cell];
+            }
+         }
+
+         // calculate reduced exchange constants me_j^1.71 A_ij for each interaction
+         for (int cell = 0; cell < num_cells; cell++){
+            double sum = 0.0;
+            for(int j = exchange_list_start[cell]; j < exchange_list_start[cell+1]; j++){
+               const double mj = m_e[exchange_list_neighbour[j]];
+               const double Ac = exchange_list_A[j]*std::pow(mj,1.71);
+               exchange_list_coefficient[j] = Ac*mj;
+               sum += Ac;
+            }
+            exchange_self_coefficient[cell] = sum*m_e[cell];
+         }
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to update temperature dependent coefficients for LLB
+      //------------------------------------------------------------------------
+      void update_llb_coefficients(const double temperature, const int num_cells){
+
+         if(temperature == llb_coefficient_temperature) return;
+         llb_coefficient_temperature = temperature;
+         llg_coefficient_temperature = -1.0;
+
+         if(int(exchange_list_start.size()) != num_cells + 1) initialise_exchange_list(num_cells);
+
+         // set cell temperatures
+         for (int lc = 0; lc < number_of_micromagnetic_cells; lc++){
+            int cell = list_of_micromagnetic_cells[lc];
+            mm::T[cell] = temperature;
+         }
+
+         // compute parallel and perpendicular susceptibilities
+         mm::calculate_chi_para(number_of_micromagnetic_cells, list_of_micromagnetic_cells, mm::one_o_chi_para, mm::T, mm::Tc);
+         mm::calculate_chi_perp(number_of_micromagnetic_cells, list_of_micromagnetic_cells, mm::one_o_chi_perp, mm::T, mm::Tc);
+
+         //sets m_e and alpha temperature dependant parameters
+         for (int lc = 0; lc < number_of_micromagnetic_cells; lc++){
+            int cell = list_of_micromagnetic_cells[lc];
+            const double reduced_temperature = temperature/Tc[cell];
+            if (temperature<=Tc[cell]){
+               m_e[cell] = pow((Tc[cell]-temperature)/(Tc[cell]),0.365);
+               alpha_para[cell] = (2.0/3.0)*alpha[cell]*reduced_temperature;
+               alpha_perp[cell] = alpha[cell]*(1.0-temperature/(3.0*Tc[cell]));
+            }
+            else{
+               m_e[cell] = 0.0;
+               alpha_para[cell] = alpha[cell]*(2.0/3.0)*reduced_temperature;
+               alpha_perp[cell] = alpha_para[cell];
+            }
+            if (temperature < 0.1){
+              m_e[cell] = 1.0;
+              alpha_para[cell] = 0.001;
+            }
+         }
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to calculate magnetisation dependent LLB exchange scaling
+      // once per cell rather than for every interaction
+      //------------------------------------------------------------------------
+      void calculate_llb_exchange_scaling(const int num_cells,
+                                          const std::vector<double>& x_array,
+                                          const std::vector<double>& y_array,
+                                          const std::vector<double>& z_array){
+
+         for (int cell = 0; cell < num_cells; cell++){
+            const double mj = sqrt(x_array[cell]*x_array[cell] + y_array[cell]*y_array[cell] + z_array[cell]*z_array[cell]);
+            llb_exchange_scaling[cell] = pow(mj,1.71);
+         }
+
+         return;
+
+      }
+
+   } // end of internal namespace
+
+} // end of micromagnetic namespace
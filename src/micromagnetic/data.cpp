@@ -143,6 +143,17 @@ namespace micromagnetic{
       std::vector<double> macro_neighbour_list_end_index;
       std::vector<double> macro_neighbour_list_array;
 
+      // cached temperature dependent coefficients
+      double llg_coefficient_temperature = -1.0; // temperature of cached LLG coefficients (negative if invalid)
+      double llb_coefficient_temperature = -1.0; // temperature of cached LLB coefficients (negative if invalid)
+
+      std::vector<int> exchange_list_start;                 // start of neighbours of each cell [num_cells+1]
+      std::vector<int> exchange_list_neighbour;             // neighbouring cell of each interaction
+      std::vector<double> exchange_list_A;                  // exchange constant of each interaction
+      std::vector<double> exchange_list_coefficient;        // A_ij me_j^1.71 me_j for each interaction (LLG)
+      std::vector<double> exchange_self_coefficient;        // me_i sum_j A_ij me_j^1.71 for each cell (LLG)
+      std::vector<double> llb_exchange_scaling;             // |m_j|^1.71 for each cell (LLB)
+
       // spin transfer torque polarization vector
       double sttpx=0.0;
       double sttpy=0.0;
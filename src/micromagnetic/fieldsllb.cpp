@@ -56,21 +56,7 @@ namespace micromagnetic{
       const double Tc_o_Tc_m_T = Tc[cell]/(temperature - Tc[cell]);
 
 
-      //sets m_e and alpha temperature dependant parameters
-      if (temperature<=Tc[cell]){
-         m_e[cell] = pow((Tc[cell]-temperature)/(Tc[cell]),0.365);
-         alpha_para[cell] = (2.0/3.0)*alpha[cell]*reduced_temperature;
-         alpha_perp[cell] = alpha[cell]*(1.0-temperature/(3.0*Tc[cell]));
-      }
-      else{
-         m_e[cell] = 0.0;
-         alpha_para[cell] = alpha[cell]*(2.0/3.0)*reduced_temperature;
-         alpha_perp[cell] = alpha_para[cell];
-      }
-      if (temperature < 0.1){
-        m_e[cell] = 1.0;
-        alpha_para[cell] = 0.001;
-      }
+      // m_e and alpha temperature dependant parameters are cached in update_llb_coefficients
 
       const double mx = m[0];
       const double my = m[1];
@@ -89,34 +75,16 @@ namespace micromagnetic{
       //array to store the exchanege field
       double exchange_field[3]={0.0,0.0,0.0};
       //int mat  = cell_material_array[cell];
-      if (num_cells > 1){
-         //loops over all other cells with interactions to this cell
-         const int start = macro_neighbour_list_start_index[cell];
-         const int end = macro_neighbour_list_end_index[cell] +1;
-
-         for(int j = start;j< end;j++){
-            // calculate reduced exchange constant factor
-            const int cellj = macro_neighbour_list_array[j];
-            const double mj = sqrt(x_array[cellj]*x_array[cellj] + y_array[cellj]*y_array[cellj] + z_array[cellj]*z_array[cellj]);
-            double Ac = A[j]*pow(mj,1.71);
-
-         //    int matj =cell_material_array[cellj];
-             if (cell != cellj){
-         //    if (mp::material[mat].enable_SAF == true && mp::material[matj].enable_SAF == true){
-         //      if (mat != matj){
-         //      Ac = -pow(mj,1.66)*prefactor[matj]*mp::material[mat].SAF[matj];
-
-         //      }
-         //   }
-
-         //   if (mp::material[mat].override_atomsitic[matj] == true){
-         //     Ac = -2*pow(mj,1.66)*mp::material[mat].EF_MM[matj]/(ms[cell]);
-         //   }
-            exchange_field[0] -= Ac*(x_array[cellj] - x_array[cell]);
-            exchange_field[1] -= Ac*(y_array[cellj] - y_array[cell]);
-            exchange_field[2] -= Ac*(z_array[cellj] - z_array[cell]);
-          }
-         }
+      //loops over all other cells with interactions to this cell
+      const int start = exchange_list_start[cell];
+      const int end = exchange_list_start[cell+1];
+      for(int j = start;j< end;j++){
+         // calculate reduced exchange constant factor using cached |m_j|^1.71
+         const int cellj = exchange_list_neighbour[j];
+         const double Ac = exchange_list_A[j]*llb_exchange_scaling[cellj];
+         exchange_field[0] -= Ac*(x_array[cellj] - x_array[cell]);
+         exchange_field[1] -= Ac*(y_array[cellj] - y_array[cell]);
+         exchange_field[2] -= Ac*(z_array[cellj] - z_array[cell]);
       }
 
       // get cell level spin transfer torque parameters
@@ -40,31 +40,8 @@ void mm::calculate_llg_spin_fields(const double temperature,
                                std::vector<double>& y_total_spin_field_array,   // total magnetic field
                                std::vector<double>& z_total_spin_field_array){  // total magnetic field
 
-   // Loop over all micromagnetic cells - should this be all cells?
-   for (int cell = 0; cell < num_cells; cell++){
-      // Optionally determine temperature dependent constants
-      if(mm::temperature_dependent_parameters){
-
-         const double rT = temperature/Tc[cell]; // ratio T/Tc
-
-         // determine equilibrium magnetization and damping
-         if( temperature <= Tc[cell] ){
-            m_e[cell] = std::pow( (1.0 - rT) ,0.34);
-            alpha_perp[cell] = alpha[cell]*(1.0 - 0.333333333333 * rT);
-         }
-         else{
-            m_e[cell] = 0.01;
-            alpha_perp[cell] = alpha[cell] * 0.666666666667 * rT;
-         }
-
-      }
-      // constant micromagnetic parameters
-      else{
-         m_e[cell] = 1.0;
-         alpha_perp[cell] = alpha[cell];
-      }
-
-   }
+   // update cached temperature dependent parameters (only if temperature has changed)
+   mm::update_llg_coefficients(temperature, num_cells);
 
    // Determine fields for all micromagnetic cells
    for (int lc = 0; lc < number_of_micromagnetic_cells; lc++){
@@ -88,32 +65,27 @@ void mm::calculate_llg_spin_fields(const double temperature,
       // Temporary variable to calculate total exchange field
       double exchange_field[3]={ 0.0, 0.0, 0.0 };
 
-      // Check that there is more than one cell
-      if (num_cells > 1){
-
-         const int start = macro_neighbour_list_start_index[cell]; // save start index for neighbour list
-         const int end = macro_neighbour_list_end_index[cell] +1;  // save end index for neighbour list
-
-         // loop over neighbouring cells
-         for(int j = start;j< end;j++){
-
-            // get ID of neighbouring cell
-            const int cellj = macro_neighbour_list_array[j];
-
-            // get equilibrim magnetization of neighbouring cell
-            const double mj = m_e[cellj];
+      // loop over neighbouring cells using reduced exchange constants me_j^1.71*A
+      const int start = exchange_list_start[cell];
+      const int end = exchange_list_start[cell+1];
+      for(int j = start; j < end; j++){
 
-            // calculate reduced exchange constant factor
-            double Ac = A[j]*std::pow(mj,1.71);
+         // get ID of neighbouring cell
+         const int cellj = exchange_list_neighbour[j];
+         const double Ac = exchange_list_coefficient[j];
 
-            // Add field from cell to total exchange field (at equillibrium this term goes to zero)
-            exchange_field[0] -= Ac*(mx_array[cellj]*m_e[cellj] - mx*me);
-            exchange_field[1] -= Ac*(my_array[cellj]*m_e[cellj] - my*me);
-            exchange_field[2] -= Ac*(mz_array[cellj]*m_e[cellj] - mz*me);
+         // Add field from cell to total exchange field
+         exchange_field[0] -= Ac*mx_array[cellj];
+         exchange_field[1] -= Ac*my_array[cellj];
+         exchange_field[2] -= Ac*mz_array[cellj];
 
-         } // end of loop over cells
+      } // end of loop over cells
 
-      } // end of check for neighbouring cells
+      // add self term (at equillibrium the total exchange field goes to zero)
+      const double As = exchange_self_coefficient[cell];
+      exchange_field[0] += As*mx;
+      exchange_field[1] += As*my;
+      exchange_field[2] += As*mz;
 
       // get cell level spin transfer torque parameters
   		const double strj  = mm::stt_rj[cell];
@@ -116,6 +116,18 @@ namespace micromagnetic{
       extern std::vector<double> macro_neighbour_list_end_index;
       extern std::vector<double> macro_neighbour_list_array;
 
+      // cached temperature dependent coefficients
+      extern double llg_coefficient_temperature; // temperature of cached LLG coefficients (negative if invalid)
+      extern double llb_coefficient_temperature; // temperature of cached LLB coefficients (negative if invalid)
+
+      // CSR macrocell neighbour list and exchange coefficients
+      extern std::vector<int> exchange_list_start;
+      extern std::vector<int> exchange_list_neighbour;
+      extern std::vector<double> exchange_list_A;
+      extern std::vector<double> exchange_list_coefficient;
+      extern std::vector<double> exchange_self_coefficient;
+      extern std::vector<double> llb_exchange_scaling;
+
       extern std::vector<double> fields_neighbouring_atoms_begin;
       extern std::vector<double> fields_neighbouring_atoms_end;
 
@@ -190,6 +202,15 @@ namespace micromagnetic{
                                                 std::vector<double>& y_array,
                                                 std::vector<double>& z_array);
 
+      // temperature dependent coefficient cache
+      void initialise_exchange_list(const int num_cells);
+      void update_llg_coefficients(const double temperature, const int num_cells);
+      void update_llb_coefficients(const double temperature, const int num_cells);
+      void calculate_llb_exchange_scaling(const int num_cells,
+                                          const std::vector<double>& x_array,
+                                          const std::vector<double>& y_array,
+                                          const std::vector<double>& z_array);
+
       void calculate_llg_external_fields(const double temperature,
                                          const int num_cells,
                                          std::vector<double>& x_array,
@@ -162,19 +162,12 @@ int LLB( std::vector <int>& local_cell_array,
 	// Check for initialisation of LLG integration arrays
 	if(LLG_set== false) micromagnetic::micromagnetic_init(num_cells, x_mag_array, y_mag_array, z_mag_array);
 
-   // set cell temperatures
-   for (int lc = 0; lc < number_of_micromagnetic_cells; lc++){
-      int cell = list_of_micromagnetic_cells[lc];
-      mm::T[cell] = temperature;
-   }
+   // set cell temperatures and compute m_e, alpha and susceptibilities (only if temperature has changed)
+   mm::update_llb_coefficients(temperature, num_cells);
 
    // Output cell parameters for debugging
    //mm::output_system_parameters(cells::pos_and_mom_array, x_mag_array, y_mag_array, z_mag_array); std::cin.get();
 
-   // compute parallel and perpendicular susceptibilities
-   mm::calculate_chi_para(number_of_micromagnetic_cells, list_of_micromagnetic_cells, mm::one_o_chi_para, mm::T, mm::Tc);
-   mm::calculate_chi_perp(number_of_micromagnetic_cells, list_of_micromagnetic_cells, mm::one_o_chi_perp, mm::T, mm::Tc);
-
    //initialise the x_array to Mx/Ms
    for (int cell = 0; cell < num_cells; cell++){
 		double ims =1.0/mm::ms[cell];
@@ -211,6 +204,9 @@ int LLB( std::vector <int>& local_cell_array,
 
    double xyz[3] = {0.0,0.0,0.0};
 
+   // calculate magnetisation dependent exchange scaling |m|^1.71 once per cell
+   mm::calculate_llb_exchange_scaling(num_cells, x_array, y_array, z_array);
+
    //calculate the euler gradient (for cells on this processor)
    for (int lc = 0; lc < number_of_micromagnetic_cells; lc++){
       int cell = list_of_micromagnetic_cells[lc];
@@ -286,6 +282,9 @@ int LLB( std::vector <int>& local_cell_array,
       MPI_Allreduce(MPI_IN_PLACE, &z_spin_storage_array[0], data_size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
    #endif
 
+   // update exchange scaling for predicted magnetisation
+   mm::calculate_llb_exchange_scaling(num_cells, x_spin_storage_array, y_spin_storage_array, z_spin_storage_array);
+
    //calculates the heun gradient
    for (int lc = 0; lc < number_of_micromagnetic_cells; lc++){
    	int cell = list_of_micromagnetic_cells[lc];
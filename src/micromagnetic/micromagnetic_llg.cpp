@@ -131,14 +131,8 @@ namespace micromagnetic{
       // Check for initialisation of LLG integration arrays
       if(LLG_set== false) micromagnetic::micromagnetic_init_llg(num_cells);
 
-      // set cell temperatures
-      for (int lc = 0; lc < number_of_micromagnetic_cells; lc++){
-         int cell = list_of_micromagnetic_cells[lc];
-         mm::T[cell] = temperature;
-      }
-
-      // calculate chi(T).
-      mm::calculate_chi_perp(number_of_micromagnetic_cells, list_of_micromagnetic_cells, mm::one_o_chi_perp, mm::T, mm::Tc);
+      // set cell temperatures and calculate chi(T), m_e(T) and exchange (only if temperature has changed)
+      mm::update_llg_coefficients(temperature, num_cells);
 
       // Set the current external field
       mm::ext_field[0] = H*Hx;
@@ -65,6 +65,7 @@ namespace montecarlo{
       // Internal function declarations
       //-------------------------------------------------------------------------
       void mc_move(const std::vector<double>&, std::vector<double>&);
+      void mc_move(const std::vector<double>&, std::vector<double>&, const double, const double, replica_rng_t&);
 
    } // end of internal namespace
 
@@ -26,6 +26,7 @@
 #include "sim.hpp"
 #include "vmath.hpp"
 #include "vio.hpp"
+#include "vprofile.hpp"
 #include "lsf_mc.hpp"
 #include "exchange.hpp"
 #include "../simulate/internal.hpp"
@@ -304,7 +305,10 @@ void lsf_mc_step_parallel(std::vector<double> &x_spin_array,
       vmpi::TotalComputeTime+=vmpi::SwapTimer(vmpi::ComputeTime, vmpi::WaitTime);
 
       // Wait for other processors
-      vmpi::barrier();
+      {
+         VPROFILE_SCOPE(vprofile::mpi_wait);
+         vmpi::barrier();
+      }
 
       // Swap timers wait -> compute
       vmpi::TotalWaitTime += vmpi::SwapTimer(vmpi::WaitTime, vmpi::ComputeTime);
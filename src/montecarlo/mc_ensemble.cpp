@@ -0,0 +1,167 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// Standard Libraries
+#include <cmath>
+#include <vector>
+
+// OpenMP header
+#ifdef _OPENMP
+   #include <omp.h>
+#endif
+
+// Vampire Header files
+#include "exchange.hpp"
+#include "random.hpp"
+#include "sim.hpp"
+
+// Internal header
+#include "internal.hpp"
+
+namespace montecarlo{
+
+//------------------------------------------------------------------------------
+// Integrates a Monte Carlo step for a batch of replicas sharing the same
+// structure, with spins stored replica interleaved [atom][component][replica].
+// The sequence of trial sites is shared between replicas, while trial moves,
+// temperatures, applied fields and acceptance are independent for each
+// replica. When compiled with OpenMP each thread integrates a contiguous block
+// of replicas, gathering their exchange fields in a single pass over the
+// neighbour list of each trial site. Every replica draws from its own random
+// number generator, so results do not depend on the number of threads.
+//------------------------------------------------------------------------------
+void mc_step_ensemble(std::vector<double>& spin_array,             // replica interleaved spins
+                      const int num_replicas,
+                      const int num_atoms,
+                      const std::vector<int>& type_array,
+                      const std::vector<double>& temperature,      // temperature of each replica
+                      const std::vector<double>& applied_field,    // applied field strength of each replica
+                      std::vector<double>& adaptive_sigma,         // adaptive trial width of each replica
+                      std::vector<replica_rng_t>& rng){            // random number generator of each replica
+
+      const int R = num_replicas;
+      const int num_materials = internal::num_materials;
+
+      // calculate number of steps to calculate
+      const int nmoves = num_atoms;
+
+      // Material dependent temperature rescaling for each replica [replica][material]
+      std::vector<double> rescaled_material_kBTBohr(R*num_materials);
+      std::vector<double> sigma_array(R*num_materials); // range for tuned gaussian random move
+      for(int r=0; r<R; ++r){
+         for(int m=0; m<num_materials; ++m){
+            double alpha = internal::temperature_rescaling_alpha[m];
+            double Tc = internal::temperature_rescaling_Tc[m];
+            double rescaled_temperature = temperature[r] < Tc ? Tc*pow(temperature[r]/Tc,alpha) : temperature[r];
+            rescaled_material_kBTBohr[r*num_materials+m] = 9.27400915e-24/(rescaled_temperature*1.3806503e-23);
+            sigma_array[r*num_materials+m] = rescaled_temperature < 1.0 ? 0.02 : pow(1.0/rescaled_material_kBTBohr[r*num_materials+m],0.2)*0.08;
+         }
+      }
+
+      // pick trial sites, shared by all replicas
+      std::vector<int> trial_site(nmoves);
+      for(int i=0;i<nmoves; i++) trial_site[i] = int(nmoves*mtrandom::grnd());
+
+      std::vector<double> statistics_reject(R, 0.0);
+
+      #ifdef _OPENMP
+      #pragma omp parallel
+      #endif
+      {
+
+         #ifdef _OPENMP
+            const int thread = omp_get_thread_num();
+            const int num_threads = omp_get_num_threads();
+         #else
+            const int thread = 0;
+            const int num_threads = 1;
+         #endif
+
+         // block of replicas integrated by this thread
+         const int first_replica = (R*thread)/num_threads;
+         const int last_replica = (R*(thread+1))/num_threads;
+
+         // exchange fields for the replicas of the trial site [component][replica]
+         std::vector<double> exchange_field(3*R, 0.0);
+
+         std::vector<double> Sold(3);
+         std::vector<double> Snew(3);
+
+         // loop over natoms to form a single Monte Carlo step
+         for(int i=0; i<nmoves && first_replica<last_replica; i++){
+
+            const int atom = trial_site[i];
+
+            // get material id
+            const int imaterial=type_array[atom];
+
+            // calculate exchange fields of block of replicas at once
+            exchange::replica_fields(atom, R, first_replica, last_replica, spin_array, exchange_field);
+
+            double* s = &spin_array[3*R*atom];
+
+            for(int r=first_replica; r<last_replica; ++r){
+
+               // Save old spin position
+               Sold[0] = s[r];
+               Sold[1] = s[R+r];
+               Sold[2] = s[2*R+r];
+
+               // Make Monte Carlo move
+               internal::mc_move(Sold, Snew, sigma_array[r*num_materials+imaterial], adaptive_sigma[r], rng[r]);
+
+               // Exchange energy change from the gathered exchange field
+               double DE = -(exchange_field[r]     * (Snew[0] - Sold[0]) +
+                             exchange_field[R+r]   * (Snew[1] - Sold[1]) +
+                             exchange_field[2*R+r] * (Snew[2] - Sold[2]));
+
+               // On-site energy change at replica temperature and field
+               DE += sim::spin_onsite_energy(atom, imaterial, Snew[0], Snew[1], Snew[2], temperature[r], applied_field[r]) -
+                     sim::spin_onsite_energy(atom, imaterial, Sold[0], Sold[1], Sold[2], temperature[r], applied_field[r]);
+
+               // Calculate difference in Joules/mu_B
+               DE *= internal::mu_s_SI[imaterial]*1.07828231e23; //1/9.27400915e-24
+
+               // Accept lower energy states unconditionally, otherwise evaluate probability for move
+               if(DE<0 || exp(-DE*rescaled_material_kBTBohr[r*num_materials+imaterial]) >= rng[r].uniform(rng[r].generator)){
+                  s[r]     = Snew[0];
+                  s[R+r]   = Snew[1];
+                  s[2*R+r] = Snew[2];
+               }
+               // If rejected add one to rejection counter
+               else statistics_reject[r] += 1.0;
+
+            }
+         }
+
+      } // end of parallel region
+
+      // calculate new adaptive step sigma angle for each replica
+      if(montecarlo::algorithm == montecarlo::adaptive){
+         for(int r=0; r<R; ++r){
+            const double last_rejection_rate = statistics_reject[r] / double(nmoves);
+            const double factor = 0.5 / last_rejection_rate;
+            adaptive_sigma[r] *= factor;
+            // check for excessive range (too small angle takes too long to grow, too large does not improve performance) and truncate
+            if (adaptive_sigma[r] > 60.0 || adaptive_sigma[r] < 1e-5) adaptive_sigma[r] = 60.0;
+         }
+      }
+
+      // Save statistics to sim namespace variable
+      for(int r=0; r<R; ++r){
+         sim::mc_statistics_moves += double(nmoves);
+         sim::mc_statistics_reject += statistics_reject[r];
+      }
+
+      return;
+
+   }
+
+} // End of namespace montecarlo
@@ -161,6 +161,62 @@ void mc_adaptive(const std::vector<double>& old_spin, std::vector<double>& new_s
    return;
 }
 
+//-----------------------------------------------------------------------------------------
+/// Trial move for one replica of a batch, using the random number generator of
+/// that replica and explicit trial widths instead of the shared module state, so
+/// that replicas can be moved concurrently on different threads.
+//-----------------------------------------------------------------------------------------
+void mc_move(const std::vector<double>& old_spin, std::vector<double>& new_spin,
+             const double delta_angle, const double sigma, replica_rng_t& rng){
+
+   // Reference enum list for readability
+   using namespace montecarlo;
+
+   algorithm_t move = algorithm;
+
+   // Select random move type for combination move
+   if(move == hinzke_nowak){
+      const int pick_move = int(3.0*rng.uniform(rng.generator));
+      if(pick_move == 0)      move = spin_flip;
+      else if(pick_move == 1) move = uniform;
+      else                    move = angle;
+   }
+
+   switch(move){
+
+      case spin_flip:
+         mc_spin_flip(old_spin, new_spin);
+         return;
+
+      case uniform:
+         new_spin[0] = rng.gaussian(rng.generator);
+         new_spin[1] = rng.gaussian(rng.generator);
+         new_spin[2] = rng.gaussian(rng.generator);
+         break;
+
+      default:{
+         // angle and adaptive moves differ only in width of cone
+         const double width = move == angle ? delta_angle : sigma;
+         new_spin[0] = old_spin[0] + rng.gaussian(rng.generator) * width;
+         new_spin[1] = old_spin[1] + rng.gaussian(rng.generator) * width;
+         new_spin[2] = old_spin[2] + rng.gaussian(rng.generator) * width;
+         break;
+      }
+
+   }
+
+   // Calculate new spin length
+   const double r = 1.0/sqrt (new_spin[0]*new_spin[0]+new_spin[1]*new_spin[1]+new_spin[2]*new_spin[2]);
+
+   // Apply normalisation
+   new_spin[0] *= r;
+   new_spin[1] *= r;
+   new_spin[2] *= r;
+
+   return;
+
+}
+
 } //end of namespace internal
 
 } //end of namespace montecarlo
@@ -20,6 +20,7 @@
 #include "random.hpp"
 #include "sim.hpp"
 #include "vmpi.hpp"
+#include "vprofile.hpp"
 
 // Internal header
 #include "internal.hpp"
@@ -271,7 +272,10 @@ void mc_step_parallel(std::vector<double> &x_spin_array,
       vmpi::TotalComputeTime+=vmpi::SwapTimer(vmpi::ComputeTime, vmpi::WaitTime);
 
       // Wait for other processors
-      vmpi::barrier();
+      {
+         VPROFILE_SCOPE(vprofile::mpi_wait);
+         vmpi::barrier();
+      }
 
       // Swap timers wait -> compute
       vmpi::TotalWaitTime += vmpi::SwapTimer(vmpi::WaitTime, vmpi::ComputeTime);
@@ -0,0 +1,161 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// Standard Libraries
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// OpenMP header
+#ifdef _OPENMP
+   #include <omp.h>
+#endif
+
+// Vampire Header files
+#include "exchange.hpp"
+#include "random.hpp"
+#include "sim.hpp"
+
+// Internal header
+#include "internal.hpp"
+
+namespace montecarlo{
+
+//------------------------------------------------------------------------------
+// Attempts to exchange the configurations of neighbouring replicas a and
+// b = a+1 of a batch stored replica interleaved [atom][component][replica],
+// for a = offset, offset+2, ... Each replica has its own Hamiltonian through
+// its temperature and applied field, so the swap is accepted with probability
+//
+//    P = min(1, exp(-beta_a [E_a(x_b) - E_a(x_a)] - beta_b [E_b(x_a) - E_b(x_b)]))
+//
+// which reduces to the usual exp[(beta_a - beta_b)(E_a - E_b)] for temperature
+// independent Hamiltonians. Energies are accumulated per material so that the
+// material dependent temperature rescaling of mc_step is consistent. When
+// compiled with OpenMP the energies are accumulated over atoms on each thread
+// and summed in thread order, so results do not depend on thread timing.
+//------------------------------------------------------------------------------
+void replica_exchange(std::vector<double>& spin_array,             // replica interleaved spins
+                      const int num_replicas,
+                      const int num_atoms,
+                      const std::vector<int>& type_array,
+                      const std::vector<double>& temperature,      // temperature of each replica
+                      const std::vector<double>& applied_field,    // applied field strength of each replica
+                      const int offset,                            // first replica of first pair (0 or 1)
+                      std::vector<double>& attempts,               // number of exchange attempts for each pair
+                      std::vector<double>& accepts){               // number of accepted exchanges for each pair
+
+      const int R = num_replicas;
+      const int num_materials = internal::num_materials;
+
+      // Material dependent inverse thermal energy (1/J) for each replica [replica][material]
+      std::vector<double> beta(R*num_materials);
+      for(int r=0; r<R; ++r){
+         for(int m=0; m<num_materials; ++m){
+            double alpha = internal::temperature_rescaling_alpha[m];
+            double Tc = internal::temperature_rescaling_Tc[m];
+            double rescaled_temperature = temperature[r] < Tc ? Tc*pow(temperature[r]/Tc,alpha) : temperature[r];
+            beta[r*num_materials+m] = 1.0/(rescaled_temperature*1.3806503e-23);
+         }
+      }
+
+      // Energies of each pair [pair][material] as E_a(x_a), E_a(x_b), E_b(x_a), E_b(x_b) in Joules
+      const int num_energies = 4*R*num_materials;
+
+      #ifdef _OPENMP
+         const int num_threads = omp_get_max_threads();
+      #else
+         const int num_threads = 1;
+      #endif
+
+      // energies accumulated on each thread
+      std::vector<double> thread_energy(num_threads*num_energies, 0.0);
+
+      #ifdef _OPENMP
+      #pragma omp parallel
+      #endif
+      {
+
+         #ifdef _OPENMP
+            const int thread = omp_get_thread_num();
+         #else
+            const int thread = 0;
+         #endif
+
+         double* energy = &thread_energy[thread*num_energies];
+
+         // exchange fields for all replicas of each site [component][replica]
+         std::vector<double> exchange_field(3*R);
+
+         #ifdef _OPENMP
+         #pragma omp for schedule(static)
+         #endif
+         for(int atom=0; atom<num_atoms; atom++){
+
+            const int imaterial = type_array[atom];
+            const double mu_s = internal::mu_s_SI[imaterial];
+
+            exchange::replica_fields(atom, R, spin_array, exchange_field);
+
+            const double* s = &spin_array[3*R*atom];
+            const double* h = exchange_field.data();
+
+            for(int a=offset; a+1<R; a+=2){
+
+               const int b = a+1;
+
+               // exchange energy is independent of replica conditions and is halved to avoid double counting
+               const double ex_a = -0.5*(h[a]*s[a] + h[R+a]*s[R+a] + h[2*R+a]*s[2*R+a]);
+               const double ex_b = -0.5*(h[b]*s[b] + h[R+b]*s[R+b] + h[2*R+b]*s[2*R+b]);
+
+               double* e = &energy[4*(a*num_materials+imaterial)];
+               e[0] += mu_s*(ex_a + sim::spin_onsite_energy(atom, imaterial, s[a], s[R+a], s[2*R+a], temperature[a], applied_field[a]));
+               e[1] += mu_s*(ex_b + sim::spin_onsite_energy(atom, imaterial, s[b], s[R+b], s[2*R+b], temperature[a], applied_field[a]));
+               e[2] += mu_s*(ex_a + sim::spin_onsite_energy(atom, imaterial, s[a], s[R+a], s[2*R+a], temperature[b], applied_field[b]));
+               e[3] += mu_s*(ex_b + sim::spin_onsite_energy(atom, imaterial, s[b], s[R+b], s[2*R+b], temperature[b], applied_field[b]));
+
+            }
+         }
+
+      } // end of parallel region
+
+      // sum energies of all threads
+      std::vector<double> energy(thread_energy.begin(), thread_energy.begin() + num_energies);
+      for(int t=1; t<num_threads; t++){
+         for(int i=0; i<num_energies; i++) energy[i] += thread_energy[t*num_energies + i];
+      }
+
+      for(int a=offset; a+1<R; a+=2){
+
+         const int b = a+1;
+
+         // exchange is only defined between replicas at finite temperature
+         if(temperature[a] <= 0.0 || temperature[b] <= 0.0) continue;
+
+         double log_probability = 0.0;
+         for(int m=0; m<num_materials; ++m){
+            const double* e = &energy[4*(a*num_materials+m)];
+            log_probability -= beta[a*num_materials+m]*(e[1]-e[0]) + beta[b*num_materials+m]*(e[2]-e[3]);
+         }
+
+         attempts[a] += 1.0;
+
+         if(log_probability >= 0.0 || exp(log_probability) >= mtrandom::grnd()){
+            accepts[a] += 1.0;
+            for(int i=0; i<3*num_atoms; i++) std::swap(spin_array[i*R+a], spin_array[i*R+b]);
+         }
+
+      }
+
+      return;
+
+   }
+
+} // End of namespace montecarlo
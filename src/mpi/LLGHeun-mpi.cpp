@@ -29,6 +29,7 @@
 #include "LLG.hpp"
 #include "sim.hpp"
 #include "vmpi.hpp"
+#include "vprofile.hpp"
 
 #include <cmath>
 
@@ -302,7 +303,10 @@ int LLG_Heun_mpi(){
 	vmpi::TotalComputeTime+=vmpi::SwapTimer(vmpi::ComputeTime, vmpi::WaitTime);
 
 	// Wait for other processors
-	vmpi::barrier();
+	{
+		VPROFILE_SCOPE(vprofile::mpi_wait);
+		vmpi::barrier();
+	}
 
 	// Swap timers wait -> compute
 	vmpi::TotalWaitTime+=vmpi::SwapTimer(vmpi::WaitTime, vmpi::ComputeTime);
@@ -30,6 +30,7 @@
 #include "LLG.hpp"
 #include "sim.hpp"
 #include "vmpi.hpp"
+#include "vprofile.hpp"
 
 // Standard Libraries
 #include <cmath>
@@ -229,7 +230,10 @@ int LLG_Midpoint_mpi(){
 	}
 
 	// Wait for other processors
-	vmpi::barrier();
+	{
+		VPROFILE_SCOPE(vprofile::mpi_wait);
+		vmpi::barrier();
+	}
 
 	return EXIT_SUCCESS;
 }
@@ -18,6 +18,7 @@
 #include "random.hpp"
 #include "lsf.hpp"
 #include "vio.hpp"
+#include "vprofile.hpp"
 #include "../simulate/internal.hpp"
 
 #include <cmath>
@@ -329,7 +330,10 @@ int LSF_mpi(){
 	vmpi::TotalComputeTime+=vmpi::SwapTimer(vmpi::ComputeTime, vmpi::WaitTime);
 
 	// Wait for other processors
-	vmpi::barrier();
+	{
+		VPROFILE_SCOPE(vprofile::mpi_wait);
+		vmpi::barrier();
+	}
 
 	// Swap timers wait -> compute
 	vmpi::TotalWaitTime+=vmpi::SwapTimer(vmpi::WaitTime, vmpi::ComputeTime);
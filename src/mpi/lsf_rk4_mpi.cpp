@@ -18,6 +18,7 @@
 #include "random.hpp"
 #include "lsf_rk4.hpp"
 #include "vio.hpp"
+#include "vprofile.hpp"
 #include "../simulate/internal.hpp"
 
 #include <cmath>
@@ -468,7 +469,10 @@ int LSF_RK4_mpi(){
 	vmpi::TotalComputeTime+=vmpi::SwapTimer(vmpi::ComputeTime, vmpi::WaitTime);
 
 	// Wait for other processors
-	vmpi::barrier();
+	{
+		VPROFILE_SCOPE(vprofile::mpi_wait);
+		vmpi::barrier();
+	}
 
 	// Swap timers wait -> compute
 	vmpi::TotalWaitTime+=vmpi::SwapTimer(vmpi::WaitTime, vmpi::ComputeTime);
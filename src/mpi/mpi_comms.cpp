@@ -39,6 +39,7 @@
 #include "atoms.hpp"
 #include "errors.hpp"
 #include "vmpi.hpp"
+#include "vprofile.hpp"
 #include <iostream>
 #include <iomanip>
 #include <fstream>
@@ -141,8 +142,11 @@ void mpi_complete_halo_swap(){
 	vmpi::TotalComputeTime+=vmpi::SwapTimer(vmpi::ComputeTime, vmpi::WaitTime);
 
 	// Wait for all comms to complete
-	vmpi::stati.resize(vmpi::requests.size());
-	MPI_Waitall(vmpi::requests.size(),&vmpi::requests[0],&vmpi::stati[0]);
+	{
+		VPROFILE_SCOPE(vprofile::mpi_wait);
+		vmpi::stati.resize(vmpi::requests.size());
+		MPI_Waitall(vmpi::requests.size(),&vmpi::requests[0],&vmpi::stati[0]);
+	}
 
 	// Swap timers wait -> compute
 	vmpi::TotalWaitTime+=vmpi::SwapTimer(vmpi::WaitTime, vmpi::ComputeTime);
@@ -237,8 +241,11 @@ void mpi_complete_halo_swap_coords(){
 	vmpi::TotalComputeTime+=vmpi::SwapTimer(vmpi::ComputeTime, vmpi::WaitTime);
 
 	// Wait for all comms to complete
-	vmpi::stati.resize(vmpi::requests.size());
-	MPI_Waitall(vmpi::requests.size(),&vmpi::requests[0],&vmpi::stati[0]);
+	{
+		VPROFILE_SCOPE(vprofile::mpi_wait);
+		vmpi::stati.resize(vmpi::requests.size());
+		MPI_Waitall(vmpi::requests.size(),&vmpi::requests[0],&vmpi::stati[0]);
+	}
 
 	// Swap timers wait -> compute
 	vmpi::TotalWaitTime+=vmpi::SwapTimer(vmpi::WaitTime, vmpi::ComputeTime);
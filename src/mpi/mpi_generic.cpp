@@ -75,6 +75,9 @@ void initialise(int argc, char *argv[]){
 	// Start MPI Timer
 	vmpi::start_time = MPI_Wtime();
 	hostname = name;
+
+	// Set up communicators for node level shared memory
+	vmpi::initialise_shared_memory();
 #else
 
    // set master flag on master (root) process (serial)
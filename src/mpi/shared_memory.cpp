@@ -0,0 +1,229 @@
+//-----------------------------------------------------------------------------
+//
+// This source file is part of the VAMPIRE open source package under the
+// GNU GPL (version 2) licence (see licence file for details).
+//
+// (c) agent 2026. All rights reserved.
+//
+//-----------------------------------------------------------------------------
+
+// C++ standard library headers
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <iostream>
+
+// Vampire headers
+#include "errors.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+// Shared memory windows require MPI-3
+#if defined(MPICF) && defined(MPI_VERSION) && MPI_VERSION >= 3
+   #define VMPI_SHARED_MEMORY
+#endif
+
+namespace vmpi{
+
+   int my_node_rank = 0;        // rank of processor within shared memory node
+   int num_node_processors = 1; // number of processors sharing memory on node
+#ifdef MPICF
+   MPI_Comm node_comm = MPI_COMM_NULL;        // communicator for processors on the same node
+   MPI_Comm node_master_comm = MPI_COMM_NULL; // communicator for node master processors
+#endif
+
+//------------------------------------------------------------------------------
+// Function to determine which processors share memory and create node and
+// node master communicators
+//------------------------------------------------------------------------------
+void initialise_shared_memory(){
+
+#ifdef VMPI_SHARED_MEMORY
+
+   MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, vmpi::my_rank, MPI_INFO_NULL, &vmpi::node_comm);
+   MPI_Comm_rank(vmpi::node_comm, &vmpi::my_node_rank);
+   MPI_Comm_size(vmpi::node_comm, &vmpi::num_node_processors);
+
+   // communicator between one processor per node for exchanging shared data
+   const int colour = (vmpi::my_node_rank == 0) ? 0 : MPI_UNDEFINED;
+   MPI_Comm_split(MPI_COMM_WORLD, colour, vmpi::my_rank, &vmpi::node_master_comm);
+
+#elif defined(MPICF)
+
+   // without shared memory every processor is its own node
+   MPI_Comm_dup(MPI_COMM_SELF, &vmpi::node_comm);
+   MPI_Comm_dup(MPI_COMM_WORLD, &vmpi::node_master_comm);
+
+#endif
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Shared memory class functions
+//------------------------------------------------------------------------------
+shared_memory_t::shared_memory_t():
+   ptr(NULL),
+   num_bytes(0)
+#ifdef MPICF
+   ,window_allocated(false)
+#endif
+{
+   return;
+}
+
+shared_memory_t::~shared_memory_t(){
+   release();
+}
+
+void shared_memory_t::allocate(uint64_t bytes){
+
+   // free existing data first
+   release();
+
+   num_bytes = bytes;
+
+#ifdef VMPI_SHARED_MEMORY
+
+   // allocate all memory on node master and none on other processors
+   const MPI_Aint local_bytes = (vmpi::my_node_rank == 0) ? MPI_Aint(bytes) : 0;
+   void* local_ptr = NULL;
+   MPI_Win_allocate_shared(local_bytes, 1, MPI_INFO_NULL, vmpi::node_comm, &local_ptr, &window);
+   window_allocated = true;
+
+   // get pointer to memory of node master
+   MPI_Aint size = 0;
+   int disp_unit = 1;
+   MPI_Win_shared_query(window, 0, &size, &disp_unit, &ptr);
+
+   // open passive epoch for the lifetime of the window so that MPI_Win_sync is valid
+   MPI_Win_lock_all(MPI_MODE_NOCHECK, window);
+
+   // zero memory on node master
+   if(vmpi::my_node_rank == 0 && bytes > 0) std::memset(ptr, 0, bytes);
+   sync();
+
+   zlog << zTs() << "Allocated " << double(bytes)/1.0e6 << " MB of shared memory for " << vmpi::num_node_processors << " processors on node" << std::endl;
+
+#else
+
+   local_data.assign(bytes, 0);
+   ptr = local_data.data();
+
+#endif
+
+   return;
+
+}
+
+void shared_memory_t::release(){
+
+#ifdef VMPI_SHARED_MEMORY
+   if(window_allocated){
+      // do not free window after MPI has been finalised (global objects)
+      int finalized = 0;
+      MPI_Finalized(&finalized);
+      if(!finalized){
+         MPI_Win_unlock_all(window);
+         MPI_Win_free(&window);
+      }
+      window_allocated = false;
+   }
+#endif
+
+   std::vector<char>().swap(local_data);
+   ptr = NULL;
+   num_bytes = 0;
+
+   return;
+
+}
+
+void shared_memory_t::sync(){
+
+#ifdef VMPI_SHARED_MEMORY
+   if(window_allocated){
+      MPI_Win_sync(window);
+      MPI_Barrier(vmpi::node_comm);
+      MPI_Win_sync(window);
+   }
+#endif
+
+   return;
+
+}
+
+bool shared_memory_t::writer() const{
+#ifdef VMPI_SHARED_MEMORY
+   return vmpi::my_node_rank == 0;
+#else
+   return true;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Function to gather data from all processors into a shared array. Each
+// processor writes num_local values at the given offset, and the node
+// masters then combine the contributions of all nodes.
+//------------------------------------------------------------------------------
+void all_gather_shared(const double* local, uint64_t num_local, uint64_t offset, shared_array_t<double>& global){
+
+#ifdef VMPI_SHARED_MEMORY
+
+   // zero node copy on node master once all processors on the node have
+   // finished with it, so that data from any previous gather is not summed
+   // again between nodes
+   double* global_data = global.data();
+   global.sync();
+   if(vmpi::my_node_rank == 0) std::fill(global_data, global_data + global.size(), 0.0);
+   global.sync();
+
+   // write local data directly into node copy
+   for(uint64_t i = 0; i < num_local; i++) global_data[offset + i] = local[i];
+   global.sync();
+
+   // sum disjoint contributions of all nodes on node masters, in chunks as
+   // MPI counts are limited to int
+   if(vmpi::node_master_comm != MPI_COMM_NULL){
+      const uint64_t max_chunk = INT_MAX;
+      for(uint64_t start = 0; start < global.size(); start += max_chunk){
+         const int chunk = std::min(max_chunk, global.size() - start);
+         MPI_Allreduce(MPI_IN_PLACE, global_data + start, chunk, MPI_DOUBLE, MPI_SUM, vmpi::node_master_comm);
+      }
+   }
+   global.sync();
+
+#elif defined(MPICF)
+
+   // MPI counts and displacements are int, so the gathered array must be indexable by int
+   if(global.size() > uint64_t(INT_MAX)){
+      terminaltextcolor(RED);
+      std::cerr << "Error - shared array of " << global.size() << " elements is too large to gather without MPI-3 shared memory. Exiting." << std::endl;
+      terminaltextcolor(WHITE);
+      zlog << zTs() << "Error - shared array of " << global.size() << " elements is too large to gather without MPI-3 shared memory. Exiting." << std::endl;
+      err::vexit();
+   }
+
+   // gather sizes and offsets of data on all processors
+   int my_count = num_local;
+   int my_offset = offset;
+   std::vector<int> counts(vmpi::num_processors, 0);
+   std::vector<int> displacements(vmpi::num_processors, 0);
+   MPI_Allgather(&my_count,  1, MPI_INT, &counts[0],        1, MPI_INT, MPI_COMM_WORLD);
+   MPI_Allgather(&my_offset, 1, MPI_INT, &displacements[0], 1, MPI_INT, MPI_COMM_WORLD);
+
+   MPI_Allgatherv(const_cast<double*>(local), my_count, MPI_DOUBLE, global.data(), &counts[0], &displacements[0], MPI_DOUBLE, MPI_COMM_WORLD);
+
+#else
+
+   double* global_data = global.data();
+   for(uint64_t i = 0; i < num_local; i++) global_data[offset + i] = local[i];
+
+#endif
+
+   return;
+
+}
+
+} // end of vmpi namespace
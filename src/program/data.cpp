@@ -52,6 +52,12 @@ namespace program{
       double exchange_stiffness_max_constraint_angle   = 180.01; // degrees
       double exchange_stiffness_delta_constraint_angle =  5; // 22.5 degrees
 
+      //------------------------------------------------------------------------
+      // Parallel tempering program
+      //------------------------------------------------------------------------
+      uint64_t parallel_tempering_swap_interval = 10;  // time steps between replica exchange attempts
+      bool parallel_tempering_adaptive_ladder = true;  // flag to adapt temperature ladder during equilibration
+
       //------------------------------------------------------------------------
       // Material specific program parameters
       //------------------------------------------------------------------------
@@ -130,6 +130,11 @@ namespace program{
             program::program = 18;
             return true;
          }
+         test="parallel-tempering";
+         if(value==test){
+            program::program = 19;
+            return true;
+         }
          test="diagnostic-boltzmann";
          if(value==test){
             program::program=50;
@@ -192,6 +197,7 @@ namespace program{
             std::cerr << "\t\"laser-pulse\"" << std::endl;
             std::cerr << "\t\"localised-field-cool\"" << std::endl;
             std::cerr << "\t\"localised-temperature-pulse\"" << std::endl;
+            std::cerr << "\t\"parallel-tempering\"" << std::endl;
             std::cerr << "\t\"time-series\"" << std::endl;
             std::cerr << "\t\"hysteresis-loop\"" << std::endl;
             std::cerr << "\t\"partial-hysteresis-loop\"" << std::endl;
@@ -258,6 +264,21 @@ namespace program{
          program::internal::field_pulse_time = pt;
          return true;
       }
+      //-------------------------------------------------------------------
+      test = "parallel-tempering-swap-interval";
+      if(word == test){
+         int si = atoi(value.c_str());
+         vin::check_for_valid_int(si, word, line, prefix, 1, 1000000,"input","1 - 1,000,000");
+         program::internal::parallel_tempering_swap_interval = si;
+         return true;
+      }
+      //-------------------------------------------------------------------
+      test = "parallel-tempering-adaptive-ladder";
+      if(word == test){
+         bool tf = vin::check_for_valid_bool(value, word, line, prefix, "input");
+         program::internal::parallel_tempering_adaptive_ladder = tf;
+         return true;
+      }
       //--------------------------------------------------------------------
       // Keyword not found
       //--------------------------------------------------------------------
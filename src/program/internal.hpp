@@ -20,6 +20,7 @@
 //---------------------------------------------------------------------
 
 // C++ standard library headers
+#include <cstdint>
 #include <vector>
 
 // Vampire headers
@@ -83,6 +84,12 @@ namespace program{
       extern double exchange_stiffness_max_constraint_angle; // degrees
       extern double exchange_stiffness_delta_constraint_angle; // degrees
 
+      //------------------------------------------------------------------------
+      // Parallel tempering program
+      //------------------------------------------------------------------------
+      extern uint64_t parallel_tempering_swap_interval; // time steps between replica exchange attempts
+      extern bool parallel_tempering_adaptive_ladder;   // flag to adapt temperature ladder during equilibration
+
       //------------------------------------------------------------------------
       // Material level parameters
       //------------------------------------------------------------------------
@@ -91,6 +98,7 @@ namespace program{
       //-------------------------------------------------------------------------
       // Internal function declarations
       //-------------------------------------------------------------------------
+      void adapt_temperature_ladder(std::vector<double>& ladder, const std::vector<double>& acceptance);
 
    } // end of internal namespace
 
@@ -124,8 +124,11 @@ void lagrange_multiplier(){
          // Reset start time
          int start_time=sim::time;
 
-         // Simulate system
-         while(sim::time<sim::loop_time+start_time){
+         // Minimise energy directly if minimiser is set
+         if(sim::minimiser != sim::no_minimiser) sim::minimise(sim::loop_time);
+
+         // Otherwise simulate system
+         else while(sim::time<sim::loop_time+start_time){
 
             // Integrate system
             sim::integrate(sim::partial_time);
@@ -0,0 +1,167 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// Vampire headers
+#include "ensemble.hpp"
+#include "errors.hpp"
+#include "program.hpp"
+#include "sim.hpp"
+#include "stats.hpp"
+#include "vio.hpp"
+
+// program module headers
+#include "internal.hpp"
+
+// namespace abbreviation for brevity
+namespace pgi = program::internal;
+
+namespace program{
+
+namespace internal{
+
+//------------------------------------------------------------------------------
+// Function to set new spacing of temperature ladder from exchange acceptance
+// rates. Gaps in log(T) are scaled by the square root of the acceptance of each
+// pair relative to the mean so that the ladder converges to uniform acceptance
+// with fixed end points.
+//------------------------------------------------------------------------------
+void adapt_temperature_ladder(std::vector<double>& ladder, const std::vector<double>& acceptance){
+
+   const int num_gaps = acceptance.size();
+
+   double mean_acceptance = 0.0;
+   for(int r = 0; r < num_gaps; r++) mean_acceptance += acceptance[r];
+   mean_acceptance /= double(num_gaps);
+
+   std::vector<double> gap(num_gaps);
+   double total_gap = 0.0;
+   for(int r = 0; r < num_gaps; r++){
+      gap[r] = log(ladder[r+1]/ladder[r]) * sqrt((acceptance[r] + 0.05)/(mean_acceptance + 0.05));
+      total_gap += gap[r];
+   }
+
+   // rescale gaps to preserve minimum and maximum temperatures
+   const double scale = log(ladder[num_gaps]/ladder[0]) / total_gap;
+   for(int r = 0; r < num_gaps; r++) ladder[r+1] = ladder[r] * exp(gap[r] * scale);
+
+   return;
+
+}
+
+} // end of namespace internal
+
+//------------------------------------------------------------------------------
+// Function to calculate equilibrium properties over a range of temperatures
+// using parallel tempering (replica exchange) Monte Carlo. Each replica of the
+// ensemble is held at one temperature of a ladder between sim:minimum-temperature
+// and sim:maximum-temperature and configurations of neighbouring temperatures
+// are exchanged periodically. The ladder is initially geometric and optionally
+// adapted to equal exchange acceptance during equilibration. Statistics for
+// each temperature are output to the replica output files.
+//------------------------------------------------------------------------------
+void parallel_tempering(){
+
+   // check calling of routine if error checking is activated
+   if(err::check==true){std::cout << "program::parallel_tempering has been called" << std::endl;}
+
+   const int R = ensemble::get_num_replicas();
+
+   if(!ensemble::enabled){
+      terminaltextcolor(RED);
+      std::cerr << "Error - parallel-tempering program requires ensemble:num-replicas > 1. Exiting." << std::endl;
+      terminaltextcolor(WHITE);
+      zlog << zTs() << "Error - parallel-tempering program requires ensemble:num-replicas > 1. Exiting." << std::endl;
+      err::vexit();
+   }
+   if(sim::Tmin <= 0.0 || sim::Tmax <= sim::Tmin){
+      terminaltextcolor(RED);
+      std::cerr << "Error - parallel-tempering program requires 0 < sim:minimum-temperature < sim:maximum-temperature. Exiting." << std::endl;
+      terminaltextcolor(WHITE);
+      zlog << zTs() << "Error - parallel-tempering program requires 0 < sim:minimum-temperature < sim:maximum-temperature. Exiting." << std::endl;
+      err::vexit();
+   }
+
+   // Set geometric temperature ladder, with replica 0 at minimum temperature
+   std::vector<double> ladder(R);
+   for(int r = 0; r < R; r++) ladder[r] = sim::Tmin * pow(sim::Tmax/sim::Tmin, double(r)/double(R-1));
+
+   sim::temperature = ladder[0];
+   ensemble::set_temperature_ladder(ladder);
+
+   std::vector<double> acceptance;
+
+   // number of exchange attempts between adaptations of the ladder
+   const int adaptation_period = 500;
+   int num_attempts = 0;
+
+   // Equilibrate system with exchange between replicas
+   uint64_t start_time = sim::time;
+   while(sim::time < sim::equilibration_time + start_time){
+
+      sim::integrate(pgi::parallel_tempering_swap_interval);
+
+      ensemble::attempt_replica_exchange();
+      num_attempts++;
+
+      if(pgi::parallel_tempering_adaptive_ladder && num_attempts % adaptation_period == 0){
+         ensemble::get_exchange_acceptance(acceptance);
+         pgi::adapt_temperature_ladder(ladder, acceptance);
+         ensemble::set_temperature_ladder(ladder);
+         ensemble::reset_exchange_statistics();
+      }
+
+   }
+
+   zlog << zTs() << "Parallel tempering temperature ladder:";
+   for(int r = 0; r < R; r++) zlog << " " << ladder[r];
+   zlog << std::endl;
+
+   // Reset mean magnetisation counters and exchange statistics
+   stats::reset();
+   ensemble::reset_exchange_statistics();
+
+   // Simulate system at fixed ladder, updating statistics every partial_time
+   start_time = sim::time;
+   uint64_t last_update_time = sim::time;
+   while(sim::time < sim::total_time + start_time){
+
+      sim::integrate(pgi::parallel_tempering_swap_interval);
+
+      ensemble::attempt_replica_exchange();
+
+      if(sim::time - last_update_time >= sim::partial_time){
+
+         last_update_time = sim::time;
+
+         // Calculate magnetisation statistics
+         stats::update();
+
+         // Output data
+         vout::data();
+
+      }
+
+   }
+
+   ensemble::get_exchange_acceptance(acceptance);
+   zlog << zTs() << "Parallel tempering exchange acceptance:";
+   for(int r = 0; r < R-1; r++) zlog << " " << acceptance[r];
+   zlog << std::endl;
+
+   return;
+
+}
+
+} // end of namespace program
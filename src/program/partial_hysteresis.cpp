@@ -59,7 +59,8 @@ void partial_hysteresis_loop(){
 
    // Equilibrate system in saturation field
    sim::H_applied=sim::Heq;
-   sim::integrate(sim::equilibration_time);
+   if(sim::minimiser != sim::no_minimiser) sim::minimise(sim::equilibration_time);
+   else sim::integrate(sim::equilibration_time);
 
    // Setup min and max fields and increment (uT)
    int64_t iHmax=vmath::iround64(double(sim::Hmax)*1.0E6);
@@ -88,8 +89,17 @@ void partial_hysteresis_loop(){
       // Reset mean magnetisation counters
       stats::reset();
 
-      // Integrate system
-      while(sim::time<sim::loop_time+start_time){
+      // Minimise energy directly for a quasi-static loop if minimiser is set
+      if(sim::minimiser != sim::no_minimiser){
+
+         sim::minimise(sim::loop_time);
+
+         // Calculate mag_m, mag
+         stats::update();
+
+      }
+      // Otherwise integrate system
+      else while(sim::time<sim::loop_time+start_time){
 
          // Integrate system
          sim::integrate(sim::partial_time);
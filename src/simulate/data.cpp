@@ -20,6 +20,7 @@ namespace sim{
    // Shared variables used with main vampire code
    //---------------------------------------------------------------------------
    integrator_t integrator = llg_heun; // variable to specify integrator
+   minimiser_t minimiser = no_minimiser; // energy minimiser used by quasi-static programs
 
 
    std::vector < double > track_field_x;
@@ -94,6 +95,18 @@ namespace sim{
 
       std::vector<double> vcmak;   // voltage controlled anisotropy coefficient
 
+      noise_interpolation_t noise_interpolation = linear_noise; // scheme used to interpolate coarse noise
+      bool noise_benchmark = false; // flag to report spectral error and memory of all schemes
+      double noise_temperature_tolerance = 0.01; // relative change in temperature before noise is refiltered
+      uint64_t noise_period = 0; // time steps after which noise repeats (0 = equilibration time)
+
+      std::vector<quantum_bath_t> quantum_bath; // array of quantum thermostat bath coefficients
+
+      double adaptive_tolerance = 1.0e-5; // maximum spin angle error per step of adaptive LLG integrator (rad)
+      double adaptive_maximum_step_ratio = 100.0; // maximum step of adaptive LLG integrator in units of time step
+
+      double minimiser_torque_tolerance = 1.0e-6; // maximum torque on any spin at convergence of minimiser (T)
+
       std::vector<double> lsf_second_order_coefficient;
       std::vector<double> lsf_fourth_order_coefficient; // LSF coefficients
       std::vector<double> lsf_sixth_order_coefficient;
@@ -114,24 +127,22 @@ namespace sim{
    std::vector <double> y_v_array;
    std::vector <double> z_v_array;
 
-   // Storage arrays for RK4
-   std::vector<std::vector<double>> k1_storage;
-   std::vector<std::vector<double>> k2_storage;
-   std::vector<std::vector<double>> k3_storage;
-   std::vector<std::vector<double>> k4_storage;
-   std::vector<std::vector<double>> y_pred_storage;
-   std::vector<std::vector<double>> y_in_storage;
+   // Structure of arrays for fused RK4 stages, component c of atom i stored at c*num_atoms+i
+   std::vector<double> rk4_spin_initial; //< Spin at start of step (3 components)
+   std::vector<double> rk4_aux_stage;    //< Auxiliary variables v and w of stage state (6 components)
+   std::vector<double> rk4_sum;          //< Weighted sum of stage derivatives (9 components)
 
    // Arrays for noise generation (now storing coarse-grained noise)
    std::vector<double> coarse_noise_field;
    std::vector<double> sqrt_PSD_buffer; // Restored buffer
    double noise_index;
-   int M_decimation;    //< Decimation factor for noise interpolation
+   std::vector<noise_group_t> noise_groups; //< Noise groups for each material
+   double noise_temperature = 0.0; //< Temperature of current noise
 
    // Indices for random fields
-   std::vector<double> atom_idx_x;
-   std::vector<double> atom_idx_y;
-   std::vector<double> atom_idx_z;
+   std::vector<uint64_t> atom_idx_x;
+   std::vector<uint64_t> atom_idx_y;
+   std::vector<uint64_t> atom_idx_z;
 
    bool LLG_set=false; ///< Flag to define state of LLG arrays (initialised/uninitialised)
 
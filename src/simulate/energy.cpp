@@ -224,4 +224,31 @@ double calculate_spin_energy(const int atom){
 	return energy; // Tesla
 }
 
+//------------------------------------------------------------------------------
+// Calculates the on-site energy of a single spin for a given spin direction,
+// temperature and applied field strength. Includes anisotropy, applied field,
+// local applied field and vcma terms but not exchange or magnetostatic terms,
+// allowing replicas at different temperatures and fields to share one set of
+// pairwise interactions.
+//------------------------------------------------------------------------------
+double spin_onsite_energy(const int atom, const int imaterial, const double sx, const double sy, const double sz,
+                          const double temperature, const double applied_field){
+
+   // calculate anisotropy energy for atom
+   double energy = anisotropy::single_spin_energy(atom, imaterial, sx, sy, sz, temperature);
+
+   // applied field energy
+   energy -= applied_field*(sim::H_vec[0]*sx + sim::H_vec[1]*sy + sim::H_vec[2]*sz);
+
+   // local applied fields
+   if(sim::local_applied_field) energy += spin_local_applied_field_energy(imaterial, sx, sy, sz);
+
+   // vcma energy
+   const double vcma = program::fractional_electric_field_strength * spin_transport::get_voltage() * sim::internal::vcmak[imaterial];
+   energy -= vcma * sz * sz;
+
+   return energy; // Tesla
+
+}
+
 } // end of namespace sim
@@ -47,6 +47,7 @@
 #include "spintransport.hpp"
 #include "stats.hpp"
 #include "vmpi.hpp"
+#include "vprofile.hpp"
 #include "../micromagnetic/internal.hpp"
 
 // sim module header
@@ -81,6 +82,9 @@ void calculate_spin_fields(const int start_index,const int end_index){
 	// check calling of routine if error checking is activated
 	if(err::check==true){std::cout << "calculate_spin_fields has been called" << std::endl;}
 
+	// time spent in function for profiling
+	VPROFILE_SCOPE(vprofile::spin_fields);
+
 	// Initialise Total Spin Fields to zero
 	fill (atoms::x_total_spin_field_array.begin()+start_index,atoms::x_total_spin_field_array.begin()+end_index,0.0);
 	fill (atoms::y_total_spin_field_array.begin()+start_index,atoms::y_total_spin_field_array.begin()+end_index,0.0);
@@ -89,29 +93,35 @@ void calculate_spin_fields(const int start_index,const int end_index){
    //-----------------------------------------
 	// Calculate exchange Fields
    //-----------------------------------------
-   exchange::fields(start_index, // first atom for exchange interactions to be calculated
-                    end_index, // last +1 atom to be calculated
-                    atoms::neighbour_list_start_index,
-                    atoms::neighbour_list_end_index,
-                    atoms::type_array, // type for atom
-                    atoms::neighbour_list_array, // list of interactions between atoms
-                    atoms::neighbour_interaction_type_array, // list of interaction type for each pair of atoms with value given in exchange list
-                    atoms::i_exchange_list, // list of isotropic exchange constants
-                    atoms::v_exchange_list, // list of vectorial exchange constants
-                    atoms::t_exchange_list, // list of tensorial exchange constants
-                    atoms::x_spin_array,
-                    atoms::y_spin_array,
-                    atoms::z_spin_array,
-                    atoms::x_total_spin_field_array,
-                    atoms::y_total_spin_field_array,
-                    atoms::z_total_spin_field_array);
+   {
+      VPROFILE_SCOPE(vprofile::exchange);
+      exchange::fields(start_index, // first atom for exchange interactions to be calculated
+                       end_index, // last +1 atom to be calculated
+                       atoms::neighbour_list_start_index,
+                       atoms::neighbour_list_end_index,
+                       atoms::type_array, // type for atom
+                       atoms::neighbour_list_array, // list of interactions between atoms
+                       atoms::neighbour_interaction_type_array, // list of interaction type for each pair of atoms with value given in exchange list
+                       atoms::i_exchange_list, // list of isotropic exchange constants
+                       atoms::v_exchange_list, // list of vectorial exchange constants
+                       atoms::t_exchange_list, // list of tensorial exchange constants
+                       atoms::x_spin_array,
+                       atoms::y_spin_array,
+                       atoms::z_spin_array,
+                       atoms::x_total_spin_field_array,
+                       atoms::y_total_spin_field_array,
+                       atoms::z_total_spin_field_array);
+   }
 
    //-----------------------------------------
    // calculate anistropy fields
    //-----------------------------------------
-   anisotropy::fields(atoms::x_spin_array, atoms::y_spin_array, atoms::z_spin_array, atoms::type_array,
-                      atoms::x_total_spin_field_array, atoms::y_total_spin_field_array, atoms::z_total_spin_field_array,
-                      start_index, end_index, sim::temperature);
+   {
+      VPROFILE_SCOPE(vprofile::anisotropy);
+      anisotropy::fields(atoms::x_spin_array, atoms::y_spin_array, atoms::z_spin_array, atoms::type_array,
+                         atoms::x_total_spin_field_array, atoms::y_total_spin_field_array, atoms::z_total_spin_field_array,
+                         start_index, end_index, sim::temperature);
+   }
 
 	// Spin Dependent Extra Fields
 	if(sim::lagrange_multiplier==true) calculate_lagrange_fields(start_index,end_index);
@@ -140,6 +150,9 @@ void calculate_external_fields(const int start_index,const int end_index){
 	//----------------------------------------------------------
 	if(err::check==true){std::cout << "calculate_external_fields has been called" << std::endl;}
 
+	// time spent in function for profiling
+	VPROFILE_SCOPE(vprofile::external_fields);
+
 	// Initialise Total External Fields to zero
 	fill (atoms::x_total_external_field_array.begin()+start_index,atoms::x_total_external_field_array.begin()+end_index,0.0);
 	fill (atoms::y_total_external_field_array.begin()+start_index,atoms::y_total_external_field_array.begin()+end_index,0.0);
@@ -298,6 +311,9 @@ int calculate_thermal_fields(const int start_index,const int end_index){
    // check calling of routine if error checking is activated
    if(err::check==true){std::cout << "calculate_thermal_fields has been called" << std::endl;}
 
+   // time spent in function for profiling
+   VPROFILE_SCOPE(vprofile::thermal_fields);
+
    // unroll sigma for speed
    std::vector<double> sigma_prefactor(0);
    sigma_prefactor.reserve(mp::material.size());
@@ -345,6 +361,9 @@ int calculate_dipolar_fields(const int start_index,const int end_index){
 	//----------------------------------------------------------
    if(err::check==true){std::cout << "calculate_dipolar_fields has been called" << std::endl;}
 
+   // time spent in function for profiling
+   VPROFILE_SCOPE(vprofile::dipole_fields);
+
    // Add dipolar fields
    if(dipole::activated){
       for(int atom=start_index;atom<end_index;atom++){
@@ -63,6 +63,26 @@ namespace sim{
 
       }
 
+      // Unroll quantum thermostat bath coefficients, where materials without
+      // their own bath inherit the parameters of the first material
+      sim::internal::quantum_bath.resize(num_materials);
+      for(int m = 0; m < num_materials; ++m){
+         sim::internal::quantum_bath_t& bath = sim::internal::quantum_bath[m];
+         bath.A      = 0.0;
+         bath.Gamma  = 0.0;
+         bath.omega0 = 0.0;
+         bath.S0     = 0.0;
+         for(int s = 0; s < 2; ++s){
+            // source of parameters, first material then this material
+            const unsigned int src = (s == 0) ? 0 : m;
+            if(src >= sim::internal::mp.size()) continue;
+            if(sim::internal::mp[src].A.is_set())      bath.A      = sim::internal::mp[src].A.get();
+            if(sim::internal::mp[src].Gamma.is_set())  bath.Gamma  = sim::internal::mp[src].Gamma.get();
+            if(sim::internal::mp[src].omega0.is_set()) bath.omega0 = sim::internal::mp[src].omega0.get();
+            if(sim::internal::mp[src].S0.is_set())     bath.S0     = sim::internal::mp[src].S0.get();
+         }
+      }
+
       return;
    }
 
@@ -170,11 +170,18 @@ namespace sim{
             return true;
          }
          //--------------------------------------------------------------------
+         test="llg-adaptive";
+         if( value == test ){
+            sim::integrator = sim::llg_adaptive;
+            return true;
+         }
+         //--------------------------------------------------------------------
          else{
             terminaltextcolor(RED);
                std::cerr << "Error - value for \'sim:" << word << "\' must be one of:" << std::endl;
                std::cerr << "\t\"llg-heun\"" << std::endl;
                std::cerr << "\t\"llg-midpoint\"" << std::endl;
+               std::cerr << "\t\"llg-adaptive\"" << std::endl;
                std::cerr << "\t\"llg-quantum\"" << std::endl;
                std::cerr << "\t\"monte-carlo\"" << std::endl;
                std::cerr << "\t\"constrained-monte-carlo\"" << std::endl;
@@ -186,6 +193,39 @@ namespace sim{
           }
       }
       //--------------------------------------------------------------------
+      test = "minimiser";
+      if( word == test ){
+         //--------------------------------------------------------------------
+         test="none";
+         if( value == test ){
+            sim::minimiser = sim::no_minimiser;
+            return true;
+         }
+         //--------------------------------------------------------------------
+         test="fire";
+         if( value == test ){
+            sim::minimiser = sim::fire_minimiser;
+            return true;
+         }
+         //--------------------------------------------------------------------
+         else{
+            terminaltextcolor(RED);
+               std::cerr << "Error - value for \'sim:" << word << "\' must be one of:" << std::endl;
+               std::cerr << "\t\"none\"" << std::endl;
+               std::cerr << "\t\"fire\"" << std::endl;
+            terminaltextcolor(WHITE);
+            err::vexit();
+          }
+      }
+      //--------------------------------------------------------------------
+      test = "minimiser-torque-tolerance";
+      if( word == test ){
+         double tt = atof(value.c_str());
+         vin::check_for_valid_value(tt, word, line, prefix, unit, "field", 1.0e-12, 1.0,"input","1e-12 - 1 T");
+         sim::internal::minimiser_torque_tolerance = tt;
+         return true;
+      }
+      //--------------------------------------------------------------------
       test="domain-wall-axis";
       if(word==test){
          //vin::check_for_valid_int(tt, word, line, prefix, 0, max_time,"input","0 - "+max_time_str);
@@ -254,15 +294,15 @@ namespace sim{
       if (word == test) {
           if (value == "classical") {
              sim::noise_type = 0;
-             return EXIT_SUCCESS;
+             return true;
           }
           else if (value == "quantum") {
              sim::noise_type = 1;
-             return EXIT_SUCCESS;
+             return true;
           }
           else if (value == "semiquantum") {
              sim::noise_type = 2;
-             return EXIT_SUCCESS;
+             return true;
           }
           else {
              terminaltextcolor(RED);
@@ -274,6 +314,74 @@ namespace sim{
              err::vexit();
           }
       }
+      //--------------------------------------------------------------------
+      test = "quantum-noise-interpolation";
+      if (word == test) {
+         if (value == "linear") {
+            sim::internal::noise_interpolation = sim::internal::linear_noise;
+            return true;
+         }
+         else if (value == "cubic") {
+            sim::internal::noise_interpolation = sim::internal::cubic_noise;
+            return true;
+         }
+         else if (value == "windowed-sinc") {
+            sim::internal::noise_interpolation = sim::internal::sinc_noise;
+            return true;
+         }
+         else if (value == "exact") {
+            sim::internal::noise_interpolation = sim::internal::exact_noise;
+            return true;
+         }
+         else {
+            terminaltextcolor(RED);
+            std::cerr << "Error - value for 'sim:" << word << "' must be one of:" << std::endl;
+            std::cerr << "\t\"linear\"" << std::endl;
+            std::cerr << "\t\"cubic\"" << std::endl;
+            std::cerr << "\t\"windowed-sinc\"" << std::endl;
+            std::cerr << "\t\"exact\"" << std::endl;
+            terminaltextcolor(WHITE);
+            err::vexit();
+         }
+      }
+      //--------------------------------------------------------------------
+      test = "quantum-noise-benchmark";
+      if (word == test) {
+         sim::internal::noise_benchmark = true;
+         return true;
+      }
+      //--------------------------------------------------------------------
+      test = "quantum-noise-temperature-tolerance";
+      if (word == test) {
+         double tt = atof(value.c_str());
+         vin::check_for_valid_value(tt, word, line, prefix, unit, "none", 0.0, 1.0,"input","0 - 1");
+         sim::internal::noise_temperature_tolerance = tt;
+         return true;
+      }
+      //--------------------------------------------------------------------
+      test = "quantum-noise-period";
+      if (word == test) {
+         uint64_t tt = vin::str_to_uint64(value); // convert string to uint64_t
+         vin::check_for_valid_int(tt, word, line, prefix, 0, 100000000,"input","0 - 100,000,000");
+         sim::internal::noise_period = tt;
+         return true;
+      }
+      //--------------------------------------------------------------------
+      test = "adaptive-tolerance";
+      if (word == test) {
+         double tt = atof(value.c_str());
+         vin::check_for_valid_value(tt, word, line, prefix, unit, "none", 1.0e-12, 0.1,"input","1e-12 - 0.1");
+         sim::internal::adaptive_tolerance = tt;
+         return true;
+      }
+      //--------------------------------------------------------------------
+      test = "adaptive-maximum-step-ratio";
+      if (word == test) {
+         double tt = atof(value.c_str());
+         vin::check_for_valid_value(tt, word, line, prefix, unit, "none", 1.0, 10000.0,"input","1 - 10,000");
+         sim::internal::adaptive_maximum_step_ratio = tt;
+         return true;
+      }
       // input parameter not found here
       return false;
    }
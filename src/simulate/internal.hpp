@@ -88,8 +88,36 @@ namespace sim{
       extern std::vector<double> lsf_fourth_order_coefficient; // LSF coefficients
       extern std::vector<double> lsf_sixth_order_coefficient;
 
+      // schemes for interpolating decimated quantum thermostat noise
+      enum noise_interpolation_t { linear_noise = 0, cubic_noise = 1, sinc_noise = 2, exact_noise = 3 };
+
+      extern noise_interpolation_t noise_interpolation; // scheme used to interpolate coarse noise
+      extern bool noise_benchmark; // flag to report spectral error and memory of all schemes
+      extern double noise_temperature_tolerance; // relative change in temperature before noise is refiltered
+      extern uint64_t noise_period; // time steps after which noise repeats (0 = equilibration time)
+
+      // bath coefficients of the quantum thermostat for a material
+      struct quantum_bath_t{
+         double A;      // coupling of spin to bath oscillator
+         double Gamma;  // damping of bath oscillator
+         double omega0; // resonance frequency of bath oscillator
+         double S0;     // spin length
+      };
+
+      extern std::vector<quantum_bath_t> quantum_bath; // array of quantum thermostat bath coefficients
+
+      extern double adaptive_tolerance; // maximum spin angle error per step of adaptive LLG integrator (rad)
+      extern double adaptive_maximum_step_ratio; // maximum step of adaptive LLG integrator in units of time step
+
+      extern double minimiser_torque_tolerance; // maximum torque on any spin at convergence of minimiser (T)
+
       // shared Functions
       void llg_quantum_step();
+      void llg_quantum_stage(const int stage, const int start, const int end);
+      uint64_t initialise_noise_interpolation(int n_fine, double dt_fine, double T);
+      int required_decimation(const int mat, double dt_fine, double T);
+      void generate_quantum_noise(const double T);
+      void update_noise_temperature(const double T);
 
       //-------------------------------------------------------------------------
       // Internal function declarations
@@ -98,6 +126,8 @@ namespace sim{
       extern void increment_time();
       extern void lsf_step();
       extern void lsf_rk4_step();
+      extern void llg_adaptive_init();
+      extern void llg_adaptive_integrate(const uint64_t n_steps);
 
    } // end of internal namespace
 
@@ -115,28 +145,57 @@ namespace sim{
    extern std::vector <double> y_v_array;
    extern std::vector <double> z_v_array;
 
-   // Storage arrays for RK4
-   extern std::vector<std::vector<double>> k1_storage;
-   extern std::vector<std::vector<double>> k2_storage;
-   extern std::vector<std::vector<double>> k3_storage;
-   extern std::vector<std::vector<double>> k4_storage;
-   extern std::vector<std::vector<double>> y_pred_storage;
-   extern std::vector<std::vector<double>> y_in_storage;
+   // Structure of arrays for fused RK4 stages, component c of atom i stored at c*num_atoms+i
+   extern std::vector<double> rk4_spin_initial; //< Spin at start of step (3 components)
+   extern std::vector<double> rk4_aux_stage;    //< Auxiliary variables v and w of stage state (6 components)
+   extern std::vector<double> rk4_sum;          //< Weighted sum of stage derivatives (9 components)
 
    // Arrays for noise generation (now storing coarse-grained noise)
    extern std::vector<double> coarse_noise_field;
    extern std::vector<double> sqrt_PSD_buffer; // Restored buffer
    extern double noise_index;
-   extern int M_decimation;    //< Decimation factor for noise interpolation
 
-   // Indices for random fields
-   extern std::vector<double> atom_idx_x;
-   extern std::vector<double> atom_idx_y;
-   extern std::vector<double> atom_idx_z;
+   // Noise of the atoms of each material is generated and interpolated as a group
+   struct noise_group_t{
+      int num_atoms;    //< Number of atoms in group
+      int M;            //< Decimation factor for noise interpolation
+      int n_coarse;     //< Number of coarse noise values per realization
+      int taps;         //< Number of coarse values used for each interpolated value
+      uint64_t offset;  //< Index of first noise value of group in coarse_noise_field
+      double dt_coarse; //< Time step of coarse noise
+      double temperature; //< Temperature for which noise was filtered
+      double scale;     //< Amplitude scale of filtered noise at current temperature
+      std::vector<double> weights; //< Interpolation weights for each half step phase
+      uint32_t seed;    //< Seed of white noise of group, used to regenerate the same white noise for a new temperature
+   };
+
+   extern std::vector<noise_group_t> noise_groups; //< Noise groups for each material
+   extern double noise_temperature; //< Temperature of current noise
+
+   // Coarse noise indices and weights interpolating the noise of a group at one time
+   const int max_noise_taps = 8;
+   struct noise_stencil_t{
+      int taps;
+      int index[max_noise_taps];
+      double weight[max_noise_taps];
+   };
+
+   // Index of first coarse noise value of each atom and component, stored as
+   // 64 bit integers since the noise of large systems exceeds 2^31 values
+   extern std::vector<uint64_t> atom_idx_x;
+   extern std::vector<uint64_t> atom_idx_y;
+   extern std::vector<uint64_t> atom_idx_z;
 
    extern bool LLG_set; ///< Flag to define state of LLG arrays (initialised/uninitialised)
 
    }
+
+   namespace internal{
+
+      void build_noise_stencil(const LLGQ_arrays::noise_group_t& group, double fine_step_idx, LLGQ_arrays::noise_stencil_t& stencil);
+
+   } // end of internal namespace
+
 } // end of sim namespace
 
 #endif //SIM_INTERNAL_H_
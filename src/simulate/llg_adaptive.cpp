@@ -0,0 +1,337 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// Standard Libraries
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+// Vampire Header files
+#include "atoms.hpp"
+#include "errors.hpp"
+#include "material.hpp"
+#include "sim.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+#include "internal.hpp"
+
+// Field calculation functions
+int calculate_spin_fields(const int, const int);
+int calculate_external_fields(const int, const int);
+
+namespace LLG_adaptive_arrays{
+
+   // Local arrays for adaptive LLG integration
+   std::vector<double> x_initial_spin_array;
+   std::vector<double> y_initial_spin_array;
+   std::vector<double> z_initial_spin_array;
+
+   std::vector<double> x_k1_array;
+   std::vector<double> y_k1_array;
+   std::vector<double> z_k1_array;
+
+   std::vector<double> x_k2_array;
+   std::vector<double> y_k2_array;
+   std::vector<double> z_k2_array;
+
+   std::vector<double> x_k3_array;
+   std::vector<double> y_k3_array;
+   std::vector<double> z_k3_array;
+
+   std::vector<double> x_k4_array;
+   std::vector<double> y_k4_array;
+   std::vector<double> z_k4_array;
+
+   double step_ratio = 1.0; // proposed step size in units of the nominal time step
+
+   // Flag to define state of adaptive LLG arrays (initialised/uninitialised)
+   bool LLG_adaptive_set = false;
+
+}
+
+namespace sim{
+
+   namespace internal{
+
+      //------------------------------------------------------------------------
+      // Function to initialise arrays for the adaptive LLG integrator
+      //------------------------------------------------------------------------
+      void llg_adaptive_init(){
+
+         // Check calling of routine if error checking is activated
+         if(err::check == true) std::cout << "sim::internal::llg_adaptive_init has been called" << std::endl;
+
+         using namespace LLG_adaptive_arrays;
+
+         x_initial_spin_array.resize(atoms::num_atoms, 0.0);
+         y_initial_spin_array.resize(atoms::num_atoms, 0.0);
+         z_initial_spin_array.resize(atoms::num_atoms, 0.0);
+
+         x_k1_array.resize(atoms::num_atoms, 0.0);
+         y_k1_array.resize(atoms::num_atoms, 0.0);
+         z_k1_array.resize(atoms::num_atoms, 0.0);
+
+         x_k2_array.resize(atoms::num_atoms, 0.0);
+         y_k2_array.resize(atoms::num_atoms, 0.0);
+         z_k2_array.resize(atoms::num_atoms, 0.0);
+
+         x_k3_array.resize(atoms::num_atoms, 0.0);
+         y_k3_array.resize(atoms::num_atoms, 0.0);
+         z_k3_array.resize(atoms::num_atoms, 0.0);
+
+         x_k4_array.resize(atoms::num_atoms, 0.0);
+         y_k4_array.resize(atoms::num_atoms, 0.0);
+         z_k4_array.resize(atoms::num_atoms, 0.0);
+
+         // Integrator is deterministic, so disable external thermal field calculations
+         sim::hamiltonian_simulation_flags[3] = 0;
+
+         // start from the nominal time step
+         step_ratio = 1.0;
+
+         zlog << zTs() << "Adaptive LLG integrator initialised with tolerance " << sim::internal::adaptive_tolerance
+              << " rad and maximum step of " << sim::internal::adaptive_maximum_step_ratio << " time steps" << std::endl;
+
+         LLG_adaptive_set = true;
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to calculate the LLG derivative dS/dt of atoms 0 to end for
+      // the spin configuration held in the spin arrays
+      //------------------------------------------------------------------------
+      void llg_adaptive_derivative(const int end, std::vector<double>& kx, std::vector<double>& ky, std::vector<double>& kz){
+
+         // Update halo spins before calculating fields
+         #ifdef MPICF
+            vmpi::mpi_init_halo_swap();
+            vmpi::mpi_complete_halo_swap();
+         #endif
+
+         calculate_spin_fields(0, end);
+         calculate_external_fields(0, end);
+
+         for(int atom = 0; atom < end; atom++){
+
+            const int imaterial = atoms::type_array[atom];
+            const double one_oneplusalpha_sq = mp::material[imaterial].one_oneplusalpha_sq; // material specific alpha and gamma
+            const double alpha_oneplusalpha_sq = mp::material[imaterial].alpha_oneplusalpha_sq;
+
+            // Store local spin in S and local field in H
+            const double S[3] = {atoms::x_spin_array[atom], atoms::y_spin_array[atom], atoms::z_spin_array[atom]};
+            const double H[3] = {atoms::x_total_spin_field_array[atom] + atoms::x_total_external_field_array[atom],
+                                 atoms::y_total_spin_field_array[atom] + atoms::y_total_external_field_array[atom],
+                                 atoms::z_total_spin_field_array[atom] + atoms::z_total_external_field_array[atom]};
+
+            // Calculate Delta S
+            kx[atom] = (one_oneplusalpha_sq)*(S[1]*H[2]-S[2]*H[1]) + (alpha_oneplusalpha_sq)*(S[1]*(S[0]*H[1]-S[1]*H[0])-S[2]*(S[2]*H[0]-S[0]*H[2]));
+            ky[atom] = (one_oneplusalpha_sq)*(S[2]*H[0]-S[0]*H[2]) + (alpha_oneplusalpha_sq)*(S[2]*(S[1]*H[2]-S[2]*H[1])-S[0]*(S[0]*H[1]-S[1]*H[0]));
+            kz[atom] = (one_oneplusalpha_sq)*(S[0]*H[1]-S[1]*H[0]) + (alpha_oneplusalpha_sq)*(S[0]*(S[2]*H[0]-S[0]*H[2])-S[1]*(S[1]*H[2]-S[2]*H[1]));
+
+         }
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to integrate the deterministic LLG equation over n_steps
+      // nominal time steps with the embedded Bogacki-Shampine 3(2) scheme.
+      // The step size is chosen so that the difference between the third and
+      // second order solutions, approximately the error in the spin angle, is
+      // below the tolerance. Simulation time is incremented once for every
+      // nominal time step that is completed, so that statistics and field
+      // updates see the same time as the fixed step integrators.
+      //------------------------------------------------------------------------
+      void llg_adaptive_integrate(const uint64_t n_steps){
+
+         // Check calling of routine if error checking is activated
+         if(err::check == true) std::cout << "sim::internal::llg_adaptive_integrate has been called" << std::endl;
+
+         using namespace LLG_adaptive_arrays;
+
+         // integrator is only valid in the absence of thermal fluctuations
+         if(sim::temperature > 0.0 || sim::local_temperature){
+            terminaltextcolor(RED);
+            std::cerr << "Error - the llg-adaptive integrator is deterministic and requires sim:temperature = 0, but the temperature is "
+                      << sim::temperature << " K. Use the llg-heun integrator for finite temperature simulations." << std::endl;
+            terminaltextcolor(WHITE);
+            zlog << zTs() << "Error - the llg-adaptive integrator is deterministic and requires sim:temperature = 0, but the temperature is "
+                 << sim::temperature << " K. Exiting." << std::endl;
+            err::vexit();
+         }
+
+         // Check for initialisation of adaptive LLG integration arrays
+         if(LLG_adaptive_set == false) llg_adaptive_init();
+
+         // atoms to integrate, including boundary atoms in parallel
+         #ifdef MPICF
+            const int end = vmpi::num_core_atoms + vmpi::num_bdry_atoms;
+         #else
+            const int end = atoms::num_atoms;
+         #endif
+
+         const double tolerance = sim::internal::adaptive_tolerance;
+         const double max_ratio = sim::internal::adaptive_maximum_step_ratio;
+
+         // smallest permitted step as a fraction of the nominal time step
+         const double min_ratio = 1.0e-6;
+
+         // Bogacki-Shampine coefficients
+         const double b1 = 2.0/9.0;
+         const double b2 = 1.0/3.0;
+         const double b3 = 4.0/9.0;
+         const double e1 = -5.0/72.0;
+         const double e2 = 1.0/12.0;
+         const double e3 = 1.0/9.0;
+         const double e4 = -1.0/8.0;
+
+         // derivative at start of interval, reused from the last stage of each accepted step
+         llg_adaptive_derivative(end, x_k1_array, y_k1_array, z_k1_array);
+
+         double t = 0.0; // integrated time in units of the nominal time step
+         uint64_t steps_completed = 0;
+
+         while(steps_completed < n_steps){
+
+            // shorten step to finish exactly at the end of the interval
+            const double remaining = double(n_steps) - t;
+            const bool clamped = (step_ratio >= remaining);
+            const double ratio = clamped ? remaining : step_ratio;
+            const double h = ratio * mp::dt;
+
+            // Store initial spin positions and calculate second stage
+            for(int atom = 0; atom < end; atom++){
+               const double S[3] = {atoms::x_spin_array[atom], atoms::y_spin_array[atom], atoms::z_spin_array[atom]};
+               x_initial_spin_array[atom] = S[0];
+               y_initial_spin_array[atom] = S[1];
+               z_initial_spin_array[atom] = S[2];
+
+               double S_new[3] = {S[0] + 0.5 * h * x_k1_array[atom],
+                                  S[1] + 0.5 * h * y_k1_array[atom],
+                                  S[2] + 0.5 * h * z_k1_array[atom]};
+
+               // Normalise Spin Length
+               const double mod_S = 1.0 / sqrt(S_new[0]*S_new[0] + S_new[1]*S_new[1] + S_new[2]*S_new[2]);
+
+               atoms::x_spin_array[atom] = S_new[0] * mod_S;
+               atoms::y_spin_array[atom] = S_new[1] * mod_S;
+               atoms::z_spin_array[atom] = S_new[2] * mod_S;
+            }
+
+            llg_adaptive_derivative(end, x_k2_array, y_k2_array, z_k2_array);
+
+            // Calculate third stage
+            for(int atom = 0; atom < end; atom++){
+               double S_new[3] = {x_initial_spin_array[atom] + 0.75 * h * x_k2_array[atom],
+                                  y_initial_spin_array[atom] + 0.75 * h * y_k2_array[atom],
+                                  z_initial_spin_array[atom] + 0.75 * h * z_k2_array[atom]};
+
+               const double mod_S = 1.0 / sqrt(S_new[0]*S_new[0] + S_new[1]*S_new[1] + S_new[2]*S_new[2]);
+
+               atoms::x_spin_array[atom] = S_new[0] * mod_S;
+               atoms::y_spin_array[atom] = S_new[1] * mod_S;
+               atoms::z_spin_array[atom] = S_new[2] * mod_S;
+            }
+
+            llg_adaptive_derivative(end, x_k3_array, y_k3_array, z_k3_array);
+
+            // Calculate third order solution
+            for(int atom = 0; atom < end; atom++){
+               double S_new[3] = {x_initial_spin_array[atom] + h * (b1 * x_k1_array[atom] + b2 * x_k2_array[atom] + b3 * x_k3_array[atom]),
+                                  y_initial_spin_array[atom] + h * (b1 * y_k1_array[atom] + b2 * y_k2_array[atom] + b3 * y_k3_array[atom]),
+                                  z_initial_spin_array[atom] + h * (b1 * z_k1_array[atom] + b2 * z_k2_array[atom] + b3 * z_k3_array[atom])};
+
+               const double mod_S = 1.0 / sqrt(S_new[0]*S_new[0] + S_new[1]*S_new[1] + S_new[2]*S_new[2]);
+
+               atoms::x_spin_array[atom] = S_new[0] * mod_S;
+               atoms::y_spin_array[atom] = S_new[1] * mod_S;
+               atoms::z_spin_array[atom] = S_new[2] * mod_S;
+            }
+
+            llg_adaptive_derivative(end, x_k4_array, y_k4_array, z_k4_array);
+
+            // Calculate maximum difference between third and second order solutions
+            double max_error_sq = 0.0;
+            for(int atom = 0; atom < end; atom++){
+               const double ex = h * (e1 * x_k1_array[atom] + e2 * x_k2_array[atom] + e3 * x_k3_array[atom] + e4 * x_k4_array[atom]);
+               const double ey = h * (e1 * y_k1_array[atom] + e2 * y_k2_array[atom] + e3 * y_k3_array[atom] + e4 * y_k4_array[atom]);
+               const double ez = h * (e1 * z_k1_array[atom] + e2 * z_k2_array[atom] + e3 * z_k3_array[atom] + e4 * z_k4_array[atom]);
+               max_error_sq = std::max(max_error_sq, ex*ex + ey*ey + ez*ez);
+            }
+
+            #ifdef MPICF
+               MPI_Allreduce(MPI_IN_PLACE, &max_error_sq, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+            #endif
+
+            const double error = sqrt(max_error_sq);
+            const bool accepted = (error <= tolerance);
+
+            // optimal step for third order scheme, limited to avoid oscillation in the step size
+            double factor = 5.0;
+            if(error > 0.0) factor = std::min(5.0, std::max(0.2, 0.9 * pow(tolerance / error, 1.0/3.0)));
+
+            if(accepted){
+
+               // advance time, ending exactly on the interval boundary
+               t = clamped ? double(n_steps) : t + ratio;
+
+               // derivative at end of step is derivative at start of next step
+               x_k1_array.swap(x_k4_array);
+               y_k1_array.swap(y_k4_array);
+               z_k1_array.swap(z_k4_array);
+
+               // keep the proposed step when it was only shortened to reach the end of the interval
+               if(!clamped || ratio * factor > step_ratio) step_ratio = std::min(ratio * factor, max_ratio);
+
+               // Increment time for each nominal step completed
+               const uint64_t steps_reached = std::min(n_steps, uint64_t(t + 1.0e-9));
+               while(steps_completed < steps_reached){
+                  sim::internal::increment_time();
+                  steps_completed++;
+               }
+
+            }
+            else{
+
+               // Restore initial spin positions and retry with a smaller step
+               for(int atom = 0; atom < end; atom++){
+                  atoms::x_spin_array[atom] = x_initial_spin_array[atom];
+                  atoms::y_spin_array[atom] = y_initial_spin_array[atom];
+                  atoms::z_spin_array[atom] = z_initial_spin_array[atom];
+               }
+
+               step_ratio = std::min(ratio * factor, max_ratio);
+
+               if(step_ratio < min_ratio){
+                  terminaltextcolor(RED);
+                  std::cerr << "Error - the llg-adaptive integrator requires a step smaller than " << min_ratio
+                            << " time steps to reach the tolerance of " << tolerance << " rad. Reduce sim:time-step or increase sim:adaptive-tolerance." << std::endl;
+                  terminaltextcolor(WHITE);
+                  zlog << zTs() << "Error - the llg-adaptive integrator requires a step smaller than " << min_ratio
+                       << " time steps to reach the tolerance of " << tolerance << " rad. Exiting." << std::endl;
+                  err::vexit();
+               }
+
+            }
+
+         }
+
+         return;
+
+      }
+
+   } // end of internal namespace
+
+} // end of sim namespace
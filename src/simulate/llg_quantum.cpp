@@ -11,6 +11,7 @@
 //
 
 // Standard Libraries
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
@@ -31,6 +32,7 @@
 #include "material.hpp"
 #include "random.hpp"
 #include "sim.hpp"
+#include "vio.hpp"
 
 #include "internal.hpp"
 
@@ -62,12 +64,15 @@ namespace sim{
    //---------------------------------------------------------------------------
    // Class for FFTW plan management
    //---------------------------------------------------------------------------
-   void calculate_random_fields(int realizations, int n_fine, double dt_fine, int M, double T, int n_coarse);
-   void assign_unique_indices(int n_coarse);
-   void precompute_sqrt_PSD(int n, double dt, double T);
-   double PSD(const double& omega, const double& T);
-   double estimate_cutoff_omega_cdf(double T, double target_frac);
-   double get_noise(const std::vector<double>& coarse_noise, double fine_step_idx, int M, int atom_idx);
+   void calculate_random_fields(int n_fine, double dt_fine, double T, uint64_t num_noise_values);
+   void generate_noise_group(const int mat, const double T, int& completed_realizations, const int total_realizations);
+   void assign_unique_indices();
+   void precompute_sqrt_PSD(int n, double dt, double T, const int mat);
+   double PSD(const double& omega, const double& T, const int mat);
+   double estimate_cutoff_omega_cdf(double T, double target_frac, const int mat);
+
+   // number of noise realizations transformed together
+   const int noise_batch_size = 32;
 
 
 
@@ -84,59 +89,176 @@ namespace sim{
       y_v_array.resize(atoms::num_atoms, 0.0);
       z_v_array.resize(atoms::num_atoms, 0.0);
 
-      k1_storage.resize(atoms::num_atoms, std::vector<double>(9));
-      k2_storage.resize(atoms::num_atoms, std::vector<double>(9));
-      k3_storage.resize(atoms::num_atoms, std::vector<double>(9));
-      k4_storage.resize(atoms::num_atoms, std::vector<double>(9));
-      y_pred_storage.resize(atoms::num_atoms, std::vector<double>(9));
-      y_in_storage.resize(atoms::num_atoms, std::vector<double>(9));
+      rk4_spin_initial.resize(3 * atoms::num_atoms, 0.0);
+      rk4_aux_stage.resize(6 * atoms::num_atoms, 0.0);
+      rk4_sum.resize(9 * atoms::num_atoms, 0.0);
 
 
-      // Set number of realizations (full field, for final release allow even smaller number of realizations)
-      const int num_atoms = atoms::num_atoms;
-      int realizations = num_atoms * 3 + 4;
       LLGQ_arrays::noise_index = 0;
 
       // Disable external thermal field calculations
       sim::hamiltonian_simulation_flags[3] = 0;
 
+      // Generate noise for the current temperature
+      sim::internal::generate_quantum_noise(sim::temperature);
 
-      // --- Interpolation Setup ---
-      const double dt_fine = mp::dt;
-      const int n_fine = static_cast<int>(sim::equilibration_time) + 1;
+      LLG_set=true;
 
-      // Calculate cutoff frequency and decimation factor
-      double omega_cutoff = estimate_cutoff_omega_cdf(sim::temperature, 0.99999);
-      M_decimation = static_cast<int>(std::ceil((M_PI / omega_cutoff) / dt_fine));
+      return EXIT_SUCCESS;
+   }
 
-      
-      const int n_coarse = (n_fine > 0) ? ((n_fine - 1) / M_decimation + 1) : 0;
-      double mem_red = 100.0 * (1.0 - static_cast<double>(n_coarse) / n_fine);
-      std::cout << "Quantum noise interpolation enabled." << std::endl;
-      std::cout << "Decimation factor M=" << M_decimation << ", estimated memory reduction=" << std::fixed << std::setprecision(1) << mem_red << "%" << std::endl;
+   namespace internal{
 
+    
 
-      // Assign unique indices for random fields
-      assign_unique_indices(n_coarse);
+      //------------------------------------------------------------------------
+      // Function to perform one fused RK4 stage for atoms start to end. A single
+      // pass interpolates the noise, computes the derivatives of the spin and
+      // bath variables, accumulates them and updates and normalises the stage
+      // state. The spin of the stage state is stored directly in the spin arrays
+      // for the next field calculation, and the last stage completes the step.
+      //------------------------------------------------------------------------
+      void llg_quantum_stage(const int stage, const int start, const int end){
 
-      // Generate random fields directly on coarse grid and store for interpolation
-      calculate_random_fields(realizations, n_fine, dt_fine, M_decimation, sim::temperature, n_coarse);
+         using namespace LLGQ_arrays;
 
-      LLG_set=true;
+         const int num_atoms = atoms::num_atoms;
+         const int num_materials = quantum_bath.size();
+
+         // RK4 weight of stage derivative and time step to next stage state
+         const double stage_weight[4] = { 1.0, 2.0, 2.0, 1.0 };
+         const double stage_dt[4] = { 0.5 * mp::dt, 0.5 * mp::dt, mp::dt, mp::dt / 6.0 };
+         const double stage_time[4] = { 0.0, 0.5, 0.5, 1.0 };
+
+         const double weight = stage_weight[stage];
+         const double h = stage_dt[stage];
+         const bool last_stage = (stage == 3);
+
+         // noise stencils and bath coefficients of each material for this stage
+         std::vector<noise_stencil_t> stencil(num_materials);
+         std::vector<double> bath_A(num_materials);
+         std::vector<double> bath_Gamma(num_materials);
+         std::vector<double> bath_omega0_sq(num_materials);
+         for(int mat = 0; mat < num_materials; ++mat){
+            if(noise_groups[mat].num_atoms > 0) build_noise_stencil(noise_groups[mat], noise_index + stage_time[stage], stencil[mat]);
+            bath_A[mat] = quantum_bath[mat].A;
+            bath_Gamma[mat] = quantum_bath[mat].Gamma;
+            bath_omega0_sq[mat] = quantum_bath[mat].omega0 * quantum_bath[mat].omega0;
+         }
 
-      return EXIT_SUCCESS;
-   }
+         // stage state (spin in spin arrays, first stage starts from auxiliary variables at start of step)
+         double* sx = atoms::x_spin_array.data();
+         double* sy = atoms::y_spin_array.data();
+         double* sz = atoms::z_spin_array.data();
+         const double* vw[6];
+         if(stage == 0){
+            vw[0] = x_v_array.data(); vw[1] = y_v_array.data(); vw[2] = z_v_array.data();
+            vw[3] = x_w_array.data(); vw[4] = y_w_array.data(); vw[5] = z_w_array.data();
+         }
+         else for(int c = 0; c < 6; ++c) vw[c] = &rk4_aux_stage[c * num_atoms];
+
+         const double* __restrict hx = atoms::x_total_spin_field_array.data();
+         const double* __restrict hy = atoms::y_total_spin_field_array.data();
+         const double* __restrict hz = atoms::z_total_spin_field_array.data();
+         const double* __restrict ex = atoms::x_total_external_field_array.data();
+         const double* __restrict ey = atoms::y_total_external_field_array.data();
+         const double* __restrict ez = atoms::z_total_external_field_array.data();
+         const double* __restrict noise = coarse_noise_field.data();
+
+         double* s0 = rk4_spin_initial.data();
+         double* aux = rk4_aux_stage.data();
+         double* sum = rk4_sum.data();
+
+         // state at start of step
+         const double* initial[9] = { s0, s0 + num_atoms, s0 + 2 * num_atoms,
+                                      x_v_array.data(), y_v_array.data(), z_v_array.data(),
+                                      x_w_array.data(), y_w_array.data(), z_w_array.data() };
+
+         for(int atom = start; atom < end; ++atom){
+
+            const int mat = atoms::type_array[atom];
+            const noise_stencil_t& st = stencil[mat];
+
+            // Save initial spin for later stages
+            if(stage == 0){
+               s0[atom] = sx[atom];
+               s0[num_atoms + atom] = sy[atom];
+               s0[2 * num_atoms + atom] = sz[atom];
+            }
 
-   namespace internal{
+            // Interpolated noise with stencil shared by all atoms of material
+            const uint64_t r_x = atom_idx_x[atom];
+            const uint64_t r_y = atom_idx_y[atom];
+            const uint64_t r_z = atom_idx_z[atom];
+            double nx = 0.0, ny = 0.0, nz = 0.0;
+            for(int t = 0; t < st.taps; ++t){
+               nx += st.weight[t] * noise[st.index[t] + r_x];
+               ny += st.weight[t] * noise[st.index[t] + r_y];
+               nz += st.weight[t] * noise[st.index[t] + r_z];
+            }
 
-    
+            const double Hx = hx[atom] + ex[atom] + nx;
+            const double Hy = hy[atom] + ey[atom] + ny;
+            const double Hz = hz[atom] + ez[atom] + nz;
+
+            // Stage state
+            const double y0 = sx[atom];
+            const double y1 = sy[atom];
+            const double y2 = sz[atom];
+            const double y3 = vw[0][atom];
+            const double y4 = vw[1][atom];
+            const double y5 = vw[2][atom];
+            const double y6 = vw[3][atom];
+            const double y7 = vw[4][atom];
+            const double y8 = vw[5][atom];
+
+            const double A = bath_A[mat];
+            const double Gamma = bath_Gamma[mat];
+            const double omega0_sq = bath_omega0_sq[mat];
+
+            // dS/dt = S × (H + v), dv/dt = w, dw/dt = -ω₀²v - Γw + AS
+            double d[9];
+            d[0] = (y1*(Hz+y5) - y2*(Hy+y4));
+            d[1] = (y2*(Hx+y3) - y0*(Hz+y5));
+            d[2] = (y0*(Hy+y4) - y1*(Hx+y3));
+            d[3] = y6;
+            d[4] = y7;
+            d[5] = y8;
+            d[6] = -omega0_sq*y3 - Gamma*y6 + A*y0;
+            d[7] = -omega0_sq*y4 - Gamma*y7 + A*y1;
+            d[8] = -omega0_sq*y5 - Gamma*y8 + A*y2;
+
+            // Accumulate weighted derivatives, new state from initial state
+            double y_new[9];
+            for(int c = 0; c < 9; ++c){
+               double& sum_c = sum[c * num_atoms + atom];
+               if(stage == 0) sum_c = d[c];
+               else sum_c += weight * d[c];
+               y_new[c] = initial[c][atom] + h * (last_stage ? sum_c : d[c]);
+            }
+
+            // Normalize spin length
+            const double inv_mag = 1.0 / std::sqrt(y_new[0] * y_new[0] + y_new[1] * y_new[1] + y_new[2] * y_new[2]);
+            sx[atom] = y_new[0] * inv_mag;
+            sy[atom] = y_new[1] * inv_mag;
+            sz[atom] = y_new[2] * inv_mag;
+
+            if(last_stage){
+               // Update auxiliary variables
+               x_v_array[atom] = y_new[3];
+               y_v_array[atom] = y_new[4];
+               z_v_array[atom] = y_new[5];
+               x_w_array[atom] = y_new[6];
+               y_w_array[atom] = y_new[7];
+               z_w_array[atom] = y_new[8];
+            }
+            else for(int c = 0; c < 6; ++c) aux[c * num_atoms + atom] = y_new[c + 3];
+
+         }
 
-      /// @brief LLG Heun Integrator Corrector
-      ///
-      /// @details Integrates the system using the LLG and Heun solver
-      // ... (Doxygen comments remain the same) ...
-      //
-      void spinDynamics(const double* y,const double* H,double* dydt);
+         return;
+
+      }
 
       void llg_quantum_step(){
 
@@ -148,225 +270,149 @@ namespace sim{
          // Check for initialisation of LLG integration arrays
          if(LLG_set==false) sim::LLGQinit();
 
+         // Refilter or rescale noise if temperature has changed
+         update_noise_temperature(sim::temperature);
+
          // Local variables
          const int num_atoms = atoms::num_atoms;
-         std::vector<double> H(3);
-
-         // Store initial state
-         for (int atom = 0; atom < num_atoms; atom++) {
-            y_in_storage[atom][0] = atoms::x_spin_array[atom];
-            y_in_storage[atom][1] = atoms::y_spin_array[atom];
-            y_in_storage[atom][2] = atoms::z_spin_array[atom];
-            y_in_storage[atom][3] = LLGQ_arrays::x_v_array[atom];
-            y_in_storage[atom][4] = LLGQ_arrays::y_v_array[atom];
-            y_in_storage[atom][5] = LLGQ_arrays::z_v_array[atom];
-            y_in_storage[atom][6] = LLGQ_arrays::x_w_array[atom];
-            y_in_storage[atom][7] = LLGQ_arrays::y_w_array[atom];
-            y_in_storage[atom][8] = LLGQ_arrays::z_w_array[atom];
-         }
-
 
          // Calculate fields
          calculate_spin_fields(0, num_atoms);
          calculate_external_fields(0, num_atoms);
 
-         const double dt = mp::dt;
-         const double half_dt = 0.5 * mp::dt;
-         const double dt_over_6 = mp::dt / 6.0;
-         const int M = M_decimation;
+         // K1 to K4 stages with spin fields updated for each stage state
+         for(int stage = 0; stage < 4; ++stage){
+            if(stage > 0) calculate_spin_fields(0, num_atoms);
+            llg_quantum_stage(stage, 0, num_atoms);
+         }
 
-         // K1 Step
-         for (int atom = 0; atom < num_atoms; ++atom) {
-            // Update fields for k1 with interpolated noise at time t
-            H[0] = atoms::x_total_spin_field_array[atom] + atoms::x_total_external_field_array[atom] + get_noise(coarse_noise_field, noise_index, M, atom_idx_x[atom]);
-            H[1] = atoms::y_total_spin_field_array[atom] + atoms::y_total_external_field_array[atom] + get_noise(coarse_noise_field, noise_index, M, atom_idx_y[atom]);
-            H[2] = atoms::z_total_spin_field_array[atom] + atoms::z_total_external_field_array[atom] + get_noise(coarse_noise_field, noise_index, M, atom_idx_z[atom]);
+         // Increment noise index
+         LLGQ_arrays::noise_index += 1;
 
-            // Calculate K1
-            spinDynamics(y_in_storage[atom].data(), H.data(), k1_storage[atom].data());
+         return;
+      }
 
-            // Calculate y_pred for k2
-            for (size_t i = 0; i < 9; ++i) {
-               y_pred_storage[atom][i] = y_in_storage[atom][i] + half_dt * k1_storage[atom][i];
-            }
+      //------------------------------------------------------------------------
+      // Function to set up noise groups and generate noise at temperature T
+      //------------------------------------------------------------------------
+      void generate_quantum_noise(const double T){
 
-            // Normalize spin length
-            double S_magnitude = std::sqrt(y_pred_storage[atom][0] * y_pred_storage[atom][0] + y_pred_storage[atom][1] * y_pred_storage[atom][1] + y_pred_storage[atom][2] * y_pred_storage[atom][2]);
-            const double inv_mag = 1.0 / S_magnitude;
-            y_pred_storage[atom][0] *= inv_mag;
-            y_pred_storage[atom][1] *= inv_mag;
-            y_pred_storage[atom][2] *= inv_mag;
-
-            // Update spin for field calculation
-            atoms::x_spin_array[atom] = y_pred_storage[atom][0];
-            atoms::y_spin_array[atom] = y_pred_storage[atom][1];
-            atoms::z_spin_array[atom] = y_pred_storage[atom][2];
-         }
+         // --- Interpolation Setup ---
+         const double dt_fine = mp::dt;
 
-         // Update spin fields for k2
-         calculate_spin_fields(0, num_atoms);
+         // noise repeats after period time steps
+         const uint64_t period = (sim::internal::noise_period > 0) ? sim::internal::noise_period : sim::equilibration_time;
+         const int n_fine = static_cast<int>(period) + 1;
 
-         // K2 Step
-         for (int atom = 0; atom < num_atoms; ++atom) {
-            // Update fields for k2 with interpolated noise at time t + dt/2
-            const int r_x = atom_idx_x[atom];
-            const int r_y = atom_idx_y[atom];
-            const int r_z = atom_idx_z[atom];
-            H[0] = atoms::x_total_spin_field_array[atom] + atoms::x_total_external_field_array[atom] + get_noise(coarse_noise_field, noise_index+0.5, M, atom_idx_x[atom]);
-            H[1] = atoms::y_total_spin_field_array[atom] + atoms::y_total_external_field_array[atom] + get_noise(coarse_noise_field, noise_index+0.5, M, atom_idx_y[atom]);
-            H[2] = atoms::z_total_spin_field_array[atom] + atoms::z_total_external_field_array[atom] + get_noise(coarse_noise_field, noise_index+0.5, M, atom_idx_z[atom]);
-
-            // Calculate K2
-            spinDynamics(y_pred_storage[atom].data(), H.data(), k2_storage[atom].data());
-
-            // Calculate y_pred for k3
-            for (size_t i = 0; i < 9; ++i) {
-               y_pred_storage[atom][i] = y_in_storage[atom][i] + half_dt * k2_storage[atom][i];
-            }
+         // Calculate decimation factor and interpolation weights of each material
+         const uint64_t num_noise_values = sim::internal::initialise_noise_interpolation(n_fine, dt_fine, T);
 
-            // Normalize spin length
-            double S_magnitude = std::sqrt(y_pred_storage[atom][0] * y_pred_storage[atom][0] + y_pred_storage[atom][1] * y_pred_storage[atom][1] + y_pred_storage[atom][2] * y_pred_storage[atom][2]);
-            const double inv_mag = 1.0 / S_magnitude;
-            y_pred_storage[atom][0] *= inv_mag;
-            y_pred_storage[atom][1] *= inv_mag;
-            y_pred_storage[atom][2] *= inv_mag;
+         // exact noise is generated directly on the half step grid
+         const double dt_noise = (sim::internal::noise_interpolation == sim::internal::exact_noise) ? 0.5 * dt_fine : dt_fine;
 
-            // Update spin for field calculation
-            atoms::x_spin_array[atom] = y_pred_storage[atom][0];
-            atoms::y_spin_array[atom] = y_pred_storage[atom][1];
-            atoms::z_spin_array[atom] = y_pred_storage[atom][2];
+         // Assign unique indices for random fields
+         assign_unique_indices();
 
-         }
+         // Generate random fields directly on coarse grid and store for interpolation
+         calculate_random_fields(n_fine, dt_noise, T, num_noise_values);
 
-         // Update spin fields for k3
-         calculate_spin_fields(0, num_atoms);
+         LLGQ_arrays::noise_temperature = T;
 
-         // K3 Step
-         for (int atom = 0; atom < num_atoms; ++atom) {
-            // Update fields for k3 with interpolated noise at time t + dt/2
-            const int r_x = atom_idx_x[atom];
-            const int r_y = atom_idx_y[atom];
-            const int r_z = atom_idx_z[atom];
-            H[0] = atoms::x_total_spin_field_array[atom] + atoms::x_total_external_field_array[atom] + get_noise(coarse_noise_field, noise_index+0.5, M, atom_idx_x[atom]);
-            H[1] = atoms::y_total_spin_field_array[atom] + atoms::y_total_external_field_array[atom] + get_noise(coarse_noise_field, noise_index+0.5, M, atom_idx_y[atom]);
-            H[2] = atoms::z_total_spin_field_array[atom] + atoms::z_total_external_field_array[atom] + get_noise(coarse_noise_field, noise_index+0.5, M, atom_idx_z[atom]);
-
-            // Calculate K3
-            spinDynamics(y_pred_storage[atom].data(), H.data(), k3_storage[atom].data());
-
-            // Calculate y_pred for k4
-            for (size_t i = 0; i < 9; ++i) {
-               y_pred_storage[atom][i] = y_in_storage[atom][i] + dt * k3_storage[atom][i];
-            }
+      }
 
-            // Normalize spin length
-            double S_magnitude = std::sqrt(y_pred_storage[atom][0] * y_pred_storage[atom][0] + y_pred_storage[atom][1] * y_pred_storage[atom][1] + y_pred_storage[atom][2] * y_pred_storage[atom][2]);
-            const double inv_mag = 1.0 / S_magnitude;
-            y_pred_storage[atom][0] *= inv_mag;
-            y_pred_storage[atom][1] *= inv_mag;
-            y_pred_storage[atom][2] *= inv_mag;
-
-            // Update spin for field calculation
-            atoms::x_spin_array[atom] = y_pred_storage[atom][0];
-            atoms::y_spin_array[atom] = y_pred_storage[atom][1];
-            atoms::z_spin_array[atom] = y_pred_storage[atom][2];
-         }
+      //------------------------------------------------------------------------
+      // Function to bring noise up to date with a change of temperature. The
+      // classical PSD is proportional to T and so the noise is rescaled. The
+      // quantum PSDs change shape, and so the white noise is regenerated from the
+      // seed of each group and refiltered when the temperature has changed by
+      // more than the tolerance, unless the new PSD needs a finer coarse grid,
+      // when all noise is regenerated with new seeds.
+      //------------------------------------------------------------------------
+      void update_noise_temperature(const double T){
 
-         // Update fields for k4
-         calculate_spin_fields(0, num_atoms);
+         using namespace LLGQ_arrays;
 
-         //K4 step
-         for (int atom = 0; atom < num_atoms; ++atom) {
-            // Update fields for k4 with interpolated noise at t+dt
-            const int r_x = atom_idx_x[atom];
-            const int r_y = atom_idx_y[atom];
-            const int r_z = atom_idx_z[atom];
-            H[0] = atoms::x_total_spin_field_array[atom] + atoms::x_total_external_field_array[atom] + get_noise(coarse_noise_field, noise_index + 1.0, M, atom_idx_x[atom]);
-            H[1] = atoms::y_total_spin_field_array[atom] + atoms::y_total_external_field_array[atom] + get_noise(coarse_noise_field, noise_index + 1.0, M, atom_idx_y[atom]);
-            H[2] = atoms::z_total_spin_field_array[atom] + atoms::z_total_external_field_array[atom] + get_noise(coarse_noise_field, noise_index + 1.0, M, atom_idx_z[atom]);
-
-            // Calculate K4
-            spinDynamics(y_pred_storage[atom].data(), H.data(), k4_storage[atom].data());
-
-            // Final update and normalization for spin components
-            for (size_t i = 0; i < 3; ++i) {
-               y_pred_storage[atom][i] = y_in_storage[atom][i] + dt_over_6 * (k1_storage[atom][i] + 2.0 * k2_storage[atom][i] + 2.0 * k3_storage[atom][i] + k4_storage[atom][i]);
-            }
+         if(T == noise_temperature) return;
 
-            double S_magnitude = std::sqrt(y_pred_storage[atom][0] * y_pred_storage[atom][0] + y_pred_storage[atom][1] * y_pred_storage[atom][1] + y_pred_storage[atom][2] * y_pred_storage[atom][2]);
-            const double inv_mag = 1.0 / S_magnitude;
-            y_pred_storage[atom][0] *= inv_mag;
-            y_pred_storage[atom][1] *= inv_mag;
-            y_pred_storage[atom][2] *= inv_mag;
+         bool regenerate = false;
 
-            atoms::x_spin_array[atom] = y_pred_storage[atom][0];
-            atoms::y_spin_array[atom] = y_pred_storage[atom][1];
-            atoms::z_spin_array[atom] = y_pred_storage[atom][2];
+         for(size_t mat = 0; mat < noise_groups.size(); ++mat){
 
-            // Update auxiliary variables
-            LLGQ_arrays::x_v_array[atom] = y_in_storage[atom][3] + (dt_over_6) * (k1_storage[atom][3] + 2.0 * k2_storage[atom][3] + 2.0 * k3_storage[atom][3] + k4_storage[atom][3]);
-            LLGQ_arrays::y_v_array[atom] = y_in_storage[atom][4] + (dt_over_6) * (k1_storage[atom][4] + 2.0 * k2_storage[atom][4] + 2.0 * k3_storage[atom][4] + k4_storage[atom][4]);
-            LLGQ_arrays::z_v_array[atom] = y_in_storage[atom][5] + (dt_over_6) * (k1_storage[atom][5] + 2.0 * k2_storage[atom][5] + 2.0 * k3_storage[atom][5] + k4_storage[atom][5]);
-            LLGQ_arrays::x_w_array[atom] = y_in_storage[atom][6] + (dt_over_6) * (k1_storage[atom][6] + 2.0 * k2_storage[atom][6] + 2.0 * k3_storage[atom][6] + k4_storage[atom][6]);
-            LLGQ_arrays::y_w_array[atom] = y_in_storage[atom][7] + (dt_over_6) * (k1_storage[atom][7] + 2.0 * k2_storage[atom][7] + 2.0 * k3_storage[atom][7] + k4_storage[atom][7]);
-            LLGQ_arrays::z_w_array[atom] = y_in_storage[atom][8] + (dt_over_6) * (k1_storage[atom][8] + 2.0 * k2_storage[atom][8] + 2.0 * k3_storage[atom][8] + k4_storage[atom][8]);
+            noise_group_t& group = noise_groups[mat];
+            if(group.num_atoms == 0) continue;
 
-         }
+            const double T0 = group.temperature;
 
-         // Increment noise index
-         LLGQ_arrays::noise_index += 1;
+            // classical noise scales with the square root of temperature
+            if(sim::noise_type == 0 && T0 > 0.0){
+               group.scale = std::sqrt(T / T0);
+               continue;
+            }
 
-         return;
-      }
+            // reuse noise filtered at a nearby temperature
+            if(std::fabs(T - T0) <= noise_temperature_tolerance * std::max(T0, 1.0)){
+               group.scale = 1.0;
+               continue;
+            }
 
-      void spinDynamics(const double* y, const double* H, double* dydt) {
-         // Correctly access parameters using 
-         const double A = sim::internal::mp[0].A.get();
-         const double Gamma = sim::internal::mp[0].Gamma.get();
-         const double omega0 = sim::internal::mp[0].omega0.get();
+            // check coarse grid resolves PSD at new temperature
+            if(required_decimation(mat, mp::dt, T) < group.M){
+               regenerate = true;
+               break;
+            }
 
-         // dS/dt = S × (H + v)
-         dydt[0] =  (y[1]*(H[2]+y[5]) - y[2]*(H[1]+y[4]));
-         dydt[1] =  (y[2]*(H[0]+y[3]) - y[0]*(H[2]+y[5]));
-         dydt[2] =  (y[0]*(H[1]+y[4]) - y[1]*(H[0]+y[3]));
+            // regenerate white noise of group from its seed and filter at new temperature
+            int completed_realizations = 0;
+            generate_noise_group(mat, T, completed_realizations, 0);
 
+         }
 
-         // dv/dt = w
-         dydt[3] = y[6];
-         dydt[4] = y[7];
-         dydt[5] = y[8];
+         if(regenerate){
+            zlog << zTs() << "Regenerating quantum noise for temperature " << T << " K" << std::endl;
+            generate_quantum_noise(T);
+         }
+
+         noise_temperature = T;
 
-         // dw/dt = -ω₀²v - Γw + AS
-         dydt[6] = -omega0*omega0*y[3] - Gamma*y[6] + A*y[0];
-         dydt[7] = -omega0*omega0*y[4] - Gamma*y[7] + A*y[1];
-         dydt[8] = -omega0*omega0*y[5] - Gamma*y[8] + A*y[2];
       }
 
    } // end of internal namespace
 
-   void assign_unique_indices(int n_coarse) {
+   //------------------------------------------------------------------------------
+   // Function to assign each atom three consecutive realizations in the noise
+   // group of its material
+   //------------------------------------------------------------------------------
+   void assign_unique_indices() {
       const int num_atoms = atoms::num_atoms;
 
-
       LLGQ_arrays::atom_idx_x.resize(num_atoms);
       LLGQ_arrays::atom_idx_y.resize(num_atoms);
       LLGQ_arrays::atom_idx_z.resize(num_atoms);
 
+      // number of atoms of each material assigned so far
+      std::vector<uint64_t> group_atom(LLGQ_arrays::noise_groups.size(), 0);
+
       for (int atom = 0; atom < num_atoms; atom++) {
-         LLGQ_arrays::atom_idx_x[atom] = 3 * atom * n_coarse;
-         LLGQ_arrays::atom_idx_y[atom] = 3 * atom * n_coarse + n_coarse;
-         LLGQ_arrays::atom_idx_z[atom] = 3 * atom * n_coarse + 2*n_coarse;
+         const int mat = atoms::type_array[atom];
+         const LLGQ_arrays::noise_group_t& group = LLGQ_arrays::noise_groups[mat];
+         const uint64_t n_coarse = group.n_coarse;
+         const uint64_t first = group.offset + 3 * group_atom[mat] * n_coarse;
+         LLGQ_arrays::atom_idx_x[atom] = first;
+         LLGQ_arrays::atom_idx_y[atom] = first + n_coarse;
+         LLGQ_arrays::atom_idx_z[atom] = first + 2*n_coarse;
+         group_atom[mat]++;
       }
    }
 
-   void calculate_random_fields(int realizations, int n_fine, double dt_fine, int M, double T, int n_coarse) {
-      // Correctly access parameters using 
-      if (n_coarse < 0) {
-         n_coarse = (n_fine > 0) ? ((n_fine - 1) / M + 1) : 0;
-      }
+   //------------------------------------------------------------------------------
+   // Function to generate the noise of all noise groups at temperature T. Each
+   // group draws a seed for its white noise, so that the same white noise can be
+   // regenerated and refiltered when the temperature changes without storing it.
+   //------------------------------------------------------------------------------
+   void calculate_random_fields(int n_fine, double dt_fine, double T, uint64_t num_noise_values) {
 
-      // Check if realizations is valid
-      if (realizations <= 0 || n_fine <= 0 || M <= 0 || n_coarse <= 0) {
+      // Check if parameters are valid
+      if (n_fine <= 0 || num_noise_values == 0) {
          std::cerr << "Error: Invalid parameters for quantum noise generation." << std::endl;
          return;
       }
@@ -374,118 +420,176 @@ namespace sim{
       // Check if FFTW is available
 
      #ifdef FFT
-      if (n_fine <= 0) return; // Do not generate noise if there are no steps
 
-      // Correctly access S0 using 
-      const double S0 = sim::internal::mp[0].S0.get();
-      const double inv_sqrt_S0 = (S0 > 0) ? 1.0 / std::sqrt(S0) : 1.0;
+      std::cout << "Generating quantum noise fields with FFTW on coarse grid..." << std::endl;
+      std::cout << "Total number fine time steps: " << n_fine << std::endl;
 
-      // Calculate coarse time step
-      const double dt_coarse = dt_fine * M;
+      // source of seeds for the white noise of each group
+      static thread_local std::random_device rd;
+      static thread_local std::mt19937 gen(rd());
 
-      // --- Optimized Memory Allocation for Coarse Grid FFT ---
-      std::cout << "Generating quantum noise fields with FFTW on coarse grid..." << std::endl;
+      LLGQ_arrays::coarse_noise_field.resize(num_noise_values);
 
-      double* __restrict in = (double*)fftw_malloc(sizeof(double) * n_coarse);
-      fftw_complex* __restrict out = (fftw_complex*)fftw_malloc(sizeof(fftw_complex) * (n_coarse/2 + 1));
-      double* __restrict result = (double*)fftw_malloc(sizeof(double) * n_coarse);
+      // total number of realizations for progress bar
+      int total_realizations = 0;
+      for (size_t mat = 0; mat < LLGQ_arrays::noise_groups.size(); ++mat) total_realizations += 3 * LLGQ_arrays::noise_groups[mat].num_atoms;
+      int completed_realizations = 0;
 
-      fftw_plan forward = fftw_plan_dft_r2c_1d(n_coarse, in, out, FFTW_MEASURE);
-      fftw_plan backward = fftw_plan_dft_c2r_1d(n_coarse, out, result, FFTW_MEASURE);
+      for (size_t mat = 0; mat < LLGQ_arrays::noise_groups.size(); ++mat) {
 
-      std::cout << "FFTW plans created for coarse grid." << std::endl;
-      std::cout << "Total number fine time steps: " << n_fine << std::endl;
-      std::cout << "Decimation factor M: " << M << std::endl;
-      std::cout << "Number of coarse time steps: " << n_coarse << std::endl;
-      std::cout << "FFT speedup factor: " << static_cast<double>(n_fine) / n_coarse << "x" << std::endl;
- 
-      const double norm_factor = 1.0 / n_coarse;
+         LLGQ_arrays::noise_group_t& group = LLGQ_arrays::noise_groups[mat];
+         const int realizations = 3 * group.num_atoms;
+         if (realizations == 0) continue;
+
+         // Calculate coarse time step
+         group.dt_coarse = dt_fine * group.M;
+         group.seed = gen();
+
+         std::cout << "Material " << mat + 1 << ": " << realizations << " realizations, decimation factor M: " << group.M
+                   << ", number of coarse time steps: " << group.n_coarse << ", FFT speedup factor: " << static_cast<double>(n_fine) / group.n_coarse << "x" << std::endl;
+
+         generate_noise_group(mat, T, completed_realizations, total_realizations);
+
+      }
+
+      #else
+         std::cerr << "Error - quantum thermostat requires the FFTW library to function. Please recompile with the FFT library linked" << std::endl;
+         err::vexit();
+      #endif
+
+      std::cout << std::endl;
+   }
+
+   //------------------------------------------------------------------------------
+   // Function to generate the white noise of a group from its seed and filter it
+   // with the PSD of its material at temperature T, giving the coarse noise of
+   // the group. Each realization has its own stream seeded from the group seed
+   // and realization index, so the white noise is identical whenever the group
+   // is regenerated. Realizations are transformed in batches to amortise the
+   // cost of the FFTs. A progress bar is printed if total_realizations > 0.
+   //------------------------------------------------------------------------------
+   void generate_noise_group(const int mat, const double T, int& completed_realizations, const int total_realizations) {
+
+     #ifdef FFT
+
+      LLGQ_arrays::noise_group_t& group = LLGQ_arrays::noise_groups[mat];
+      const int realizations = 3 * group.num_atoms;
+      if (realizations == 0) return;
+
+      int n_coarse = group.n_coarse;
+      const int n_freq = n_coarse/2 + 1;
+      const double dt_coarse = group.dt_coarse;
 
       // White noise statistics use fine time step to preserve variance
-      static thread_local std::random_device rd;
-      static thread_local std::mt19937 gen(rd());
-      std::normal_distribution<> dist(0.0, 1.0 / std::sqrt(dt_fine));
+      const double dt_fine = dt_coarse / group.M;
 
-      LLGQ_arrays::coarse_noise_field.resize(realizations*n_coarse);
+      // Spin length of material
+      const double S0 = sim::internal::quantum_bath[mat].S0;
+      const double inv_sqrt_S0 = (S0 > 0) ? 1.0 / std::sqrt(S0) : 1.0;
 
-      // Progress bar setup
-      const int bar_width = 50;
-      int last_printed_percent = -1;
-      std::cout << "Generating PSD-based quantum noise fields on coarse grid..." << std::endl;
+      // Scale to preserve fine-time-step variance
+      const double scale = std::sqrt(1.0 / group.M) * inv_sqrt_S0 / n_coarse;
 
-      // Precompute PSD on coarse grid frequency space
-      std::vector<double> sqrt_PSD_coarse(n_coarse/2 + 1);
+      // Precompute PSD of material on coarse grid frequency space
+      std::vector<double> sqrt_PSD_coarse(n_freq);
       double df_coarse = 1.0 / (n_coarse * dt_coarse);
-      for (int i = 0; i <= n_coarse/2; ++i) {
+      for (int i = 0; i < n_freq; ++i) {
          double omega = 2.0 * M_PI * i * df_coarse;
-         sqrt_PSD_coarse[i] = std::sqrt(PSD(omega, T));
+         sqrt_PSD_coarse[i] = std::sqrt(PSD(omega, T, mat));
       }
 
-      std::cout << "Starting noise generation for " << realizations << " realizations..." << std::endl;
-      for (int r = 0; r < realizations; ++r) {
-         // Generate white noise on the coarse grid
-         for (int i = 0; i < n_coarse; ++i) {
-            in[i] = dist(gen);
+      // --- Batched Memory Allocation for Coarse Grid FFT ---
+      const int batch = std::min(noise_batch_size, realizations);
+      double* __restrict in = (double*)fftw_malloc(sizeof(double) * n_coarse * batch);
+      fftw_complex* __restrict out = (fftw_complex*)fftw_malloc(sizeof(fftw_complex) * n_freq * batch);
+
+      fftw_plan forward = fftw_plan_many_dft_r2c(1, &n_coarse, batch, in, NULL, 1, n_coarse, out, NULL, 1, n_freq, FFTW_MEASURE);
+      fftw_plan backward = fftw_plan_many_dft_c2r(1, &n_coarse, batch, out, NULL, 1, n_freq, in, NULL, 1, n_coarse, FFTW_MEASURE);
+
+      // Progress bar setup
+      const int bar_width = 50;
+      int last_printed_percent = -1;
+
+      for (int r0 = 0; r0 < realizations; r0 += batch) {
+         const int nb = std::min(batch, realizations - r0);
+
+         // Generate white noise on the coarse grid, padding a partial batch with zeros
+         for (int b = 0; b < batch; ++b) {
+            double* in_b = in + b * n_coarse;
+            if (b < nb) {
+               std::seed_seq seq{group.seed, static_cast<uint32_t>(r0 + b)};
+               std::mt19937 gen(seq);
+               std::normal_distribution<> dist(0.0, 1.0 / std::sqrt(dt_fine));
+               for (int i = 0; i < n_coarse; ++i) in_b[i] = dist(gen);
+            }
+            else for (int i = 0; i < n_coarse; ++i) in_b[i] = 0.0;
          }
 
          // Forward FFT
          fftw_execute(forward);
 
-         // Apply PSD on coarse grid
-         for (int i = 0; i <= n_coarse/2; i++) {
-            const double magnitude = sqrt_PSD_coarse[i];
-            out[i][0] *= magnitude;
-            out[i][1] *= magnitude;
+         // Apply PSD on coarse grid to white noise spectra
+         for (int b = 0; b < batch; ++b) {
+            fftw_complex* out_b = out + b * n_freq;
+            for (int i = 0; i < n_freq; i++) {
+               const double magnitude = sqrt_PSD_coarse[i];
+               out_b[i][0] *= magnitude;
+               out_b[i][1] *= magnitude;
+            }
          }
 
          // Inverse FFT
          fftw_execute(backward);
 
-         // Scale to preserve fine-time-step variance and store coarse noise
-         const double scale = std::sqrt(dt_fine / dt_coarse);
-         for (int j = 0; j < n_coarse; ++j) {
-            LLGQ_arrays::coarse_noise_field[j+r*n_coarse] = result[j] * norm_factor * inv_sqrt_S0 * scale;
+         // Store coarse noise of group
+         for (int b = 0; b < nb; ++b) {
+            const double* result_b = in + b * n_coarse;
+            double* noise = &LLGQ_arrays::coarse_noise_field[group.offset + uint64_t(r0 + b) * n_coarse];
+            for (int j = 0; j < n_coarse; ++j) noise[j] = result_b[j] * scale;
          }
 
          // Progress bar update
-         int current_percent = static_cast<int>(std::round((r + 1) * 100.0 / realizations));
-         if (current_percent > last_printed_percent) {
-            float progress = static_cast<float>(r + 1) / realizations;
-            int pos = static_cast<int>(bar_width * progress);
-
-            std::cout << "\r[";
-            for (int i = 0; i < bar_width; ++i) {
-               if (i < pos) std::cout << "=";
-               else if (i == pos) std::cout << ">";
-               else std::cout << " ";
+         completed_realizations += nb;
+         if (total_realizations > 0) {
+            int current_percent = static_cast<int>(std::round(completed_realizations * 100.0 / total_realizations));
+            if (current_percent > last_printed_percent) {
+               float progress = static_cast<float>(completed_realizations) / total_realizations;
+               int pos = static_cast<int>(bar_width * progress);
+
+               std::cout << "\r[";
+               for (int i = 0; i < bar_width; ++i) {
+                  if (i < pos) std::cout << "=";
+                  else if (i == pos) std::cout << ">";
+                  else std::cout << " ";
+               }
+               std::cout << "] " << std::setw(3) << current_percent << "%";
+               std::cout.flush();
+
+               last_printed_percent = current_percent;
             }
-            std::cout << "] " << std::setw(3) << current_percent << "%";
-            std::cout.flush();
-
-            last_printed_percent = current_percent;
          }
       }
 
-      // Cleanup FFTW resources after all realizations are complete
+      // Cleanup FFTW resources after all realizations of group are complete
       fftw_destroy_plan(forward);
       fftw_destroy_plan(backward);
       fftw_free(in);
       fftw_free(out);
-      fftw_free(result);
 
-      #else
-         std::cerr << "Error - quantum thermostat requires the FFTW library to function. Please recompile with the FFT library linked" << std::endl;
-         err::vexit();
+      group.temperature = T;
+      group.scale = 1.0;
+
+      zlog << zTs() << "Quantum noise of material " << mat + 1 << " generated for temperature " << T << " K" << std::endl;
+
       #endif
 
-      std::cout << std::endl;
    }
 
-   double PSD(const double& omega, const double& T) {
-      // Correctly access parameters using 
-      const double A = sim::internal::mp[0].A.get();
-      const double Gamma = sim::internal::mp[0].Gamma.get();
-      const double omega0 = sim::internal::mp[0].omega0.get();
+   double PSD(const double& omega, const double& T, const int mat) {
+      // Bath coefficients of material
+      const double A = sim::internal::quantum_bath[mat].A;
+      const double Gamma = sim::internal::quantum_bath[mat].Gamma;
+      const double omega0 = sim::internal::quantum_bath[mat].omega0;
 
       double x = (T > 1e-12) ? omega / (2 * T) : omega;  // Avoid division by zero
       double lorentzian_denom = (omega0 * omega0 - omega * omega) * (omega0 * omega0 - omega * omega) + Gamma * Gamma * omega * omega;
@@ -511,53 +615,15 @@ namespace sim{
 
    }
 
-   void precompute_sqrt_PSD(int n, double dt, double T) {
+   void precompute_sqrt_PSD(int n, double dt, double T, const int mat) {
       if (n <= 0) return;
       // Correctly access sqrt_PSD_buffer from the namespace
       LLGQ_arrays::sqrt_PSD_buffer.resize(n/2 + 1);
       double df = 1.0 / (n * dt);
       for (int i = 0; i <= n/2; ++i) {
          double omega = 2.0 * M_PI * i * df;
-         LLGQ_arrays::sqrt_PSD_buffer[i] = std::sqrt(PSD(omega, T));
+         LLGQ_arrays::sqrt_PSD_buffer[i] = std::sqrt(PSD(omega, T, mat));
       }
    }
 
-   // Function to estimate cutoff frequency from noise_interpolated.cpp
-   double estimate_cutoff_omega_cdf(double T, double target_frac) { 
-       const double omega0 = sim::internal::mp[0].omega0.get();
-       if (omega0 <= 0) return 1.0;
-       double omega_max = 10.0 * omega0;
-       int steps = 50000;
-       std::vector<double> psd_vals(steps + 1);
-       double domega = omega_max / steps;
-       for (int i = 0; i <= steps; ++i) {
-           double omega = i * domega;
-           psd_vals[i] = PSD(omega, T);
-       }
-       double total_area = 0.0;
-       for (int i = 0; i < steps; ++i) {
-           total_area += 0.5 * (psd_vals[i] + psd_vals[i + 1]) * domega;
-       }
-       if (total_area <= 1e-12) return omega_max;
-       double cum_area = 0.0;
-       for (int i = 0; i <= steps; ++i) {
-           if (i > 0) cum_area += 0.5 * (psd_vals[i - 1] + psd_vals[i]) * domega;
-           if (cum_area >= target_frac * total_area) {
-               return i * domega;
-           }
-       }
-       return omega_max;
-   }    
-
-   
-
-   double get_noise(const std::vector<double>& coarse_noise, double fine_step_idx, int M, int atom_idx) {
-          double coarse_idx_float = fine_step_idx / M;
-          int j = static_cast<int>(coarse_idx_float);
-          double frac = coarse_idx_float - j;
-
-          // Linear interpolation
-          return coarse_noise[j+atom_idx] * (1.0 - frac) + coarse_noise[j + atom_idx + 1] * frac;
-    }
-
 } // end of sim namespace
@@ -0,0 +1,222 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// Standard Libraries
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+// Vampire Header files
+#include "atoms.hpp"
+#include "errors.hpp"
+#include "sim.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+#include "internal.hpp"
+
+namespace minimiser_arrays{
+
+   // Velocities of spins in the tangent plane for FIRE minimisation
+   std::vector<double> x_velocity_array;
+   std::vector<double> y_velocity_array;
+   std::vector<double> z_velocity_array;
+
+   // Forces on spins, the component of the effective field in the tangent plane
+   std::vector<double> x_force_array;
+   std::vector<double> y_force_array;
+   std::vector<double> z_force_array;
+
+}
+
+namespace sim{
+
+   //---------------------------------------------------------------------------
+   // Function to relax the spin configuration to a local energy minimum at zero
+   // temperature with the fast inertial relaxation engine (FIRE) of Bitzek et
+   // al, Phys. Rev. Lett. 97, 170201 (2006), adapted to the product of spheres.
+   // The force on each spin is the component of the effective field in the
+   // tangent plane, velocities are kept in the tangent plane and spins are
+   // renormalised after each move. Minimisation stops when the maximum torque
+   // |S x H| on any spin, as calculated by stats::max_torque(), is below the
+   // tolerance or after max_iterations. Each iteration increments the
+   // simulation time so that dipole and other time dependent fields are
+   // updated as for the integrators. Returns the number of iterations.
+   //---------------------------------------------------------------------------
+   uint64_t minimise(const uint64_t max_iterations){
+
+      // Check calling of routine if error checking is activated
+      if(err::check == true) std::cout << "sim::minimise has been called" << std::endl;
+
+      using namespace minimiser_arrays;
+
+      // atoms to minimise, including boundary atoms in parallel
+      #ifdef MPICF
+         const int end = vmpi::num_core_atoms + vmpi::num_bdry_atoms;
+      #else
+         const int end = atoms::num_atoms;
+      #endif
+
+      x_velocity_array.assign(atoms::num_atoms, 0.0);
+      y_velocity_array.assign(atoms::num_atoms, 0.0);
+      z_velocity_array.assign(atoms::num_atoms, 0.0);
+
+      x_force_array.resize(atoms::num_atoms, 0.0);
+      y_force_array.resize(atoms::num_atoms, 0.0);
+      z_force_array.resize(atoms::num_atoms, 0.0);
+
+      // minimisation is at zero temperature, so temporarily disable thermal fields
+      const int thermal_flag = sim::hamiltonian_simulation_flags[3];
+      sim::hamiltonian_simulation_flags[3] = 0;
+
+      const double tolerance = sim::internal::minimiser_torque_tolerance;
+
+      // FIRE parameters
+      const int    n_min   = 5;    // minimum number of downhill steps before time step increases
+      const double f_inc   = 1.1;  // time step increase factor
+      const double f_dec   = 0.5;  // time step decrease factor
+      const double a_start = 0.1;  // initial velocity mixing parameter
+      const double f_a     = 0.99; // mixing parameter decrease factor
+
+      double alpha = a_start;
+      double dt = 0.0;
+      double dt_max = 0.0;
+      int n_downhill = 0;
+
+      uint64_t iteration = 0;
+      double max_torque = 0.0;
+
+      while(true){
+
+         // Update halo spins and calculate fields
+         #ifdef MPICF
+            vmpi::mpi_init_halo_swap();
+            vmpi::mpi_complete_halo_swap();
+         #endif
+
+         calculate_spin_fields(0, end);
+         calculate_external_fields(0, end);
+
+         // Project fields onto tangent plane to find forces and accumulate sums
+         double sums[3] = {0.0, 0.0, 0.0}; // power F.v, |F|^2, |v|^2
+         double maxima[2] = {0.0, 0.0};    // maximum torque and field
+         for(int atom = 0; atom < end; atom++){
+
+            const double S[3] = {atoms::x_spin_array[atom], atoms::y_spin_array[atom], atoms::z_spin_array[atom]};
+            const double H[3] = {atoms::x_total_spin_field_array[atom] + atoms::x_total_external_field_array[atom],
+                                 atoms::y_total_spin_field_array[atom] + atoms::y_total_external_field_array[atom],
+                                 atoms::z_total_spin_field_array[atom] + atoms::z_total_external_field_array[atom]};
+
+            const double SdotH = S[0]*H[0] + S[1]*H[1] + S[2]*H[2];
+
+            // Calculate force, |F| = |S x H| for unit spins
+            const double F[3] = {H[0] - SdotH*S[0], H[1] - SdotH*S[1], H[2] - SdotH*S[2]};
+            x_force_array[atom] = F[0];
+            y_force_array[atom] = F[1];
+            z_force_array[atom] = F[2];
+
+            const double v[3] = {x_velocity_array[atom], y_velocity_array[atom], z_velocity_array[atom]};
+            const double F_sq = F[0]*F[0] + F[1]*F[1] + F[2]*F[2];
+
+            sums[0] += F[0]*v[0] + F[1]*v[1] + F[2]*v[2];
+            sums[1] += F_sq;
+            sums[2] += v[0]*v[0] + v[1]*v[1] + v[2]*v[2];
+            maxima[0] = std::max(maxima[0], F_sq);
+            maxima[1] = std::max(maxima[1], H[0]*H[0] + H[1]*H[1] + H[2]*H[2]);
+
+         }
+
+         #ifdef MPICF
+            MPI_Allreduce(MPI_IN_PLACE, sums, 3, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+            MPI_Allreduce(MPI_IN_PLACE, maxima, 2, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+         #endif
+
+         max_torque = sqrt(maxima[0]);
+
+         // Check for convergence
+         if(max_torque < tolerance || iteration >= max_iterations) break;
+
+         // Set time steps from the stiffest spin, dt^2 |H| ~ 1 for the maximum step
+         if(iteration == 0){
+            dt_max = 1.0 / sqrt(std::max(sqrt(maxima[1]), tolerance));
+            dt = 0.1 * dt_max;
+         }
+
+         // Mix velocities with forces when moving downhill, otherwise stop
+         const double power = sums[0];
+         double mix_v = 1.0;
+         double mix_F = 0.0;
+         if(power >= 0.0 && sums[1] > 0.0){
+            mix_v = 1.0 - alpha;
+            mix_F = alpha * sqrt(sums[2] / sums[1]);
+            if(n_downhill > n_min){
+               dt = std::min(dt * f_inc, dt_max);
+               alpha *= f_a;
+            }
+            n_downhill++;
+         }
+         else{
+            mix_v = 0.0;
+            dt *= f_dec;
+            alpha = a_start;
+            n_downhill = 0;
+         }
+
+         // Move spins and keep velocities in the tangent plane of new spins
+         for(int atom = 0; atom < end; atom++){
+
+            const double F[3] = {x_force_array[atom], y_force_array[atom], z_force_array[atom]};
+
+            double v[3] = {mix_v * x_velocity_array[atom] + mix_F * F[0] + dt * F[0],
+                           mix_v * y_velocity_array[atom] + mix_F * F[1] + dt * F[1],
+                           mix_v * z_velocity_array[atom] + mix_F * F[2] + dt * F[2]};
+
+            double S_new[3] = {atoms::x_spin_array[atom] + dt * v[0],
+                               atoms::y_spin_array[atom] + dt * v[1],
+                               atoms::z_spin_array[atom] + dt * v[2]};
+
+            // Normalise Spin Length
+            const double mod_S = 1.0 / sqrt(S_new[0]*S_new[0] + S_new[1]*S_new[1] + S_new[2]*S_new[2]);
+            S_new[0] *= mod_S;
+            S_new[1] *= mod_S;
+            S_new[2] *= mod_S;
+
+            const double vdotS = v[0]*S_new[0] + v[1]*S_new[1] + v[2]*S_new[2];
+
+            x_velocity_array[atom] = v[0] - vdotS * S_new[0];
+            y_velocity_array[atom] = v[1] - vdotS * S_new[1];
+            z_velocity_array[atom] = v[2] - vdotS * S_new[2];
+
+            atoms::x_spin_array[atom] = S_new[0];
+            atoms::y_spin_array[atom] = S_new[1];
+            atoms::z_spin_array[atom] = S_new[2];
+
+         }
+
+         // Increment time
+         sim::internal::increment_time();
+         iteration++;
+
+      }
+
+      // restore thermal fields
+      sim::hamiltonian_simulation_flags[3] = thermal_flag;
+
+      if(max_torque >= tolerance){
+         zlog << zTs() << "Warning - energy minimisation did not converge after " << iteration << " iterations, maximum torque is "
+              << max_torque << " T" << std::endl;
+      }
+
+      return iteration;
+
+   }
+
+} // end of sim namespace
@@ -0,0 +1,524 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// Standard Libraries
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Vampire Header files
+#include "atoms.hpp"
+#include "sim.hpp"
+#include "vio.hpp"
+
+#include "internal.hpp"
+
+//------------------------------------------------------------------------------
+// Interpolation of the quantum thermostat noise
+//
+// The coloured noise of the quantum thermostat is generated on a coarse time
+// grid with spacing M dt and interpolated to the fine (half) time steps of the
+// integrator. Linear interpolation strongly attenuates power close to the
+// coarse Nyquist frequency and leaks power into images above it, so the
+// decimation factor M has to be chosen conservatively. Higher order schemes
+// (cubic Catmull-Rom and Lanczos windowed sinc) have a flatter pass band and
+// smaller images, and so allow a larger M for the same spectral error. The
+// exact scheme generates noise directly on the half step grid.
+//
+// Each material has its own bath, and so its own PSD and decimation factor.
+// The noise of all atoms of a material is stored as a contiguous group.
+//
+// The spectral error of each scheme is estimated analytically from the
+// frequency response of the interpolation kernel applied to the band limited
+// coarse spectrum, without generating any noise.
+//------------------------------------------------------------------------------
+namespace sim{
+
+   double PSD(const double& omega, const double& T, const int mat);
+
+   namespace{
+
+      //---------------------------------------------------------------------------
+      // Tabulated power spectral density and its cumulative integral, cached for
+      // the last set of thermostat parameters of each material
+      //---------------------------------------------------------------------------
+      class psd_table_t{
+      public:
+         bool valid;
+         double T;
+         double A;
+         double Gamma;
+         double omega0;
+         int noise_type;
+         double domega; // frequency step
+         std::vector<double> psd; // power spectral density at i*domega
+         std::vector<double> cdf; // integral of psd from 0 to i*domega
+
+         psd_table_t(): valid(false), T(0.0), A(0.0), Gamma(0.0), omega0(0.0), noise_type(0), domega(0.0){}
+      };
+
+      std::vector<psd_table_t> psd_tables; // tables for each material
+      const int psd_table_steps = 50000; // number of frequency intervals in table
+      const int error_stride = 10; // table stride used for spectral error estimates
+
+      const int sinc_lobes = 4; // number of lobes of the Lanczos window
+
+      // frequency response tables of interpolation kernels
+      const double response_dx = 0.01;
+      const double response_x_max = 32.0 * M_PI;
+      std::vector<double> response_table[4];
+
+      //---------------------------------------------------------------------------
+      // Function to return PSD table for the current thermostat parameters
+      //---------------------------------------------------------------------------
+      const psd_table_t& get_psd_table(double T, const int mat){
+
+         const double A = sim::internal::quantum_bath[mat].A;
+         const double Gamma = sim::internal::quantum_bath[mat].Gamma;
+         const double omega0 = sim::internal::quantum_bath[mat].omega0;
+
+         if(psd_tables.size() < sim::internal::quantum_bath.size()) psd_tables.resize(sim::internal::quantum_bath.size());
+         psd_table_t& psd_table = psd_tables[mat];
+
+         // return cached table if parameters are unchanged
+         if(psd_table.valid && psd_table.T == T && psd_table.A == A && psd_table.Gamma == Gamma &&
+            psd_table.omega0 == omega0 && psd_table.noise_type == sim::noise_type) return psd_table;
+
+         const int steps = psd_table_steps;
+         const double omega_max = 10.0 * omega0;
+         const double domega = omega_max / steps;
+
+         psd_table.psd.resize(steps + 1);
+         psd_table.cdf.resize(steps + 1);
+
+         for (int i = 0; i <= steps; ++i) psd_table.psd[i] = PSD(i * domega, T, mat);
+
+         double cum_area = 0.0;
+         psd_table.cdf[0] = 0.0;
+         for (int i = 1; i <= steps; ++i){
+            cum_area += 0.5 * (psd_table.psd[i - 1] + psd_table.psd[i]) * domega;
+            psd_table.cdf[i] = cum_area;
+         }
+
+         psd_table.valid = true;
+         psd_table.T = T;
+         psd_table.A = A;
+         psd_table.Gamma = Gamma;
+         psd_table.omega0 = omega0;
+         psd_table.noise_type = sim::noise_type;
+         psd_table.domega = domega;
+
+         return psd_table;
+
+      }
+
+      //---------------------------------------------------------------------------
+      // Function to interpolate tabulated PSD, zero outside of table
+      //---------------------------------------------------------------------------
+      double tabulated_psd(const psd_table_t& table, double omega){
+         const double x = omega / table.domega;
+         const int i = static_cast<int>(x);
+         if(i >= psd_table_steps) return (i == psd_table_steps && x == i) ? table.psd[i] : 0.0;
+         const double frac = x - i;
+         return table.psd[i] * (1.0 - frac) + table.psd[i + 1] * frac;
+      }
+
+      //---------------------------------------------------------------------------
+      // Interpolation kernels in units of the coarse time step
+      //---------------------------------------------------------------------------
+      double interpolation_kernel(sim::internal::noise_interpolation_t scheme, double s){
+         const double x = std::fabs(s);
+         switch(scheme){
+            case sim::internal::cubic_noise: // Catmull-Rom spline
+               if(x < 1.0) return 1.5 * x * x * x - 2.5 * x * x + 1.0;
+               if(x < 2.0) return -0.5 * x * x * x + 2.5 * x * x - 4.0 * x + 2.0;
+               return 0.0;
+            case sim::internal::sinc_noise:{ // Lanczos windowed sinc
+               if(x < 1.0e-12) return 1.0;
+               if(x >= sinc_lobes) return 0.0;
+               const double px = M_PI * x;
+               return sinc_lobes * std::sin(px) * std::sin(px / sinc_lobes) / (px * px);
+            }
+            case sim::internal::exact_noise:
+               return x < 0.5 ? 1.0 : 0.0;
+            default: // linear
+               return x < 1.0 ? 1.0 - x : 0.0;
+         }
+      }
+
+      int kernel_taps(sim::internal::noise_interpolation_t scheme){
+         switch(scheme){
+            case sim::internal::cubic_noise: return 4;
+            case sim::internal::sinc_noise: return 2 * sinc_lobes;
+            case sim::internal::exact_noise: return 1;
+            default: return 2;
+         }
+      }
+
+      std::string scheme_name(sim::internal::noise_interpolation_t scheme){
+         switch(scheme){
+            case sim::internal::cubic_noise: return "cubic";
+            case sim::internal::sinc_noise: return "windowed-sinc";
+            case sim::internal::exact_noise: return "exact";
+            default: return "linear";
+         }
+      }
+
+      //---------------------------------------------------------------------------
+      // Function to return the power response |H(x)|^2 of an interpolation
+      // kernel at x = omega * coarse time step
+      //---------------------------------------------------------------------------
+      double power_response(sim::internal::noise_interpolation_t scheme, double x){
+
+         if(x >= response_x_max) return 0.0;
+
+         std::vector<double>& table = response_table[scheme];
+
+         // tabulate response on first use with Simpson integration of the kernel
+         if(table.empty()){
+            const int num_x = static_cast<int>(response_x_max / response_dx) + 2;
+            const double support = 0.5 * kernel_taps(scheme);
+            const int n = 256 * kernel_taps(scheme); // even number of intervals
+            const double ds = support / n;
+            std::vector<double> kernel(n + 1);
+            for(int k = 0; k <= n; k++) kernel[k] = interpolation_kernel(scheme, k * ds);
+            table.resize(num_x);
+            for(int i = 0; i < num_x; i++){
+               const double xi = i * response_dx;
+               double sum = kernel[0] + kernel[n] * std::cos(xi * support);
+               for(int k = 1; k < n; k++) sum += (k % 2 == 1 ? 4.0 : 2.0) * kernel[k] * std::cos(xi * k * ds);
+               const double H = 2.0 * sum * ds / 3.0;
+               table[i] = H * H;
+            }
+            // interpolation weights are normalised, so normalise to unit response at zero frequency
+            const double norm = table[0];
+            for(int i = 0; i < num_x; i++) table[i] /= norm;
+         }
+
+         const double r = x / response_dx;
+         const int i = static_cast<int>(r);
+         const double frac = r - i;
+         return table[i] * (1.0 - frac) + table[i + 1] * frac;
+
+      }
+
+      //---------------------------------------------------------------------------
+      // Function to estimate the relative spectral error of the interpolated noise
+      //
+      // The noise is generated with the PSD up to the coarse Nyquist frequency,
+      // so the time averaged spectrum of the interpolated noise is the nearest
+      // image of the band limited spectrum weighted by the kernel response. The
+      // error is the integrated absolute difference to the target PSD, relative
+      // to the total power.
+      //---------------------------------------------------------------------------
+      double spectral_error(sim::internal::noise_interpolation_t scheme, int M, double dt, double T, const int mat){
+
+         const psd_table_t& table = get_psd_table(T, mat);
+
+         const double delta = (scheme == sim::internal::exact_noise) ? 0.5 * dt : M * dt;
+         const double omega_nyquist = M_PI / delta;
+
+         double error = 0.0;
+         double total = 0.0;
+         for(int i = 0; i <= psd_table_steps; i += error_stride){
+            const double omega = i * table.domega;
+            const double target = table.psd[i];
+            // nearest image of band limited coarse spectrum
+            const double k = std::floor(0.5 * omega / omega_nyquist + 0.5);
+            const double base = std::fabs(omega - 2.0 * k * omega_nyquist);
+            double gain = 0.0;
+            if(scheme == sim::internal::exact_noise) gain = (k == 0.0) ? 1.0 : 0.0;
+            else gain = power_response(scheme, omega * delta);
+            error += std::fabs(gain * tabulated_psd(table, base) - target);
+            total += target;
+         }
+
+         return total > 0.0 ? error / total : 0.0;
+
+      }
+
+      //---------------------------------------------------------------------------
+      // Function to choose the decimation factor for a given scheme, as the
+      // largest M with a spectral error no larger than linear interpolation
+      // with the cutoff based decimation factor
+      //---------------------------------------------------------------------------
+      int select_decimation(sim::internal::noise_interpolation_t scheme, int M_linear, double dt, double T, const int mat){
+
+         if(scheme == sim::internal::linear_noise) return M_linear;
+         if(scheme == sim::internal::exact_noise) return 1;
+
+         const double reference_error = spectral_error(sim::internal::linear_noise, M_linear, dt, T, mat);
+         const int max_M = 64 * M_linear;
+
+         // bracket largest acceptable M between lo (acceptable) and hi (not acceptable)
+         int lo = M_linear;
+         int hi = 2 * M_linear;
+         if(spectral_error(scheme, lo, dt, T, mat) > reference_error){
+            hi = lo;
+            lo = 0;
+         }
+         else{
+            while(hi <= max_M && spectral_error(scheme, hi, dt, T, mat) <= reference_error){
+               lo = hi;
+               hi *= 2;
+            }
+            if(hi > max_M) return lo;
+         }
+
+         // bisect to find largest acceptable M
+         while(hi - lo > 1){
+            const int mid = lo + (hi - lo) / 2;
+            if(spectral_error(scheme, mid, dt, T, mat) <= reference_error) lo = mid;
+            else hi = mid;
+         }
+
+         return lo > 0 ? lo : 1;
+
+      }
+
+      //---------------------------------------------------------------------------
+      // Function to compute number of coarse noise values for a scheme
+      //---------------------------------------------------------------------------
+      int num_coarse_values(sim::internal::noise_interpolation_t scheme, int M, int n_fine){
+         if(n_fine <= 0) return 0;
+         if(scheme == sim::internal::exact_noise) return 2 * n_fine;
+         return (n_fine - 1) / M + 1;
+      }
+
+      //---------------------------------------------------------------------------
+      // Function to write table of spectral error against noise memory
+      //---------------------------------------------------------------------------
+      void report_noise_benchmark(int M_linear, int n_fine, double dt, double T, int realizations, const int mat){
+
+         const sim::internal::noise_interpolation_t schemes[4] = { sim::internal::linear_noise, sim::internal::cubic_noise,
+                                                                   sim::internal::sinc_noise, sim::internal::exact_noise };
+
+         const double bytes_per_value = double(realizations) * sizeof(double);
+
+         std::stringstream table;
+         table << "Quantum noise interpolation benchmark for material " << mat + 1 << " with " << n_fine << " time steps and " << realizations << " realizations" << "\n";
+         table << std::left << std::setw(16) << "scheme" << std::right << std::setw(10) << "M"
+               << std::setw(14) << "coarse steps" << std::setw(14) << "memory (MB)" << std::setw(16) << "spectral error" << "\n";
+         for(int s = 0; s < 4; s++){
+            const int M = select_decimation(schemes[s], M_linear, dt, T, mat);
+            const int n_coarse = num_coarse_values(schemes[s], M, n_fine);
+            table << std::left << std::setw(16) << scheme_name(schemes[s]) << std::right << std::setw(10) << M
+                  << std::setw(14) << n_coarse << std::setw(14) << std::fixed << std::setprecision(3) << 1.0e-6 * bytes_per_value * n_coarse
+                  << std::setw(16) << std::scientific << std::setprecision(4) << spectral_error(schemes[s], M, dt, T, mat) << "\n";
+         }
+
+         // spectral error of decimating schemes for a range of decimation factors
+         table << "Spectral error against decimation factor" << "\n";
+         table << std::right << std::setw(10) << "M" << std::setw(14) << "memory (MB)";
+         for(int s = 0; s < 3; s++) table << std::setw(16) << scheme_name(schemes[s]);
+         table << "\n";
+         for(int M = 1; M <= 4 * M_linear; M *= 2){
+            table << std::setw(10) << M << std::setw(14) << std::fixed << std::setprecision(3)
+                  << 1.0e-6 * bytes_per_value * num_coarse_values(sim::internal::linear_noise, M, n_fine);
+            table << std::scientific << std::setprecision(4);
+            for(int s = 0; s < 3; s++) table << std::setw(16) << spectral_error(schemes[s], M, dt, T, mat);
+            table << "\n";
+         }
+
+         std::string line;
+         while(std::getline(table, line)){
+            std::cout << line << std::endl;
+            zlog << zTs() << line << std::endl;
+         }
+
+         return;
+
+      }
+
+   } // end of anonymous namespace
+
+   //------------------------------------------------------------------------------
+   // Function to estimate the frequency below which a fraction target_frac of
+   // the noise power of a material lies, from the cached cumulative PSD table
+   //------------------------------------------------------------------------------
+   double estimate_cutoff_omega_cdf(double T, double target_frac, const int mat) {
+      const double omega0 = sim::internal::quantum_bath[mat].omega0;
+      if (omega0 <= 0) return 1.0;
+      const psd_table_t& table = get_psd_table(T, mat);
+      const double omega_max = psd_table_steps * table.domega;
+      const double total_area = table.cdf[psd_table_steps];
+      if (total_area <= 1e-12) return omega_max;
+      // first frequency with cumulative power reaching the target
+      std::vector<double>::const_iterator it = std::lower_bound(table.cdf.begin(), table.cdf.end(), target_frac * total_area);
+      if (it == table.cdf.end()) return omega_max;
+      return (it - table.cdf.begin()) * table.domega;
+   }
+
+   namespace internal{
+
+      //---------------------------------------------------------------------------
+      // Function to compute the coarse noise indices and weights interpolating the
+      // noise of a group at a (half) fine time step. These are the same for all
+      // realizations in the group, and include the amplitude scale of the group.
+      //---------------------------------------------------------------------------
+      void build_noise_stencil(const LLGQ_arrays::noise_group_t& group, double fine_step_idx, LLGQ_arrays::noise_stencil_t& stencil){
+
+         const int M = group.M;
+         const int n_coarse = group.n_coarse;
+
+         // noise is generated by FFT and so is periodic, allowing runs of any length
+         switch(noise_interpolation){
+
+            case exact_noise:{
+               stencil.taps = 1;
+               stencil.index[0] = static_cast<int64_t>(2.0 * fine_step_idx + 0.5) % n_coarse;
+               stencil.weight[0] = group.scale;
+               break;
+            }
+
+            case cubic_noise:
+            case sinc_noise:{
+               // fine step index is a multiple of half a step, so weights only depend on the phase
+               const int taps = group.taps;
+               const int64_t half_steps = static_cast<int64_t>(2.0 * fine_step_idx + 0.5);
+               const int phase = half_steps % (2 * M);
+               const int first = (half_steps / (2 * M)) % n_coarse + 1 - taps / 2;
+               const double* weights = &group.weights[phase * taps];
+               stencil.taps = taps;
+               for(int t = 0; t < taps; t++){
+                  int j = (first + t) % n_coarse;
+                  if(j < 0) j += n_coarse;
+                  stencil.index[t] = j;
+                  stencil.weight[t] = group.scale * weights[t];
+               }
+               break;
+            }
+
+            default:{
+               double coarse_idx_float = fine_step_idx / M;
+               int64_t coarse_idx = static_cast<int64_t>(coarse_idx_float);
+               double frac = coarse_idx_float - coarse_idx;
+
+               // Linear interpolation, wrapping at the end of the periodic realization
+               const int j = coarse_idx % n_coarse;
+               stencil.taps = 2;
+               stencil.index[0] = j;
+               stencil.index[1] = (j + 1 < n_coarse) ? j + 1 : 0;
+               stencil.weight[0] = group.scale * (1.0 - frac);
+               stencil.weight[1] = group.scale * frac;
+               break;
+            }
+
+         }
+
+      }
+
+      //---------------------------------------------------------------------------
+      // Function to return the decimation factor needed for the noise of a
+      // material at temperature T
+      //---------------------------------------------------------------------------
+      int required_decimation(const int mat, double dt_fine, double T){
+
+         // Calculate cutoff frequency and decimation factor for linear interpolation
+         const double omega_cutoff = estimate_cutoff_omega_cdf(T, 0.99999, mat);
+         const int M_linear = static_cast<int>(std::ceil((M_PI / omega_cutoff) / dt_fine));
+
+         return select_decimation(noise_interpolation, M_linear, dt_fine, T, mat);
+
+      }
+
+      //---------------------------------------------------------------------------
+      // Function to set up the noise group of each material with its decimation
+      // factor and interpolation weights, returning the total number of coarse
+      // noise values of all groups
+      //---------------------------------------------------------------------------
+      uint64_t initialise_noise_interpolation(int n_fine, double dt_fine, double T){
+
+         using namespace LLGQ_arrays;
+
+         const int num_materials = sim::internal::quantum_bath.size();
+
+         // count atoms of each material
+         std::vector<int> material_atoms(num_materials, 0);
+         for(int atom = 0; atom < atoms::num_atoms; atom++) material_atoms[atoms::type_array[atom]]++;
+
+         noise_groups.resize(num_materials);
+
+         uint64_t offset = 0;
+         uint64_t total_fine = 0; // noise values without decimation
+
+         for(int mat = 0; mat < num_materials; mat++){
+
+            noise_group_t& group = noise_groups[mat];
+            group.num_atoms = material_atoms[mat];
+            group.offset = offset;
+            group.M = 1;
+            group.n_coarse = 0;
+            group.taps = kernel_taps(noise_interpolation);
+            group.dt_coarse = dt_fine;
+            group.temperature = T;
+            group.scale = 1.0;
+            group.weights.clear();
+            group.seed = 0;
+
+            // skip materials without atoms
+            if(group.num_atoms == 0) continue;
+
+            const int realizations = 3 * group.num_atoms;
+
+            // Calculate cutoff frequency and decimation factor for linear interpolation
+            const double omega_cutoff = estimate_cutoff_omega_cdf(T, 0.99999, mat);
+            const int M_linear = static_cast<int>(std::ceil((M_PI / omega_cutoff) / dt_fine));
+
+            // Report spectral error and memory of all schemes
+            if(sim::internal::noise_benchmark) report_noise_benchmark(M_linear, n_fine, dt_fine, T, realizations, mat);
+
+            group.M = required_decimation(mat, dt_fine, T);
+            group.n_coarse = num_coarse_values(noise_interpolation, group.M, n_fine);
+
+            // Precompute normalised interpolation weights for every half step phase
+            const int taps = group.taps;
+            group.weights.assign(2 * group.M * taps, 0.0);
+            for(int phase = 0; phase < 2 * group.M; phase++){
+               const double frac = static_cast<double>(phase) / (2 * group.M);
+               double sum = 0.0;
+               for(int t = 0; t < taps; t++){
+                  const double w = interpolation_kernel(noise_interpolation, t + 1 - taps / 2 - frac);
+                  group.weights[phase * taps + t] = w;
+                  sum += w;
+               }
+               if(sum > 0.0) for(int t = 0; t < taps; t++) group.weights[phase * taps + t] /= sum;
+            }
+
+            offset += uint64_t(realizations) * group.n_coarse;
+            total_fine += uint64_t(realizations) * n_fine;
+
+            zlog << zTs() << "Quantum noise of material " << mat + 1 << " interpolated with scheme " << scheme_name(noise_interpolation)
+                 << " with decimation factor " << group.M << " and " << group.n_coarse << " noise values for each of " << realizations << " realizations" << std::endl;
+
+         }
+
+         const double mem_red = (total_fine > 0) ? 100.0 * (1.0 - static_cast<double>(offset) / total_fine) : 0.0;
+         std::cout << "Quantum noise interpolation enabled." << std::endl;
+         std::cout << "Interpolation scheme " << scheme_name(noise_interpolation) << ", decimation factor M=";
+         bool first = true;
+         for(int mat = 0; mat < num_materials; mat++){
+            if(noise_groups[mat].num_atoms == 0) continue;
+            std::cout << (first ? "" : ",") << noise_groups[mat].M;
+            first = false;
+         }
+         std::cout << ", estimated memory reduction=" << std::fixed << std::setprecision(1) << mem_red << "%" << std::endl;
+
+         return offset;
+
+      }
+
+   } // end of internal namespace
+
+} // end of sim namespace
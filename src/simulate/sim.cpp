@@ -51,6 +51,7 @@
 #include "../cells/internal.hpp"
 #include "../micromagnetic/internal.hpp"
 #include "dipole.hpp"
+#include "ensemble.hpp"
 #include "errors.hpp"
 #include "gpu.hpp"
 #include "grains.hpp"
@@ -66,6 +67,7 @@
 #include "stopwatch.hpp"
 #include "vio.hpp"
 #include "vmpi.hpp"
+#include "vprofile.hpp"
 #include "vutil.hpp"
 #include "micromagnetic.hpp"
 #include "sld.hpp"
@@ -244,6 +246,7 @@ int run(){
    // Precalculate initial statistics and then reset averages if not continuing a previous simulation
    // RE technically this double counts the last data point in the statistics, need to implement a reset_counter to fix.
    stats::update();
+   if(stats::calculate_system_histogram) stats::system_histogram.reset_histogram(); // initial sample is not part of any histogram
    if(!load_checkpoint_continue_flag) stats::reset();
 
    // For continuous checkpoints inform user about I/O
@@ -319,6 +322,9 @@ int run(){
    // Precondition spins at equilibration temperature
    montecarlo::monte_carlo_preconditioning();
 
+   // Set up replicas of preconditioned spin configuration for ensemble mode
+   ensemble::initialize(atoms::num_atoms, atoms::x_spin_array, atoms::y_spin_array, atoms::z_spin_array);
+
    // For MPI version, calculate initialisation time
    if(vmpi::my_rank==0){
 		std::cout << "Starting Simulation with Program ";
@@ -485,6 +491,13 @@ int run(){
 	  		}
 	  		program::field_pulse();
 	  		break;
+		case 19:
+	  		if(vmpi::my_rank==0){
+	    		std::cout << "parallel-tempering..." << std::endl;
+	    		zlog << "parallel-tempering..." << std::endl;
+	  		}
+	  		program::parallel_tempering();
+	  		break;
 
 		case 50:
 			if(vmpi::my_rank==0){
@@ -563,6 +576,9 @@ int run(){
 			}
 	}
 
+   // complete final block of energy-magnetization histogram
+   if(stats::calculate_system_histogram) stats::system_histogram.write_histogram();
+
    std::cout <<     "Simulation run time [s]: " << stopwatch.elapsed_seconds() << std::endl;
    zlog << zTs() << "Simulation run time [s]: " << stopwatch.elapsed_seconds() << std::endl;
 
@@ -597,6 +613,9 @@ int run(){
    // De-initialize GPU
    if(gpu::acceleration) gpu::finalize();
 
+   // Release dipole solver memory
+   dipole::finalize();
+
    // optionally save checkpoint file
    if(sim::save_checkpoint_flag && !sim::save_checkpoint_continuous_flag) save_checkpoint();
 
@@ -631,6 +650,10 @@ int integrate(uint64_t n_steps){
 	// Check for calling of function
 	if(err::check==true) std::cout << "sim::integrate has been called" << std::endl;
 
+	// time spent in integrators for profiling
+	VPROFILE_SCOPE(vprofile::integrator);
+	vprofile::add_steps(n_steps);
+
 	// Call serial or parallell depending at compile time
 	#ifdef MPICF
 		sim::integrate_mpi(n_steps);
@@ -698,6 +721,9 @@ void integrate_serial(uint64_t n_steps){
                 // Optionally select GPU accelerated version
                 if(gpu::acceleration) gpu::mc_step();
 
+                // Integrate all replicas in ensemble mode
+                else if(ensemble::enabled) ensemble::mc_step();
+
                 else montecarlo::mc_step(atoms::x_spin_array, atoms::y_spin_array, atoms::z_spin_array, atoms::num_atoms, atoms::type_array);
 
 				// increment time
@@ -767,6 +793,10 @@ void integrate_serial(uint64_t n_steps){
 			}
 			break;
 
+		case sim::llg_adaptive: // LLG adaptive time step (increments time internally)
+			sim::internal::llg_adaptive_integrate(n_steps);
+			break;
+
 		default:{
 			std::cerr << "Unknown integrator type "<< sim::integrator << " requested, exiting" << std::endl;
          err::vexit();
@@ -953,6 +983,10 @@ int integrate_mpi(uint64_t n_steps){
  			}
  			break;
 
+		case 10: // LLG adaptive time step (increments time internally)
+			sim::internal::llg_adaptive_integrate(n_steps);
+			break;
+
 		default:{
 			terminaltextcolor(RED);
 			std::cerr << "Unknown integrator type "<< sim::integrator << " requested, exiting" << std::endl;
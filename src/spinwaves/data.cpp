@@ -85,6 +85,10 @@ namespace spinwaves{
       // to check number of spectrums
       std::vector<int> super_index_values;
 
+      // streaming structure factor variables
+      bool streaming = false;
+      int segment_length = 512;
+
 
    } // end of internal namespace
 
@@ -0,0 +1,280 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// Vampire headers
+#include "spinwaves.hpp"
+#include "vio.hpp"
+
+// sw module headers
+#include "internal.hpp"
+
+namespace spinwaves{
+
+   namespace internal{
+
+      //------------------------------------------------------------------------------
+      // Direct summation of the spatial structure factor
+      //------------------------------------------------------------------------------
+      // S(k) = sum_j s_j exp(-i k.r_j) is evaluated for blocks of atoms held in
+      // short local arrays so that the inner loops vectorise. Without tabulated
+      // prefactors the phase for successive k-points along the path is obtained
+      // by complex multiplication with a per-atom step rotation exp(-i dk.r_j),
+      // requiring trigonometric functions only at the start of each chunk of
+      // k-points. Chunks are independent and distributed over threads when
+      // compiled with OpenMP.
+      //------------------------------------------------------------------------------
+
+      namespace direct_kernel{
+
+         const int block_size = 64;   // number of atoms in each block
+         const int lanes = 8;         // number of independent partial sums
+         const int chunk_size = 16;   // number of k-points in each chunk
+         const int max_steps = 32;    // maximum number of distinct path steps
+
+         std::vector<int> spec_start;      // start of each spectrum in mask [nspec+1]
+         std::vector<double> rx;           // coordinates of masked atoms
+         std::vector<double> ry;
+         std::vector<double> rz;
+         std::vector<double> spin;         // spin components of masked atoms
+         std::vector<int> k_step;          // step rotation for each k-point (-1 for none)
+         std::vector<double> step_cos;     // step rotations [step][atom]
+         std::vector<double> step_sin;
+
+      }
+
+      namespace dk = spinwaves::internal::direct_kernel;
+
+      //---------------------------------------------------------------------------
+      // Function to sort masked atoms by spectrum and precompute path steps
+      //---------------------------------------------------------------------------
+      void initialise_direct_kernel(const std::vector<double>& rx, const std::vector<double>& ry, const std::vector<double>& rz){
+
+         const int num_masked = internal::atom_mask.size();
+
+         // sort mask by spectrum (stable to preserve atom order)
+         std::vector<int> order(num_masked);
+         for(int j = 0; j < num_masked; j++) order[j] = j;
+         std::stable_sort(order.begin(), order.end(), [](const int a, const int b){ return internal::spec_mask[a] < internal::spec_mask[b]; });
+
+         std::vector<int> sorted_atoms(num_masked);
+         std::vector<int> sorted_specs(num_masked);
+         for(int j = 0; j < num_masked; j++){
+            sorted_atoms[j] = internal::atom_mask[order[j]];
+            sorted_specs[j] = internal::spec_mask[order[j]];
+         }
+         internal::atom_mask.swap(sorted_atoms);
+         internal::spec_mask.swap(sorted_specs);
+
+         dk::spec_start.assign(internal::nspec + 1, 0);
+         for(int j = 0; j < num_masked; j++) dk::spec_start[internal::spec_mask[j] + 1]++;
+         for(int s = 0; s < internal::nspec; s++) dk::spec_start[s + 1] += dk::spec_start[s];
+
+         // pack coordinates of masked atoms
+         dk::rx.resize(num_masked);
+         dk::ry.resize(num_masked);
+         dk::rz.resize(num_masked);
+         dk::spin.resize(num_masked);
+         for(int j = 0; j < num_masked; j++){
+            const int atom = internal::atom_mask[j];
+            dk::rx[j] = rx[atom];
+            dk::ry[j] = ry[atom];
+            dk::rz[j] = rz[atom];
+         }
+
+         // tabulated prefactors need no step rotations
+         if(internal::prefactor) return;
+
+         //------------------------------------------------------------------------
+         // Identify distinct steps between successive k-points
+         //------------------------------------------------------------------------
+         const int nk = internal::kx.size();
+         dk::k_step.assign(nk, -1);
+         std::vector<double> steps;
+         for(int k = 1; k < nk; k++){
+            const double dkx = internal::kx[k] - internal::kx[k-1];
+            const double dky = internal::ky[k] - internal::ky[k-1];
+            const double dkz = internal::kz[k] - internal::kz[k-1];
+            const double tol = 1.0e-10 * (1.0 + std::abs(dkx) + std::abs(dky) + std::abs(dkz));
+            const int num_steps = steps.size() / 3;
+            for(int s = 0; s < num_steps; s++){
+               if(std::abs(steps[3*s] - dkx) < tol && std::abs(steps[3*s+1] - dky) < tol && std::abs(steps[3*s+2] - dkz) < tol){
+                  dk::k_step[k] = s;
+                  break;
+               }
+            }
+            if(dk::k_step[k] < 0 && num_steps < dk::max_steps){
+               steps.push_back(dkx);
+               steps.push_back(dky);
+               steps.push_back(dkz);
+               dk::k_step[k] = num_steps;
+            }
+         }
+
+         // calculate step rotations for each masked atom
+         const int num_steps = steps.size() / 3;
+         dk::step_cos.resize(num_steps * num_masked);
+         dk::step_sin.resize(num_steps * num_masked);
+         for(int s = 0; s < num_steps; s++){
+            for(int j = 0; j < num_masked; j++){
+               const double arg = -steps[3*s] * dk::rx[j] - steps[3*s+1] * dk::ry[j] - steps[3*s+2] * dk::rz[j];
+               dk::step_cos[s * num_masked + j] = cos(arg);
+               dk::step_sin[s * num_masked + j] = sin(arg);
+            }
+         }
+
+         zlog << zTs() << "Spinwave direct kernel using " << num_steps << " distinct k-point steps for phase recurrence." << std::endl;
+
+         return;
+
+      }
+
+      //---------------------------------------------------------------------------
+      // Function to sum a block of atoms into lane accumulators
+      //---------------------------------------------------------------------------
+      inline void accumulate_block(const double* s, const double* c, const double* sn, const int n, double& sum_real, double& sum_imag){
+
+         double acc_real[dk::lanes] = {0.0};
+         double acc_imag[dk::lanes] = {0.0};
+
+         const int nv = n - n % dk::lanes;
+         for(int b = 0; b < nv; b += dk::lanes){
+            for(int l = 0; l < dk::lanes; l++){
+               acc_real[l] += s[b+l] * c[b+l];
+               acc_imag[l] += s[b+l] * sn[b+l];
+            }
+         }
+         for(int b = nv; b < n; b++){
+            acc_real[0] += s[b] * c[b];
+            acc_imag[0] += s[b] * sn[b];
+         }
+
+         for(int l = 0; l < dk::lanes; l++){
+            sum_real += acc_real[l];
+            sum_imag += acc_imag[l];
+         }
+
+         return;
+
+      }
+
+      //---------------------------------------------------------------------------
+      // Function to calculate spatial structure factor for all k-points
+      //
+      // Results are written to sk_real/sk_imag[k*nspec+spec]
+      //---------------------------------------------------------------------------
+      void direct_structure_factor(double* sk_real, double* sk_imag){
+
+         const int nk = internal::nk;
+         const int nspec = internal::nspec;
+         const int num_masked = internal::atom_mask.size();
+
+         // gather spin components of masked atoms
+         for(int j = 0; j < num_masked; j++){
+            dk::spin[j] = (*internal::sw_array[internal::spec_mask[j]])[internal::atom_mask[j]];
+         }
+         const double* spin = dk::spin.data();
+
+         //------------------------------------------------------------------------
+         // Tabulated prefactors
+         //------------------------------------------------------------------------
+         if(internal::prefactor){
+
+            #ifdef _OPENMP
+            #pragma omp parallel for schedule(static)
+            #endif
+            for(int k = 0; k < nk; k++){
+               const double* c = &internal::cos_k[size_t(k) * num_masked];
+               const double* s = &internal::sin_k[size_t(k) * num_masked];
+               for(int spec = 0; spec < nspec; spec++){
+                  const int start = dk::spec_start[spec];
+                  double sum_real = 0.0;
+                  double sum_imag = 0.0;
+                  accumulate_block(spin + start, c + start, s + start, dk::spec_start[spec+1] - start, sum_real, sum_imag);
+                  sk_real[k * nspec + spec] = sum_real;
+                  sk_imag[k * nspec + spec] = sum_imag;
+               }
+            }
+
+            return;
+
+         }
+
+         //------------------------------------------------------------------------
+         // Rotation recurrence along chunks of k-points
+         //------------------------------------------------------------------------
+         for(int i = 0; i < nk * nspec; i++){
+            sk_real[i] = 0.0;
+            sk_imag[i] = 0.0;
+         }
+
+         const int num_chunks = (nk + dk::chunk_size - 1) / dk::chunk_size;
+
+         #ifdef _OPENMP
+         #pragma omp parallel for schedule(dynamic)
+         #endif
+         for(int chunk = 0; chunk < num_chunks; chunk++){
+
+            const int k_first = chunk * dk::chunk_size;
+            const int k_last = std::min(nk, k_first + dk::chunk_size);
+
+            double c[dk::block_size];
+            double s[dk::block_size];
+
+            for(int spec = 0; spec < nspec; spec++){
+               for(int start = dk::spec_start[spec]; start < dk::spec_start[spec+1]; start += dk::block_size){
+
+                  const int n = std::min(dk::block_size, dk::spec_start[spec+1] - start);
+
+                  for(int k = k_first; k < k_last; k++){
+
+                     const int step = dk::k_step[k];
+
+                     if(k == k_first || step < 0){
+                        // evaluate phases directly
+                        const double kx = internal::kx[k];
+                        const double ky = internal::ky[k];
+                        const double kz = internal::kz[k];
+                        for(int b = 0; b < n; b++){
+                           const double arg = -kx * dk::rx[start+b] - ky * dk::ry[start+b] - kz * dk::rz[start+b];
+                           c[b] = cos(arg);
+                           s[b] = sin(arg);
+                        }
+                     }
+                     else{
+                        // rotate phases by step from previous k-point
+                        const double* rc = &dk::step_cos[size_t(step) * num_masked + start];
+                        const double* rs = &dk::step_sin[size_t(step) * num_masked + start];
+                        for(int b = 0; b < n; b++){
+                           const double cb = c[b];
+                           c[b] = cb * rc[b] - s[b] * rs[b];
+                           s[b] = cb * rs[b] + s[b] * rc[b];
+                        }
+                     }
+
+                     accumulate_block(spin + start, c, s, n, sk_real[k * nspec + spec], sk_imag[k * nspec + spec]);
+
+                  }
+               }
+            }
+         }
+
+         return;
+
+      }
+
+   } // end of internal namespace
+
+} // end of sw namespace
@@ -29,13 +29,6 @@
 
 namespace spinwaves {
 
-   // Local variables
-   double sx;
-   int atom;
-   int spec;
-   int index;
-   int reduc_index;
-
    //----------------------------------------------------------------------------
    // Function to initialize sw module
    //----------------------------------------------------------------------------
@@ -44,69 +37,32 @@ namespace spinwaves {
                    const std::vector<double>& rz,
                    const int time ){
 
-      for(int k=0;k<internal::nk;k++){
-
-         #ifdef MPICF
-
-            //reset values
-            for (int spec = 0; spec < internal::nspec; spec++){
-               skx_r[k*internal::nspec+spec] = 0.0;
-               skx_i[k*internal::nspec+spec] = 0.0;
-            }
+      // streaming calculation uses grid FFT and accumulates spectra on the fly
+      if(internal::streaming){
+         internal::update_streaming();
+         return;
+      }
 
-            // loop over atoms on each rank
-            for(unsigned int j=0;j<internal::atom_mask.size();j++){
-
-               // get atom, spectrum and spin component to fourier transform
-               atom=internal::atom_mask[j];
-               spec=internal::spec_mask[j];
-               sx = (*internal::sw_array[spec])[atom];
-               index = k*internal::nspec+spec;
-
-               // calculate spacial fourier transorm
-               if (internal::prefactor == true){
-                  skx_r[index] += sx*internal::cos_k[k*(internal::atom_mask.size())+j];
-                  skx_i[index] += sx*internal::sin_k[k*(internal::atom_mask.size())+j];
-               }
-               else if (internal::prefactor == false){
-                  skx_r[index] += sx*cos(rx[atom]*internal::kx[k] + ry[atom]*internal::kx[k] + rz[atom]*internal::kx[k]);
-                  skx_i[index] += sx*sin(rx[atom]*internal::kx[k] + ry[atom]*internal::ky[k] + rz[atom]*internal::ky[k]);
-               }
-            }
+      #ifdef MPICF
 
+         // calculate local contribution to structure factor for all k-points
+         internal::direct_structure_factor(&skx_r[0], &skx_i[0]);
 
-            // reduce kpoint to rank for fft in time.
-            if (internal::reduc_ver == "direct-scatter"){
-               reduc_index=(k % nk_per_rank)*internal::nt*internal::nspec+time*internal::nspec;
+         // reduce kpoint to rank for fft in time.
+         if (internal::reduc_ver == "direct-scatter"){
+            for(int k=0;k<internal::nk;k++){
+               const int reduc_index=(k % nk_per_rank)*internal::nt*internal::nspec+time*internal::nspec;
                MPI_Reduce(&skx_r[k*internal::nspec], &skx_r_scatter[reduc_index], internal::nspec, MPI_DOUBLE, MPI_SUM, k / nk_per_rank, MPI_COMM_WORLD);
                MPI_Reduce(&skx_i[k*internal::nspec], &skx_i_scatter[reduc_index], internal::nspec, MPI_DOUBLE, MPI_SUM, k / nk_per_rank, MPI_COMM_WORLD);
             }
+         }
 
-         #else
-
-            for(unsigned int j=0;j<internal::atom_mask.size();j++){
-
-               // get atom, spectrum and spin component to fourier transform
-               atom=internal::atom_mask[j];
-               spec=internal::spec_mask[j];
-               sx = (*internal::sw_array[spec])[atom];
-
-               index = time*internal::nk*internal::nspec+k*internal::nspec+spec;
+      #else
 
-               // calculate spacial fourier transorm
-               if (internal::prefactor == true){
-                  spinwaves::skx_r_node[index] += sx*internal::cos_k[k*(internal::atom_mask.size())+j];
-                  spinwaves::skx_i_node[index] += sx*internal::sin_k[k*(internal::atom_mask.size())+j];
-               }
-               else if (internal::prefactor == false){
-                  skx_r_node[index] += sx*cos(rx[atom]*internal::kx[k] + ry[atom]*internal::kx[k] + rz[atom]*internal::kx[k]);
-                  skx_i_node[index] += sx*sin(rx[atom]*internal::kx[k] + ry[atom]*internal::ky[k] + rz[atom]*internal::ky[k]);
-               }
-            }
+         // calculate structure factor directly into time series
+         internal::direct_structure_factor(&skx_r_node[time*internal::nk*internal::nspec], &skx_i_node[time*internal::nk*internal::nspec]);
 
-         #endif
-
-      }
+      #endif
 
       // reduce every kpoint to rank 0.
       #ifdef MPICF
@@ -41,6 +41,12 @@ namespace spinwaves {
 
    void fft_in_time(){
 
+      // power spectra are accumulated during streaming calculation
+      if(internal::streaming){
+         internal::finalise_streaming();
+         return;
+      }
+
       #ifdef FFT
 
       // Start time for time series fourier transform
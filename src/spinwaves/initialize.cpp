@@ -85,11 +85,20 @@ namespace spinwaves{
 		if (internal::filetype == "specific-k") spinwaves::internal::determine_kpoints_from_user_specific_k(system_dimensions_x, system_dimensions_y, system_dimensions_z, unit_cell_size_x, unit_cell_size_y, unit_cell_size_z);
 		if (internal::filetype == "path") spinwaves::internal::determine_kpoints_from_user_high_sym_path(system_dimensions_x, system_dimensions_y, system_dimensions_z, unit_cell_size_x, unit_cell_size_y, unit_cell_size_z);
 
-		// initialise arrays based on kpoints calculated above
-		spinwaves::internal::initialise_arrays();
-
-		// determine prefactor that will be used in fourier transform. sin(k_x*r_x) etc.
-		spinwaves::internal::calculate_fourier_prefactor(atom_coords_x, atom_coords_y, atom_coords_z);
+		if(internal::streaming){
+			// use grid FFT and segment averaged spectra with memory independent of run length
+			spinwaves::internal::initialise_streaming();
+		}
+		else{
+			// initialise arrays based on kpoints calculated above
+			spinwaves::internal::initialise_arrays();
+
+			// sort atoms by spectrum and determine phase steps along k-path
+			spinwaves::internal::initialise_direct_kernel(atom_coords_x, atom_coords_y, atom_coords_z);
+
+			// determine prefactor that will be used in fourier transform. sin(k_x*r_x) etc.
+			spinwaves::internal::calculate_fourier_prefactor(atom_coords_x, atom_coords_y, atom_coords_z);
+		}
 
 		// determine which component of spin to calculate spinwave dispersion from
 		spinwaves::internal::determine_spin_component();
@@ -141,6 +141,30 @@ namespace spinwaves{
                return false;
             }
          }
+         test="streaming";
+         if(word==test){
+            if (value == "false"){
+               internal::streaming = false;
+               return true;
+            }
+            else if (value == "true"){
+               internal::streaming = true;
+               return true;
+            }
+            else {
+               terminaltextcolor(RED);
+               std::cerr << "Error - Unknown value in control statement \'spinwaves:" << word << " = " << value << "\' on line " << line << " of input file" << std::endl;
+               terminaltextcolor(WHITE);
+               return false;
+            }
+         }
+         test="segment-length";
+         if(word==test){
+            uint64_t tt = vin::str_to_uint64(value); // convert string to uint64_t
+            vin::check_for_valid_int(tt, word, line, prefix, 2, 1000000,"input","2 - 1,000,000");
+            internal::segment_length = tt;
+            return true;
+         }
          test="intermediate-structure-factor";
          if(word==test){
             if (value == "false"){
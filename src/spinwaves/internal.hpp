@@ -24,6 +24,7 @@
 
 // Vampire headers
 #include "spinwaves.hpp"
+#include "unitcell.hpp"
 
 // sw module headers
 #include "internal.hpp"
@@ -104,6 +105,10 @@ namespace spinwaves{
       extern int nspec;
       extern std::vector<int> super_index_values;
 
+      // streaming structure factor variables
+      extern bool streaming;       // use grid FFT and segment averaged power spectra
+      extern int segment_length;   // number of samples per time segment
+
 
       //-------------------------------------------------------------------------
       // Internal function declarations
@@ -126,6 +131,15 @@ namespace spinwaves{
       extern void determine_kpoints_from_user_specific_k(const double dimx, const double dimy, const double dimz,	const double uc_x, const double uc_y, const double uc_z);
       extern void determine_kpoints_from_user_high_sym_path(const double dimx, const double dimy, const double dimz,	const double uc_x, const double uc_y, const double uc_z);
 
+      // direct structure factor functions
+      extern void initialise_direct_kernel(const std::vector<double>& rx, const std::vector<double>& ry, const std::vector<double>& rz);
+      extern void direct_structure_factor(double* sk_real, double* sk_imag);
+
+      // streaming structure factor functions
+      extern void initialise_streaming();
+      extern void update_streaming();
+      extern void finalise_streaming();
+
 
       // post analysis functions
       #ifdef FFT
@@ -0,0 +1,429 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+// Vampire headers
+#include "atoms.hpp"
+#include "create.hpp"
+#include "errors.hpp"
+#include "sim.hpp"
+#include "spinwaves.hpp"
+#include "unitcell.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+// sw module headers
+#include "internal.hpp"
+
+namespace spinwaves{
+
+   namespace internal{
+
+      //------------------------------------------------------------------------------
+      // Streaming calculation of the dynamic structure factor
+      //------------------------------------------------------------------------------
+      // The spin field of each spectrum is placed on a regular grid commensurate
+      // with the unit cell, so that S(k) = sum_j s_j exp(-i k.r_j) for all k-points
+      // of the supercell is obtained from a single real 3D FFT per sample. The
+      // values on the k-path are stored in a ring buffer of one segment length.
+      // Every half segment the buffer is Hann windowed and Fourier transformed in
+      // time and the power spectrum accumulated (Welch's method), so memory is
+      // independent of the length of the simulation.
+      //------------------------------------------------------------------------------
+
+      namespace streaming_data{
+
+         int grid[3];                          // number of grid points in x,y,z
+         int num_entries = 0;                  // number of masked atoms on all processors (root only)
+         std::vector<int> spec_start;          // start of each spectrum in entry list [nspec+1] (root only)
+         std::vector<int> entry_index;         // grid index of each entry sorted by spectrum (root only)
+         std::vector<int> entry_order;         // position of sorted entry in gathered data (root only)
+         std::vector<int> k_index;             // index of each k-point in r2c output
+         std::vector<bool> k_conjugate;        // k-point obtained from conjugate symmetric point
+
+         std::vector<double> local_values;     // local spin components of masked atoms
+         std::vector<double> all_values;       // spin components of all masked atoms (root only)
+         std::vector<int> counts;              // number of masked atoms on each processor
+         std::vector<int> displacements;       // offsets of masked atoms from each processor
+
+         std::vector<double> ring_real;        // time series ring buffer [k][spec][segment]
+         std::vector<double> ring_imag;
+         std::vector<double> power;            // accumulated power spectrum [k][spec][segment]
+         std::vector<double> window;           // Hann window
+         int num_samples = 0;                  // number of samples added to ring buffer
+         int num_segments = 0;                 // number of segments accumulated
+
+         #ifdef FFT
+            double* spin_grid;
+            fftw_complex* sk_grid;
+            fftw_complex* segment;
+            fftw_plan plan_space;
+            fftw_plan plan_time;
+         #endif
+
+      }
+
+      namespace sd = spinwaves::internal::streaming_data;
+
+      //---------------------------------------------------------------------------
+      // Function to find smallest subdivision of unit cell placing all atoms on grid
+      //---------------------------------------------------------------------------
+      int grid_subdivision(const std::vector<unitcell::atom_t>& atom, const int d){
+         for(int n = 1; n <= 24; n++){
+            bool commensurate = true;
+            for(unsigned int i = 0; i < atom.size(); i++){
+               const double f = d == 0 ? atom[i].x : (d == 1 ? atom[i].y : atom[i].z);
+               if(std::abs(f * n - round(f * n)) > 1.0e-6) commensurate = false;
+            }
+            if(commensurate) return n;
+         }
+         terminaltextcolor(RED);
+         std::cerr << "Error: atomic positions in unit cell are not commensurate with a regular grid, required for spinwaves:streaming. Exiting." << std::endl;
+         terminaltextcolor(WHITE);
+         zlog << zTs() << "Error: atomic positions in unit cell are not commensurate with a regular grid, required for spinwaves:streaming. Exiting." << std::endl;
+         err::vexit();
+         return 0;
+      }
+
+      //---------------------------------------------------------------------------
+      // Function to initialise streaming structure factor calculation
+      //---------------------------------------------------------------------------
+      void initialise_streaming(){
+
+         #ifdef FFT
+
+         // time series of the intermediate structure factor and the complex
+         // spectrum are not retained when averaging power spectra over segments
+         if(internal::isf){
+            terminaltextcolor(RED);
+            std::cerr << "Error: spinwaves:intermediate-structure-factor is not supported with spinwaves:streaming. Exiting." << std::endl;
+            terminaltextcolor(WHITE);
+            zlog << zTs() << "Error: spinwaves:intermediate-structure-factor is not supported with spinwaves:streaming. Exiting." << std::endl;
+            err::vexit();
+         }
+         for(int spec = 0; spec < internal::nspec; spec++){
+            if(!internal::cm[spec]){
+               terminaltextcolor(RED);
+               std::cerr << "Error: spinwaves[" << spec+1 << "]:complex-magnitude = false is not supported with spinwaves:streaming, which outputs power spectra. Exiting." << std::endl;
+               terminaltextcolor(WHITE);
+               zlog << zTs() << "Error: spinwaves[" << spec+1 << "]:complex-magnitude = false is not supported with spinwaves:streaming, which outputs power spectra. Exiting." << std::endl;
+               err::vexit();
+            }
+         }
+
+         const std::vector<unitcell::atom_t>& atom = cs::unit_cell.atom;
+         const std::vector<double>& rx = atoms::x_coord_array;
+         const std::vector<double>& ry = atoms::y_coord_array;
+         const std::vector<double>& rz = atoms::z_coord_array;
+
+         // define number of time and kpoints
+         internal::nk = internal::kx.size();
+         internal::nt = (sim::total_time / sim::partial_time);
+
+         // segment length must be even and no longer than the run
+         if(internal::segment_length > internal::nt) internal::segment_length = internal::nt;
+         internal::segment_length -= internal::segment_length % 2;
+         if(internal::segment_length < 2){
+            terminaltextcolor(RED);
+            std::cerr << "Error: spinwave simulation contains fewer than two samples. Exiting." << std::endl;
+            terminaltextcolor(WHITE);
+            zlog << zTs() << "Error: spinwave simulation contains fewer than two samples. Exiting." << std::endl;
+            err::vexit();
+         }
+         const int ns = internal::segment_length;
+
+         //------------------------------------------------------------------------
+         // Determine grid commensurate with unit cell
+         //------------------------------------------------------------------------
+         const double ncells[3] = {double(cs::total_num_unit_cells[0]), double(cs::total_num_unit_cells[1]), double(cs::total_num_unit_cells[2])};
+         const double ucsize[3] = {cs::unit_cell.dimensions[0], cs::unit_cell.dimensions[1], cs::unit_cell.dimensions[2]};
+         double h[3];
+         for(int d = 0; d < 3; d++){
+            const int sub = grid_subdivision(atom, d);
+            sd::grid[d] = int(round(ncells[d])) * sub;
+            h[d] = ucsize[d] / double(sub);
+         }
+         const int Nx = sd::grid[0];
+         const int Ny = sd::grid[1];
+         const int Nz = sd::grid[2];
+         const int Nzh = Nz / 2 + 1;
+
+         //------------------------------------------------------------------------
+         // Determine location of k-points in r2c output
+         //------------------------------------------------------------------------
+         sd::k_index.resize(internal::nk);
+         sd::k_conjugate.resize(internal::nk);
+         int num_incommensurate = 0;
+         for(int k = 0; k < internal::nk; k++){
+            const double kv[3] = {internal::kx[k], internal::ky[k], internal::kz[k]};
+            int m[3];
+            for(int d = 0; d < 3; d++){
+               const double u = kv[d] * double(sd::grid[d]) * h[d] / (2.0 * M_PI);
+               if(std::abs(u - round(u)) > 1.0e-3) num_incommensurate++;
+               m[d] = ((int(round(u)) % sd::grid[d]) + sd::grid[d]) % sd::grid[d];
+            }
+            // only half of the z frequencies are stored for real input
+            sd::k_conjugate[k] = m[2] >= Nzh;
+            if(sd::k_conjugate[k]){
+               m[0] = (Nx - m[0]) % Nx;
+               m[1] = (Ny - m[1]) % Ny;
+               m[2] = (Nz - m[2]) % Nz;
+            }
+            sd::k_index[k] = (m[0] * Ny + m[1]) * Nzh + m[2];
+         }
+         if(num_incommensurate > 0){
+            terminaltextcolor(YELLOW);
+            std::cout << "Warning: " << num_incommensurate << " spinwave k-vector components are not commensurate with the system size and have been rounded to the nearest allowed value." << std::endl;
+            terminaltextcolor(WHITE);
+            zlog << zTs() << "Warning: " << num_incommensurate << " spinwave k-vector components are not commensurate with the system size and have been rounded to the nearest allowed value." << std::endl;
+         }
+
+         //------------------------------------------------------------------------
+         // Determine grid index of local masked atoms and collect on root
+         //------------------------------------------------------------------------
+         const int num_local = internal::atom_mask.size();
+         std::vector<int> local_index(num_local);
+         for(int j = 0; j < num_local; j++){
+            const int i = internal::atom_mask[j];
+            const int ix = ((int(round(rx[i] / h[0])) % Nx) + Nx) % Nx;
+            const int iy = ((int(round(ry[i] / h[1])) % Ny) + Ny) % Ny;
+            const int iz = ((int(round(rz[i] / h[2])) % Nz) + Nz) % Nz;
+            local_index[j] = (ix * Ny + iy) * Nz + iz;
+         }
+         sd::local_values.resize(num_local);
+
+         std::vector<int> all_index;
+         std::vector<int> all_spec;
+
+         #ifdef MPICF
+            sd::counts.resize(vmpi::num_processors, 0);
+            sd::displacements.resize(vmpi::num_processors, 0);
+            MPI_Gather(&num_local, 1, MPI_INT, &sd::counts[0], 1, MPI_INT, 0, MPI_COMM_WORLD);
+            for(int p = 1; p < vmpi::num_processors; p++) sd::displacements[p] = sd::displacements[p-1] + sd::counts[p-1];
+            sd::num_entries = sd::displacements[vmpi::num_processors-1] + sd::counts[vmpi::num_processors-1];
+            all_index.resize(std::max(1, sd::num_entries));
+            all_spec.resize(std::max(1, sd::num_entries));
+            // pad local arrays to ensure valid pointers on processors without masked atoms
+            std::vector<int> local_spec(internal::spec_mask);
+            local_index.push_back(0);
+            local_spec.push_back(0);
+            sd::local_values.push_back(0.0);
+            MPI_Gatherv(&local_index[0], num_local, MPI_INT, &all_index[0], &sd::counts[0], &sd::displacements[0], MPI_INT, 0, MPI_COMM_WORLD);
+            MPI_Gatherv(&local_spec[0], num_local, MPI_INT, &all_spec[0], &sd::counts[0], &sd::displacements[0], MPI_INT, 0, MPI_COMM_WORLD);
+         #else
+            sd::num_entries = num_local;
+            all_index = local_index;
+            all_spec = internal::spec_mask;
+         #endif
+
+         //------------------------------------------------------------------------
+         // On root sort entries by spectrum and allocate grids and spectra
+         //------------------------------------------------------------------------
+         if(vmpi::my_rank == 0){
+
+            sd::all_values.resize(std::max(1, sd::num_entries));
+
+            sd::spec_start.assign(internal::nspec + 1, 0);
+            for(int e = 0; e < sd::num_entries; e++) sd::spec_start[all_spec[e] + 1]++;
+            for(int s = 0; s < internal::nspec; s++) sd::spec_start[s + 1] += sd::spec_start[s];
+            std::vector<int> next(sd::spec_start.begin(), sd::spec_start.end() - 1);
+            sd::entry_index.resize(sd::num_entries);
+            sd::entry_order.resize(sd::num_entries);
+            for(int e = 0; e < sd::num_entries; e++){
+               const int pos = next[all_spec[e]]++;
+               sd::entry_index[pos] = all_index[e];
+               sd::entry_order[pos] = e;
+            }
+
+            const int ring = internal::nk * internal::nspec * ns;
+            sd::ring_real.assign(ring, 0.0);
+            sd::ring_imag.assign(ring, 0.0);
+            sd::power.assign(ring, 0.0);
+
+            // periodic Hann window
+            sd::window.resize(ns);
+            for(int t = 0; t < ns; t++) sd::window[t] = 0.5 * (1.0 - cos(2.0 * M_PI * double(t) / double(ns)));
+
+            sd::spin_grid = (double*) fftw_malloc(sizeof(double) * Nx * Ny * Nz);
+            sd::sk_grid   = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * Nx * Ny * Nzh);
+            sd::segment   = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * ns);
+            sd::plan_space = fftw_plan_dft_r2c_3d(Nx, Ny, Nz, sd::spin_grid, sd::sk_grid, FFTW_MEASURE);
+            sd::plan_time  = fftw_plan_dft_1d(ns, sd::segment, sd::segment, FFTW_FORWARD, FFTW_MEASURE);
+
+            // calculate memory requirements
+            const double mem = (double(Nx) * double(Ny) * (double(Nz) + 2.0 * double(Nzh)) * sizeof(double) +
+                                3.0 * double(ring) * sizeof(double) + double(sd::num_entries) * 3.0 * sizeof(int)) / 1.0e6;
+            std::cout << "Spinwave module using " << mem << " MB of RAM for streaming structure factor with grid of " << Nx << " x " << Ny << " x " << Nz
+                      << " points and segment length " << ns << std::endl;
+            zlog << zTs() << "Spinwave module using " << mem << " MB of RAM for streaming structure factor with grid of " << Nx << " x " << Ny << " x " << Nz
+                          << " points and segment length " << ns << std::endl;
+
+         }
+
+         sd::num_samples = 0;
+         sd::num_segments = 0;
+
+         #endif
+
+         return;
+
+      }
+
+      //---------------------------------------------------------------------------
+      // Function to add a sample of the structure factor to the ring buffer and
+      // accumulate the power spectrum of completed segments
+      //---------------------------------------------------------------------------
+      void update_streaming(){
+
+         #ifdef FFT
+
+         // collect spin components of masked atoms on root
+         const int num_local = internal::atom_mask.size();
+         for(int j = 0; j < num_local; j++){
+            sd::local_values[j] = (*internal::sw_array[internal::spec_mask[j]])[internal::atom_mask[j]];
+         }
+         #ifdef MPICF
+            MPI_Gatherv(sd::local_values.data(), num_local, MPI_DOUBLE, sd::all_values.data(), &sd::counts[0], &sd::displacements[0], MPI_DOUBLE, 0, MPI_COMM_WORLD);
+         #else
+            sd::all_values.swap(sd::local_values);
+         #endif
+
+         if(vmpi::my_rank == 0){
+
+            const int ns = internal::segment_length;
+            const int grid_points = sd::grid[0] * sd::grid[1] * sd::grid[2];
+            const int slot = sd::num_samples % ns;
+
+            for(int spec = 0; spec < internal::nspec; spec++){
+
+               // place spins on grid and transform
+               for(int i = 0; i < grid_points; i++) sd::spin_grid[i] = 0.0;
+               for(int e = sd::spec_start[spec]; e < sd::spec_start[spec + 1]; e++){
+                  sd::spin_grid[sd::entry_index[e]] += sd::all_values[sd::entry_order[e]];
+               }
+               fftw_execute(sd::plan_space);
+
+               // store k-path values in ring buffer
+               for(int k = 0; k < internal::nk; k++){
+                  const int id = (k * internal::nspec + spec) * ns + slot;
+                  const fftw_complex& sk = sd::sk_grid[sd::k_index[k]];
+                  sd::ring_real[id] = sk[0];
+                  sd::ring_imag[id] = sd::k_conjugate[k] ? -sk[1] : sk[1];
+               }
+
+            }
+
+            sd::num_samples++;
+
+            // accumulate windowed power spectrum every half segment
+            if(sd::num_samples >= ns && (sd::num_samples - ns) % (ns / 2) == 0){
+               const int oldest = sd::num_samples % ns;
+               for(int ks = 0; ks < internal::nk * internal::nspec; ks++){
+                  for(int t = 0; t < ns; t++){
+                     const int id = ks * ns + (oldest + t) % ns;
+                     sd::segment[t][0] = sd::window[t] * sd::ring_real[id];
+                     sd::segment[t][1] = sd::window[t] * sd::ring_imag[id];
+                  }
+                  fftw_execute(sd::plan_time);
+                  for(int f = 0; f < ns; f++){
+                     sd::power[ks * ns + f] += sd::segment[f][0] * sd::segment[f][0] + sd::segment[f][1] * sd::segment[f][1];
+                  }
+               }
+               sd::num_segments++;
+            }
+
+         }
+
+         #ifndef MPICF
+            sd::all_values.swap(sd::local_values);
+         #endif
+
+         #endif
+
+         return;
+
+      }
+
+      //---------------------------------------------------------------------------
+      // Function to normalise and output averaged power spectra
+      //---------------------------------------------------------------------------
+      void finalise_streaming(){
+
+         #ifdef FFT
+
+         if(vmpi::my_rank == 0){
+
+            const int ns = internal::segment_length;
+
+            std::cout     << "Spinwave power spectra averaged over " << sd::num_segments << " segments." << std::endl;
+            zlog << zTs() << "Spinwave power spectra averaged over " << sd::num_segments << " segments." << std::endl;
+
+            // normalise by number of segments and window power
+            double window_power = 0.0;
+            for(int t = 0; t < ns; t++) window_power += sd::window[t] * sd::window[t];
+            const double norm = sd::num_segments > 0 ? 1.0 / (double(sd::num_segments) * window_power) : 0.0;
+
+            std::vector<double> spectrum(ns);
+
+            for(int k = 0; k < internal::nk; k++){
+               for(int spec = 0; spec < internal::nspec; spec++){
+
+                  const double* p = &sd::power[(k * internal::nspec + spec) * ns];
+                  int len = ns;
+
+                  if(internal::oss[spec]){
+                     // fold negative frequencies onto positive frequencies
+                     len = ns / 2;
+                     spectrum[0] = p[0] * norm;
+                     for(int f = 1; f < len; f++) spectrum[f] = (p[f] + p[ns - f]) * norm;
+                  }
+                  else{
+                     for(int f = 0; f < ns; f++) spectrum[f] = p[f] * norm;
+                  }
+
+                  if(internal::normk[spec]){
+                     double largest = 0.0;
+                     for(int f = 0; f < len; f++) largest = std::max(largest, spectrum[f]);
+                     if(largest > 0.0) for(int f = 0; f < len; f++) spectrum[f] /= largest;
+                  }
+
+                  std::stringstream sstr;
+                  sstr << "sw_spec_" << std::setw(2) << std::setfill('0') << spec+1 << "_real_" << std::setw(4) << std::setfill('0') << std::to_string(k) << ".dat";
+                  std::ofstream ofile(sstr.str().c_str());
+                  for(int f = 0; f < len; f++) ofile << spectrum[f] << "\n";
+                  ofile.close();
+
+               }
+            }
+
+            fftw_destroy_plan(sd::plan_space);
+            fftw_destroy_plan(sd::plan_time);
+            fftw_free(sd::spin_grid);
+            fftw_free(sd::sk_grid);
+            fftw_free(sd::segment);
+
+         }
+
+         #endif
+
+         return;
+
+      }
+
+   } // end of internal namespace
+
+} // end of sw namespace
@@ -38,22 +38,25 @@ namespace spinwaves {
 
         void save_frequencies(){
 
+            // streaming spectra have the resolution of a single segment
+            const int num_freq = internal::streaming ? internal::segment_length : internal::nt;
+
             #ifdef MPICF
                 if (vmpi::my_rank==0) {
 
                     // open files
                     std::ofstream freq_file;
                     freq_file.open("frequencies.dat");
-                    for (int i=0; i < internal::nt; i++){
-                        freq_file << i/(sim::partial_time*mp::dt/1.76e11)/internal::nt << "\n";
+                    for (int i=0; i < num_freq; i++){
+                        freq_file << i/(sim::partial_time*mp::dt/1.76e11)/num_freq << "\n";
                     }
                     freq_file.close();
                 }
             #else
                 std::ofstream freq_file;
                 freq_file.open("frequencies.dat");
-                for (int i=0; i < internal::nt; i++){
-                    freq_file << i/(sim::partial_time*mp::dt/1.76e11)/internal::nt << "\n";
+                for (int i=0; i < num_freq; i++){
+                    freq_file << i/(sim::partial_time*mp::dt/1.76e11)/num_freq << "\n";
                 }
                 freq_file.close();
             #endif
@@ -61,6 +61,10 @@ namespace stats{
    bool calculate_system_binder_cumulant        = false;
    bool calculate_material_binder_cumulant      = false;
 
+   bool calculate_system_histogram              = false;
+   int histogram_energy_bins                    = 1000; // number of energy bins for histograms
+   int histogram_magnetization_bins             = 100;  // number of magnetization bins for histograms
+
    energy_statistic_t system_energy("s");
    energy_statistic_t grain_energy("g");
    energy_statistic_t material_energy("m");
@@ -106,6 +110,8 @@ namespace stats{
    binder_cumulant_statistic_t system_binder_cumulant("bc");
    binder_cumulant_statistic_t material_binder_cumulant("mbc");
 
+   histogram_statistic_t system_histogram("s");
+
    //-----------------------------------------------------------------------------
    // Shared variables used for statistics calculation
    //-----------------------------------------------------------------------------
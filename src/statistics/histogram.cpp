@@ -0,0 +1,162 @@
+//-----------------------------------------------------------------------------
+//
+// This source file is part of the VAMPIRE open source package under the
+// GNU GPL (version 2) licence (see licence file for details).
+//
+// (c) agent 2026. All rights reserved.
+//
+//-----------------------------------------------------------------------------
+
+// C++ standard library headers
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+
+// Vampire headers
+#include "constants.hpp"
+#include "errors.hpp"
+#include "stats.hpp"
+#include "vmpi.hpp"
+#include "vio.hpp"
+
+namespace {
+
+   // stream file for histograms, opened on first write
+   std::ofstream histogram_file;
+
+}
+
+namespace stats{
+
+//------------------------------------------------------------------------------------------------------
+// Function to initialize data structures
+//------------------------------------------------------------------------------------------------------
+void histogram_statistic_t::initialize(stats::energy_statistic_t& energy_stat, stats::magnetization_statistic_t& mag_stat){
+
+   // Check that energy and magnetization statistics are properly initialized
+   if(!energy_stat.is_initialized() || !mag_stat.is_initialized()){
+      terminaltextcolor(RED);
+      std::cerr << "Programmer Error - Uninitialized energy or magnetization statistic passed to histogram statistic - please initialize first." << std::endl;
+      terminaltextcolor(WHITE);
+      zlog << zTs() << "Programmer Error - Uninitialized energy or magnetization statistic passed to histogram statistic - please initialize first." << std::endl;
+      err::vexit();
+   }
+
+   // histograms are collected for the magnetic atoms of the whole system (first mask element)
+   normalisation = energy_stat.normalisation[0];
+   saturation = mag_stat.saturation[0];
+
+   temperature = 0.0;
+   field = 0.0;
+
+   // Set flag indicating correct initialization
+   initialized=true;
+
+}
+
+//------------------------------------------------------------------------------------------------------
+// Function to add a sample of the total energy (mu_B T) and reduced magnetization length to the
+// current block. A change of temperature or applied field completes the current block.
+//------------------------------------------------------------------------------------------------------
+void histogram_statistic_t::calculate(const std::vector<double>& energy, const std::vector<double>& magnetization, const double in_temperature, const double in_field){
+
+   if(!energy_samples.empty() && (in_temperature != temperature || in_field != field)) write_histogram();
+
+   temperature = in_temperature;
+   field = in_field;
+
+   energy_samples.push_back(energy[0] * constants::muB);
+   magnetization_samples.push_back(magnetization[3]);
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------------------------------
+// Function to bin the current block of samples and append it to the histogram stream file. Each
+// block consists of a header line
+//
+//    histogram T H num_spins saturation num_samples E_min dE num_E_bins m_min dm num_m_bins num_bins
+//
+// followed by num_bins lines "energy_bin magnetization_bin count" for all non-empty bins, where
+// the energy E (J) of bin i lies in [E_min + i dE, E_min + (i+1) dE).
+//------------------------------------------------------------------------------------------------------
+void histogram_statistic_t::write_histogram(){
+
+   if(!initialized || energy_samples.empty()) return;
+
+   if(vmpi::my_rank == 0){
+
+      const int num_energy_bins = stats::histogram_energy_bins;
+      const int num_magnetization_bins = stats::histogram_magnetization_bins;
+
+      // determine range of samples
+      const double min_energy = *std::min_element(energy_samples.begin(), energy_samples.end());
+      const double max_energy = *std::max_element(energy_samples.begin(), energy_samples.end());
+      const double min_magnetization = *std::min_element(magnetization_samples.begin(), magnetization_samples.end());
+      const double max_magnetization = *std::max_element(magnetization_samples.begin(), magnetization_samples.end());
+
+      // set bin widths, avoiding zero width for constant samples
+      double energy_bin_width = (max_energy - min_energy) / double(num_energy_bins);
+      double magnetization_bin_width = (max_magnetization - min_magnetization) / double(num_magnetization_bins);
+      if(energy_bin_width <= 0.0) energy_bin_width = 1.0e-30;
+      if(magnetization_bin_width <= 0.0) magnetization_bin_width = 1.0e-30;
+
+      // accumulate counts of non-empty bins only, as the number of samples in a block is
+      // usually much smaller than the number of bins. The map is ordered by energy bin
+      // and then magnetization bin.
+      std::map<std::pair<int,int>, uint64_t> counts;
+      for(size_t i = 0; i < energy_samples.size(); i++){
+         const int eb = std::min(int((energy_samples[i] - min_energy) / energy_bin_width), num_energy_bins - 1);
+         const int mb = std::min(int((magnetization_samples[i] - min_magnetization) / magnetization_bin_width), num_magnetization_bins - 1);
+         counts[std::make_pair(eb, mb)]++;
+      }
+
+      const uint64_t num_bins = counts.size();
+
+      // open file on first write
+      if(!histogram_file.is_open()){
+         std::string filename = vout::output_file_name + "-histograms";
+         histogram_file.open(filename.c_str(), std::ofstream::trunc);
+         histogram_file << "# vampire energy-magnetisation histograms: for each block" << std::endl;
+         histogram_file << "# histogram T(K) H(T) num_spins saturation(muB) num_samples E_min(J) dE(J) num_E_bins m_min dm num_m_bins num_bins" << std::endl;
+         histogram_file << "# followed by num_bins lines of: energy_bin magnetisation_bin count" << std::endl;
+      }
+
+      histogram_file.precision(16);
+      histogram_file << "histogram " << temperature << " " << field << " " << normalisation << " " << saturation << " " << energy_samples.size() << " "
+                     << min_energy << " " << energy_bin_width << " " << num_energy_bins << " "
+                     << min_magnetization << " " << magnetization_bin_width << " " << num_magnetization_bins << " " << num_bins << "\n";
+
+      for(std::map<std::pair<int,int>, uint64_t>::const_iterator it = counts.begin(); it != counts.end(); ++it){
+         histogram_file << it->first.first << " " << it->first.second << " " << it->second << "\n";
+      }
+
+      histogram_file.flush();
+
+   }
+
+   energy_samples.clear();
+   magnetization_samples.clear();
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------------------------------
+// Function to discard the current block of samples without writing
+//------------------------------------------------------------------------------------------------------
+void histogram_statistic_t::reset_histogram(){
+
+   energy_samples.clear();
+   magnetization_samples.clear();
+
+   return;
+
+}
+
+} // end of namespace stats
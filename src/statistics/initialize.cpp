@@ -451,6 +451,11 @@ namespace stats{
       if(stats::calculate_system_binder_cumulant) stats::system_binder_cumulant.initialize(stats::system_magnetization);
       if(stats::calculate_material_binder_cumulant) stats::material_binder_cumulant.initialize(stats::material_magnetization);
 
+      //------------------------------------------------------------------------
+      // energy-magnetization histogram
+      //------------------------------------------------------------------------
+      if(stats::calculate_system_histogram) stats::system_histogram.initialize(stats::system_energy, stats::system_magnetization);
+
       return;
 
    }
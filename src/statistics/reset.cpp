@@ -13,6 +13,7 @@
 // C++ standard library headers
 
 // Vampire headers
+#include "ensemble.hpp"
 #include "gpu.hpp"
 #include "stats.hpp"
 
@@ -84,8 +85,14 @@ namespace stats{
          if(stats::calculate_system_binder_cumulant)   stats::system_binder_cumulant.reset_averages();
          if(stats::calculate_material_binder_cumulant) stats::material_binder_cumulant.reset_averages();
 
+         // complete current block of energy-magnetization histogram
+         if(stats::calculate_system_histogram) stats::system_histogram.write_histogram();
+
       }
 
+      // reset statistics of additional replicas in ensemble mode
+      if(ensemble::enabled) ensemble::reset_statistics();
+
       return;
 
    }
@@ -14,9 +14,11 @@
 
 // Vampire headers
 #include "atoms.hpp"
+#include "ensemble.hpp"
 #include "gpu.hpp"
 #include "sim.hpp"
 #include "stats.hpp"
+#include "vprofile.hpp"
 
 namespace stats{
 
@@ -103,6 +105,11 @@ namespace stats{
             if(stats::calculate_system_binder_cumulant)         stats::system_binder_cumulant.calculate(stats::system_magnetization.get_magnetization());
             if(stats::calculate_material_binder_cumulant)       stats::material_binder_cumulant.calculate(stats::material_magnetization.get_magnetization());
 
+            // update energy-magnetization histogram
+            if(stats::calculate_system_histogram)               stats::system_histogram.calculate(stats::system_energy.get_total_energy(),
+                                                                                                  stats::system_magnetization.get_magnetization(),
+                                                                                                  temperature, sim::H_applied);
+
          }
 
          return;
@@ -116,12 +123,18 @@ namespace stats{
    //------------------------------------------------------------------------------------------------------
    void update(){
 
+      // time spent in statistics for profiling
+      VPROFILE_SCOPE(vprofile::statistics);
+
       // call actual function, picking up arguments directly from namespace header files
       stats::internal::update(atoms::x_spin_array, 				  		atoms::y_spin_array, 				    atoms::z_spin_array,
    					            atoms::x_total_spin_field_array,     atoms::y_total_spin_field_array, 	 atoms::z_total_spin_field_array,
    					            atoms::x_total_external_field_array, atoms::y_total_external_field_array, atoms::z_total_external_field_array,
    					            atoms::m_spin_array, 					   atoms::type_array, 						 sim::temperature);
 
+      // update statistics of additional replicas in ensemble mode
+      if(ensemble::enabled) ensemble::update_statistics();
+
       return;
 
    }
@@ -0,0 +1,314 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <cstdlib>
+#include <cstring>
+
+// Vampire headers
+#include "errors.hpp"
+#include "material.hpp"
+#include "unitcell.hpp"
+#include "vio.hpp"
+
+// unitcell module headers
+#include "internal.hpp"
+
+namespace unitcell{
+namespace internal{
+
+//------------------------------------------------------------------------------
+// Binary unit cell file format (version 1), native byte order
+//
+//    char     magic[8]              "VAMPUCF"
+//    uint32   version
+//    double   dimensions[3]
+//    double   shape[3][3]
+//    uint64   num_atoms
+//       num_atoms  x { double x, y, z; int32 mat, lc, hc }
+//    bilinear and biquadratic interaction templates, each
+//       uint64   num_interactions
+//       uint32   exchange type (0 isotropic, 1 vectorial, 2 tensorial)
+//       uint32   use material exchange constants (normalised exchange)
+//       num_interactions x { int32 i, j, dx, dy, dz; double J[1, 3 or 9] }
+//
+// The same format is used to broadcast the unit cell parsed on the root
+// process to all other processes, and is written by util/ucf2bin.cpp.
+//------------------------------------------------------------------------------
+namespace{
+
+   const char ucf_magic[8] = {'V','A','M','P','U','C','F','\0'};
+   const uint32_t ucf_version = 1;
+
+   // number of exchange values stored for each exchange type
+   unsigned int num_exchange_values(const uint32_t type){
+      if(type == exchange::vectorial) return 3;
+      if(type == exchange::tensorial) return 9;
+      return 1;
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to append raw bytes of a value to buffer
+   //---------------------------------------------------------------------------
+   template <typename T>
+   void append(std::vector<char>& buffer, const T value){
+      const char* bytes = reinterpret_cast<const char*>(&value);
+      buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+   }
+
+   //---------------------------------------------------------------------------
+   // Class to read values sequentially from buffer with bounds checking
+   //---------------------------------------------------------------------------
+   class reader_t{
+
+   private:
+      const std::vector<char>& buffer;
+      const std::string& filename;
+      uint64_t position;
+
+   public:
+      reader_t(const std::vector<char>& b, const std::string& f): buffer(b), filename(f), position(0){}
+
+      template <typename T>
+      T next(){
+         if(position + sizeof(T) > buffer.size()){
+            terminaltextcolor(RED);
+            std::cerr << "Error! Binary unit cell file " << filename << " is truncated or corrupt. Exiting" << std::endl;
+            terminaltextcolor(WHITE);
+            zlog << zTs() << "Error! Binary unit cell file " << filename << " is truncated or corrupt. Exiting" << std::endl;
+            err::vexit();
+         }
+         T value;
+         std::memcpy(&value, &buffer[position], sizeof(T));
+         position += sizeof(T);
+         return value;
+      }
+
+   };
+
+   //---------------------------------------------------------------------------
+   // Functions to pack and unpack interaction template
+   //---------------------------------------------------------------------------
+   void pack_template(const exchange_template_t& exchange, std::vector<char>& buffer){
+
+      const uint32_t type = exchange.exchange_type;
+      const unsigned int num_values = num_exchange_values(type);
+
+      append(buffer, uint64_t(exchange.interaction.size()));
+      append(buffer, type);
+      append(buffer, uint32_t(exchange.use_material_exchange_constants));
+
+      for(const interaction_t& interaction : exchange.interaction){
+         append(buffer, int32_t(interaction.i));
+         append(buffer, int32_t(interaction.j));
+         append(buffer, int32_t(interaction.dx));
+         append(buffer, int32_t(interaction.dy));
+         append(buffer, int32_t(interaction.dz));
+         if(num_values == 1) append(buffer, interaction.Jij[0][0]);
+         else if(num_values == 3){
+            for(int k = 0; k < 3; k++) append(buffer, interaction.Jij[k][k]);
+         }
+         else{
+            for(int k = 0; k < 3; k++){
+               for(int l = 0; l < 3; l++) append(buffer, interaction.Jij[k][l]);
+            }
+         }
+      }
+
+   }
+
+   void unpack_template(reader_t& reader, const int num_atoms, const std::string& filename,
+                        exchange_template_t& exchange, unsigned int& interaction_range){
+
+      const uint64_t num_interactions = reader.next<uint64_t>();
+      const uint32_t type = reader.next<uint32_t>();
+      const uint32_t normalised = reader.next<uint32_t>();
+
+      if(type > exchange::tensorial){
+         terminaltextcolor(RED);
+         std::cerr << "Error! Unknown exchange type " << type << " in binary unit cell file " << filename << ". Exiting" << std::endl;
+         terminaltextcolor(WHITE);
+         zlog << zTs() << "Error! Unknown exchange type " << type << " in binary unit cell file " << filename << ". Exiting" << std::endl;
+         err::vexit();
+      }
+
+      const unsigned int num_values = num_exchange_values(type);
+
+      exchange.interaction.assign(num_interactions, interaction_t());
+      exchange.ni.assign(num_atoms, 0);
+
+      exchange.exchange_type = exchange::exchange_t(type);
+      exchange.use_material_exchange_constants = (normalised != 0);
+
+      for(uint64_t id = 0; id < num_interactions; id++){
+
+         interaction_t& interaction = exchange.interaction[id];
+
+         const int iatom = reader.next<int32_t>();
+         const int jatom = reader.next<int32_t>();
+         interaction.dx = reader.next<int32_t>();
+         interaction.dy = reader.next<int32_t>();
+         interaction.dz = reader.next<int32_t>();
+
+         // check for sane input
+         if(iatom < 0 || iatom >= num_atoms || jatom < 0 || jatom >= num_atoms){
+            terminaltextcolor(RED);
+            std::cerr << "Error! Atom numbers " << iatom << " and " << jatom << " for interaction id " << id << " in binary unit cell file "
+                      << filename << " are outside of valid range 0-" << num_atoms-1 << ". Exiting" << std::endl;
+            terminaltextcolor(WHITE);
+            zlog << zTs() << "Error! Atom numbers " << iatom << " and " << jatom << " for interaction id " << id << " in binary unit cell file "
+                 << filename << " are outside of valid range 0-" << num_atoms-1 << ". Exiting" << std::endl;
+            err::vexit();
+         }
+         interaction.i = iatom;
+         interaction.j = jatom;
+
+         if(num_values == 1){
+            interaction.Jij[0][0] = reader.next<double>();
+            interaction.Jij[1][1] = interaction.Jij[0][0];
+            interaction.Jij[2][2] = interaction.Jij[0][0];
+         }
+         else if(num_values == 3){
+            for(int k = 0; k < 3; k++) interaction.Jij[k][k] = reader.next<double>();
+         }
+         else{
+            for(int k = 0; k < 3; k++){
+               for(int l = 0; l < 3; l++) interaction.Jij[k][l] = reader.next<double>();
+            }
+         }
+
+         // check for long range interactions
+         if(static_cast<unsigned int>(abs(interaction.dx)) > interaction_range) interaction_range = abs(interaction.dx);
+         if(static_cast<unsigned int>(abs(interaction.dy)) > interaction_range) interaction_range = abs(interaction.dy);
+         if(static_cast<unsigned int>(abs(interaction.dz)) > interaction_range) interaction_range = abs(interaction.dz);
+
+         // increment number of interactions for atom i
+         exchange.ni[iatom]++;
+
+      }
+
+   }
+
+} // end of anonymous namespace
+
+//------------------------------------------------------------------------------
+// Function to check if file contents are a binary unit cell file
+//------------------------------------------------------------------------------
+bool is_binary_unit_cell(const std::vector<char>& contents){
+   return contents.size() >= sizeof(ucf_magic) && std::memcmp(&contents[0], ucf_magic, sizeof(ucf_magic)) == 0;
+}
+
+//------------------------------------------------------------------------------
+// Function to pack unit cell into binary unit cell format
+//------------------------------------------------------------------------------
+void pack_unit_cell(const unit_cell_t& unit_cell, std::vector<char>& buffer){
+
+   buffer.clear();
+
+   // estimate buffer size to avoid reallocation
+   buffer.reserve(128 + 36*unit_cell.atom.size() + 92*(unit_cell.bilinear.interaction.size() + unit_cell.biquadratic.interaction.size()));
+
+   buffer.insert(buffer.end(), ucf_magic, ucf_magic + sizeof(ucf_magic));
+   append(buffer, ucf_version);
+
+   for(int i = 0; i < 3; i++) append(buffer, unit_cell.dimensions[i]);
+   for(int i = 0; i < 3; i++){
+      for(int j = 0; j < 3; j++) append(buffer, unit_cell.shape[i][j]);
+   }
+
+   append(buffer, uint64_t(unit_cell.atom.size()));
+   for(const atom_t& atom : unit_cell.atom){
+      append(buffer, atom.x);
+      append(buffer, atom.y);
+      append(buffer, atom.z);
+      append(buffer, int32_t(atom.mat));
+      append(buffer, int32_t(atom.lc));
+      append(buffer, int32_t(atom.hc));
+   }
+
+   pack_template(unit_cell.bilinear, buffer);
+   pack_template(unit_cell.biquadratic, buffer);
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to unpack unit cell from binary unit cell format, returning the
+// maximum range of the interactions in unit cells
+//------------------------------------------------------------------------------
+unsigned int unpack_unit_cell(const std::vector<char>& buffer, unit_cell_t& unit_cell, const std::string& filename){
+
+   reader_t reader(buffer, filename);
+
+   // check header
+   char magic[8];
+   for(int i = 0; i < 8; i++) magic[i] = reader.next<char>();
+   const uint32_t version = reader.next<uint32_t>();
+   if(std::memcmp(magic, ucf_magic, sizeof(ucf_magic)) != 0 || version != ucf_version){
+      terminaltextcolor(RED);
+      std::cerr << "Error! Binary unit cell file " << filename << " has unsupported version " << version << ". Exiting" << std::endl;
+      terminaltextcolor(WHITE);
+      zlog << zTs() << "Error! Binary unit cell file " << filename << " has unsupported version " << version << ". Exiting" << std::endl;
+      err::vexit();
+   }
+
+   for(int i = 0; i < 3; i++) unit_cell.dimensions[i] = reader.next<double>();
+   for(int i = 0; i < 3; i++){
+      for(int j = 0; j < 3; j++) unit_cell.shape[i][j] = reader.next<double>();
+   }
+
+   const uint64_t num_atoms = reader.next<uint64_t>();
+   if(num_atoms == 0 || num_atoms > 100000000){
+      terminaltextcolor(RED);
+      std::cerr << "Error! Number of atoms " << num_atoms << " in binary unit cell file " << filename << " is outside of valid range 1-100,000,000. Exiting" << std::endl;
+      terminaltextcolor(WHITE);
+      zlog << zTs() << "Error! Number of atoms " << num_atoms << " in binary unit cell file " << filename << " is outside of valid range 1-100,000,000. Exiting" << std::endl;
+      err::vexit();
+   }
+
+   unit_cell.atom.assign(num_atoms, atom_t());
+   for(uint64_t i = 0; i < num_atoms; i++){
+      atom_t& atom = unit_cell.atom[i];
+      atom.x = reader.next<double>();
+      atom.y = reader.next<double>();
+      atom.z = reader.next<double>();
+      const int mat = reader.next<int32_t>();
+      atom.lc = reader.next<int32_t>();
+      atom.hc = reader.next<int32_t>();
+      if(atom.x < 0.0 || atom.x > 1.0 || atom.y < 0.0 || atom.y > 1.0 || atom.z < 0.0 || atom.z > 1.0){
+         terminaltextcolor(RED);
+         std::cerr << "Error! Coordinates of atom " << i << " in binary unit cell file " << filename << " are outside of valid range 0.0-1.0. Exiting" << std::endl;
+         terminaltextcolor(WHITE);
+         zlog << zTs() << "Error! Coordinates of atom " << i << " in binary unit cell file " << filename << " are outside of valid range 0.0-1.0. Exiting" << std::endl;
+         err::vexit();
+      }
+      if(mat < 0 || mat >= mp::num_materials){
+         terminaltextcolor(RED);
+         std::cerr << "Error! Requested material id " << mat << " for atom number " << i << " in binary unit cell file " << filename
+                   << " is greater than the number of materials ( " << mp::num_materials << " ) specified in the material file. Exiting" << std::endl;
+         terminaltextcolor(WHITE);
+         zlog << zTs() << "Error! Requested material id " << mat << " for atom number " << i << " in binary unit cell file " << filename
+              << " is greater than the number of materials ( " << mp::num_materials << " ) specified in the material file. Exiting" << std::endl;
+         err::vexit();
+      }
+      atom.mat = mat;
+   }
+
+   unsigned int interaction_range = 1; // assume +-1 unit cell as default
+   unpack_template(reader, num_atoms, filename, unit_cell.bilinear, interaction_range);
+   unpack_template(reader, num_atoms, filename, unit_cell.biquadratic, interaction_range);
+
+   return interaction_range;
+
+}
+
+} // end of internal namespace
+} // end of unitcell namespace
@@ -83,6 +83,13 @@ namespace unitcell{
 
       void calculate_interactions(unit_cell_t& unit_cell);
       void read_unit_cell(unit_cell_t & unit_cell, std::string filename);
+      void parse_unit_cell(unit_cell_t & unit_cell, const std::string& contents, std::string filename);
+
+      // functions for binary unit cell format
+      bool is_binary_unit_cell(const std::vector<char>& contents);
+      void pack_unit_cell(const unit_cell_t& unit_cell, std::vector<char>& buffer);
+      unsigned int unpack_unit_cell(const std::vector<char>& buffer, unit_cell_t& unit_cell, const std::string& filename);
+
       void read_biquadratic_interactions(unit_cell_t & unit_cell,
                                          std::stringstream& ucf,
                                          std::istringstream& ucf_ss,
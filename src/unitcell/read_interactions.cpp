@@ -11,6 +11,7 @@
 //
 
 // C++ standard library headers
+#include <cstdlib>
 
 // Vampire headers
 #include "errors.hpp"
@@ -23,6 +24,33 @@
 
 namespace unitcell{
 
+   namespace{
+
+      //------------------------------------------------------------------------
+      // Functions to read the next value from a character string, returning
+      // false if no value could be read. These avoid the large overhead of
+      // creating a string stream for every line of large interaction lists.
+      //------------------------------------------------------------------------
+      inline bool next_value(const char*& str, int& value){
+         char* end;
+         const long result = std::strtol(str, &end, 10);
+         if(end == str) return false;
+         value = result;
+         str = end;
+         return true;
+      }
+
+      inline bool next_value(const char*& str, double& value){
+         char* end;
+         const double result = std::strtod(str, &end);
+         if(end == str) return false;
+         value = result;
+         str = end;
+         return true;
+      }
+
+   }
+
    void unitcell::exchange_template_t::read_interactions(
       //unit_cell_t& unit_cell,
       const int num_atoms, // num atoms in unit cell
@@ -57,6 +85,9 @@ namespace unitcell{
       // resize interaction counter array to store number of interactions per atom
       ni.resize(num_atoms, 0);
 
+      // line buffer reused for all interactions
+      std::string int_line;
+
       // loop over all interactions and read into class
       for (int i=0; i<num_interactions; i++){
 
@@ -68,11 +99,12 @@ namespace unitcell{
          int iatom=-1,jatom=-1; // atom pairs
          int dx=0, dy=0,dz=0; // relative unit cell coordinates
          // get line
-         std::string int_line;
          getline(ucf_file,int_line);
          //std::cout << int_line.c_str() << std::endl;
-         std::istringstream int_iss(int_line,std::istringstream::in);
-         int_iss >> id >> iatom >> jatom >> dx >> dy >> dz;
+         const char* int_str = int_line.c_str();
+         // read values in order, stopping at the first missing value
+         const bool valid_line = next_value(int_str, id) && next_value(int_str, iatom) && next_value(int_str, jatom) &&
+                                 next_value(int_str, dx) && next_value(int_str, dy)    && next_value(int_str, dz);
          //inputfile >> id >> iatom >> jatom >> dx >> dy >> dz;
          line_counter++;
          // check for sane input
@@ -122,18 +154,18 @@ namespace unitcell{
          //int jatom_mat = unit_cell.atom[jatom].mat;
          switch(num_exchange_values){
             case 1:
-               int_iss >> interaction[i].Jij[0][0];
+               if(valid_line) next_value(int_str, interaction[i].Jij[0][0]);
                // save interactions into diagonal components of the exchange tensor
                interaction[i].Jij[1][1] = interaction[i].Jij[0][0];
                interaction[i].Jij[2][2] = interaction[i].Jij[0][0];
                break;
             case 3:
-               int_iss >> interaction[i].Jij[0][0] >> interaction[i].Jij[1][1] >> interaction[i].Jij[2][2];
+               if(valid_line) next_value(int_str, interaction[i].Jij[0][0]) && next_value(int_str, interaction[i].Jij[1][1]) && next_value(int_str, interaction[i].Jij[2][2]);
                break;
             case 9:
-               int_iss >> interaction[i].Jij[0][0] >> interaction[i].Jij[0][1] >> interaction[i].Jij[0][2];
-               int_iss >> interaction[i].Jij[1][0] >> interaction[i].Jij[1][1] >> interaction[i].Jij[1][2];
-               int_iss >> interaction[i].Jij[2][0] >> interaction[i].Jij[2][1] >> interaction[i].Jij[2][2];
+               if(valid_line) next_value(int_str, interaction[i].Jij[0][0]) && next_value(int_str, interaction[i].Jij[0][1]) && next_value(int_str, interaction[i].Jij[0][2]) &&
+                              next_value(int_str, interaction[i].Jij[1][0]) && next_value(int_str, interaction[i].Jij[1][1]) && next_value(int_str, interaction[i].Jij[1][2]) &&
+                              next_value(int_str, interaction[i].Jij[2][0]) && next_value(int_str, interaction[i].Jij[2][1]) && next_value(int_str, interaction[i].Jij[2][2]);
                break;
             default:
                terminaltextcolor(RED);
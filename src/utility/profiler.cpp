@@ -0,0 +1,201 @@
+//-----------------------------------------------------------------------------
+//
+// This source file is part of the VAMPIRE open source package under the
+// GNU GPL (version 2) licence (see licence file for details).
+//
+// (c) agent 2026. All rights reserved.
+//
+//-----------------------------------------------------------------------------
+
+// C++ standard library headers
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+// Vampire headers
+#include "vio.hpp"
+#include "vmpi.hpp"
+#include "vprofile.hpp"
+
+namespace vprofile{
+
+#ifdef VPROFILE
+
+   std::vector<accumulator_t> accumulators; // per-thread timing data
+
+   namespace{
+
+      // names of sections, indented to show usual nesting
+      const char* section_names[num_sections] = { "integrator",
+                                                  "  spin fields",
+                                                  "    exchange",
+                                                  "    anisotropy",
+                                                  "  external fields",
+                                                  "    thermal noise",
+                                                  "    dipole",
+                                                  "  mpi wait",
+                                                  "statistics",
+                                                  "output" };
+
+      uint64_t start_ticks = 0; // time stamp at start of profiling
+      std::chrono::steady_clock::time_point start_time;
+      uint64_t total_steps = 0; // number of integration steps
+
+   }
+
+#endif
+
+//------------------------------------------------------------------------------
+// Function to reset all timers and start profiling
+//------------------------------------------------------------------------------
+void initialise(){
+
+#ifdef VPROFILE
+
+   #ifdef _OPENMP
+      const int num_threads = omp_get_max_threads();
+   #else
+      const int num_threads = 1;
+   #endif
+
+   accumulator_t zero;
+   std::fill(zero.ticks, zero.ticks + num_sections, 0);
+   std::fill(zero.child_ticks, zero.child_ticks + num_sections, 0);
+   std::fill(zero.calls, zero.calls + num_sections, 0);
+   zero.current = -1;
+
+   accumulators.assign(num_threads, zero);
+   total_steps = 0;
+
+   start_time = std::chrono::steady_clock::now();
+   start_ticks = ticks();
+
+   zlog << zTs() << "Profiling enabled for " << num_threads << " threads" << std::endl;
+
+#endif
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to add number of integration steps
+//------------------------------------------------------------------------------
+#ifdef VPROFILE
+void add_steps(uint64_t num_steps){
+   total_steps += num_steps;
+   return;
+}
+#else
+void add_steps(uint64_t){
+   return;
+}
+#endif
+
+//------------------------------------------------------------------------------
+// Function to print table of time spent in each section on each processor
+// and aggregated over all processors to the log file
+//------------------------------------------------------------------------------
+void report(){
+
+#ifdef VPROFILE
+
+   // calibrate ticks against wall clock time over the whole run
+   const uint64_t end_ticks = ticks();
+   const double wall_time = 1.e-9*double(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_time).count());
+   const double seconds_per_tick = (end_ticks > start_ticks && wall_time > 0.0) ? wall_time/double(end_ticks - start_ticks) : 0.0;
+
+   // sum data over all threads on this processor
+   std::vector<double> local(3*num_sections + 1, 0.0);
+   for(const accumulator_t& acc : accumulators){
+      for(int s = 0; s < num_sections; s++){
+         local[3*s + 0] += seconds_per_tick*double(acc.ticks[s]);
+         local[3*s + 1] += seconds_per_tick*double(acc.ticks[s] - acc.child_ticks[s]);
+         local[3*s + 2] += double(acc.calls[s]);
+      }
+   }
+   local[3*num_sections] = wall_time;
+
+   // collect data from all processors on root
+   const int stride = local.size();
+   std::vector<double> all(stride*vmpi::num_processors, 0.0);
+   #ifdef MPICF
+      MPI_Gather(&local[0], stride, MPI_DOUBLE, &all[0], stride, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+   #else
+      all = local;
+   #endif
+
+   if(vmpi::my_rank != 0) return;
+
+   const int np = vmpi::num_processors;
+   const double steps = total_steps > 0 ? double(total_steps) : 1.0;
+
+   // aggregated table
+   std::stringstream table;
+   table << std::fixed;
+   table << "Profile of " << total_steps << " integration steps on " << np << " processors (times in seconds, per step in microseconds)" << "\n";
+   table << std::left << std::setw(20) << "section" << std::right
+         << std::setw(12) << "calls" << std::setw(12) << "min total" << std::setw(12) << "mean total"
+         << std::setw(12) << "max total" << std::setw(12) << "mean self" << std::setw(12) << "per step"
+         << std::setw(10) << "% run" << "\n";
+
+   double max_wall = 0.0;
+   for(int p = 0; p < np; p++) max_wall = std::max(max_wall, all[p*stride + 3*num_sections]);
+
+   for(int s = 0; s < num_sections; s++){
+      double min_total = all[3*s];
+      double max_total = 0.0;
+      double sum_total = 0.0;
+      double sum_self  = 0.0;
+      double sum_calls = 0.0;
+      for(int p = 0; p < np; p++){
+         const double total = all[p*stride + 3*s + 0];
+         min_total  = std::min(min_total, total);
+         max_total  = std::max(max_total, total);
+         sum_total += total;
+         sum_self  += all[p*stride + 3*s + 1];
+         sum_calls += all[p*stride + 3*s + 2];
+      }
+      const double mean_total = sum_total/double(np);
+      table << std::left << std::setw(20) << section_names[s] << std::right
+            << std::setw(12) << uint64_t(sum_calls/double(np))
+            << std::setprecision(4)
+            << std::setw(12) << min_total << std::setw(12) << mean_total << std::setw(12) << max_total
+            << std::setw(12) << sum_self/double(np)
+            << std::setprecision(3)
+            << std::setw(12) << 1.e6*mean_total/steps
+            << std::setprecision(2)
+            << std::setw(10) << (max_wall > 0.0 ? 100.0*mean_total/max_wall : 0.0) << "\n";
+   }
+
+   // per processor table of total time in each section
+   table << "Total time per processor" << "\n";
+   table << std::left << std::setw(20) << "section" << std::right;
+   for(int p = 0; p < np; p++){
+      std::stringstream rank;
+      rank << "rank " << p;
+      table << std::setw(12) << rank.str();
+   }
+   table << "\n" << std::setprecision(4);
+   for(int s = 0; s < num_sections; s++){
+      table << std::left << std::setw(20) << section_names[s] << std::right;
+      for(int p = 0; p < np; p++) table << std::setw(12) << all[p*stride + 3*s];
+      table << "\n";
+   }
+   table << std::left << std::setw(20) << "wall time" << std::right;
+   for(int p = 0; p < np; p++) table << std::setw(12) << all[p*stride + 3*num_sections];
+   table << "\n";
+
+   // write table to log file line by line
+   std::string line;
+   while(std::getline(table, line)) zlog << zTs() << line << std::endl;
+
+#endif
+
+   return;
+
+}
+
+} // end of namespace vprofile
@@ -11,10 +11,12 @@
 //
 
 // C++ standard library headers
+#include <iomanip>
 #include <sstream>
 
 // Vampire headers
 #include "config.hpp"
+#include "ensemble.hpp"
 #include "errors.hpp"
 #include "info.hpp"
 #include "gpu.hpp"
@@ -22,6 +24,7 @@
 #include "sim.hpp"
 #include "sld.hpp"
 #include "vio.hpp"
+#include "vprofile.hpp"
 #include "micromagnetic.hpp"
 
 // vio module headers
@@ -363,6 +366,46 @@ namespace vout{
       header = false;
    }
 
+   //-------------------------------------------
+   // Output data for additional replicas of an
+   // ensemble to separate output files
+   //-------------------------------------------
+   void write_replica_data(){
+
+      // output files for replicas 1 to num_replicas-1, replica 0 is in zmag
+      static std::vector<std::ofstream> zreplica;
+
+      const int num_replicas = ensemble::get_num_replicas();
+
+      if(vmpi::my_rank == 0 && zreplica.size() == 0){
+         zreplica.resize(num_replicas);
+         for(int r = 1; r < num_replicas; r++){
+            std::stringstream filename;
+            filename << vout::output_file_name << "-replica-" << std::setfill('0') << std::setw(3) << r;
+            zreplica[r].open(filename.str().c_str(), std::ofstream::trunc);
+            // column names are written here as write_out only writes them for the first output
+            const bool header_option = vout::header_option;
+            vout::header_option = false;
+            write_output_file_header(zreplica[r], file_output_list);
+            vout::header_option = header_option;
+            if(vout::header_option && file_output_list.size() > 0){
+               for(unsigned int item = 0; item < file_output_list.size(); item++) output_switch(zreplica[r], file_output_list[item], true);
+               zreplica[r] << std::endl;
+            }
+         }
+      }
+
+      // write replica statistics with the same columns as the output file
+      for(int r = 1; r < num_replicas; r++){
+         ensemble::swap_replica_statistics(r);
+         write_out(zreplica[r], file_output_list);
+         ensemble::swap_replica_statistics(r);
+      }
+
+      return;
+
+   }
+
    //-------------------------------------------
 	// Data output wrapper function
    //-------------------------------------------
@@ -373,6 +416,9 @@ namespace vout{
 		// check calling of routine if error checking is activated
 		if(err::check==true){std::cout << "vout::data has been called" << std::endl;}
 
+		// time spent in output for profiling
+		VPROFILE_SCOPE(vprofile::output);
+
 		// Calculate MPI Timings since last data output
 		#ifdef MPICF
 		if(vmpi::DetailedMPITiming){
@@ -414,6 +460,8 @@ namespace vout{
       // Only output 1/output_rate time steps// This is all serialised inside the write_output fn - AJN
       if(sim::time%vout::output_rate==0){
          write_out(zmag,file_output_list);
+         // output additional replicas in ensemble mode
+         if(ensemble::enabled) write_replica_data();
       } // end of if statement for output rate
 
       if(sim::time%vout::output_rate==0){ // needs to be altered to separate variable at some point
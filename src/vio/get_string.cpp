@@ -28,9 +28,10 @@ namespace vin {
 
    //---------------------------------------------------------------------------
    // Function to open file on master process and return string on all
-   // processes containing file contents
+   // processes containing file contents. If broadcast is false the contents
+   // are returned only on the master process and an empty string elsewhere.
    //---------------------------------------------------------------------------
-   std::string get_string(std::string const filename, std::string source_file_name, int line){
+   std::string get_string(std::string const filename, std::string source_file_name, int line, bool broadcast){
 
       // boolean variable specifying root process
       bool root = false;
@@ -57,8 +58,8 @@ namespace vin {
          // start the timer
          timer.start();
 
-         // Open file
-         inputfile.open(filename.c_str());
+         // Open file (binary mode so that the size on disk is the number of characters)
+         inputfile.open(filename.c_str(), std::ios::binary);
 
          // Check for correct opening
          if(!inputfile.is_open()){
@@ -72,20 +73,17 @@ namespace vin {
             err::vexit(); // exit program disgracefully
          }
 
-         // load file directly into std::string
-         std::string contents( (std::istreambuf_iterator<char>(inputfile)), std::istreambuf_iterator<char>() );
-
-         // stop the timer
-         timer.stop();
-
          // get total number of characters in file
-         length = contents.length();
+         inputfile.seekg(0, std::ios::end);
+         length = inputfile.tellg();
+         inputfile.seekg(0, std::ios::beg);
 
-         // reserve correct amount of storage for message
-         message.reserve(length);
+         // load file directly into message buffer in a single read
+         message.resize(length);
+         if(length > 0) inputfile.read(&message[0], length);
 
-         // copy contents to message buffer for broadcast
-         std::copy(contents.begin(), contents.end(), std::back_inserter(message));
+         // stop the timer
+         timer.stop();
 
          // calculate size (MB) and bandwith and save to log file
          const double file_size = length * sizeof(char)*1.0e-6;
@@ -96,6 +94,8 @@ namespace vin {
 
       #ifdef MPICF
 
+      if(broadcast){
+
          // broadcast string size from root (0) to all processors
          MPI_Bcast(&length, 1, MPI_UINT64_T, 0, MPI_COMM_WORLD);
 
@@ -112,6 +112,8 @@ namespace vin {
          vmpi::broadcast(message, 0);
          //MPI_Bcast(&message[0], message.size(), MPI_CHAR, 0, MPI_COMM_WORLD);
 
+      }
+
       #endif
 
       // return message array cast to a std::string on all processors
@@ -16,6 +16,7 @@
 
 // Vampire headers
 #include "errors.hpp"
+#include "stats.hpp"
 #include "vio.hpp"
 
 // vio module headers
@@ -54,6 +55,30 @@ namespace vio{
         vout::header_option = true;
          return true;
       }
+      //-------------------------------------------------------------------
+      test="energy-magnetisation-histograms";
+      if(word==test){
+         stats::calculate_system_energy = true;
+         stats::calculate_system_magnetization = true;
+         stats::calculate_system_histogram = true;
+         return true;
+      }
+      //-------------------------------------------------------------------
+      test="histogram-energy-bins";
+      if(word==test){
+         int n=atoi(value.c_str());
+         vin::check_for_valid_int(n, word, line, prefix, 10, 1000000,"input","10 - 1,000,000");
+         stats::histogram_energy_bins = n;
+         return true;
+      }
+      //-------------------------------------------------------------------
+      test="histogram-magnetisation-bins";
+      if(word==test){
+         int n=atoi(value.c_str());
+         vin::check_for_valid_int(n, word, line, prefix, 1, 10000,"input","1 - 10,000");
+         stats::histogram_magnetization_bins = n;
+         return true;
+      }
       //--------------------------------------------------------------------
       // Keyword not found
       //--------------------------------------------------------------------
@@ -49,6 +49,7 @@ namespace vin{
    //----------------------------------------------------------------------------------
    int read(std::string const filename);
    int read_mat_file(std::string const, int const);
+   void hash_structural_input(std::string const key, std::string const line);
 
 }
 
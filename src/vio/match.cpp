@@ -20,10 +20,12 @@
 #include "vio.hpp"
 #include "sim.hpp"
 #include "dipole.hpp"
+#include "ensemble.hpp"
 #include "errors.hpp"
 #include "exchange.hpp"
 #include "environment.hpp"
 #include "hamr.hpp"
+#include "hierarchical.hpp"
 #include "material.hpp"
 #include "gpu.hpp"
 #include "grains.hpp"
@@ -83,6 +85,7 @@ namespace vin{
         else if(cells::match_input_parameter(key, word, value, unit, line)) return EXIT_SUCCESS;
         else if(create::match_input_parameter(key, word, value, unit, line)) return EXIT_SUCCESS;
         else if(dipole::match_input_parameter(key, word, value, unit, line)) return EXIT_SUCCESS;
+        else if(ensemble::match_input_parameter(key, word, value, unit, line)) return EXIT_SUCCESS;
         else if(gpu::match_input_parameter(key, word, value, unit, line)) return EXIT_SUCCESS;
         else if(exchange::match_input_parameter(key, word, value, unit, line)) return EXIT_SUCCESS;
         else if(montecarlo::match_input_parameter(key, word, value, unit, line)) return EXIT_SUCCESS;
@@ -95,6 +98,7 @@ namespace vin{
         else if(micromagnetic::match_input_parameter(key, word, value, unit, line)) return EXIT_SUCCESS;
         else if(environment::match_input_parameter(key, word, value, unit, line)) return EXIT_SUCCESS;
         else if(hamr::match_input_parameter(key, word, value, unit, line)) return EXIT_SUCCESS;
+        else if(hierarchical::match_input_parameter(key, word, value, unit, line)) return EXIT_SUCCESS;
         else if(sld::match_input_parameter(key, word, value, unit, line)) return EXIT_SUCCESS;
         else if(spinwaves::match_input_parameter(key, word, value, unit, line)) return EXIT_SUCCESS; // JRH spinwaves input parameters
         //===================================================================
@@ -1652,6 +1656,10 @@ namespace vin{
             // remove carriage returns for dos formatted files
                         line.erase(remove(line.begin(), line.end(), '\r'), line.end());
 
+            // add line to hash of structural input (all material parameters are included)
+            const std::string hash_line = line.substr(0,line.find('#'));
+            if(hash_line != "") hash_structural_input("material", hash_line);
+
             // strip key,word,unit,value
             std::string key="";
             std::string word="";
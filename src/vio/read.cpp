@@ -24,6 +24,36 @@
 #include "internal.hpp"
 
 namespace vin{
+
+	// hash of structural input, initialised to 64 bit FNV-1a offset basis
+	uint64_t structural_input_hash = 14695981039346656037ULL;
+
+	//-----------------------------------------------------------------------------
+	// Function to add a cleaned input line to the hash of the structural input.
+	// Sections which only control simulation, output or post-creation modules
+	// are ignored so that parameter sweeps keep the same structural hash.
+	//-----------------------------------------------------------------------------
+	void hash_structural_input(std::string const key, std::string const line){
+
+		const char* ignored_keys[] = { "sim", "output", "screen", "config", "anisotropy", "cells", "dipole",
+		                               "environment", "gpu", "hamr", "hierarchical", "local-temperature-pulse",
+		                               "micromagnetic", "montecarlo", "spin-lattice", "spin-torque",
+		                               "spin-transport", "spinwaves" };
+
+		for(const char* ignored : ignored_keys) if(key == ignored) return;
+
+		// FNV-1a hash of line including terminator
+		for(const char c : line){
+			structural_input_hash ^= uint64_t(static_cast<unsigned char>(c));
+			structural_input_hash *= 1099511628211ULL;
+		}
+		structural_input_hash ^= uint64_t('\n');
+		structural_input_hash *= 1099511628211ULL;
+
+		return;
+
+	}
+
 	// Function to extract all variables from a string and return a vector of double
 	std::vector<double> doubles_from_string(std::string value){
 
@@ -207,6 +237,9 @@ namespace vin{
 				superIndex = stoi(superIndexString);
 			}
 
+			// add line to hash of structural input
+			if(key != empty) hash_structural_input(key, line);
+
 			// Call different overloads depending on whether super and sub indicies are present
 			if(key != empty && superIndex == 0 && subIndex == 0){
 				//	std::cout << "\t" << "key:  " << key << std::endl;
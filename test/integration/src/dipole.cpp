@@ -0,0 +1,287 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+// module headers
+#include "internal.hpp"
+
+//------------------------------------------------------------------------------
+// Function to read the macrocell dipole fields (columns 6-8 of the legacy cell
+// configuration file) of the first output
+//------------------------------------------------------------------------------
+std::vector<double> read_cell_dipole_fields(){
+
+   std::vector<double> field;
+
+   std::ifstream ifile;
+   ifile.open("cells-00000000.cfg");
+
+   std::string line;
+   while( getline(ifile, line) ){
+      if(line.size() == 0 || line[0] == '#') continue;
+      std::stringstream liness(line);
+      double mx, my, mz, rm, mm, hx, hy, hz;
+      liness >> mx >> my >> mz >> rm >> mm >> hx >> hy >> hz;
+      field.push_back(hx);
+      field.push_back(hy);
+      field.push_back(hz);
+   }
+
+   return field;
+
+}
+
+//------------------------------------------------------------------------------
+// Test to verify the macrocell dipole fields of a solver against the fields of
+// a reference solver for the same system and spin configuration. The input file
+// is run first and then the reference input file, and the test passes if the
+// root mean square field error relative to the root mean square reference field
+// is below the tolerance.
+//------------------------------------------------------------------------------
+bool dipole_field_test(const std::string dir, const std::string reference_input, double tolerance, const std::string executable){
+
+   // get root directory
+   std::string path = std::filesystem::current_path();
+
+   // fixed-width output for prettiness
+   std::stringstream test_name;
+   test_name << "Testing dipole fields for " << dir;
+   std::cout << std::setw(60) << std::left << test_name.str() << " : " << std::flush;
+
+   // change directory
+   if( !vt::chdir(path+"/data/"+dir) ) return false;
+
+   // run vampire for solver under test
+   int vmp = vt::system(executable);
+   if( vmp != 0){
+      std::cerr << "Error running vampire. Returning as failed test." << std::endl;
+      return false;
+   }
+   const std::vector<double> field = read_cell_dipole_fields();
+
+   // run vampire for reference solver
+   vmp = vt::system(executable+" --input-file "+reference_input);
+   if( vmp != 0){
+      std::cerr << "Error running vampire. Returning as failed test." << std::endl;
+      return false;
+   }
+   const std::vector<double> reference = read_cell_dipole_fields();
+
+   // cleanup
+   vt::system("rm -f cells-*.cfg dipole-field output log");
+
+   // return to parent directory
+   if( !vt::chdir(path) ) return false;
+
+   // now compare fields obtained from code
+   if( field.size() != reference.size() || field.size() == 0 ){
+      std::cout << "FAIL | expected " << reference.size()/3 << " cells obtained " << field.size()/3 << std::endl;
+      return false;
+   }
+
+   double sum_sq_error = 0.0;
+   double sum_sq_field = 0.0;
+   for(size_t i = 0; i < field.size(); i++){
+      sum_sq_error += (field[i] - reference[i])*(field[i] - reference[i]);
+      sum_sq_field += reference[i]*reference[i];
+   }
+   const double error = sqrt(sum_sq_error/sum_sq_field);
+
+   if( error < tolerance ){
+      std::cout << "OK" << std::endl;
+      return true;
+   }
+   else{
+      std::cout << "FAIL | relative rms error: " << error << " tolerance: " << tolerance << std::endl;
+      return false;
+   }
+
+}
+
+//------------------------------------------------------------------------------
+// Function to calculate the dipole field (T) of a periodic system of point
+// dipoles (muB) with side lengths L (A) by direct Ewald summation with vacuum
+// boundary conditions
+//------------------------------------------------------------------------------
+std::vector<double> ewald_dipole_fields(const std::vector<double>& r, const std::vector<double>& m, const std::vector<double>& L){
+
+   const int num_atoms = r.size()/3;
+   const double pi = M_PI;
+
+   // splitting parameter and ranges for convergence to around 1e-12
+   const double alpha = 3.0/std::min(L[0], std::min(L[1], L[2]));
+   const double rc = 6.0/alpha;
+   const double kc = 12.0*alpha;
+   int nr[3], nk[3];
+   for(int d = 0; d < 3; d++){
+      nr[d] = int(ceil(rc/L[d])) + 1;
+      nk[d] = int(ceil(kc*L[d]/(2.0*pi)));
+   }
+
+   const double volume = L[0]*L[1]*L[2];
+   const double self = 4.0*alpha*alpha*alpha/(3.0*sqrt(pi));
+
+   // total moment for surface term
+   double M[3] = {0.0, 0.0, 0.0};
+   for(int j = 0; j < num_atoms; j++){
+      for(int d = 0; d < 3; d++) M[d] += m[3*j+d];
+   }
+
+   std::vector<double> field(3*num_atoms, 0.0);
+
+   for(int i = 0; i < num_atoms; i++){
+
+      double h[3] = {0.0, 0.0, 0.0};
+
+      // real space sum over all images
+      for(int j = 0; j < num_atoms; j++){
+         for(int u = -nr[0]; u <= nr[0]; u++){
+            for(int v = -nr[1]; v <= nr[1]; v++){
+               for(int w = -nr[2]; w <= nr[2]; w++){
+                  const double rij[3] = { r[3*j+0] + u*L[0] - r[3*i+0],
+                                          r[3*j+1] + v*L[1] - r[3*i+1],
+                                          r[3*j+2] + w*L[2] - r[3*i+2] };
+                  const double r2 = rij[0]*rij[0] + rij[1]*rij[1] + rij[2]*rij[2];
+                  if(r2 < 1.0e-12 || r2 > rc*rc) continue;
+                  const double rr = sqrt(r2);
+                  const double e = exp(-alpha*alpha*r2);
+                  const double b = (erfc(alpha*rr) + 2.0*alpha*rr/sqrt(pi)*e)/(r2*rr);
+                  const double c = (3.0*erfc(alpha*rr) + 2.0*alpha*rr/sqrt(pi)*(3.0 + 2.0*alpha*alpha*r2)*e)/(r2*r2*rr);
+                  const double rm = rij[0]*m[3*j+0] + rij[1]*m[3*j+1] + rij[2]*m[3*j+2];
+                  for(int d = 0; d < 3; d++) h[d] += c*rm*rij[d] - b*m[3*j+d];
+               }
+            }
+         }
+      }
+
+      // reciprocal space sum
+      for(int u = -nk[0]; u <= nk[0]; u++){
+         for(int v = -nk[1]; v <= nk[1]; v++){
+            for(int w = -nk[2]; w <= nk[2]; w++){
+               if(u == 0 && v == 0 && w == 0) continue;
+               const double k[3] = { 2.0*pi*u/L[0], 2.0*pi*v/L[1], 2.0*pi*w/L[2] };
+               const double k2 = k[0]*k[0] + k[1]*k[1] + k[2]*k[2];
+               if(k2 > kc*kc) continue;
+               double sum = 0.0;
+               for(int j = 0; j < num_atoms; j++){
+                  const double km = k[0]*m[3*j+0] + k[1]*m[3*j+1] + k[2]*m[3*j+2];
+                  sum += km*cos(k[0]*(r[3*i+0] - r[3*j+0]) + k[1]*(r[3*i+1] - r[3*j+1]) + k[2]*(r[3*i+2] - r[3*j+2]));
+               }
+               const double g = 4.0*pi*exp(-k2/(4.0*alpha*alpha))/(k2*volume);
+               for(int d = 0; d < 3; d++) h[d] -= g*k[d]*sum;
+            }
+         }
+      }
+
+      // self and surface terms, converted to Tesla
+      const double prefactor = 0.9274009994; // mu_0 * muB / (4*pi*Angstrom^3)
+      for(int d = 0; d < 3; d++){
+         field[3*i+d] = prefactor*(h[d] + self*m[3*i+d] - 4.0*pi*M[d]/(3.0*volume));
+      }
+
+   }
+
+   return field;
+
+}
+
+//------------------------------------------------------------------------------
+// Test to verify the atomistic dipole fields (atomistic_dipole_field.txt) of a
+// small fully periodic system with side lengths L against a direct Ewald sum
+// for the spin configuration at the start of the simulation
+// (spins-00000000.data, text format). The test passes if the root mean square
+// field error relative to the root mean square Ewald field is below the
+// tolerance.
+//------------------------------------------------------------------------------
+bool ewald_field_test(const std::string dir, const std::vector<double> L, double tolerance, const std::string executable){
+
+   // get root directory
+   std::string path = std::filesystem::current_path();
+
+   // fixed-width output for prettiness
+   std::stringstream test_name;
+   test_name << "Testing Ewald dipole fields for " << dir;
+   std::cout << std::setw(60) << std::left << test_name.str() << " : " << std::flush;
+
+   // change directory
+   if( !vt::chdir(path+"/data/"+dir) ) return false;
+
+   // run vampire
+   int vmp = vt::system(executable);
+   if( vmp != 0){
+      std::cerr << "Error running vampire. Returning as failed test." << std::endl;
+      return false;
+   }
+
+   // read positions, moments, spins and fields of all atoms
+   std::vector<double> r, mu, m, field;
+   double x, y, z, w;
+
+   std::ifstream pfile("atomistic_dipole_positions.txt");
+   while( pfile >> x >> y >> z >> w ){
+      r.push_back(x);
+      r.push_back(y);
+      r.push_back(z);
+      mu.push_back(w);
+   }
+
+   std::ifstream sfile("spins-00000000.data");
+   int num_spins = 0;
+   sfile >> num_spins;
+   for(int atom = 0; atom < num_spins && sfile >> x >> y >> z; atom++){
+      const double mus = atom < int(mu.size()) ? mu[atom] : 0.0;
+      m.push_back(x*mus);
+      m.push_back(y*mus);
+      m.push_back(z*mus);
+   }
+
+   std::ifstream ffile("atomistic_dipole_field.txt");
+   while( ffile >> x >> y >> z ){
+      field.push_back(x);
+      field.push_back(y);
+      field.push_back(z);
+   }
+
+   // cleanup
+   vt::system("rm -f atomistic_dipole_*.txt atoms-coords.* spins-* dipole-field output log");
+
+   // return to parent directory
+   if( !vt::chdir(path) ) return false;
+
+   // now compare fields obtained from code
+   if( field.size() != r.size() || m.size() != r.size() || field.size() == 0 ){
+      std::cout << "FAIL | inconsistent number of atoms: " << r.size()/3 << " positions " << m.size()/3 << " spins " << field.size()/3 << " fields" << std::endl;
+      return false;
+   }
+
+   const std::vector<double> reference = ewald_dipole_fields(r, m, L);
+
+   double sum_sq_error = 0.0;
+   double sum_sq_field = 0.0;
+   for(size_t i = 0; i < field.size(); i++){
+      sum_sq_error += (field[i] - reference[i])*(field[i] - reference[i]);
+      sum_sq_field += reference[i]*reference[i];
+   }
+   const double error = sqrt(sum_sq_error/sum_sq_field);
+
+   if( error < tolerance ){
+      std::cout << "OK" << std::endl;
+      return true;
+   }
+   else{
+      std::cout << "FAIL | relative rms error: " << error << " tolerance: " << tolerance << std::endl;
+      return false;
+   }
+
+}
@@ -11,6 +11,8 @@
 //
 
 // C++ standard library headers
+#include <cmath>
+#include <iomanip>
 
 // module headers
 #include "internal.hpp"
@@ -70,3 +72,67 @@ bool exchange_test(std::string dir, double result, std::string executable){
    }
 
 }
+
+//------------------------------------------------------------------------------
+// Test to verify the relaxation of random spins for different combinations of
+// exchange interactions (regression test against the magnetisation mx, my, mz
+// and |m| in the last line of the output file)
+//------------------------------------------------------------------------------
+bool exchange_dynamics_test(const std::string dir, const std::vector<double> m, double tolerance, const std::string executable){
+
+   // get root directory
+   std::string path = std::filesystem::current_path();
+
+   // fixed-width output for prettiness
+   std::stringstream test_name;
+   test_name << "Testing dynamics for " << dir;
+   std::cout << std::setw(60) << std::left << test_name.str() << " : " << std::flush;
+
+   // change directory
+   if( !vt::chdir(path+"/data/"+dir) ) return false;
+
+   // run vampire
+   int vmp = vt::system(executable);
+   if( vmp != 0){
+      std::cerr << "Error running vampire. Returning as failed test." << std::endl;
+      return false;
+   }
+
+   // open output file
+   std::ifstream ifile;
+   ifile.open("output");
+
+   // read last line of data
+   std::string line, last_line;
+   while( getline(ifile, line) ){
+      if(line.size() > 0 && line[0] != '#') last_line = line;
+   }
+   std::stringstream liness(last_line);
+   double step = 0.0;
+   std::vector<double> value(4, 0.0);
+   liness >> step >> value[0] >> value[1] >> value[2] >> value[3];
+
+   // cleanup
+   vt::system("rm output log");
+
+   // return to parent directory
+   if( !vt::chdir(path) ) return false;
+
+   // now test values obtained from code
+   bool pass = m.size() == value.size();
+   for(size_t i = 0; i < m.size() && pass; i++){
+      if( fabs(value[i] - m[i]) > tolerance ) pass = false;
+   }
+
+   if(pass){
+      std::cout << "OK" << std::endl;
+      return true;
+   }
+   else{
+      std::cout << "FAIL | expected: ";
+      for(size_t i = 0; i < m.size(); i++) std::cout << m[i] << "\t";
+      std::cout << "\tobtained:  " << last_line << std::endl;
+      return false;
+   }
+
+}
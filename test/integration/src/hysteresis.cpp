@@ -0,0 +1,103 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <vector>
+
+// module headers
+#include "internal.hpp"
+
+//------------------------------------------------------------------------------
+// Test to verify consistent coercivity of a zero temperature hysteresis loop.
+// The output columns must be the applied field strength followed by the
+// magnetisation, and the coercive field on each branch is interpolated
+// linearly between the field points either side of the reversal of mz.
+//------------------------------------------------------------------------------
+bool hysteresis_test(const std::string dir, double hc, const std::string executable){
+
+   // get root directory
+   std::string path = std::filesystem::current_path();
+
+   // fixed-width output for prettiness
+   std::stringstream test_name;
+   test_name << "Testing hysteresis for " << dir;
+   std::cout << std::setw(60) << std::left << test_name.str() << " : " << std::flush;
+
+   // change directory
+   if( !vt::chdir(path+"/data/"+dir) ) return false;
+
+   // run vampire
+   int vmp = vt::system(executable);
+   if( vmp != 0){
+      std::cerr << "Error running vampire. Returning as failed test." << std::endl;
+      return false;
+   }
+
+   // open output file
+   std::ifstream ifile;
+   ifile.open("output");
+
+   // find fields at which mz changes sign
+   std::vector<double> coercive_fields;
+   std::string line;
+   double last_h = 0.0;
+   double last_mz = 0.0;
+   bool first = true;
+
+   while( getline(ifile, line) ){
+
+      // skip header lines
+      if(line.size() == 0 || line[0] == '#') continue;
+
+      std::stringstream liness(line);
+      double h = 0.0;
+      double mx = 0.0;
+      double my = 0.0;
+      double mz = 0.0;
+
+      liness >> h >> mx >> my >> mz;
+
+      if( !first && (mz > 0.0) != (last_mz > 0.0) ){
+         coercive_fields.push_back(last_h - last_mz * (h - last_h) / (mz - last_mz));
+      }
+
+      last_h = h;
+      last_mz = mz;
+      first = false;
+
+   }
+
+   ifile.close();
+
+   // cleanup
+   vt::system("rm output log");
+
+   // return to parent directory
+   if( !vt::chdir(path) ) return false;
+
+   // loop starts at positive saturation, so switches at -hc and then +hc
+   if(coercive_fields.size() != 2){
+      std::cout << "FAIL | expected 2 magnetization reversals, obtained: " << coercive_fields.size() << std::endl;
+      return false;
+   }
+
+   const double ratio_down = -coercive_fields[0]/hc;
+   const double ratio_up = coercive_fields[1]/hc;
+
+   if(ratio_down >0.99999 && ratio_down < 1.00001 && ratio_up >0.99999 && ratio_up < 1.00001){
+      std::cout << "OK" << std::endl;
+      return true;
+   }
+   else{
+      std::cout << "FAIL | expected: " << -hc << "\t" << hc << "\t" << "\tobtained:  " << coercive_fields[0] << "\t" << coercive_fields[1] << std::endl;
+      return false;
+   }
+
+}
@@ -19,6 +19,7 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <vector>
 
 // module headers
 #include "internal.hpp"
@@ -32,5 +33,12 @@ namespace vt{
 // Test functions
 //------------------------------------------------------------------------------
 bool exchange_test(std::string dir, double result, std::string executable);
+bool exchange_dynamics_test(const std::string dir, const std::vector<double> m, double tolerance, const std::string executable);
 bool integrator_test(const std::string dir, double rx, double ry, double rz, const std::string executable);
+bool ensemble_test(const std::string dir, const std::vector<double> m, const std::string executable);
+bool hysteresis_test(const std::string dir, double hc, const std::string executable);
+bool histogram_test(const std::string dir, double temperature, double rm, double rcv, const std::string executable, const std::string reweighting);
+bool thermostat_test(const std::string dir, const std::vector<double> m, double tolerance, const std::string executable);
+bool dipole_field_test(const std::string dir, const std::string reference_input, double tolerance, const std::string executable);
+bool ewald_field_test(const std::string dir, const std::vector<double> L, double tolerance, const std::string executable);
 bool material_atoms_test(const std::string dir, int n1, int n2, int n3, int n4, const std::string executable);
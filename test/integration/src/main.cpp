@@ -28,6 +28,9 @@ int main(){
 
    std::string exe = path_string+"/vampire-serial 1>/dev/null";
 
+   // histogram reweighting tool built with the test suite
+   std::string reweighting = wd.string()+"/histogram_reweighting";
+
    //std::cout << exe << std::endl;
 
    //return 0;
@@ -40,9 +43,38 @@ int main(){
    // Exchange energy tests
    if( !exchange_test("crystals/sc" , -3.0e-17, exe ) ) fail += 1;
    if( !exchange_test("crystals/fcc", -2.4e-16, exe ) ) fail += 1;
+   if( !exchange_dynamics_test("exchange/isotropic-biquadratic", {-0.350979, 0.650765, -0.67329, 0.831546}, 1.0e-5, exe ) ) fail += 1;
+   if( !exchange_dynamics_test("exchange/isotropic-dmi-biquadratic", {-0.360898, 0.65694, -0.661954, 0.832555}, 1.0e-5, exe ) ) fail += 1;
+   if( !exchange_dynamics_test("exchange/vectorial-dmi-biquadratic", {0.165915, 0.0736788, -0.983384, 0.910055}, 1.0e-5, exe ) ) fail += 1;
+   if( !exchange_dynamics_test("exchange/tensorial-biquadratic", {-0.373606, 0.724964, -0.578658, 0.814467}, 1.0e-5, exe ) ) fail += 1;
 
    // Integrator tests
    if( !integrator_test("dynamics/heun",-0.106813,-0.337996,0.935067, exe ) ) fail += 1;
+   if( !integrator_test("dynamics/adaptive",-0.11287,-0.336631,0.934847, exe ) ) fail += 1;
+
+   // Hysteresis tests
+   if( !hysteresis_test("hysteresis/fire", 0.0949014, exe ) ) fail += 1;
+
+   // Monte Carlo tests
+   if( !ensemble_test("monte-carlo/ensemble", {0.940569, 0.873107, 0.795747, 0.695529}, exe ) ) fail += 1;
+   if( !ensemble_test("monte-carlo/parallel-tempering", {0.835227, 0.825836, 0.811703, 0.786901}, exe ) ) fail += 1;
+
+   // Statistics tests
+   if( !histogram_test("statistics/histogram", 1150.0, 0.8140512821, 1.918727633, exe, reweighting ) ) fail += 1;
+
+   // Quantum thermostat tests (vampire and tests compiled with FFTW)
+   #ifdef FFT
+   if( !integrator_test("quantum/zero-temperature",-0.156522,0.921709,0.354899, exe ) ) fail += 1;
+   if( !thermostat_test("quantum/interpolation", {0.607}, 0.03, exe ) ) fail += 1;
+   if( !thermostat_test("quantum/materials", {0.62, 0.62}, 0.04, exe ) ) fail += 1;
+   if( !thermostat_test("quantum/temperature-sweep", {0.093}, 0.03, exe ) ) fail += 1;
+   #endif
+
+   // Dipole field tests
+   if( !dipole_field_test("dipole/fast-multipole", "input-tensor", 0.02, exe ) ) fail += 1;
+   #ifdef FFT
+   if( !ewald_field_test("dipole/atomistic-pme", {14.16, 14.16, 10.62}, 0.005, exe ) ) fail += 1;
+   #endif
 
    // Structure tests
    if( !material_atoms_test("structure/core-shell", 3474, 485, 0, 0, exe ) ) fail += 1;
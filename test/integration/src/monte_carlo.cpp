@@ -0,0 +1,94 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <iomanip>
+
+// module headers
+#include "internal.hpp"
+
+//------------------------------------------------------------------------------
+// Test to verify consistent mean magnetization of all replicas of a Monte Carlo
+// ensemble. The output columns must be the temperature followed by the mean
+// magnetization length, and the final line of the output file of each replica
+// (output for replica 0, output-replica-NNN for replica NNN) is compared.
+//------------------------------------------------------------------------------
+bool ensemble_test(const std::string dir, const std::vector<double> m, const std::string executable){
+
+   // get root directory
+   std::string path = std::filesystem::current_path();
+
+   // fixed-width output for prettiness
+   std::stringstream test_name;
+   test_name << "Testing ensemble for " << dir;
+   std::cout << std::setw(60) << std::left << test_name.str() << " : " << std::flush;
+
+   // change directory
+   if( !vt::chdir(path+"/data/"+dir) ) return false;
+
+   // run vampire
+   int vmp = vt::system(executable);
+   if( vmp != 0){
+      std::cerr << "Error running vampire. Returning as failed test." << std::endl;
+      return false;
+   }
+
+   // read final temperature and magnetization of each replica
+   std::vector<double> temperature(m.size(), 0.0);
+   std::vector<double> magnetization(m.size(), 0.0);
+
+   for(size_t r = 0; r < m.size(); r++){
+
+      std::stringstream filename;
+      if(r == 0) filename << "output";
+      else filename << "output-replica-" << std::setw(3) << std::setfill('0') << r;
+
+      // open output file
+      std::ifstream ifile;
+      ifile.open(filename.str());
+
+      std::string line;
+      std::string last_line;
+      while( getline(ifile, line) ){
+         if(line.size() > 0 && line[0] != '#') last_line = line;
+      }
+
+      std::stringstream liness(last_line);
+      liness >> temperature[r] >> magnetization[r];
+
+   }
+
+   // cleanup
+   vt::system("rm output* log");
+
+   // return to parent directory
+   if( !vt::chdir(path) ) return false;
+
+   // now test values obtained from code
+   bool pass = true;
+   for(size_t r = 0; r < m.size(); r++){
+      const double ratio = magnetization[r]/m[r];
+      if(ratio <= 0.99999 || ratio >= 1.00001) pass = false;
+   }
+
+   if(pass){
+      std::cout << "OK" << std::endl;
+      return true;
+   }
+   else{
+      std::cout << "FAIL | ";
+      for(size_t r = 0; r < m.size(); r++){
+         std::cout << "T = " << temperature[r] << " expected: " << m[r] << " obtained: " << magnetization[r] << "\t";
+      }
+      std::cout << std::endl;
+      return false;
+   }
+
+}
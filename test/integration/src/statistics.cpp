@@ -0,0 +1,90 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+
+// module headers
+#include "internal.hpp"
+
+//------------------------------------------------------------------------------
+// Test to verify consistent energy-magnetization histograms and multiple
+// histogram reweighting. The histograms written by vampire are combined with
+// the histogram_reweighting tool and the mean magnetization length and
+// specific heat are compared at a temperature between the simulated ones.
+//------------------------------------------------------------------------------
+bool histogram_test(const std::string dir, double temperature, double rm, double rcv, const std::string executable, const std::string reweighting){
+
+   // get root directory
+   std::string path = std::filesystem::current_path();
+
+   // fixed-width output for prettiness
+   std::stringstream test_name;
+   test_name << "Testing histogram reweighting for " << dir;
+   std::cout << std::setw(60) << std::left << test_name.str() << " : " << std::flush;
+
+   // change directory
+   if( !vt::chdir(path+"/data/"+dir) ) return false;
+
+   // run vampire
+   int vmp = vt::system(executable);
+   if( vmp != 0){
+      std::cerr << "Error running vampire. Returning as failed test." << std::endl;
+      return false;
+   }
+
+   // reweight histograms to test temperature
+   std::stringstream command;
+   command << reweighting << " output-histograms " << temperature << " " << temperature << " 1 1>reweighted 2>/dev/null";
+   int rw = vt::system(command.str());
+   if( rw != 0){
+      std::cerr << "Error running histogram reweighting. Returning as failed test." << std::endl;
+      return false;
+   }
+
+   // open reweighted output file
+   std::ifstream ifile;
+   ifile.open("reweighted");
+
+   // read value after header
+   std::string line;
+   while( getline(ifile, line) ){
+      if(line.size() > 0 && line[0] != '#') break;
+   }
+
+   std::stringstream liness(line);
+   double t = 0.0;
+   double e = 0.0;
+   double cv = 0.0;
+   double m = 0.0;
+
+   liness >> t >> e >> cv >> m;
+
+   ifile.close();
+
+   // cleanup
+   vt::system("rm output output-histograms reweighted log");
+
+   // return to parent directory
+   if( !vt::chdir(path) ) return false;
+
+   // now test value obtained from code
+   const double ratiom = m/rm;
+   const double ratiocv = cv/rcv;
+
+   if(ratiom >0.99999 && ratiom < 1.00001 && ratiocv >0.99999 && ratiocv < 1.00001){
+      std::cout << "OK" << std::endl;
+      return true;
+   }
+   else{
+      std::cout << "FAIL | expected: " << rm << "\t" << rcv << "\t" << "\tobtained:  " << m << "\t" << cv << "\t" << "\t" << line << std::endl;
+      return false;
+   }
+
+}
@@ -0,0 +1,89 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <cmath>
+
+// module headers
+#include "internal.hpp"
+
+//------------------------------------------------------------------------------
+// Test to verify the equilibrium of the quantum thermostat. The noise is
+// seeded differently for every run, and so the mean magnetization length is
+// compared with an absolute tolerance chosen well outside the run to run
+// spread. The output columns must be the temperature followed by one or more
+// mean magnetization lengths, and the final line of the output file is used.
+//------------------------------------------------------------------------------
+bool thermostat_test(const std::string dir, const std::vector<double> m, double tolerance, const std::string executable){
+
+   // get root directory
+   std::string path = std::filesystem::current_path();
+
+   // fixed-width output for prettiness
+   std::stringstream test_name;
+   test_name << "Testing thermostat for " << dir;
+   std::cout << std::setw(60) << std::left << test_name.str() << " : " << std::flush;
+
+   // change directory
+   if( !vt::chdir(path+"/data/"+dir) ) return false;
+
+   // run vampire
+   int vmp = vt::system(executable);
+   if( vmp != 0){
+      std::cerr << "Error running vampire. Returning as failed test." << std::endl;
+      return false;
+   }
+
+   // open output file
+   std::ifstream ifile;
+   ifile.open("output");
+
+   // read final line
+   std::string line;
+   std::string last_line;
+   while( getline(ifile, line) ){
+      if(line.size() > 0 && line[0] != '#') last_line = line;
+   }
+
+   ifile.close();
+
+   std::stringstream liness(last_line);
+   double temperature = 0.0;
+   std::vector<double> magnetization(m.size(), 0.0);
+
+   liness >> temperature;
+   for(size_t i = 0; i < m.size(); i++) liness >> magnetization[i];
+
+   // cleanup
+   vt::system("rm output log");
+
+   // return to parent directory
+   if( !vt::chdir(path) ) return false;
+
+   // now test values obtained from code
+   bool pass = true;
+   for(size_t i = 0; i < m.size(); i++){
+      if(std::fabs(magnetization[i] - m[i]) > tolerance) pass = false;
+   }
+
+   if(pass){
+      std::cout << "OK" << std::endl;
+      return true;
+   }
+   else{
+      std::cout << "FAIL | expected: ";
+      for(size_t i = 0; i < m.size(); i++) std::cout << m[i] << "\t";
+      std::cout << "\tobtained:  ";
+      for(size_t i = 0; i < m.size(); i++) std::cout << magnetization[i] << "\t";
+      std::cout << "\t" << last_line << std::endl;
+      return false;
+   }
+
+}
@@ -0,0 +1,31 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <iostream>
+#include <cmath>
+#include <vector>
+
+// include header for test functions
+#include "atoms.hpp"
+#include "exchange.hpp"
+#include "exchange/internal.hpp"
+
+namespace ut{
+
+int floaterror(const double value, const double expected_value, const double precision, const std::string function);
+
+   namespace exchange{
+
+      int test_four_spin_energy(const bool verbose);
+
+   }
+
+}
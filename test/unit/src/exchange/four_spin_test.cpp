@@ -0,0 +1,118 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <iostream>
+#include <cmath>
+#include <vector>
+
+// include header for test functions
+#include "exchange_test.hpp"
+#include "material.hpp"
+#include "vio/internal.hpp"
+
+// definitions otherwise provided by the create and main modules
+namespace cs{
+   double system_dimensions[3] = {0.0, 0.0, 0.0};
+}
+
+namespace mp{
+   std::vector <materials_t> material;
+}
+
+namespace ut{
+
+   namespace exchange{
+
+      //------------------------------------------------------------------------
+      // Function to add a quartet to the four spin lists in the same order as
+      // exchange::internal::initialize_four_spin_exchange()
+      //------------------------------------------------------------------------
+      void add_quartet(const int i, const int a, const int b, const int c, const double J){
+
+         const int quartet[4] = {i, a, b, c};
+
+         for(int p = 0; p < 4; p++){
+            ::exchange::internal::four_spin_neighbour_list_array_i.push_back(quartet[(p+0)%4]);
+            ::exchange::internal::four_spin_neighbour_list_array_j.push_back(quartet[(p+1)%4]);
+            ::exchange::internal::four_spin_neighbour_list_array_k.push_back(quartet[(p+2)%4]);
+            ::exchange::internal::four_spin_neighbour_list_array_l.push_back(quartet[(p+3)%4]);
+            ::exchange::internal::four_spin_exchange_list.push_back(J);
+         }
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Test that the single spin four spin energy used by Monte Carlo gives
+      // the same energy change for a trial move as the total four spin energy
+      //------------------------------------------------------------------------
+      int test_four_spin_energy(const bool verbose){
+
+         int ec = 0; // error count increment
+
+         // allow log messages without opening a log file
+         vout::zLogInitialised = true;
+
+         // five atoms in two quartets sharing three atoms
+         atoms::num_atoms = 5;
+         atoms::x_spin_array = {  0.6,  0.0, -0.48,  0.0,  0.8 };
+         atoms::y_spin_array = {  0.0,  0.6,  0.6,  -0.8,  0.0 };
+         atoms::z_spin_array = {  0.8,  0.8,  0.64,  0.6,  0.6 };
+
+         ::exchange::internal::enable_fourspin = true;
+         add_quartet(0, 1, 2, 3, 1.3);
+         add_quartet(0, 1, 2, 4, 0.7);
+         ::exchange::internal::sort_four_spin_interactions();
+
+         // trial spin direction
+         const double tx = -0.36;
+         const double ty =  0.48;
+         const double tz =  0.8;
+
+         for(int atom = 0; atom < atoms::num_atoms; atom++){
+
+            const double sx = atoms::x_spin_array[atom];
+            const double sy = atoms::y_spin_array[atom];
+            const double sz = atoms::z_spin_array[atom];
+
+            // energy difference as calculated in Monte Carlo
+            const double Eold = ::exchange::single_spin_four_spin_energy(atom, sx, sy, sz);
+            const double Enew = ::exchange::single_spin_four_spin_energy(atom, tx, ty, tz);
+
+            // total energy before and after trial move
+            const double Ebefore = ::exchange::four_spin_energy();
+            atoms::x_spin_array[atom] = tx;
+            atoms::y_spin_array[atom] = ty;
+            atoms::z_spin_array[atom] = tz;
+            const double Eafter = ::exchange::four_spin_energy();
+
+            // restore spin
+            atoms::x_spin_array[atom] = sx;
+            atoms::y_spin_array[atom] = sy;
+            atoms::z_spin_array[atom] = sz;
+
+            ec += ut::floaterror(Enew - Eold, Eafter - Ebefore, 1e-12, "exchange::single_spin_four_spin_energy");
+
+         }
+
+         if(verbose){
+            if(ec == 0) std::cout << "   four spin energy   : PASS" << std::endl;
+            else        std::cout << "   four spin energy   : FAIL" << std::endl;
+         }
+
+         return ec;
+
+      }
+
+   }
+
+}
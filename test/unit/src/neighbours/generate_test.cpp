@@ -0,0 +1,222 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+// include header for test functions
+#include "neighbours_test.hpp"
+
+// definitions otherwise provided by the create module
+namespace cs{
+   bool pbc[3] = {false, false, false};
+}
+
+namespace ut{
+
+   namespace neighbours{
+
+      //------------------------------------------------------------------------
+      // Reference neighbour list generator, as list_t::generate before the flat
+      // cell index: nested supercell array and a single serial loop over cells
+      // and template interactions
+      //------------------------------------------------------------------------
+      void reference_generate(std::vector<cs::catom_t>& atom_array,
+                              unitcell::exchange_template_t& exchange,
+                              const unsigned int num_atoms_in_unit_cell,
+                              const double ucdx, const double ucdy, const double ucdz,
+                              std::vector<std::vector<::neighbours::neighbour_t> >& list){
+
+         const int num_atoms = atom_array.size();
+         list.assign(num_atoms, std::vector<::neighbours::neighbour_t>());
+
+         // find supercell range of atoms
+         int64_t min[3] = {1000000000000, 1000000000000, 1000000000000};
+         int64_t max[3] = {0, 0, 0};
+         for(int atom = 0; atom < num_atoms; atom++){
+            const int64_t c[3] = { atom_array[atom].scx, atom_array[atom].scy, atom_array[atom].scz };
+            for(int i = 0; i < 3; i++){
+               if( c[i] < min[i] ) min[i] = c[i];
+               if( c[i] > max[i] ) max[i] = c[i];
+            }
+         }
+         const int64_t d[3] = { max[0] - min[0] + 1, max[1] - min[1] + 1, max[2] - min[2] + 1 };
+
+         // nested supercell array [x][y][z][uc_id]
+         std::vector<std::vector<std::vector<std::vector<int> > > > supercell_array(d[0],
+            std::vector<std::vector<std::vector<int> > >(d[1], std::vector<std::vector<int> >(d[2], std::vector<int>(num_atoms_in_unit_cell, -1))));
+
+         for(int atom = 0; atom < num_atoms; atom++){
+            supercell_array[atom_array[atom].scx - min[0]][atom_array[atom].scy - min[1]][atom_array[atom].scz - min[2]][atom_array[atom].uc_id] = atom;
+         }
+
+         for(int x = 0; x < d[0]; x++){
+            for(int y = 0; y < d[1]; y++){
+               for(int z = 0; z < d[2]; z++){
+                  for(unsigned int i = 0; i < exchange.interaction.size(); i++){
+
+                     const int atom  = exchange.interaction[i].i;
+                     const int natom = exchange.interaction[i].j;
+
+                     int nx = exchange.interaction[i].dx + x;
+                     int ny = exchange.interaction[i].dy + y;
+                     int nz = exchange.interaction[i].dz + z;
+
+                     // wrap around for periodic boundaries
+                     double vx = 0.0;
+                     double vy = 0.0;
+                     double vz = 0.0;
+                     if(cs::pbc[0]){
+                        if(nx >= int(d[0])){ nx -= d[0]; vx += d[0]*ucdx; }
+                        else if(nx < 0){ nx += d[0]; vx -= d[0]*ucdx; }
+                     }
+                     if(cs::pbc[1]){
+                        if(ny >= int(d[1])){ ny -= d[1]; vy += d[1]*ucdy; }
+                        else if(ny < 0){ ny += d[1]; vy -= d[1]*ucdy; }
+                     }
+                     if(cs::pbc[2]){
+                        if(nz >= int(d[2])){ nz -= d[2]; vz += d[2]*ucdz; }
+                        else if(nz < 0){ nz += d[2]; vz -= d[2]*ucdz; }
+                     }
+
+                     if(nx < 0 || nx >= d[0] || ny < 0 || ny >= d[1] || nz < 0 || nz >= d[2]) continue;
+
+                     const int atomi = supercell_array[x][y][z][atom];
+                     const int atomj = supercell_array[nx][ny][nz][natom];
+                     if(atomi == -1 || atomj == -1) continue;
+
+                     ::neighbours::neighbour_t nt;
+                     nt.nn = atomj;
+                     nt.i = i;
+                     nt.vx = vx + (atom_array[atomj].x - atom_array[atomi].x);
+                     nt.vy = vy + (atom_array[atomj].y - atom_array[atomi].y);
+                     nt.vz = vz + (atom_array[atomj].z - atom_array[atomi].z);
+                     list[atomi].push_back(nt);
+
+                  }
+               }
+            }
+         }
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Test that list_t::generate gives identical neighbour lists (neighbours,
+      // interaction types, vectors and order) to the reference generator for an
+      // fcc system with vacancies and shuffled atoms, for open, mixed and
+      // periodic boundaries
+      //------------------------------------------------------------------------
+      int test_generate(const bool verbose){
+
+         int ec = 0; // error count increment
+
+         // fcc unit cell
+         const double a = 3.54;
+         const unsigned int num_uc_atoms = 4;
+         const double uc[4][3] = { {0.0, 0.0, 0.0}, {0.5, 0.5, 0.0}, {0.5, 0.0, 0.5}, {0.0, 0.5, 0.5} };
+
+         // exchange template for first and second nearest neighbours
+         unitcell::exchange_template_t exchange;
+         for(unsigned int i = 0; i < num_uc_atoms; i++){
+            for(int dx = -1; dx <= 1; dx++){
+               for(int dy = -1; dy <= 1; dy++){
+                  for(int dz = -1; dz <= 1; dz++){
+                     for(unsigned int j = 0; j < num_uc_atoms; j++){
+                        const double rx = uc[j][0] + dx - uc[i][0];
+                        const double ry = uc[j][1] + dy - uc[i][1];
+                        const double rz = uc[j][2] + dz - uc[i][2];
+                        const double r = sqrt(rx*rx + ry*ry + rz*rz);
+                        if(r < 1.0e-6 || r > 1.01) continue;
+                        unitcell::interaction_t tmp;
+                        tmp.i = i;
+                        tmp.j = j;
+                        tmp.dx = dx;
+                        tmp.dy = dy;
+                        tmp.dz = dz;
+                        tmp.rij = r;
+                        exchange.interaction.push_back(tmp);
+                     }
+                  }
+               }
+            }
+         }
+
+         // generate atoms in offset supercells with some vacancies
+         std::mt19937 generator(12345);
+         std::uniform_real_distribution<double> uniform(0.0, 1.0);
+         std::vector<cs::catom_t> atoms;
+         for(int x = 2; x < 7; x++){
+            for(int y = 0; y < 4; y++){
+               for(int z = 1; z < 4; z++){
+                  for(unsigned int s = 0; s < num_uc_atoms; s++){
+                     if(uniform(generator) < 0.1) continue;
+                     cs::catom_t atom;
+                     atom.x = (x + uc[s][0])*a;
+                     atom.y = (y + uc[s][1])*a;
+                     atom.z = (z + uc[s][2])*a;
+                     atom.scx = x;
+                     atom.scy = y;
+                     atom.scz = z;
+                     atom.uc_id = s;
+                     atoms.push_back(atom);
+                  }
+               }
+            }
+         }
+         std::shuffle(atoms.begin(), atoms.end(), generator);
+
+         const bool boundaries[3][3] = { {false, false, false}, {true, true, false}, {true, true, true} };
+
+         for(int b = 0; b < 3; b++){
+
+            for(int i = 0; i < 3; i++) cs::pbc[i] = boundaries[b][i];
+
+            std::vector<std::vector<::neighbours::neighbour_t> > reference;
+            reference_generate(atoms, exchange, num_uc_atoms, a, a, a, reference);
+
+            ::neighbours::list_t bilinear;
+            bilinear.generate(atoms, exchange, num_uc_atoms, a, a, a);
+
+            int errors = 0;
+            if(bilinear.list.size() != reference.size()) errors++;
+            for(size_t atom = 0; atom < reference.size() && errors == 0; atom++){
+               if(bilinear.list[atom].size() != reference[atom].size()){
+                  errors++;
+                  break;
+               }
+               for(size_t nn = 0; nn < reference[atom].size(); nn++){
+                  const ::neighbours::neighbour_t& n = bilinear.list[atom][nn];
+                  const ::neighbours::neighbour_t& r = reference[atom][nn];
+                  if(n.nn != r.nn || n.i != r.i || n.vx != r.vx || n.vy != r.vy || n.vz != r.vz) errors++;
+               }
+            }
+
+            if(errors > 0) std::cerr << "Error in neighbours::list_t::generate for periodic boundaries " << cs::pbc[0] << cs::pbc[1] << cs::pbc[2] << std::endl;
+            ec += errors;
+
+         }
+
+         if(verbose){
+            if(ec == 0) std::cout << "   neighbour list     : PASS" << std::endl;
+            else        std::cout << "   neighbour list     : FAIL" << std::endl;
+         }
+
+         return ec;
+
+      }
+
+   }
+
+}
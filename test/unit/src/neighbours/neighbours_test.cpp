@@ -0,0 +1,38 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <iostream>
+
+// include header for test functions
+#include "neighbours_test.hpp"
+
+namespace ut{
+//------------------------------------------------------------------------------
+// Function to test neighbours module functions
+//------------------------------------------------------------------------------
+int neighbours_tests(const bool verbose){
+
+   if(verbose) std::cout << "Testing neighbours module" << std::endl;
+
+   int error_count = 0;
+
+   error_count += ut::neighbours::test_generate(verbose);
+
+   if(verbose) std::cout <<          "================================" << std::endl;
+   if(error_count == 0) std::cout << " neighbours          : PASS " << std::endl;
+   else std::cout <<                 " neighbours          : FAIL " << error_count << std::endl;
+   if(verbose) std::cout <<          "================================" << std::endl;
+
+   return error_count;
+
+}
+
+}
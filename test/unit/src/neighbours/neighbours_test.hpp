@@ -0,0 +1,28 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <iostream>
+#include <vector>
+
+// include header for test functions
+#include "create_atoms_class.hpp"
+#include "neighbours.hpp"
+#include "unitcell.hpp"
+
+namespace ut{
+
+   namespace neighbours{
+
+      int test_generate(const bool verbose);
+
+   }
+
+}
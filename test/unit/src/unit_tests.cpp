@@ -42,6 +42,8 @@ int main(int argc, char* argv[]){
    std::cout << "--------------------------------------------------" << std::endl;
 
    if( module.utility || all ) error_count += ut::utility_tests(verbose);
+   if( module.exchange || all ) error_count += ut::exchange_tests(verbose);
+   if( module.neighbours || all ) error_count += ut::neighbours_tests(verbose);
 
 
    // Summary
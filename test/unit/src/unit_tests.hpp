@@ -20,9 +20,13 @@ namespace ut{
    // simple struct specifying modules to test
    struct module_t {
       bool utility = false;
+      bool exchange = false;
+      bool neighbours = false;
    };
 
    // module level functions
    int utility_tests(const bool verbose);
+   int exchange_tests(const bool verbose);
+   int neighbours_tests(const bool verbose);
 
 }
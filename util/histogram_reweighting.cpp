@@ -0,0 +1,309 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+//   Simple code to combine the energy-magnetisation histograms written by
+//   vampire with output:energy-magnetisation-histograms using the multiple
+//   histogram (Ferrenberg-Swendsen / WHAM) method, and to interpolate the
+//   thermodynamic averages between the simulated temperatures. Compile with
+//
+//      g++ -O3 -std=c++11 histogram_reweighting.cpp -o histogram_reweighting
+//
+//   and run as
+//
+//      ./histogram_reweighting output-histograms Tmin Tmax dT > reweighted
+//
+//   The density of states is estimated from all histograms by iterating the
+//   self consistent equations for the free energies f_k of each simulated
+//   temperature T_k with N_k samples
+//
+//      exp(-f_k) = sum_i c_i exp(-E_i/kB T_k) / sum_j N_j exp(f_j - E_i/kB T_j)
+//
+//   where the sum i runs over all non-empty bins with count c_i and bin
+//   centre energy E_i. Averages at temperature T are then reweighted from the
+//   same bins. All histograms must be collected at the same applied field and
+//   should overlap in energy between neighbouring temperatures. Output columns
+//   match the vampire statistics of the same name:
+//
+//      T  mean-total-energy(J)  mean-specific-heat  mean-magnetisation-length
+//      mean-susceptibility(|m|)  binder-cumulant
+//
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace reweighting{
+
+   const double kB  = 1.3806503e-23;  // Boltzmann constant (J/K)
+   const double muB = 9.27400915e-24; // Bohr magneton (J/T)
+
+   //---------------------------------------------------------------------------
+   // Histogram of a single simulated temperature
+   //---------------------------------------------------------------------------
+   class histogram_t{
+   public:
+      double temperature;    // simulated temperature (K)
+      double field;          // applied field (T)
+      double num_samples;    // total number of samples
+      std::vector<double> energy;        // bin centre energy (J)
+      std::vector<double> magnetisation; // bin centre reduced magnetisation length
+      std::vector<double> count;         // number of samples in bin
+      std::vector<double> marginal_energy; // energy of non-empty energy bins (J)
+      std::vector<double> marginal_count;  // number of samples in energy bin
+   };
+
+   //---------------------------------------------------------------------------
+   // Function to calculate log(sum(exp(x))) without overflow
+   //---------------------------------------------------------------------------
+   double log_sum_exp(const std::vector<double>& x){
+      const double max = *std::max_element(x.begin(), x.end());
+      if(max == -std::numeric_limits<double>::infinity()) return max;
+      double sum = 0.0;
+      for(size_t i = 0; i < x.size(); i++) sum += exp(x[i] - max);
+      return max + log(sum);
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to read all histograms from file
+   //---------------------------------------------------------------------------
+   void read_histograms(const std::string filename, std::vector<histogram_t>& histograms, double& num_spins, double& saturation){
+
+      std::ifstream ifile(filename.c_str());
+      if(!ifile.is_open()){
+         std::cerr << "Error - unable to open histogram file " << filename << std::endl;
+         exit(EXIT_FAILURE);
+      }
+
+      std::string line;
+      while(std::getline(ifile, line)){
+
+         std::istringstream ss(line);
+         std::string tag;
+         ss >> tag;
+         if(tag != "histogram") continue;
+
+         histogram_t h;
+         double min_energy, dE, min_m, dm;
+         int num_E_bins, num_m_bins;
+         uint64_t num_bins;
+         ss >> h.temperature >> h.field >> num_spins >> saturation >> h.num_samples
+            >> min_energy >> dE >> num_E_bins >> min_m >> dm >> num_m_bins >> num_bins;
+         if(ss.fail()){
+            std::cerr << "Error - malformed histogram header in file " << filename << ": " << line << std::endl;
+            exit(EXIT_FAILURE);
+         }
+
+         // bins are ordered by energy bin, so the energy marginal is accumulated in place
+         int last_eb = -1;
+         for(uint64_t b = 0; b < num_bins; b++){
+            int eb, mb;
+            double count;
+            ifile >> eb >> mb >> count;
+            const double energy = min_energy + (double(eb) + 0.5) * dE;
+            h.energy.push_back(energy);
+            h.magnetisation.push_back(min_m + (double(mb) + 0.5) * dm);
+            h.count.push_back(count);
+            if(eb != last_eb){
+               h.marginal_energy.push_back(energy);
+               h.marginal_count.push_back(0.0);
+               last_eb = eb;
+            }
+            h.marginal_count.back() += count;
+         }
+         if(ifile.fail()){
+            std::cerr << "Error - unexpected end of histogram file " << filename << std::endl;
+            exit(EXIT_FAILURE);
+         }
+
+         if(h.temperature <= 0.0){
+            std::cerr << "Warning - ignoring histogram at zero temperature" << std::endl;
+            continue;
+         }
+
+         // blocks of a few samples are typically from initial statistics updates before equilibration
+         if(h.num_samples < 10){
+            std::cerr << "Warning - ignoring histogram at " << h.temperature << " K with only " << h.num_samples << " samples" << std::endl;
+            continue;
+         }
+
+         histograms.push_back(h);
+
+      }
+
+      return;
+
+   }
+
+} // end of namespace reweighting
+
+int main(int argc, char* argv[]){
+
+   namespace rw = reweighting;
+
+   if(argc != 5){
+      std::cerr << "Usage: " << argv[0] << " histogram_file Tmin Tmax dT" << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   const std::string filename = argv[1];
+   const double Tmin = atof(argv[2]);
+   const double Tmax = atof(argv[3]);
+   const double dT = atof(argv[4]);
+   if(Tmin <= 0.0 || Tmax < Tmin || dT <= 0.0){
+      std::cerr << "Error - temperatures must satisfy 0 < Tmin <= Tmax and dT > 0" << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   std::vector<rw::histogram_t> histograms;
+   double num_spins = 1.0;
+   double saturation = 1.0;
+   rw::read_histograms(filename, histograms, num_spins, saturation);
+
+   const int K = histograms.size();
+   if(K == 0){
+      std::cerr << "Error - no histograms found in file " << filename << std::endl;
+      return EXIT_FAILURE;
+   }
+   for(int k = 1; k < K; k++){
+      if(histograms[k].field != histograms[0].field){
+         std::cerr << "Error - histograms must all be collected at the same applied field" << std::endl;
+         return EXIT_FAILURE;
+      }
+   }
+
+   // flatten energy marginals of all histograms for the free energy iteration, and
+   // all bins for the averages
+   std::vector<double> E, log_count, m, E_bin, log_count_bin;
+   std::vector<double> beta(K), log_N(K);
+   double sim_Tmin = histograms[0].temperature;
+   double sim_Tmax = histograms[0].temperature;
+   for(int k = 0; k < K; k++){
+      const rw::histogram_t& h = histograms[k];
+      beta[k] = 1.0 / (rw::kB * h.temperature);
+      log_N[k] = log(h.num_samples);
+      sim_Tmin = std::min(sim_Tmin, h.temperature);
+      sim_Tmax = std::max(sim_Tmax, h.temperature);
+      for(size_t i = 0; i < h.marginal_count.size(); i++){
+         E.push_back(h.marginal_energy[i]);
+         log_count.push_back(log(h.marginal_count[i]));
+      }
+      for(size_t i = 0; i < h.count.size(); i++){
+         E_bin.push_back(h.energy[i]);
+         m.push_back(h.magnetisation[i]);
+         log_count_bin.push_back(log(h.count[i]));
+      }
+   }
+   const int num_energies = E.size();
+   const int num_bins = E_bin.size();
+
+   // energy shift to keep exponents of order of the fluctuations
+   double E0 = 0.0;
+   for(int i = 0; i < num_energies; i++) E0 += E[i];
+   E0 /= double(num_energies);
+   for(int i = 0; i < num_energies; i++) E[i] -= E0;
+   for(int i = 0; i < num_bins; i++) E_bin[i] -= E0;
+
+   // initial free energies f_k = -log(Z_k) from single histogram reweighting between successive histograms
+   std::vector<double> f(K, 0.0);
+   for(int k = 1; k < K; k++){
+      const rw::histogram_t& h = histograms[k-1];
+      std::vector<double> terms(h.marginal_count.size());
+      for(size_t i = 0; i < terms.size(); i++) terms[i] = log(h.marginal_count[i]) - (beta[k] - beta[k-1]) * (h.marginal_energy[i] - E0);
+      f[k] = f[k-1] - (rw::log_sum_exp(terms) - log_N[k-1]);
+   }
+
+   // iterate self consistent equations for free energies
+   std::vector<double> log_D(num_energies);
+   std::vector<double> terms_K(K), terms_energies(num_energies);
+   const int max_iterations = 100000;
+   const double tolerance = 1.0e-8;
+   int iteration = 0;
+   double change = 1.0;
+   for(iteration = 0; iteration < max_iterations && change > tolerance; iteration++){
+
+      // denominator sum_j N_j exp(f_j - beta_j E_i)
+      for(int i = 0; i < num_energies; i++){
+         for(int j = 0; j < K; j++) terms_K[j] = log_N[j] + f[j] - beta[j] * E[i];
+         log_D[i] = rw::log_sum_exp(terms_K);
+      }
+
+      // new free energies, fixed relative to first histogram
+      change = 0.0;
+      std::vector<double> new_f(K);
+      for(int k = 0; k < K; k++){
+         for(int i = 0; i < num_energies; i++) terms_energies[i] = log_count[i] - beta[k] * E[i] - log_D[i];
+         new_f[k] = -rw::log_sum_exp(terms_energies);
+      }
+      for(int k = K-1; k >= 0; k--){
+         new_f[k] -= new_f[0];
+         change = std::max(change, std::fabs(new_f[k] - f[k]));
+         f[k] = new_f[k];
+      }
+
+   }
+
+   std::cerr << "Combined " << K << " histograms with " << num_bins << " bins in " << iteration << " iterations";
+   if(change > tolerance) std::cerr << " (not converged, change " << change << ")";
+   std::cerr << std::endl;
+
+   // denominator for all bins
+   std::vector<double> log_D_bin(num_bins), terms_bins(num_bins);
+   for(int i = 0; i < num_bins; i++){
+      for(int j = 0; j < K; j++) terms_K[j] = log_N[j] + f[j] - beta[j] * E_bin[i];
+      log_D_bin[i] = rw::log_sum_exp(terms_K);
+   }
+
+   std::cout << "# T\tmean-total-energy\tmean-specific-heat\tmean-magnetisation-length\tmean-susceptibility\tbinder-cumulant" << std::endl;
+   std::cout.precision(10);
+
+   // reweight averages to each requested temperature
+   const int num_temperatures = int((Tmax - Tmin) / dT + 1.0e-9) + 1;
+   for(int t = 0; t < num_temperatures; t++){
+
+      const double T = Tmin + double(t) * dT;
+      const double b = 1.0 / (rw::kB * T);
+
+      if(T < sim_Tmin || T > sim_Tmax){
+         std::cerr << "Warning - temperature " << T << " K is outside simulated range and extrapolated" << std::endl;
+      }
+
+      for(int i = 0; i < num_bins; i++) terms_bins[i] = log_count_bin[i] - b * E_bin[i] - log_D_bin[i];
+      const double log_Z = rw::log_sum_exp(terms_bins);
+
+      double mean_E = 0.0, mean_E2 = 0.0, mean_m = 0.0, mean_m2 = 0.0, mean_m4 = 0.0;
+      for(int i = 0; i < num_bins; i++){
+         const double w = exp(terms_bins[i] - log_Z);
+         const double m2 = m[i] * m[i];
+         mean_E  += w * E_bin[i];
+         mean_E2 += w * E_bin[i] * E_bin[i];
+         mean_m  += w * m[i];
+         mean_m2 += w * m2;
+         mean_m4 += w * m2 * m2;
+      }
+
+      // normalisation matches output of vampire statistics
+      const double specific_heat = (mean_E2 - mean_E * mean_E) / (rw::muB * rw::kB * T * T * num_spins);
+      const double susceptibility = rw::muB * saturation * (mean_m2 - mean_m * mean_m) / (rw::kB * T);
+      const double binder_cumulant = 1.0 - mean_m4 / (3.0 * mean_m2 * mean_m2);
+
+      std::cout << T << "\t" << mean_E + E0 << "\t" << specific_heat << "\t" << mean_m << "\t" << susceptibility << "\t" << binder_cumulant << std::endl;
+
+   }
+
+   return EXIT_SUCCESS;
+
+}
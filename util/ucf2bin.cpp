@@ -0,0 +1,99 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+//   Simple code to convert a text vampire unit cell file (ucf) to the compact
+//   binary unit cell format, which vampire reads directly with the same
+//   material:unit-cell-file keyword. The file is parsed and packed with the
+//   unit cell module code used by vampire (src/unitcell/parse.cpp and
+//   src/unitcell/binary.cpp), so the format is described there. Compile with
+//
+//      make ucf2bin
+//
+//   in the vampire root directory and run as
+//
+//      ./util/ucf2bin file.ucf file.ucb
+//
+//   Any errors in the unit cell file are reported as in vampire, with details
+//   in the log file.
+//
+//------------------------------------------------------------------------------
+
+// C++ standard library headers
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+// Vampire headers
+#include "material.hpp"
+#include "unitcell.hpp"
+#include "vio.hpp"
+
+// unitcell module headers
+#include "../src/unitcell/internal.hpp"
+
+// definitions otherwise provided by the main program
+namespace mp{
+   int num_materials = 1;
+}
+
+//------------------------------------------------------------------------------
+// Convert text vampire ucf file to binary unit cell file
+//------------------------------------------------------------------------------
+int main(int argc, char* argv[]){
+
+   if(argc < 3){
+      std::cerr << "Error - usage: ucf2bin <input ucf file> <output binary file>" << std::endl;
+      exit(EXIT_FAILURE);
+   }
+
+   const std::string filename(argv[1]);
+   const std::string outfilename(argv[2]);
+
+   // initialise log file used by the unit cell module for error reporting
+   vout::zLogTsInit(std::string(argv[0]));
+
+   // load file contents in a single read
+   std::ifstream file(filename.c_str(), std::ios::binary);
+   if(!file.is_open()){
+      std::cerr << "Error opening input file \"" << filename << "\" : File does not exist or cannot be opened! Exiting!" << std::endl;
+      exit(EXIT_FAILURE);
+   }
+   const std::string contents( (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>() );
+   file.close();
+
+   // material ids are checked against the material file when vampire reads
+   // the binary file, so accept any material here
+   mp::num_materials = std::numeric_limits<int>::max();
+
+   // parse and pack unit cell
+   unitcell::unit_cell_t unit_cell;
+   unitcell::internal::parse_unit_cell(unit_cell, contents, filename);
+
+   std::vector<char> buffer;
+   unitcell::internal::pack_unit_cell(unit_cell, buffer);
+
+   // write binary unit cell file
+   std::ofstream ofile(outfilename.c_str(), std::ios::binary);
+   if(!ofile.is_open()){
+      std::cerr << "Error opening output file \"" << outfilename << "\" for writing! Exiting!" << std::endl;
+      exit(EXIT_FAILURE);
+   }
+   ofile.write(buffer.data(), buffer.size());
+   ofile.close();
+
+   std::cout << "\nWritten binary unit cell file " << outfilename << " with " << unit_cell.atom.size() << " atoms, "
+             << unit_cell.bilinear.interaction.size() << " bilinear and " << unit_cell.biquadratic.interaction.size()
+             << " biquadratic interactions" << std::endl;
+
+   return 0;
+
+}
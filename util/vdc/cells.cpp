@@ -75,12 +75,9 @@ namespace vdc{
 
       unsigned int num_cells[3] = { nx, ny, nz };
 
-      // allocate storage for cell coordinates and cell magnetization
+      // allocate storage for cell coordinates
       vdc::total_cells = num_cells[0] * num_cells[1] * num_cells[2];
 
-      // total number of materials + 1
-      const unsigned int tmid = 1+vdc::materials.size();
-
       // arrays to store initial cell corrdinates
       std::vector<double> init_cell_coords(3*total_cells, 0.0);
 
@@ -198,33 +195,26 @@ namespace vdc{
       // Now redfine total number of atoms
       vdc::total_cells = num_cells_with_atoms;
 
-      vdc::cell_magnetization.resize(vdc::total_cells);
-      for(unsigned int i = 0; i < vdc::total_cells; i++){
-         vdc::cell_magnetization[i].resize(tmid);
-         // stored as mx, my, mz, |m| sets
-         for(unsigned int j=0; j< tmid; j++) vdc::cell_magnetization[i][j].resize(4,0.0); // initialise cell magnetization to zero
-      }
-
       if(vdc::verbose) std::cout << " done!" << std::endl;
 
       return;
 
    }
 
-   void output_cell_file(unsigned int spin_file_id){
+   void output_cell_file(frame_t& frame){
 
       // output informative message to user
-      if(vdc::verbose) std::cout << "   Calculating cell magnetization for " << vdc::cell_magnetization.size() << " cells" << std::endl;
+      if(vdc::verbose) frame.log << "   Calculating cell magnetization for " << vdc::total_cells << " cells" << std::endl;
 
       // total number of materials + 1
       const unsigned int tmid = 1+vdc::materials.size();
 
-      // initialise magnetization to zero
+      // allocate and initialise magnetization to zero, stored as mx, my, mz, |m| sets
+      frame.cell_magnetization.resize(vdc::total_cells);
       for(unsigned int cell = 0; cell < vdc::total_cells; cell++){
+         frame.cell_magnetization[cell].resize(tmid);
          for(unsigned int m = 0; m < tmid; m++){
-            for(int e = 0; e < 4; e++){
-               vdc::cell_magnetization[cell][m][e] = 0.0;
-            }
+            frame.cell_magnetization[cell][m].assign(4, 0.0);
          }
       }
 
@@ -237,46 +227,46 @@ namespace vdc{
          const unsigned int mat = vdc::type[atom];
          const double mu = vdc::materials[mat].moment;
 
-         const double sx = vdc::spins[3*atom+0];
-         const double sy = vdc::spins[3*atom+1];
-         const double sz = vdc::spins[3*atom+2];
+         const double sx = frame.spins[3*atom+0];
+         const double sy = frame.spins[3*atom+1];
+         const double sz = frame.spins[3*atom+2];
 
          const unsigned int cell_id = atom_cell_id[atom];
 
-         vdc::cell_magnetization[cell_id][mat][0] += sx*mu;
-         vdc::cell_magnetization[cell_id][mat][1] += sy*mu;
-         vdc::cell_magnetization[cell_id][mat][2] += sz*mu;
-         vdc::cell_magnetization[cell_id][mat][3] += mu;
+         frame.cell_magnetization[cell_id][mat][0] += sx*mu;
+         frame.cell_magnetization[cell_id][mat][1] += sy*mu;
+         frame.cell_magnetization[cell_id][mat][2] += sz*mu;
+         frame.cell_magnetization[cell_id][mat][3] += mu;
 
          // total magnetization in last set
-         vdc::cell_magnetization[cell_id][tmid-1][0] += sx*mu;
-         vdc::cell_magnetization[cell_id][tmid-1][1] += sy*mu;
-         vdc::cell_magnetization[cell_id][tmid-1][2] += sz*mu;
-         vdc::cell_magnetization[cell_id][tmid-1][3] += mu;
+         frame.cell_magnetization[cell_id][tmid-1][0] += sx*mu;
+         frame.cell_magnetization[cell_id][tmid-1][1] += sy*mu;
+         frame.cell_magnetization[cell_id][tmid-1][2] += sz*mu;
+         frame.cell_magnetization[cell_id][tmid-1][3] += mu;
 
       }
 
       // normalise magnetizations
       for(unsigned int cell = 0; cell < vdc::total_cells; cell++){
          for(unsigned int m = 0; m < tmid; m++){
-            const double mx = vdc::cell_magnetization[cell][m][0];
-            const double my = vdc::cell_magnetization[cell][m][1];
-            const double mz = vdc::cell_magnetization[cell][m][2];
-            const double mm = vdc::cell_magnetization[cell][m][3];
+            const double mx = frame.cell_magnetization[cell][m][0];
+            const double my = frame.cell_magnetization[cell][m][1];
+            const double mz = frame.cell_magnetization[cell][m][2];
+            const double mm = frame.cell_magnetization[cell][m][3];
 
             const double norm = sqrt(mx*mx + my*my + mz*mz);
 
             // calculate inverse norm if norm is greater than 1e-9, otherwise zero
             const double inorm = norm < 1.0e-9 ? 0.0 : 1.0/norm;
 
-            vdc::cell_magnetization[cell][m][0] = mx*inorm;
-            vdc::cell_magnetization[cell][m][1] = my*inorm;
-            vdc::cell_magnetization[cell][m][2] = mz*inorm;
+            frame.cell_magnetization[cell][m][0] = mx*inorm;
+            frame.cell_magnetization[cell][m][1] = my*inorm;
+            frame.cell_magnetization[cell][m][2] = mz*inorm;
 
             // set magnetization of final cell to actual magnetization in mu_B
-            if(m == tmid -1) vdc::cell_magnetization[cell][m][3] = norm; // mu_B
+            if(m == tmid -1) frame.cell_magnetization[cell][m][3] = norm; // mu_B
             // Otherwise normalise for material magnetization
-            else mm < 1.0e-9 ? 0.0 : vdc::cell_magnetization[cell][m][3] = norm/mm; // m/m_s
+            else mm < 1.0e-9 ? 0.0 : frame.cell_magnetization[cell][m][3] = norm/mm; // m/m_s
 
          }
       }
@@ -290,12 +280,12 @@ namespace vdc{
       // Determine cell file name
       std::stringstream cell_file_sstr;
       cell_file_sstr << "cells-";
-      cell_file_sstr << std::setfill('0') << std::setw(8) << spin_file_id;
+      cell_file_sstr << std::setfill('0') << std::setw(8) << frame.id;
       cell_file_sstr << ".txt";
       std::string cell_file_name = cell_file_sstr.str();
 
       // output informative message to user
-      std::cout << "   Writing cell file " << cell_file_name << "..." << std::flush;
+      frame.log << "   Writing cell file " << cell_file_name << "..." << std::flush;
 
       ofile.open(cell_file_name.c_str());
 
@@ -308,7 +298,7 @@ namespace vdc{
       for( unsigned int cell = 0; cell < total_cells; cell++){
          ofile << vdc::cell_coords[3*cell + 0] << "\t" << vdc::cell_coords[3*cell + 1] << "\t" << vdc::cell_coords[3*cell + 2] << "\t";
          for( unsigned int m = 0; m < tmid; m++){
-            ofile << vdc::cell_magnetization[cell][m][0] << "\t" << vdc::cell_magnetization[cell][m][1] << "\t" << vdc::cell_magnetization[cell][m][2] << "\t" << vdc::cell_magnetization[cell][m][3] << "\t";
+            ofile << frame.cell_magnetization[cell][m][0] << "\t" << frame.cell_magnetization[cell][m][1] << "\t" << frame.cell_magnetization[cell][m][2] << "\t" << frame.cell_magnetization[cell][m][3] << "\t";
          }
          ofile << num_atoms_in_cell[cell];
          ofile << "\n";
@@ -322,7 +312,7 @@ namespace vdc{
 
       ofile.close();
 
-      std::cout << "done!" << std::endl;
+      frame.log << "done!" << std::endl;
 
       }
 
@@ -66,7 +66,6 @@ namespace vdc{
    std::vector<int> grain(0);
 
    std::vector<double> coordinates(0);
-   std::vector<double> spins(0);
 
    // slice parameters for cutting the original system
    std::vector<double> slice_parameters = {0.0,1.0,0.0,1.0,0.0,1.0};
@@ -115,14 +114,12 @@ namespace vdc{
    std::vector<int> atom_cell_id;
    std::vector<int> num_atoms_in_cell;
    std::vector<double> cell_coords;
-   std::vector<std::vector<std::vector <double>>> cell_magnetization;
 
    // grain data
    std::vector < std::vector <xy_t> > grain_vertices_array;
 
    // array to store subsidiary data file names
    std::vector<std::string> coord_filenames(0);
-   std::vector<std::string> spin_filenames(0);
    std::vector<std::string> nm_filenames(0);
 
    // arrays for storing time-averaged spin-spin correlations
@@ -133,6 +130,8 @@ namespace vdc{
    double ssc_num_bins;  // number of bins for correlations
    double ssc_bin_width; // width of each bin (Agstroms)
    double ssc_inv_bin_width; // 1/bin width
+   ssc_mode_t ssc_mode = ssc_direct; // algorithm used to compute correlations
+   double ssc_cutoff_radius = 10.0; // maximum pair distance in cutoff mode (Angstroms)
 
    // unordered map of input key string to function wrapper
    const std::unordered_map<std::string, std::function<void(const input_t&)>> key_list = {
@@ -182,7 +181,10 @@ namespace vdc{
       {"atom-sizes" , set_atom_sizes},
       {"atom-size"  , set_atom_sizes},
       {"arrow-sizes", set_arrow_sizes},
-      {"arrow-size" , set_arrow_sizes}
+      {"arrow-size" , set_arrow_sizes},
+      // spin-spin correlation settings
+      {"ssc-mode"  , set_ssc_mode},
+      {"ssc-cutoff", set_ssc_cutoff}
    };
 
 } // end of namespace vdc
@@ -654,6 +654,61 @@ void set_cell_size(const input_t &input){
 
 }
 
+//----------------------------------------------------------------------------------
+// Set algorithm for spin-spin correlation calculation
+//----------------------------------------------------------------------------------
+void set_ssc_mode(const input_t &input){
+
+   // print help message if argument is "-h"
+   if (input.value[0] == "-h"){
+      std::cout << "\"ssc-mode\"\tExpects 1 argument: direct, fft or cutoff\n\n"
+                << "Algorithm used to compute the spin-spin correlation. direct\n"
+                << "sums over all pairs of atoms and scales as N^2. fft places\n"
+                << "the spins on the lattice grid and computes all correlations\n"
+                << "with fast Fourier transforms (requires FFTW). cutoff uses a\n"
+                << "cell list to sum over pairs closer than ssc-cutoff and works\n"
+                << "for any atomic structure.\n\n"
+                << "Default: ssc-mode = direct\n";
+      std::exit(EXIT_SUCCESS);
+   }
+
+   // check args
+   arg_count(input,1,"eq");
+
+   if      (input.value[0] == "direct"){ vdc::ssc_mode = vdc::ssc_direct; }
+   else if (input.value[0] == "fft"   ){ vdc::ssc_mode = vdc::ssc_fft;    }
+   else if (input.value[0] == "cutoff"){ vdc::ssc_mode = vdc::ssc_cutoff; }
+   else { error_message(input,"ssc-mode must be one of direct, fft or cutoff,"); }
+
+}
+
+//----------------------------------------------------------------------------------
+// Set cutoff radius for cell list spin-spin correlation
+//----------------------------------------------------------------------------------
+void set_ssc_cutoff(const input_t &input){
+
+   // print help message if argument is "-h"
+   if (input.value[0] == "-h"){
+      std::cout << "\"ssc-cutoff\"\tExpects 1 argument: positive real\n\n"
+                << "Maximum distance in Angstroms between pairs of atoms included\n"
+                << "in the spin-spin correlation when ssc-mode = cutoff.\n\n"
+                << "Default: ssc-cutoff = 10.0\n";
+      std::exit(EXIT_SUCCESS);
+   }
+
+   // check args
+   arg_count(input,1,"eq");
+
+   try { vdc::ssc_cutoff_radius = std::stod(input.value[0]); }
+   catch(...){ error_message(input,"invalid argument"); }
+
+   // check range
+   if (vdc::ssc_cutoff_radius <= 0.0){
+      error_message(input,"ssc-cutoff must be greater than 0.0,");
+   }
+
+}
+
 // bookkeeping functino to check number of args provided is correct
 void arg_count(const input_t &input, size_t args_required, std::string requirement){
 
@@ -35,17 +35,17 @@ namespace vdc{
 //------------------------------------------------------------------------------
 // Function to output cells.inc file compatible with povray
 //------------------------------------------------------------------------------
-void output_cells_inc_file(unsigned int spin_file_id){
+void output_cells_inc_file(frame_t& frame){
 
    // Open Povray Include File
 	std::stringstream incpov_file_sstr;
 	incpov_file_sstr << "cells-";
-	incpov_file_sstr << std::setfill('0') << std::setw(8) << spin_file_id;
+	incpov_file_sstr << std::setfill('0') << std::setw(8) << frame.id;
 	incpov_file_sstr << ".inc";
 	std::string incpov_file = incpov_file_sstr.str();
 
    // output informative message to user
-   if(vdc::verbose) std::cout << "   Writing povray file " << incpov_file << "..." << std::flush;
+   if(vdc::verbose) frame.log << "   Writing povray file " << incpov_file << "..." << std::flush;
 
    // open incfile
    std::ofstream incfile;
@@ -72,9 +72,9 @@ void output_cells_inc_file(unsigned int spin_file_id){
       for( unsigned int cell = 0; cell < total_cells; cell++){
 
          // get magnetization for colour contrast
-         double mx = vdc::cell_magnetization[cell][tmid][0];
-         double my = vdc::cell_magnetization[cell][tmid][1];
-         double mz = vdc::cell_magnetization[cell][tmid][2];
+         double mx = frame.cell_magnetization[cell][tmid][0];
+         double my = frame.cell_magnetization[cell][tmid][1];
+         double mz = frame.cell_magnetization[cell][tmid][2];
 
          // temporary thread private variables defining spin colours
          double red=0.0, green=0.0, blue=1.0;
@@ -107,7 +107,7 @@ void output_cells_inc_file(unsigned int spin_file_id){
    incfile.close();
 
    // output informative message to user
-   if(vdc::verbose) std::cout << "done!" << std::endl;
+   if(vdc::verbose) frame.log << "done!" << std::endl;
 
    return;
 
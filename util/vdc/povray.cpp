@@ -47,17 +47,17 @@ void initialise_povray() {
 //------------------------------------------------------------------------------
 // Function to output spins.inc file compatible with povray
 //------------------------------------------------------------------------------
-void output_inc_file(unsigned int spin_file_id){
+void output_inc_file(frame_t& frame){
 
    // Open Povray Include File
 	std::stringstream incpov_file_sstr;
 	incpov_file_sstr << "spins-";
-	incpov_file_sstr << std::setfill('0') << std::setw(8) << spin_file_id;
+	incpov_file_sstr << std::setfill('0') << std::setw(8) << frame.id;
 	incpov_file_sstr << ".inc";
 	std::string incpov_file = incpov_file_sstr.str();
 
    // output informative message to user
-   if(vdc::verbose) std::cout << "   Writing povray file " << incpov_file << "..." << std::flush;
+   if(vdc::verbose) frame.log << "   Writing povray file " << incpov_file << "..." << std::flush;
 
    // open incfile
    std::ofstream incfile;
@@ -81,9 +81,9 @@ void output_inc_file(unsigned int spin_file_id){
          unsigned int atom = vdc::sliced_atoms_list[i];
 
          // get magnetization for colour contrast
-         double sx = spins[3*atom+0];
-         double sy = spins[3*atom+1];
-         double sz = spins[3*atom+2];
+         double sx = frame.spins[3*atom+0];
+         double sy = frame.spins[3*atom+1];
+         double sz = frame.spins[3*atom+2];
 
          // flip antiferromagnetic spins if required
          if (std::find(afm_materials.begin(), afm_materials.end(), vdc::type[atom]+1) != afm_materials.end() ){
@@ -101,7 +101,7 @@ void output_inc_file(unsigned int spin_file_id){
          // format text for povray file
          otext << "spinm"<< type[atom]+1 << "(" <<
                   coordinates[3*atom+0]-vdc::system_centre[0] << "," << coordinates[3*atom+1]-vdc::system_centre[1] << "," << coordinates[3*atom+2]-vdc::system_centre[2] << "," <<
-                  spins[3*atom+0] << "," << spins[3*atom+1] << "," << spins[3*atom+2] << "," <<
+                  frame.spins[3*atom+0] << "," << frame.spins[3*atom+1] << "," << frame.spins[3*atom+2] << "," <<
                   red << "," << green << "," << blue << ")\n";
 
       } // end of parallel for
@@ -150,7 +150,7 @@ void output_inc_file(unsigned int spin_file_id){
    incfile.close();
 
    // output informative message to user
-   if(vdc::verbose) std::cout << "done!" << std::endl;
+   if(vdc::verbose) frame.log << "done!" << std::endl;
 
    return;
 
@@ -12,6 +12,7 @@
 
 // C++ standard library headers
 #include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -19,14 +20,42 @@
 #include <sstream>
 #include <vector>
 
+// memory mapped file headers
+#if defined(__unix__) || defined(__APPLE__)
+   #include <fcntl.h>
+   #include <sys/mman.h>
+   #include <sys/stat.h>
+   #include <unistd.h>
+   #define VDC_MMAP
+#endif
+
 // program header
 #include "vdc.hpp"
 
+// openmp header
+#ifdef _OPENMP
+   #include <omp.h>
+#else
+   #define omp_get_max_threads() 1
+#endif
+
 namespace vdc{
 
 // forward function declarations
-bool read_spin_metadata(unsigned int file_id);
-void read_spin_data();
+bool spin_metadata_exists(unsigned int file_id);
+bool read_spin_metadata(frame_t& frame);
+void read_spin_data(frame_t& frame);
+
+//------------------------------------------------------------------------------
+// Function to generate spin metadata file name for snapshot
+//------------------------------------------------------------------------------
+std::string spin_metadata_filename(unsigned int file_id){
+   std::stringstream filename;
+   filename << "spins-";
+   filename << std::setfill('0') << std::setw(8) << file_id;
+   filename << ".meta";
+   return filename.str();
+}
 
 //------------------------------------------------------------------------------
 // Wrapper function to read coordinate metafile to initialise data structures
@@ -43,47 +72,76 @@ void process_spins(){
 
    if(vdc::povray || vdc::povcells ) vdc::initialise_povray();
 
+   // determine consecutive snapshots available on disk
+   unsigned int end_file_id = min_file_id;
+   while(end_file_id < max_file_id && vdc::spin_metadata_exists(end_file_id)) end_file_id++;
+   const int num_frames = end_file_id - min_file_id;
+
+   // set global start and end file id
+   vdc::start_file_id = min_file_id;
+   vdc::final_file_id = num_frames > 0 ? end_file_id - 1 : max_file_id;
+
    // output povray file
    if(vdc::povray) output_povray_file();
    if(vdc::povcells) output_povray_cells_file();
 
-   unsigned int last_file_id = max_file_id;
+   //---------------------------------------------------------------------------
+   // process snapshots concurrently, one per thread
+   // step 1: each thread reads and processes its own snapshot, so reading of
+   //         one snapshot overlaps with processing of the others
+   // step 2: screen output and averages are written in snapshot order
+   //
+   // With a single snapshot the output functions are parallelised internally.
+   //---------------------------------------------------------------------------
+   const int num_workers = std::max(1, std::min(omp_get_max_threads(), num_frames));
 
-   // loop over all spin files
-   for(unsigned int file_id = min_file_id; file_id < max_file_id; file_id++){
+   #pragma omp parallel num_threads(num_workers)
+   {
 
-      // read meta data
-      bool success = vdc::read_spin_metadata(file_id);
+      // thread private snapshot data, reused between snapshots
+      vdc::frame_t frame;
 
-      // if no success then break out of for loop
-      if(!success) break;
+      #pragma omp for ordered schedule(dynamic)
+      for(int frame_index = 0; frame_index < num_frames; frame_index++){
 
-      // read coordinate data
-      vdc::read_spin_data();
+         frame.id = min_file_id + frame_index;
+         frame.log.str("");
 
-      // output cells raw data
-      if(vdc::cells) vdc::output_cell_file(file_id);
+         // read meta data
+         if(!vdc::read_spin_metadata(frame)){
+            std::cerr << "Error! Spins metadata file " << spin_metadata_filename(frame.id) << " cannot be opened. Exiting" << std::endl;
+            std::exit(EXIT_FAILURE);
+         }
 
-      // output povray files
-      if(vdc::povray) output_inc_file(file_id);
-      if(vdc::povcells) output_cells_inc_file(file_id);
+         // read spin data
+         vdc::read_spin_data(frame);
 
-      // output vtk file
-      if(vdc::vtk) output_vtk_file(file_id);
+         // output cells raw data
+         if(vdc::cells) vdc::output_cell_file(frame);
 
-      // output plain text file
-      if(vdc::txt) output_txt_file(file_id);
+         // output povray files
+         if(vdc::povray) output_inc_file(frame);
+         if(vdc::povcells) output_cells_inc_file(frame);
 
-      // compute spin-spin correlation
-      if(vdc::ssc) output_ssc_file(file_id);
+         // output vtk file
+         if(vdc::vtk) output_vtk_file(frame);
 
-      last_file_id = file_id;
+         // output plain text file
+         if(vdc::txt) output_txt_file(frame);
 
-   }
+         // compute spin-spin correlation
+         if(vdc::ssc) output_ssc_file(frame);
 
-   // set global start and end file id
-   vdc::start_file_id = min_file_id;
-   vdc::final_file_id = last_file_id;
+         // write messages and accumulate averages in snapshot order
+         #pragma omp ordered
+         {
+            std::cout << frame.log.str() << std::flush;
+            if(vdc::ssc) accumulate_ssc(frame);
+         }
+
+      }
+
+   } // end of parallel region
 
    // output average ssc
    if(vdc::ssc) output_average_ssc_file();
@@ -92,6 +150,18 @@ void process_spins(){
 
 }
 
+//------------------------------------------------------------------------------
+// Function to check if spin metafile for snapshot exists
+//------------------------------------------------------------------------------
+bool spin_metadata_exists(unsigned int file_id){
+
+   std::ifstream smfile;
+   smfile.open(spin_metadata_filename(file_id));
+
+   return smfile.is_open();
+
+}
+
 //------------------------------------------------------------------------------
 // Function to read coordinate metafile
 //------------------------------------------------------------------------------
@@ -113,17 +183,14 @@ void process_spins(){
 //       #------------------------------------------------------
 //
 //------------------------------------------------------------------------------
-bool read_spin_metadata(unsigned int file_id){
+bool read_spin_metadata(frame_t& frame){
 
    // determine file name
-   std::stringstream filename;
-   filename << "spins-";
-   filename << std::setfill('0') << std::setw(8) << file_id;
-   filename << ".meta";
+   const std::string filename = spin_metadata_filename(frame.id);
 
    // open spins metadata file
    std::ifstream smfile;
-   smfile.open(filename.str());
+   smfile.open(filename);
 
    // check for open file, if not open then end program, end of snapshots
    if(!smfile.is_open()){
@@ -134,9 +201,9 @@ bool read_spin_metadata(unsigned int file_id){
    }
 
    // Metafile found - inform the user and process data
-   if(vdc::verbose) std::cout << "--------------------------------------------------------------------" << std::endl;
-   std::cout << "Processing snapshot " << std::setfill('0') << std::setw(8) << file_id << std::endl;
-   if(vdc::verbose) std::cout << "   Reading spin meta-data file " << filename.str() << std::endl;
+   if(vdc::verbose) frame.log << "--------------------------------------------------------------------" << std::endl;
+   frame.log << "Processing snapshot " << std::setfill('0') << std::setw(8) << frame.id << std::endl;
+   if(vdc::verbose) frame.log << "   Reading spin meta-data file " << filename << std::endl;
 
    std::string line; // line string variable
 
@@ -148,17 +215,17 @@ bool read_spin_metadata(unsigned int file_id){
    line.erase (line.begin(), line.begin()+22);
    unsigned int num_spin_files=atoi(line.c_str());
 
-   if(vdc::verbose) std::cout << "   Number of data files: " << num_spin_files << std::endl;
+   if(vdc::verbose) frame.log << "   Number of data files: " << num_spin_files << std::endl;
 
-   vdc::spin_filenames.resize(0);
+   frame.spin_filenames.resize(0);
 
    for(unsigned int file = 0; file < num_spin_files; file++){
       getline(smfile, line);
       line.erase(remove(line.begin(), line.end(), '\t'), line.end());
       line.erase(remove(line.begin(), line.end(), ' '), line.end());
       line.erase(remove(line.begin(), line.end(), '\r'), line.end());
-      vdc::spin_filenames.push_back(line);
-      if(vdc::verbose) std::cout << "      " << line << std::endl;
+      frame.spin_filenames.push_back(line);
+      if(vdc::verbose) frame.log << "      " << line << std::endl;
    }
 
    return true;
@@ -168,48 +235,79 @@ bool read_spin_metadata(unsigned int file_id){
 //------------------------------------------------------------------------------
 // Function to read in coordinate data from subsidiary files
 //------------------------------------------------------------------------------
-void read_spin_data(){
+void read_spin_data(frame_t& frame){
 
-   if(vdc::verbose) std::cout << "   Reading spin data... " << std::flush;
+   if(vdc::verbose) frame.log << "   Reading spin data... " << std::flush;
 
    // resize arrays
-   if(vdc::spins.size() != 3*vdc::num_atoms) vdc::spins.resize(3*vdc::num_atoms);
+   if(frame.spins.size() != 3*vdc::num_atoms) frame.spins.resize(3*vdc::num_atoms);
 
    // index counter
    uint64_t atom_id = 0;
 
    // loop over all files
-   for(unsigned int f = 0; f < vdc::spin_filenames.size(); f++){
+   for(unsigned int f = 0; f < frame.spin_filenames.size(); f++){
+
+      const std::string& filename = frame.spin_filenames[f];
 
       switch (vdc::format){
 
          case vdc::binary:{
             uint64_t num_atoms_in_file = 0;
-            // open file in binary mode
-            std::ifstream ifile;
-            ifile.open(spin_filenames[f].c_str(), std::ios::binary); // check for errors
-            // check for open file
-            if(!ifile.is_open()){
-               std::cerr << std::endl << "   Error! Spin data file \"" << spin_filenames[f] << "\" cannot be opened. Exiting" << std::endl;
-               exit(1);
-            }
-            // read number of atoms
-            ifile.read( (char*)&num_atoms_in_file,sizeof(uint64_t) );
-            // read spin data
-            ifile.read((char*)&vdc::spins[atom_id*3], sizeof(double)*num_atoms_in_file*3);
+            #ifdef VDC_MMAP
+               // map file into memory and copy spin data directly into frame
+               const int fd = open(filename.c_str(), O_RDONLY);
+               struct stat file_stat;
+               if(fd < 0 || fstat(fd, &file_stat) != 0){
+                  std::cerr << std::endl << "   Error! Spin data file \"" << filename << "\" cannot be opened. Exiting" << std::endl;
+                  exit(1);
+               }
+               const size_t file_size = file_stat.st_size;
+               void* map = file_size > 0 ? mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+               close(fd);
+               if(map == MAP_FAILED){
+                  std::cerr << std::endl << "   Error! Spin data file \"" << filename << "\" cannot be mapped into memory. Exiting" << std::endl;
+                  exit(1);
+               }
+               madvise(map, file_size, MADV_SEQUENTIAL);
+               const char* data = static_cast<const char*>(map);
+               // read number of atoms
+               if(file_size >= sizeof(uint64_t)) memcpy(&num_atoms_in_file, data, sizeof(uint64_t));
+               // check file is complete and consistent with coordinate data
+               if(sizeof(uint64_t) + sizeof(double)*num_atoms_in_file*3 > file_size || atom_id + num_atoms_in_file > vdc::num_atoms){
+                  std::cerr << std::endl << "   Error! Spin data file \"" << filename << "\" is inconsistent with coordinate data. Exiting" << std::endl;
+                  exit(1);
+               }
+               // read spin data
+               memcpy(&frame.spins[atom_id*3], data + sizeof(uint64_t), sizeof(double)*num_atoms_in_file*3);
+               munmap(map, file_size);
+            #else
+               // open file in binary mode
+               std::ifstream ifile;
+               ifile.open(filename.c_str(), std::ios::binary); // check for errors
+               // check for open file
+               if(!ifile.is_open()){
+                  std::cerr << std::endl << "   Error! Spin data file \"" << filename << "\" cannot be opened. Exiting" << std::endl;
+                  exit(1);
+               }
+               // read number of atoms
+               ifile.read( (char*)&num_atoms_in_file,sizeof(uint64_t) );
+               // read spin data
+               ifile.read((char*)&frame.spins[atom_id*3], sizeof(double)*num_atoms_in_file*3);
+               ifile.close();
+            #endif
             // increment counter
             atom_id += num_atoms_in_file;
-            ifile.close();
             break;
          }
 
          case vdc::text:{
             // open file
             std::ifstream ifile;
-            ifile.open(spin_filenames[f].c_str()); // check for errors
+            ifile.open(filename.c_str()); // check for errors
             // check for open file
             if(!ifile.is_open()){
-               std::cerr << std::endl << "   Error! Spin data file \"" << spin_filenames[f] << "\" cannot be opened. Exiting" << std::endl;
+               std::cerr << std::endl << "   Error! Spin data file \"" << filename << "\" cannot be opened. Exiting" << std::endl;
                exit(1);
             }
 
@@ -226,9 +324,9 @@ void read_spin_data(){
                getline(ifile, line);
                std::istringstream ss(line);
                ss >> x >> y >> z;
-               vdc::spins[3*atom_id + 0] = x;
-               vdc::spins[3*atom_id + 1] = y;
-               vdc::spins[3*atom_id + 2] = z;
+               frame.spins[3*atom_id + 0] = x;
+               frame.spins[3*atom_id + 1] = y;
+               frame.spins[3*atom_id + 2] = z;
                // increment atom counter
                atom_id += 1;
             }
@@ -241,7 +339,7 @@ void read_spin_data(){
    }
 
    // output informative message to user
-   if(vdc::verbose) std::cout << "done!" << std::endl;
+   if(vdc::verbose) frame.log << "done!" << std::endl;
 
    return;
 
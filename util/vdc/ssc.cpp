@@ -11,10 +11,14 @@
 //
 
 // C++ standard library headers
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <limits>
 #include <string>
 #include <sstream>
 #include <vector>
@@ -29,8 +33,228 @@
    #define omp_get_thread_num() 0
 #endif
 
+// fftw header
+#ifdef FFT
+   #include <fftw3.h>
+#endif
+
 namespace vdc{
 
+//------------------------------------------------------------------------------
+// Private data for fft and cutoff correlation algorithms
+//------------------------------------------------------------------------------
+namespace ssc_data{
+
+   // fft mode: spins are placed on a zero-padded lattice grid so that the
+   // cyclic correlation from the FFT equals the open boundary pair sum
+   int grid[3] = {1, 1, 1};             // number of lattice grid points
+   int padded[3] = {1, 1, 1};           // number of padded grid points
+   double spacing[3] = {1.0, 1.0, 1.0}; // lattice grid spacing (Angstroms)
+   uint64_t num_points = 1;             // total number of padded grid points
+   uint64_t num_kpoints = 1;            // number of points in r2c output
+   std::vector<uint64_t> grid_index;    // padded grid point of each atom
+   std::vector<int> point_bin;          // radial bin of each displacement (-1 if no pairs)
+   std::vector<double> pair_counts;     // number of pairs in each radial bin
+
+   #ifdef FFT
+      fftw_plan plan_forward;
+      fftw_plan plan_backward;
+   #endif
+
+   // cutoff mode: cell list with cells no smaller than the cutoff radius
+   int num_cells[3] = {1, 1, 1};        // number of cells in x,y,z
+   std::vector<int> cell_start;         // first entry of each cell in cell_atoms
+   std::vector<int> cell_atoms;         // atom ids sorted by cell
+
+}
+
+namespace sd = vdc::ssc_data;
+
+//------------------------------------------------------------------------------
+// Function to determine lattice grid spacing and size along one direction
+//------------------------------------------------------------------------------
+void determine_ssc_grid(const int d){
+
+   const double tolerance = 1.0e-3; // Angstroms
+
+   std::vector<double> x(vdc::num_atoms);
+   for(unsigned int atom = 0; atom < vdc::num_atoms; atom++) x[atom] = coordinates[3*atom+d];
+   std::sort(x.begin(), x.end());
+
+   // smallest separation between distinct coordinates
+   double gap = 0.0;
+   for(unsigned int atom = 1; atom < vdc::num_atoms; atom++){
+      const double dx = x[atom] - x[atom-1];
+      if(dx > tolerance && (gap == 0.0 || dx < gap)) gap = dx;
+   }
+
+   // all atoms in a single plane
+   if(gap == 0.0){
+      sd::grid[d] = 1;
+      sd::spacing[d] = 1.0;
+      return;
+   }
+
+   // refine spacing from full extent to avoid accumulated rounding errors
+   const double range = x.back() - x.front();
+   const int intervals = int(round(range / gap));
+   sd::grid[d] = intervals + 1;
+   sd::spacing[d] = range / double(intervals);
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to initialise lattice grid and FFT plans for fft correlations
+//------------------------------------------------------------------------------
+void initialise_ssc_fft(){
+
+   #ifdef FFT
+
+      if(vdc::verbose) std::cout << "   Initialising FFT spin-spin correlation grid..." << std::flush;
+
+      double min[3] = {0.0, 0.0, 0.0};
+      for(int d = 0; d < 3; d++){
+         determine_ssc_grid(d);
+         min[d] = 1.0e123;
+         for(unsigned int atom = 0; atom < vdc::num_atoms; atom++) min[d] = std::min(min[d], coordinates[3*atom+d]);
+         // pad to twice the grid size to remove periodic images
+         sd::padded[d] = sd::grid[d] > 1 ? 2 * sd::grid[d] : 1;
+      }
+
+      sd::num_points = uint64_t(sd::padded[0]) * uint64_t(sd::padded[1]) * uint64_t(sd::padded[2]);
+      sd::num_kpoints = uint64_t(sd::padded[0]) * uint64_t(sd::padded[1]) * uint64_t(sd::padded[2]/2+1);
+
+      // allocate grids and plan transforms before data is filled
+      double* real_grid = (double*) fftw_malloc(sizeof(double) * sd::num_points);
+      fftw_complex* k_grid = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * sd::num_kpoints);
+      sd::plan_forward  = fftw_plan_dft_r2c_3d(sd::padded[0], sd::padded[1], sd::padded[2], real_grid, k_grid, FFTW_MEASURE);
+      sd::plan_backward = fftw_plan_dft_c2r_3d(sd::padded[0], sd::padded[1], sd::padded[2], k_grid, real_grid, FFTW_MEASURE);
+
+      // map atoms onto grid points, checking they lie on the grid
+      sd::grid_index.resize(vdc::num_atoms);
+      std::fill(real_grid, real_grid + sd::num_points, 0.0);
+      for(unsigned int atom = 0; atom < vdc::num_atoms; atom++){
+         int index[3];
+         for(int d = 0; d < 3; d++){
+            const double f = (coordinates[3*atom+d] - min[d]) / sd::spacing[d];
+            index[d] = int(round(f));
+            if(std::abs(f - double(index[d])) * sd::spacing[d] > 1.0e-2){
+               std::cerr << std::endl << "Error - atomic positions are not commensurate with a regular grid, required for ssc-mode = fft. Use ssc-mode = cutoff instead." << std::endl;
+               std::exit(EXIT_FAILURE);
+            }
+         }
+         const uint64_t point = (uint64_t(index[0]) * sd::padded[1] + index[1]) * sd::padded[2] + index[2];
+         if(real_grid[point] > 0.0){
+            std::cerr << std::endl << "Error - more than one atom maps to the same grid point, required for ssc-mode = fft. Use ssc-mode = cutoff instead." << std::endl;
+            std::exit(EXIT_FAILURE);
+         }
+         real_grid[point] = 1.0;
+         sd::grid_index[atom] = point;
+      }
+
+      // autocorrelation of occupancy gives number of pairs at each displacement
+      fftw_execute_dft_r2c(sd::plan_forward, real_grid, k_grid);
+      for(uint64_t k = 0; k < sd::num_kpoints; k++){
+         k_grid[k][0] = k_grid[k][0] * k_grid[k][0] + k_grid[k][1] * k_grid[k][1];
+         k_grid[k][1] = 0.0;
+      }
+      fftw_execute_dft_c2r(sd::plan_backward, k_grid, real_grid);
+
+      // determine radial bin of each displacement and total pairs in each bin
+      const int num_bins = vdc::ssc_num_bins;
+      const double inv_num_points = 1.0 / double(sd::num_points);
+      sd::point_bin.assign(sd::num_points, -1);
+      sd::pair_counts.assign(num_bins, 0.0);
+
+      for(int i = 0; i < sd::padded[0]; i++){
+         const double dx = sd::spacing[0] * double(i < sd::grid[0] ? i : i - sd::padded[0]);
+         for(int j = 0; j < sd::padded[1]; j++){
+            const double dy = sd::spacing[1] * double(j < sd::grid[1] ? j : j - sd::padded[1]);
+            for(int k = 0; k < sd::padded[2]; k++){
+               const double dz = sd::spacing[2] * double(k < sd::grid[2] ? k : k - sd::padded[2]);
+               const uint64_t point = (uint64_t(i) * sd::padded[1] + j) * sd::padded[2] + k;
+               const double count = round(real_grid[point] * inv_num_points);
+               if(count > 0.5){
+                  const double rij = sqrt(dx*dx + dy*dy + dz*dz);
+                  const int index = std::min(int(rij * vdc::ssc_inv_bin_width), num_bins - 1);
+                  sd::point_bin[point] = index;
+                  sd::pair_counts[index] += count;
+               }
+            }
+         }
+      }
+
+      fftw_free(real_grid);
+      fftw_free(k_grid);
+
+      if(vdc::verbose) std::cout << "done! [" << sd::grid[0] << " x " << sd::grid[1] << " x " << sd::grid[2] << " grid]" << std::endl;
+
+   #else
+      std::cerr << "Error - vdc must be compiled with a linked FFTW library (-DFFT) for ssc-mode = fft, exiting" << std::endl;
+      std::exit(EXIT_FAILURE);
+   #endif
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to initialise cell list for cutoff correlations
+//------------------------------------------------------------------------------
+void initialise_ssc_cell_list(){
+
+   const double cutoff = vdc::ssc_cutoff_radius;
+
+   double min[3] = {1.0e123, 1.0e123, 1.0e123};
+   double max[3] = {-1.0e123, -1.0e123, -1.0e123};
+   for(unsigned int atom = 0; atom < vdc::num_atoms; atom++){
+      for(int d = 0; d < 3; d++){
+         min[d] = std::min(min[d], coordinates[3*atom+d]);
+         max[d] = std::max(max[d], coordinates[3*atom+d]);
+      }
+   }
+
+   // cells are at least as large as the cutoff so only neighbouring cells interact
+   // (computed in 64 bit as a small cutoff in a large system overflows int)
+   const uint64_t max_cells = std::numeric_limits<int>::max() - 1;
+   double cells_per_dim[3];
+   for(int d = 0; d < 3; d++) cells_per_dim[d] = std::max(1.0, std::floor((max[d] - min[d]) / cutoff));
+   if(cells_per_dim[0] * cells_per_dim[1] * cells_per_dim[2] > double(max_cells)){
+      std::cerr << "Error - ssc-cutoff of " << cutoff << " A gives a cell list of " << cells_per_dim[0] << " x " << cells_per_dim[1] << " x " << cells_per_dim[2]
+                << " cells which exceeds the maximum of " << max_cells << " cells, increase ssc-cutoff. Exiting" << std::endl;
+      std::exit(EXIT_FAILURE);
+   }
+
+   double inv_cell_width[3];
+   for(int d = 0; d < 3; d++){
+      sd::num_cells[d] = int(cells_per_dim[d]);
+      inv_cell_width[d] = max[d] > min[d] ? double(sd::num_cells[d]) / (max[d] - min[d]) : 0.0;
+   }
+   const uint64_t total_cells = uint64_t(sd::num_cells[0]) * uint64_t(sd::num_cells[1]) * uint64_t(sd::num_cells[2]);
+
+   // determine cell of each atom
+   std::vector<int> atom_cell(vdc::num_atoms);
+   for(unsigned int atom = 0; atom < vdc::num_atoms; atom++){
+      int c[3];
+      for(int d = 0; d < 3; d++) c[d] = std::min(int((coordinates[3*atom+d] - min[d]) * inv_cell_width[d]), sd::num_cells[d] - 1);
+      atom_cell[atom] = (c[0] * sd::num_cells[1] + c[1]) * sd::num_cells[2] + c[2];
+   }
+
+   // counting sort of atoms by cell
+   sd::cell_start.assign(total_cells + 1, 0);
+   for(unsigned int atom = 0; atom < vdc::num_atoms; atom++) sd::cell_start[atom_cell[atom] + 1]++;
+   for(uint64_t cell = 0; cell < total_cells; cell++) sd::cell_start[cell + 1] += sd::cell_start[cell];
+
+   std::vector<int> offset(sd::cell_start.begin(), sd::cell_start.end() - 1);
+   sd::cell_atoms.resize(vdc::num_atoms);
+   for(unsigned int atom = 0; atom < vdc::num_atoms; atom++) sd::cell_atoms[offset[atom_cell[atom]]++] = atom;
+
+   return;
+
+}
+
 //------------------------------------------------------------------------------
 // Function to initialise ssc data for averaging
 //------------------------------------------------------------------------------
@@ -49,61 +273,20 @@ void initialise_ssc(){
    ssc_counts.resize(ssc_num_bins);
    ssc_correl.resize(ssc_num_bins);
 
+   // initialise data for chosen algorithm
+   if(vdc::ssc_mode == vdc::ssc_fft) initialise_ssc_fft();
+   else if(vdc::ssc_mode == vdc::ssc_cutoff) initialise_ssc_cell_list();
+
 }
 
 //------------------------------------------------------------------------------
-// Function to output ssc-xxxxxxxx.txt file in plaintext format
-//------------------------------------------------------------------------------
-//
-// Writes a single file for each snapshot ID formatted as:
-//  rij  < sum (si . sj) >
-//
+// Function to compute correlations by direct summation over all pairs, O(N^2)
 //------------------------------------------------------------------------------
-void output_ssc_file(unsigned int spin_file_id){
-
-   // Open Povray Include File
-	std::stringstream txt_file_sstr;
-	txt_file_sstr << "ssc-";
-	txt_file_sstr << std::setfill('0') << std::setw(8) << spin_file_id;
-	txt_file_sstr << ".txt";
-	std::string txt_file = txt_file_sstr.str();
+void direct_ssc(const std::vector<double>& spins, std::vector<double>& counts, std::vector<double>& correl){
 
-   //--------------------------------------------------------------------------------------------------------------
-   // Spin-spin correlation calculation (radially symmetric)
-   //
-   // https://en.wikipedia.org/wiki/Correlation_function_(statistical_mechanics)
-   //
-   // C(r) = < S(r) . S(r+dr) > - < M >
-   //
-   // Data is binned according intratomic distance dr
-   //--------------------------------------------------------------------------------------------------------------
-
-   const double bin_width = vdc::ssc_bin_width;
    const double inv_bin_width = vdc::ssc_inv_bin_width;
    const int num_bins = vdc::ssc_num_bins;
 
-   //--------------------------------------------------
-   // calculate total magnetization <M> = <Sxyz> . <Sxyz>
-   //--------------------------------------------------
-   double total_sx = 0.0;
-   double total_sy = 0.0;
-   double total_sz = 0.0;
-   for(unsigned int atomi = 0; atomi < vdc::num_atoms; atomi++){
-      total_sx += spins[3*atomi+0];
-      total_sy += spins[3*atomi+1];
-      total_sz += spins[3*atomi+2];
-   }
-   const double total_s = ( total_sx * total_sx +
-                            total_sy * total_sy +
-                            total_sz * total_sz )  /  ( double(vdc::num_atoms) * double(vdc::num_atoms) );
-
-   // data to store counts and summations of s.s
-   std::vector<double> counts(num_bins); // number of counts
-   std::vector<double> correl(num_bins); // sum of correlations
-
-   // output informative message to user
-   if(vdc::verbose) std::cout << "   Generating spin-spin correlation data " << txt_file << "..." << std::flush;
-
    //---------------------------------------------------------------------------
    // parallelise calculation for better performance
    //---------------------------------------------------------------------------
@@ -144,13 +327,244 @@ void output_ssc_file(unsigned int spin_file_id){
 
    } // end of parallel region
 
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to compute correlations from FFT of spins on the lattice grid
+//------------------------------------------------------------------------------
+//
+// By the Wiener-Khinchin theorem sum_r S(r).S(r+d) = IFFT( |S(k)|^2 ) (d),
+// giving the correlation at every lattice displacement in O(N log N).
+//
+//------------------------------------------------------------------------------
+void fft_ssc(const std::vector<double>& spins, std::vector<double>& counts, std::vector<double>& correl){
+
+   #ifdef FFT
+
+   const int num_bins = vdc::ssc_num_bins;
+   const int64_t num_points = sd::num_points;
+   const int64_t num_kpoints = sd::num_kpoints;
+
+   // grids are private to each call so that snapshots can be processed concurrently
+   double* real_grid = (double*) fftw_malloc(sizeof(double) * num_points);
+   fftw_complex* k_grid = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * num_kpoints);
+   std::vector<double> power(num_kpoints, 0.0); // summed |S(k)|^2 of all spin components
+
+   // accumulate power spectrum of each spin component
+   for(int c = 0; c < 3; c++){
+
+      #pragma omp parallel for
+      for(int64_t p = 0; p < num_points; p++) real_grid[p] = 0.0;
+
+      #pragma omp parallel for
+      for(int64_t atom = 0; atom < int64_t(vdc::num_atoms); atom++) real_grid[sd::grid_index[atom]] = spins[3*atom+c];
+
+      fftw_execute_dft_r2c(sd::plan_forward, real_grid, k_grid);
+
+      #pragma omp parallel for
+      for(int64_t k = 0; k < num_kpoints; k++){
+         power[k] += k_grid[k][0] * k_grid[k][0] + k_grid[k][1] * k_grid[k][1];
+      }
+
+   }
+
+   // transform back to obtain correlation at each displacement
+   #pragma omp parallel for
+   for(int64_t k = 0; k < num_kpoints; k++){
+      k_grid[k][0] = power[k];
+      k_grid[k][1] = 0.0;
+   }
+
+   fftw_execute_dft_c2r(sd::plan_backward, k_grid, real_grid);
+
+   const double inv_num_points = 1.0 / double(num_points);
+
+   #pragma omp parallel
+   {
+
+      // thread private data to store summations of s.s
+      std::vector<double> thread_correl(num_bins); // sum of correlations
+
+      #pragma omp for
+      for(int64_t p = 0; p < num_points; p++){
+         const int index = sd::point_bin[p];
+         if(index >= 0) thread_correl[index] += real_grid[p] * inv_num_points;
+      }
+
+      // now reduce thread private arrays
+      #pragma omp critical
+      for(int i=0; i<num_bins; i++) correl[i] += thread_correl[i];
+
+   } // end of parallel region
+
+   fftw_free(real_grid);
+   fftw_free(k_grid);
+
+   // pair counts are fixed by the structure
+   for(int i=0; i<num_bins; i++) counts[i] += sd::pair_counts[i];
+
+   #endif
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to compute correlations for pairs within cutoff using cell list
+//------------------------------------------------------------------------------
+void cutoff_ssc(const std::vector<double>& spins, std::vector<double>& counts, std::vector<double>& correl){
+
+   const double inv_bin_width = vdc::ssc_inv_bin_width;
+   const int num_bins = vdc::ssc_num_bins;
+   const double cutoff_sq = vdc::ssc_cutoff_radius * vdc::ssc_cutoff_radius;
+
+   const int ncx = sd::num_cells[0];
+   const int ncy = sd::num_cells[1];
+   const int ncz = sd::num_cells[2];
+
+   //---------------------------------------------------------------------------
+   // parallelise calculation for better performance
+   //---------------------------------------------------------------------------
+   #pragma omp parallel
+   {
+
+      // thread private data to store counts and summations of s.s
+      std::vector<double> thread_counts(num_bins); // number of counts
+      std::vector<double> thread_correl(num_bins); // sum of correlations
+
+      #pragma omp for schedule(dynamic)
+      for(int cell = 0; cell < ncx*ncy*ncz; cell++){
+
+         const int cx = cell / (ncy*ncz);
+         const int cy = (cell / ncz) % ncy;
+         const int cz = cell % ncz;
+
+         // loop over neighbouring cells including self
+         for(int ix = std::max(cx-1, 0); ix <= std::min(cx+1, ncx-1); ix++){
+            for(int iy = std::max(cy-1, 0); iy <= std::min(cy+1, ncy-1); iy++){
+               for(int iz = std::max(cz-1, 0); iz <= std::min(cz+1, ncz-1); iz++){
+
+                  const int ncell = (ix * ncy + iy) * ncz + iz;
+
+                  for(int ii = sd::cell_start[cell]; ii < sd::cell_start[cell+1]; ii++){
+                     const int atomi = sd::cell_atoms[ii];
+                     for(int jj = sd::cell_start[ncell]; jj < sd::cell_start[ncell+1]; jj++){
+                        const int atomj = sd::cell_atoms[jj];
+
+                        const double dx = coordinates[3*atomj+0] - coordinates[3*atomi+0];
+                        const double dy = coordinates[3*atomj+1] - coordinates[3*atomi+1];
+                        const double dz = coordinates[3*atomj+2] - coordinates[3*atomi+2];
+
+                        const double rsq = dx*dx + dy*dy + dz*dz;
+                        if(rsq > cutoff_sq) continue;
+
+                        const double sx = spins[3*atomi+0] * spins[3*atomj+0];
+                        const double sy = spins[3*atomi+1] * spins[3*atomj+1];
+                        const double sz = spins[3*atomi+2] * spins[3*atomj+2];
+
+                        const int index = std::min(int(sqrt(rsq) * inv_bin_width), num_bins - 1);
+
+                        thread_correl[index] += sx+sy+sz;
+                        thread_counts[index] += 1.0;
+
+                     }
+                  }
+
+               }
+            }
+         }
+      }
+
+      // now reduce thread private arrays
+      #pragma omp critical
+      for(int i=0; i<num_bins; i++) counts[i] += thread_counts[i];
+
+      #pragma omp critical
+      for(int i=0; i<num_bins; i++) correl[i] += thread_correl[i];
+
+   } // end of parallel region
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to output ssc-xxxxxxxx.txt file in plaintext format
+//------------------------------------------------------------------------------
+//
+// Writes a single file for each snapshot ID formatted as:
+//  rij  < sum (si . sj) >
+//
+//------------------------------------------------------------------------------
+void output_ssc_file(frame_t& frame){
+
+   // Open Povray Include File
+	std::stringstream txt_file_sstr;
+	txt_file_sstr << "ssc-";
+	txt_file_sstr << std::setfill('0') << std::setw(8) << frame.id;
+	txt_file_sstr << ".txt";
+	std::string txt_file = txt_file_sstr.str();
+
+   //--------------------------------------------------------------------------------------------------------------
+   // Spin-spin correlation calculation (radially symmetric)
+   //
+   // https://en.wikipedia.org/wiki/Correlation_function_(statistical_mechanics)
+   //
+   // C(r) = < S(r) . S(r+dr) > - < M >
+   //
+   // Data is binned according intratomic distance dr
+   //--------------------------------------------------------------------------------------------------------------
+
+   const double bin_width = vdc::ssc_bin_width;
+   const int num_bins = vdc::ssc_num_bins;
+
+   //--------------------------------------------------
+   // calculate total magnetization <M> = <Sxyz> . <Sxyz>
+   //--------------------------------------------------
+   double total_sx = 0.0;
+   double total_sy = 0.0;
+   double total_sz = 0.0;
+   for(unsigned int atomi = 0; atomi < vdc::num_atoms; atomi++){
+      total_sx += frame.spins[3*atomi+0];
+      total_sy += frame.spins[3*atomi+1];
+      total_sz += frame.spins[3*atomi+2];
+   }
+   const double total_s = ( total_sx * total_sx +
+                            total_sy * total_sy +
+                            total_sz * total_sz )  /  ( double(vdc::num_atoms) * double(vdc::num_atoms) );
+
+   // data to store counts and summations of s.s
+   std::vector<double>& counts = frame.ssc_counts; // number of counts
+   std::vector<double>& correl = frame.ssc_correl; // sum of correlations
+   counts.assign(num_bins, 0.0);
+   correl.assign(num_bins, 0.0);
+   frame.ssc_magnetization = total_s;
+
    // output informative message to user
-   if(vdc::verbose) std::cout << "done!" << std::endl;
+   if(vdc::verbose) frame.log << "   Generating spin-spin correlation data " << txt_file << "..." << std::flush;
+
+   // compute pair correlations with chosen algorithm
+   switch(vdc::ssc_mode){
+      case vdc::ssc_fft:
+         fft_ssc(frame.spins, counts, correl);
+         break;
+      case vdc::ssc_cutoff:
+         cutoff_ssc(frame.spins, counts, correl);
+         break;
+      default:
+         direct_ssc(frame.spins, counts, correl);
+         break;
+   }
+
+   // output informative message to user
+   if(vdc::verbose) frame.log << "done!" << std::endl;
 
    //--------------------------------------------------------------------------------------------------------------
 
    // output informative message to user
-   if(vdc::verbose) std::cout << "   Writing spin-spin correlation file " << txt_file << "..." << std::flush;
+   if(vdc::verbose) frame.log << "   Writing spin-spin correlation file " << txt_file << "..." << std::flush;
 
    // open incfile
    std::ofstream txtfile;
@@ -168,14 +582,22 @@ void output_ssc_file(unsigned int spin_file_id){
    txtfile.close();
 
    // output informative message to user
-   if(vdc::verbose) std::cout << "done!" << std::endl;
+   if(vdc::verbose) frame.log << "done!" << std::endl;
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to save snapshot data to average arrays (called in snapshot order)
+//------------------------------------------------------------------------------
+void accumulate_ssc(const frame_t& frame){
+
+   const int num_bins = vdc::ssc_num_bins;
 
-   //-----------------------------------------
-   // save data to average arrays
-   //-----------------------------------------
-   for(int i=0; i<num_bins; i++) vdc::ssc_counts[i] += counts[i];
-   for(int i=0; i<num_bins; i++) vdc::ssc_correl[i] += correl[i];
-   vdc::ssc_magnetization += total_s;
+   for(int i=0; i<num_bins; i++) vdc::ssc_counts[i] += frame.ssc_counts[i];
+   for(int i=0; i<num_bins; i++) vdc::ssc_correl[i] += frame.ssc_correl[i];
+   vdc::ssc_magnetization += frame.ssc_magnetization;
    vdc::ssc_snapshots += 1.0;
 
    return;
@@ -39,17 +39,17 @@ namespace vdc{
 //  cx   cy   cz   sx   sy   sz
 //
 //------------------------------------------------------------------------------
-void output_txt_file(unsigned int spin_file_id){
+void output_txt_file(frame_t& frame){
 
    // Open Povray Include File
 	std::stringstream txt_file_sstr;
 	txt_file_sstr << "spins-";
-	txt_file_sstr << std::setfill('0') << std::setw(8) << spin_file_id;
+	txt_file_sstr << std::setfill('0') << std::setw(8) << frame.id;
 	txt_file_sstr << ".txt";
 	std::string txt_file = txt_file_sstr.str();
 
    // output informative message to user
-   if(vdc::verbose) std::cout << "   Writing text file " << txt_file << "..." << std::flush;
+   if(vdc::verbose) frame.log << "   Writing text file " << txt_file << "..." << std::flush;
 
    // open incfile
    std::ofstream txtfile;
@@ -77,7 +77,7 @@ void output_txt_file(unsigned int spin_file_id){
 
          // format text for plain text file
          otext << coordinates[3*atom+0]-vdc::system_centre[0] << "\t" << coordinates[3*atom+1]-vdc::system_centre[1] << "\t" << coordinates[3*atom+2]-vdc::system_centre[2] << "\t" <<
-                  spins[3*atom+0] << "\t" << spins[3*atom+1] << "\t" << spins[3*atom+2] << "\n";
+                  frame.spins[3*atom+0] << "\t" << frame.spins[3*atom+1] << "\t" << frame.spins[3*atom+2] << "\n";
 
       } // end of parallel for
 
@@ -121,7 +121,7 @@ void output_txt_file(unsigned int spin_file_id){
    txtfile.close();
 
    // output informative message to user
-   if(vdc::verbose) std::cout << "done!" << std::endl;
+   if(vdc::verbose) frame.log << "done!" << std::endl;
 
    return;
 
@@ -19,6 +19,7 @@
 #include <unordered_map>
 #include <functional>
 #include <string>
+#include <sstream>
 #include <cstdint>
 
 namespace vdc{
@@ -58,6 +59,7 @@ namespace vdc{
    // enumerated integers for option selection
    enum format_t{ binary = 0, text = 1};
    enum slice_type{ box, box_void, sphere, cylinder};
+   enum ssc_mode_t{ ssc_direct = 0, ssc_fft = 1, ssc_cutoff = 2};
    extern format_t format;
 
    // list of input file parameters set in command line (to check for double usage)
@@ -88,6 +90,18 @@ namespace vdc{
    // vector of slices
    extern std::vector<slice_t> slices;
 
+   // data for a single snapshot, several of which are processed concurrently
+   struct frame_t{
+      unsigned int id = 0; // snapshot file id
+      std::vector<std::string> spin_filenames; // subsidiary spin data files
+      std::vector<double> spins; // spin directions
+      std::vector< std::vector< std::vector <double> > > cell_magnetization; // cell data
+      std::vector<double> ssc_counts; // number of spin-spin correlation counts
+      std::vector<double> ssc_correl; // sum of spin-spin correlations
+      double ssc_magnetization = 0.0; // snapshot magnetization
+      std::ostringstream log; // screen output, written in snapshot order
+   };
+
    // unordered map of input keys to function wrappers
    extern const std::unordered_map<std::string,std::function<void(const input_t&)>> key_list;
 
@@ -118,7 +132,6 @@ namespace vdc{
    extern std::vector<int> grain;
 
    extern std::vector<double> coordinates;
-   extern std::vector<double> spins;
 
    // axis vectors for povray colouring
    extern std::vector<double> vector_z;
@@ -155,14 +168,12 @@ namespace vdc{
    extern std::vector<int> atom_cell_id;
    extern std::vector<int> num_atoms_in_cell;
    extern std::vector<double> cell_coords;
-   extern std::vector< std::vector< std::vector <double> > > cell_magnetization;
 
    // grain data
    extern std::vector < std::vector <xy_t> > grain_vertices_array;
 
    // array to store subsidiary data file names
    extern std::vector <std::string> coord_filenames;
-   extern std::vector <std::string> spin_filenames;
    extern std::vector <std::string> nm_filenames;
 
    // arrays for storing time-averaged spin-spin correlations
@@ -173,6 +184,8 @@ namespace vdc{
    extern double ssc_num_bins;  // number of bins for correlations
    extern double ssc_bin_width; // width of each bin (Agstroms)
    extern double ssc_inv_bin_width; // 1/bin width
+   extern ssc_mode_t ssc_mode; // algorithm used to compute correlations
+   extern double ssc_cutoff_radius; // maximum pair distance in cutoff mode (Angstroms)
 
    //==========================================
    // Forward function declarations
@@ -196,16 +209,16 @@ namespace vdc{
    void output_atoms_txt_file();
 
    // VTK
-   void output_vtk_file(unsigned int spin_file_id);
+   void output_vtk_file(frame_t& frame);
 
    // TXT
-   void output_txt_file(unsigned int spin_file_id);
+   void output_txt_file(frame_t& frame);
 
    // Povray
    void initialise_povray();
-   void output_inc_file(unsigned int spin_file_id);
+   void output_inc_file(frame_t& frame);
    void output_povray_file();
-   void output_cells_inc_file(unsigned int spin_file_id);
+   void output_cells_inc_file(frame_t& frame);
    void output_povray_cells_file();
    void output_sticks_file();
 
@@ -221,11 +234,12 @@ namespace vdc{
    // SSC
    void initialise_ssc();
    void output_average_ssc_file();
-   void output_ssc_file(unsigned int spin_file_id);
+   void output_ssc_file(frame_t& frame);
+   void accumulate_ssc(const frame_t& frame);
 
    // CELL
    void initialise_cells();
-   void output_cell_file(unsigned int spin_file_id);
+   void output_cell_file(frame_t& frame);
 
    // setting functions
    void set_frame_start(const input_t &input);
@@ -249,6 +263,8 @@ namespace vdc{
    void set_background_colour(const input_t &input);
    void set_atom_sizes(const input_t &input);
    void set_arrow_sizes(const input_t &input);
+   void set_ssc_mode(const input_t &input);
+   void set_ssc_cutoff(const input_t &input);
 }
 
 #endif //VDC_H_
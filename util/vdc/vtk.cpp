@@ -27,12 +27,12 @@ namespace vdc{
 //------------------------------------------------------------------------------
 // Function to output spins-XXXX.vtu files compatible with paraview
 //------------------------------------------------------------------------------
-void output_vtk_file(unsigned int spin_file_id){
+void output_vtk_file(frame_t& frame){
 
    // Set VTK file name
 	std::stringstream vtk_file_sstr;
 	vtk_file_sstr << "spins-";
-	vtk_file_sstr << std::setfill('0') << std::setw(8) << spin_file_id;
+	vtk_file_sstr << std::setfill('0') << std::setw(8) << frame.id;
 	vtk_file_sstr << ".vtu";
 	std::string vtk_file = vtk_file_sstr.str();
 
@@ -41,7 +41,7 @@ void output_vtk_file(unsigned int spin_file_id){
    vtkfile.open(vtk_file.c_str());
 
    // output informative message to user
-   if(vdc::verbose) std::cout << "   Writing VTK file " << vtk_file << "..." << std::flush;
+   if(vdc::verbose) frame.log << "   Writing VTK file " << vtk_file << "..." << std::flush;
 
    const double scx = vdc::system_centre[0];
    const double scy = vdc::system_centre[1];
@@ -71,7 +71,7 @@ void output_vtk_file(unsigned int spin_file_id){
 		// get atom ID
 		unsigned int atom = vdc::atoms_list[i];
 
-      vtkfile << spins[3*atom+0] << " " << spins[3*atom+1] << " " << spins[3*atom+2] << " ";
+      vtkfile << frame.spins[3*atom+0] << " " << frame.spins[3*atom+1] << " " << frame.spins[3*atom+2] << " ";
    }
    vtkfile << std::endl;
    vtkfile << "         </DataArray>" << std::endl;
@@ -112,7 +112,7 @@ void output_vtk_file(unsigned int spin_file_id){
    vtkfile << "</VTKFile>" << std::endl;
 
    // output informative message to user
-   if(vdc::verbose) std::cout << "done!" << std::endl;
+   if(vdc::verbose) frame.log << "done!" << std::endl;
 
    return;
 